@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2026 Nuand LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef FPGA_COMMON_AD936X_CORRECTION_H_
+#define FPGA_COMMON_AD936X_CORRECTION_H_
+
+/* This file describes the AD9361's I/Q correction registers, so that libbladeRF
+ * and the NIOS II can both turn correction values into register writes. */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef BLADERF_NIOS_BUILD
+#include <libbladeRF.h>
+#else
+#include "libbladeRF_nios_compat.h"
+#endif
+
+#include "ad936x.h"
+
+/* Number of correction values, indexed by bladerf_correction */
+#define AD936X_CORR_COUNT 4
+
+/* Maximum number of register updates needed to apply all corrections */
+#define AD936X_CORR_MAX_UPDATES 6
+
+/* Write of some of the bits of an AD9361 register. Bits outside of `mask`
+ * must be preserved. */
+struct ad936x_reg_update {
+    uint16_t addr;
+    uint8_t mask;
+    uint8_t data;
+};
+
+/* Add an update to a list, merging it with an earlier update of the same
+ * register */
+static inline void ad936x_reg_update_add(struct ad936x_reg_update *updates,
+                                         unsigned int *count,
+                                         uint16_t addr,
+                                         uint8_t mask,
+                                         uint8_t data)
+{
+    unsigned int i;
+
+    for (i = 0; i < *count; i++) {
+        if (updates[i].addr == addr) {
+            updates[i].mask |= mask;
+            updates[i].data = (updates[i].data & ~mask) | (data & mask);
+            return;
+        }
+    }
+
+    updates[*count].addr = addr;
+    updates[*count].mask = mask;
+    updates[*count].data = data & mask;
+    (*count)++;
+}
+
+/**
+ * Determine the register updates that apply I/Q corrections
+ *
+ * The RX DC offsets are 10-bit values, packed into the registers as follows,
+ * with the B/C input registers located 9 addresses above the A input ones:
+ *
+ *     RX1_INPUT_A_Q_OFFSET:  | RX1 Q[7:0]                  |
+ *     RX1_INPUT_A_OFFSETS:   | RX1 I[5:0]     | RX1 Q[9:8] |
+ *     INPUT_A_OFFSETS_1:     | RX2 Q[3:0] | RX1 I[9:6]     |
+ *     RX2_INPUT_A_OFFSETS:   | RX2 Q[9:4]     | RX2 I[1:0] |
+ *     RX2_INPUT_A_I_OFFSET:  | RX2 I[9:2]                  |
+ *
+ * The remaining corrections each occupy a full register.
+ *
+ * @param[in]   chan        Channel index, i.e., 0 for RX1/TX1, 1 for RX2/TX2
+ * @param[in]   is_tx       Corrections are for a TX channel
+ * @param[in]   low_band    Corrections are for RX input B/C or TX output B
+ * @param[in]   corr_mask   Bitmask of the corrections to apply, with bit n
+ *                          corresponding to bladerf_correction n
+ * @param[in]   values      Correction values, indexed by bladerf_correction
+ * @param[out]  updates     Register updates. Must have room for
+ *                          AD936X_CORR_MAX_UPDATES entries.
+ *
+ * @return Number of register updates
+ */
+static inline unsigned int ad936x_correction_updates(
+    unsigned int chan,
+    bool is_tx,
+    bool low_band,
+    unsigned int corr_mask,
+    int16_t const values[AD936X_CORR_COUNT],
+    struct ad936x_reg_update *updates)
+{
+    unsigned int count = 0;
+    unsigned int corr, shift;
+    uint16_t reg, dc;
+    uint8_t force = 0;
+
+    chan &= 0x1;
+
+    for (corr = 0; corr < AD936X_CORR_COUNT; corr++) {
+        if ((corr_mask & (1 << corr)) == 0) {
+            continue;
+        }
+
+        if (is_tx) {
+            /* Output 2 registers are 8 addresses above the output 1 ones */
+            if (corr == BLADERF_CORR_PHASE || corr == BLADERF_CORR_GAIN) {
+                reg = AD936X_REG_TX1_OUT_1_PHASE_CORR + 2 * chan +
+                      (corr == BLADERF_CORR_GAIN ? 1 : 0);
+            } else {
+                reg = AD936X_REG_TX1_OUT_1_OFFSET_I + 2 * chan +
+                      (corr == BLADERF_CORR_DCOFF_Q ? 1 : 0);
+            }
+
+            reg += low_band ? 8 : 0;
+
+            /* Scale to 8-bit */
+            shift = (corr == BLADERF_CORR_DCOFF_I ||
+                     corr == BLADERF_CORR_DCOFF_Q) ? 5 : 6;
+
+            ad936x_reg_update_add(updates, &count, reg, 0xff,
+                                  (values[corr] >> shift) & 0xff);
+        } else if (corr == BLADERF_CORR_PHASE || corr == BLADERF_CORR_GAIN) {
+            reg = AD936X_REG_RX1_INPUT_A_PHASE_CORR + 2 * chan +
+                  (corr == BLADERF_CORR_GAIN ? 1 : 0) + (low_band ? 9 : 0);
+
+            /* Scale to 8-bit */
+            ad936x_reg_update_add(updates, &count, reg, 0xff,
+                                  (values[corr] >> 6) & 0xff);
+        } else {
+            reg = low_band ? 9 : 0;
+
+            /* Scale 13-bit to 10-bit */
+            dc = (values[corr] >> 3) & 0x3ff;
+
+            if (chan == 0 && corr == BLADERF_CORR_DCOFF_I) {
+                ad936x_reg_update_add(updates, &count,
+                                      AD936X_REG_INPUT_A_OFFSETS_1 + reg, 0x0f,
+                                      dc >> 6);
+                ad936x_reg_update_add(updates, &count,
+                                      AD936X_REG_RX1_INPUT_A_OFFSETS + reg,
+                                      0xfc, dc << 2);
+            } else if (chan == 0) {
+                ad936x_reg_update_add(updates, &count,
+                                      AD936X_REG_RX1_INPUT_A_OFFSETS + reg,
+                                      0x03, dc >> 8);
+                ad936x_reg_update_add(updates, &count,
+                                      AD936X_REG_RX1_INPUT_A_Q_OFFSET + reg,
+                                      0xff, dc);
+            } else if (corr == BLADERF_CORR_DCOFF_I) {
+                ad936x_reg_update_add(updates, &count,
+                                      AD936X_REG_RX2_INPUT_A_I_OFFSET + reg,
+                                      0xff, dc >> 2);
+                ad936x_reg_update_add(updates, &count,
+                                      AD936X_REG_RX2_INPUT_A_OFFSETS + reg,
+                                      0x03, dc);
+            } else {
+                ad936x_reg_update_add(updates, &count,
+                                      AD936X_REG_RX2_INPUT_A_OFFSETS + reg,
+                                      0xfc, dc >> 2);
+                ad936x_reg_update_add(updates, &count,
+                                      AD936X_REG_INPUT_A_OFFSETS_1 + reg, 0xf0,
+                                      dc << 4);
+            }
+        }
+
+        /* The values only take effect once their force bit is set */
+        if (corr == BLADERF_CORR_DCOFF_I || corr == BLADERF_CORR_DCOFF_Q) {
+            force |= 1 << (2 + chan + (low_band ? 4 : 0));
+        } else {
+            force |= 1 << (chan + (low_band ? 4 : 0));
+        }
+    }
+
+    if (force != 0) {
+        ad936x_reg_update_add(
+            updates, &count,
+            is_tx ? AD936X_REG_TX_FORCE_BITS : AD936X_REG_FORCE_BITS, force,
+            force);
+    }
+
+    return count;
+}
+
+#endif
@@ -37,6 +37,10 @@
 #   include "board/board.h"
 #   define LMS_WRITE(dev, addr, value) dev->backend->lms_write(dev, addr, value)
 #   define LMS_READ(dev, addr, value)  dev->backend->lms_read(dev, addr, value)
+#   define LMS_WRITE_BATCH(dev, addr, data, n) \
+        dev->backend->lms_write_batch(dev, addr, data, n)
+#   define LMS_READ_BATCH(dev, addr, data, n) \
+        dev->backend->lms_read_batch(dev, addr, data, n)
 #else
 #   include "libbladeRF_nios_compat.h"
 #   include "devices.h"
@@ -60,6 +64,20 @@
  */
 #define LMS_FREQ_FLAGS_FORCE_VCOCAP   (1 << 1)
 
+/**
+ * The DC offset correction register values accompanying these tuning
+ * parameters are valid, and should be written after tuning.
+ */
+#define LMS_FREQ_FLAGS_DC_CORR        (1 << 2)
+
+/**
+ * The VCOCAP value is one that the tuning algorithm previously converged to
+ * for this frequency. It is used as-is if a single VTUNE reading shows that
+ * it is still in the "normal" region. Otherwise, this bit is cleared and the
+ * full tuning algorithm is performed, starting from the VCOCAP value.
+ */
+#define LMS_FREQ_FLAGS_VERIFY_VCOCAP  (1 << 3)
+
 /**
  * This bit indicates whether the quicktune needs to set XB-200 parameters
  */
@@ -835,4 +853,30 @@ int lms_set_dc_offset_q(struct bladerf *dev,
 int lms_get_dc_offset_q(struct bladerf *dev,
                         bladerf_module module, int16_t *value);
 
+/**
+ * Convert a DC offset value to the value of the corresponding LMS6002D
+ * register, as written by lms_set_dc_offset_i() and lms_set_dc_offset_q().
+ *
+ * @param[in]   module      Module the value applies to
+ * @param[in]   value       DC offset value, scaled to [-2048, 2048]
+ *
+ * @return Register value. For RX, bit 7 is always clear.
+ */
+uint8_t lms_dc_offset_to_reg(bladerf_module module, int16_t value);
+
+/**
+ * Write the DC offset registers for both the I and Q channels, using values
+ * obtained from lms_dc_offset_to_reg(). This requires one batched register
+ * write, preceded by one batched read for RX.
+ *
+ * @param[in]   dev         Device handle
+ * @param[in]   module      Module to adjust
+ * @param[in]   reg_i       I channel register value
+ * @param[in]   reg_q       Q channel register value
+ *
+ * @return 0 on succes, BLADERF_ERR_* value on failure
+ */
+int lms_set_dc_offset_regs(struct bladerf *dev, bladerf_module module,
+                           uint8_t reg_i, uint8_t reg_q);
+
 #endif /* LMS_H_ */
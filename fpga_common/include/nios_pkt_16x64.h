@@ -102,6 +102,7 @@
 /* Target IDs */
 #define NIOS_PKT_16x64_TARGET_AD9361  0x00
 #define NIOS_PKT_16x64_TARGET_RFIC    0x01 /* RFIC control */
+#define NIOS_PKT_16x64_TARGET_IQ_CORR 0x02 /* AD9361 I/Q corrections */
 
 /* IDs 0x80 through 0xff will not be assigned by Nuand. These are reserved
  * for user customizations */
@@ -127,6 +128,62 @@
  *    +----------------+--------------------------------------------+
  */
 
+/**
+ * Sub-addresses for iq_corr target. Only writes are supported.
+ *
+ *    +================+============================================+
+ *    |      Bit(s)    |         Value                              |
+ *    +================+============================================+
+ *    |      15:13     | Reserved. Set to 0.                        |
+ *    +----------------+--------------------------------------------+
+ *    |       12       | 1 = Discard the corrections stored for the |
+ *    |                |     channel. Requires bit 11.              |
+ *    +----------------+--------------------------------------------+
+ *    |       11       | 1 = Store the corrections with the Nios    |
+ *    |                |     fast lock profile, to be applied when  |
+ *    |                |     the profile is activated by a retune2  |
+ *    |                | 0 = Apply the corrections now              |
+ *    +----------------+--------------------------------------------+
+ *    |       10       | 1 = RX input B/C or TX output B            |
+ *    |                | 0 = RX input A or TX output A              |
+ *    +----------------+--------------------------------------------+
+ *    |        9       | 1 = TX, 0 = RX                             |
+ *    +----------------+--------------------------------------------+
+ *    |        8       | Channel index (0 = RX1/TX1, 1 = RX2/TX2)   |
+ *    +----------------+--------------------------------------------+
+ *    |       7:0      | Nios fast lock profile. Ignored unless     |
+ *    |                | bit 11 is set.                             |
+ *    +----------------+--------------------------------------------+
+ *
+ * The data holds the DC I, DC Q, phase and gain correction values, as used by
+ * bladerf_set_correction(), in bits 15:0, 31:16, 47:32, and 63:48.
+ */
+#define NIOS_PKT_16x64_IQ_CORR_CLEAR     (1 << 12)
+#define NIOS_PKT_16x64_IQ_CORR_STORE     (1 << 11)
+#define NIOS_PKT_16x64_IQ_CORR_LOW_BAND  (1 << 10)
+#define NIOS_PKT_16x64_IQ_CORR_TX        (1 << 9)
+#define NIOS_PKT_16x64_IQ_CORR_CHAN      (1 << 8)
+#define NIOS_PKT_16x64_IQ_CORR_PROFILE   0xff
+
+/* Pack I/Q correction values into the data field */
+static inline uint64_t nios_pkt_16x64_iq_corr_pack(const int16_t *values)
+{
+    return ((uint64_t)(uint16_t)values[0] << 0)  |
+           ((uint64_t)(uint16_t)values[1] << 16) |
+           ((uint64_t)(uint16_t)values[2] << 32) |
+           ((uint64_t)(uint16_t)values[3] << 48);
+}
+
+/* Unpack I/Q correction values from the data field */
+static inline void nios_pkt_16x64_iq_corr_unpack(uint64_t data,
+                                                 int16_t *values)
+{
+    values[0] = (int16_t)(data >> 0);
+    values[1] = (int16_t)(data >> 16);
+    values[2] = (int16_t)(data >> 32);
+    values[3] = (int16_t)(data >> 48);
+}
+
 /* Pack the request buffer */
 static inline void nios_pkt_16x64_pack(uint8_t *buf, uint8_t target, bool write,
                                        uint16_t addr, uint64_t data)
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026 Nuand LLC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BLADERF_NIOS_PKT_8x8_BATCH_H_
+#define BLADERF_NIOS_PKT_8x8_BATCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/*
+ * This file defines the Host <-> FPGA (NIOS II) packet formats for batched
+ * accesses to devices/blocks with 8-bit addresses and 8-bit data. Up to
+ * NIOS_PKT_8x8_BATCH_MAX_OPS accesses to a single target are carried in one
+ * request, and are performed in order.
+ *
+ *
+ *                              Request
+ *                      ----------------------
+ *
+ * +================+=========================================================+
+ * |  Byte offset   |                       Description                       |
+ * +================+=========================================================+
+ * |        0       | Magic Value                                             |
+ * +----------------+---------------------------------------------------------+
+ * |        1       | Target ID (Note 1)                                      |
+ * +----------------+---------------------------------------------------------+
+ * |        2       | Flags (Note 2)                                          |
+ * +----------------+---------------------------------------------------------+
+ * |        3       | Number of accesses, N (1 to NIOS_PKT_8x8_BATCH_MAX_OPS) |
+ * +----------------+---------------------------------------------------------+
+ * |        4       | Access 0: 8-bit address                                 |
+ * +----------------+---------------------------------------------------------+
+ * |        5       | Access 0: 8-bit data                                    |
+ * +----------------+---------------------------------------------------------+
+ * |       ...      | ...                                                     |
+ * +----------------+---------------------------------------------------------+
+ * |     4 + 2*i    | Access i: 8-bit address                                 |
+ * +----------------+---------------------------------------------------------+
+ * |     5 + 2*i    | Access i: 8-bit data                                    |
+ * +----------------+---------------------------------------------------------+
+ * |    15:4+2*N    | Reserved. Set to 0.                                     |
+ * +----------------+---------------------------------------------------------+
+ *
+ *
+ *                              Response
+ *                      ----------------------
+ *
+ * The response packet contains the same information as the request.
+ * A status flag will be set if all of the accesses completed successfully.
+ *
+ * Processing stops at the first access that fails. The count field of the
+ * response indicates how many accesses were performed successfully.
+ *
+ * In the case of a read request, the data fields will contain the read data.
+ *
+ * (Note 1)
+ *  The "Target ID" refers to the peripheral, device, or block to access.
+ *  See the NIOS_PKT_8x8_TARGET_* values in nios_pkt_8x8.h.
+ *
+ * (Note 2)
+ *  The flags are defined as follows:
+ *
+ *    +================+========================+
+ *    |      Bit(s)    |         Value          |
+ *    +================+========================+
+ *    |       7:2      | Reserved. Set to 0.    |
+ *    +----------------+------------------------+
+ *    |                | Status. Only used in   |
+ *    |                | response packet.       |
+ *    |                | Ignored in request.    |
+ *    |        1       |                        |
+ *    |                |   1 = Success          |
+ *    |                |   0 = Failure          |
+ *    +----------------+------------------------+
+ *    |        0       |   0 = Read operations  |
+ *    |                |   1 = Write operations |
+ *    +----------------+------------------------+
+ *
+ */
+
+#define NIOS_PKT_8x8_BATCH_MAGIC        ((uint8_t) 'F')
+
+/* Request packet indices */
+#define NIOS_PKT_8x8_BATCH_IDX_MAGIC     0
+#define NIOS_PKT_8x8_BATCH_IDX_TARGET_ID 1
+#define NIOS_PKT_8x8_BATCH_IDX_FLAGS     2
+#define NIOS_PKT_8x8_BATCH_IDX_COUNT     3
+#define NIOS_PKT_8x8_BATCH_IDX_OPS       4
+
+/* Maximum number of accesses per packet */
+#define NIOS_PKT_8x8_BATCH_MAX_OPS       6
+
+/* Flag bits */
+#define NIOS_PKT_8x8_BATCH_FLAG_WRITE    (1 << 0)
+#define NIOS_PKT_8x8_BATCH_FLAG_SUCCESS  (1 << 1)
+
+#define NIOS_PKT_8x8_BATCH_IDX_ADDR(i)   (NIOS_PKT_8x8_BATCH_IDX_OPS + 2 * (i))
+#define NIOS_PKT_8x8_BATCH_IDX_DATA(i)   (NIOS_PKT_8x8_BATCH_IDX_OPS + 2 * (i) + 1)
+
+
+/* Pack the request buffer. `data` is ignored (and may be NULL) for reads. */
+static inline void nios_pkt_8x8_batch_pack(uint8_t *buf, uint8_t target,
+                                           bool write, const uint8_t *addr,
+                                           const uint8_t *data, uint8_t count)
+{
+    uint8_t i;
+
+    if (count > NIOS_PKT_8x8_BATCH_MAX_OPS) {
+        count = NIOS_PKT_8x8_BATCH_MAX_OPS;
+    }
+
+    buf[NIOS_PKT_8x8_BATCH_IDX_MAGIC]     = NIOS_PKT_8x8_BATCH_MAGIC;
+    buf[NIOS_PKT_8x8_BATCH_IDX_TARGET_ID] = target;
+
+    if (write) {
+        buf[NIOS_PKT_8x8_BATCH_IDX_FLAGS] = NIOS_PKT_8x8_BATCH_FLAG_WRITE;
+    } else {
+        buf[NIOS_PKT_8x8_BATCH_IDX_FLAGS] = 0x00;
+    }
+
+    buf[NIOS_PKT_8x8_BATCH_IDX_COUNT] = count;
+
+    for (i = 0; i < NIOS_PKT_8x8_BATCH_MAX_OPS; i++) {
+        if (i < count) {
+            buf[NIOS_PKT_8x8_BATCH_IDX_ADDR(i)] = addr[i];
+            buf[NIOS_PKT_8x8_BATCH_IDX_DATA(i)] =
+                (write && data != NULL) ? data[i] : 0x00;
+        } else {
+            buf[NIOS_PKT_8x8_BATCH_IDX_ADDR(i)] = 0x00;
+            buf[NIOS_PKT_8x8_BATCH_IDX_DATA(i)] = 0x00;
+        }
+    }
+}
+
+/* Unpack the request buffer. `addr` and `data` must have room for
+ * NIOS_PKT_8x8_BATCH_MAX_OPS entries. */
+static inline void nios_pkt_8x8_batch_unpack(const uint8_t *buf,
+                                             uint8_t *target, bool *write,
+                                             uint8_t *addr, uint8_t *data,
+                                             uint8_t *count)
+{
+    uint8_t i, n;
+
+    n = buf[NIOS_PKT_8x8_BATCH_IDX_COUNT];
+    if (n > NIOS_PKT_8x8_BATCH_MAX_OPS) {
+        n = NIOS_PKT_8x8_BATCH_MAX_OPS;
+    }
+
+    if (target != NULL) {
+        *target = buf[NIOS_PKT_8x8_BATCH_IDX_TARGET_ID];
+    }
+
+    if (write != NULL) {
+        *write = (buf[NIOS_PKT_8x8_BATCH_IDX_FLAGS] &
+                  NIOS_PKT_8x8_BATCH_FLAG_WRITE) != 0;
+    }
+
+    for (i = 0; i < n; i++) {
+        if (addr != NULL) {
+            addr[i] = buf[NIOS_PKT_8x8_BATCH_IDX_ADDR(i)];
+        }
+
+        if (data != NULL) {
+            data[i] = buf[NIOS_PKT_8x8_BATCH_IDX_DATA(i)];
+        }
+    }
+
+    if (count != NULL) {
+        *count = n;
+    }
+}
+
+/* Pack the response buffer */
+static inline void nios_pkt_8x8_batch_resp_pack(uint8_t *buf, uint8_t target,
+                                                bool write,
+                                                const uint8_t *addr,
+                                                const uint8_t *data,
+                                                uint8_t count, bool success)
+{
+    uint8_t i;
+
+    nios_pkt_8x8_batch_pack(buf, target, write, addr, data, count);
+
+    /* Reads return data, too */
+    if (!write) {
+        for (i = 0; i < count && i < NIOS_PKT_8x8_BATCH_MAX_OPS; i++) {
+            buf[NIOS_PKT_8x8_BATCH_IDX_DATA(i)] = data[i];
+        }
+    }
+
+    if (success) {
+        buf[NIOS_PKT_8x8_BATCH_IDX_FLAGS] |= NIOS_PKT_8x8_BATCH_FLAG_SUCCESS;
+    }
+}
+
+/* Unpack the response buffer */
+static inline void nios_pkt_8x8_batch_resp_unpack(const uint8_t *buf,
+                                                  uint8_t *target, bool *write,
+                                                  uint8_t *addr, uint8_t *data,
+                                                  uint8_t *count,
+                                                  bool *success)
+{
+    nios_pkt_8x8_batch_unpack(buf, target, write, addr, data, count);
+
+    if ((buf[NIOS_PKT_8x8_BATCH_IDX_FLAGS] &
+         NIOS_PKT_8x8_BATCH_FLAG_SUCCESS) != 0) {
+        *success = true;
+    } else {
+        *success = false;
+    }
+}
+
+#endif
@@ -225,6 +225,171 @@ static inline void nios_pkt_retune_unpack(const uint8_t *buf,
     *xb_gpio = buf[NIOS_PKT_RETUNE_IDX_RESV];
 }
 
+/*
+ *                   Retune with DC Correction Request
+ *                   ---------------------------------
+ *
+ * This variant of the retune request also carries the LMS6002D DC offset
+ * correction register values for the new frequency. These are written
+ * immediately after the retune is performed, whether it occurs now or at the
+ * scheduled time, so that no further requests are needed to apply them.
+ *
+ * To make room for these, the timestamp is reduced to 48 bits. Retunes
+ * scheduled beyond this must use the retune request above. The retune queue
+ * is shared with the retune request, and is cleared via that request.
+ *
+ * The response to this request uses the same format as the response to the
+ * retune request (below), with the magic value of this request.
+ *
+ * +================+=========================================================+
+ * |  Byte offset   |                       Description                       |
+ * +================+=========================================================+
+ * |        0       | Magic Value                                             |
+ * +----------------+---------------------------------------------------------+
+ * |        1       | 48-bit timestamp denoting when to retune. (Note 1)      |
+ * +----------------+---------------------------------------------------------+
+ * |        7       | 32-bit LMS6002D n_int & n_frac register values          |
+ * +----------------+---------------------------------------------------------+
+ * |       11       | RX/TX bit, FREQSEL LMS6002D reg value                   |
+ * +----------------+---------------------------------------------------------+
+ * |       12       | Band-selection, quick tune and VCOCAP hint              |
+ * +----------------+---------------------------------------------------------+
+ * |       13       | XB-200 configuration                                    |
+ * +----------------+---------------------------------------------------------+
+ * |       14       | DC offset I register value (Note 2)                     |
+ * +----------------+---------------------------------------------------------+
+ * |       15       | DC offset Q register value (Note 2)                     |
+ * +----------------+---------------------------------------------------------+
+ *
+ * Bytes 7 through 13 are packed in the same manner as bytes 9 through 15 of
+ * the retune request.
+ *
+ * (Note 1) A value of 0 denotes a "Tune Now" request.
+ *
+ * (Note 2) These are written to LMS6002D registers 0x71 and 0x72 for RX, in
+ *          which bit 7 is preserved, or 0x42 and 0x43 for TX.
+ */
+
+#define NIOS_PKT_RETUNE_DC_IDX_MAGIC    0
+#define NIOS_PKT_RETUNE_DC_IDX_TIME     1
+#define NIOS_PKT_RETUNE_DC_IDX_INTFRAC  7
+#define NIOS_PKT_RETUNE_DC_IDX_FREQSEL  11
+#define NIOS_PKT_RETUNE_DC_IDX_BANDSEL  12
+#define NIOS_PKT_RETUNE_DC_IDX_XB_GPIO  13
+#define NIOS_PKT_RETUNE_DC_IDX_DC_I     14
+#define NIOS_PKT_RETUNE_DC_IDX_DC_Q     15
+
+#define NIOS_PKT_RETUNE_DC_MAGIC        'V'
+
+/* Latest timestamp that may be specified in this request */
+#define NIOS_PKT_RETUNE_DC_TIME_MAX     ((((uint64_t) 1) << 48) - 1)
+
+/* Pack the retune with DC correction request buffer */
+static inline void nios_pkt_retune_dc_pack(uint8_t *buf,
+                                           bladerf_module module,
+                                           uint64_t timestamp,
+                                           uint16_t nint,
+                                           uint32_t nfrac,
+                                           uint8_t  freqsel,
+                                           uint8_t  vcocap,
+                                           bool     low_band,
+                                           uint8_t  xb_gpio,
+                                           bool     quick_tune,
+                                           uint8_t  dc_i,
+                                           uint8_t  dc_q)
+{
+    buf[NIOS_PKT_RETUNE_DC_IDX_MAGIC] = NIOS_PKT_RETUNE_DC_MAGIC;
+
+    buf[NIOS_PKT_RETUNE_DC_IDX_TIME + 0] =  timestamp        & 0xff;
+    buf[NIOS_PKT_RETUNE_DC_IDX_TIME + 1] = (timestamp >>  8) & 0xff;
+    buf[NIOS_PKT_RETUNE_DC_IDX_TIME + 2] = (timestamp >> 16) & 0xff;
+    buf[NIOS_PKT_RETUNE_DC_IDX_TIME + 3] = (timestamp >> 24) & 0xff;
+    buf[NIOS_PKT_RETUNE_DC_IDX_TIME + 4] = (timestamp >> 32) & 0xff;
+    buf[NIOS_PKT_RETUNE_DC_IDX_TIME + 5] = (timestamp >> 40) & 0xff;
+
+    buf[NIOS_PKT_RETUNE_DC_IDX_INTFRAC + 0]  = (nint >> 1) & 0xff;
+    buf[NIOS_PKT_RETUNE_DC_IDX_INTFRAC + 1]  = (nint & 0x1) << 7;
+    buf[NIOS_PKT_RETUNE_DC_IDX_INTFRAC + 1] |= ((nfrac >> 16) & 0x7f);
+    buf[NIOS_PKT_RETUNE_DC_IDX_INTFRAC + 2]  = (nfrac >> 8) & 0xff;
+    buf[NIOS_PKT_RETUNE_DC_IDX_INTFRAC + 3]  = nfrac & 0xff;
+
+    buf[NIOS_PKT_RETUNE_DC_IDX_FREQSEL] = freqsel & 0x3f;
+
+    switch (module) {
+        case BLADERF_MODULE_TX:
+            buf[NIOS_PKT_RETUNE_DC_IDX_FREQSEL] |= FLAG_TX;
+            break;
+
+        case BLADERF_MODULE_RX:
+            buf[NIOS_PKT_RETUNE_DC_IDX_FREQSEL] |= FLAG_RX;
+            break;
+
+        default:
+            /* Erroneous case - should not occur */
+            break;
+    }
+
+    buf[NIOS_PKT_RETUNE_DC_IDX_BANDSEL] = vcocap & 0x3f;
+
+    if (low_band) {
+        buf[NIOS_PKT_RETUNE_DC_IDX_BANDSEL] |= FLAG_LOW_BAND;
+    }
+
+    if (quick_tune) {
+        buf[NIOS_PKT_RETUNE_DC_IDX_BANDSEL] |= FLAG_QUICK_TUNE;
+    }
+
+    buf[NIOS_PKT_RETUNE_DC_IDX_XB_GPIO] = xb_gpio;
+    buf[NIOS_PKT_RETUNE_DC_IDX_DC_I]    = dc_i;
+    buf[NIOS_PKT_RETUNE_DC_IDX_DC_Q]    = dc_q;
+}
+
+/* Unpack a retune with DC correction request */
+static inline void nios_pkt_retune_dc_unpack(const uint8_t *buf,
+                                             bladerf_module *module,
+                                             uint64_t *timestamp,
+                                             uint16_t *nint,
+                                             uint32_t *nfrac,
+                                             uint8_t  *freqsel,
+                                             uint8_t  *vcocap,
+                                             bool     *low_band,
+                                             uint8_t  *xb_gpio,
+                                             bool     *quick_tune,
+                                             uint8_t  *dc_i,
+                                             uint8_t  *dc_q)
+{
+    *timestamp  = ( ((uint64_t) buf[NIOS_PKT_RETUNE_DC_IDX_TIME + 0]) <<  0);
+    *timestamp |= ( ((uint64_t) buf[NIOS_PKT_RETUNE_DC_IDX_TIME + 1]) <<  8);
+    *timestamp |= ( ((uint64_t) buf[NIOS_PKT_RETUNE_DC_IDX_TIME + 2]) << 16);
+    *timestamp |= ( ((uint64_t) buf[NIOS_PKT_RETUNE_DC_IDX_TIME + 3]) << 24);
+    *timestamp |= ( ((uint64_t) buf[NIOS_PKT_RETUNE_DC_IDX_TIME + 4]) << 32);
+    *timestamp |= ( ((uint64_t) buf[NIOS_PKT_RETUNE_DC_IDX_TIME + 5]) << 40);
+
+    *nint  = buf[NIOS_PKT_RETUNE_DC_IDX_INTFRAC + 0] << 1;
+    *nint |= buf[NIOS_PKT_RETUNE_DC_IDX_INTFRAC + 1] >> 7;
+
+    *nfrac  = (buf[NIOS_PKT_RETUNE_DC_IDX_INTFRAC + 1] & 0x7f) << 16;
+    *nfrac |= buf[NIOS_PKT_RETUNE_DC_IDX_INTFRAC + 2] << 8;
+    *nfrac |= buf[NIOS_PKT_RETUNE_DC_IDX_INTFRAC + 3];
+
+    *freqsel = buf[NIOS_PKT_RETUNE_DC_IDX_FREQSEL] & 0x3f;
+
+    *module = -1;
+
+    if (buf[NIOS_PKT_RETUNE_DC_IDX_FREQSEL] & FLAG_TX) {
+        *module = BLADERF_MODULE_TX;
+    } else if (buf[NIOS_PKT_RETUNE_DC_IDX_FREQSEL] & FLAG_RX) {
+        *module = BLADERF_MODULE_RX;
+    }
+
+    *low_band = (buf[NIOS_PKT_RETUNE_DC_IDX_BANDSEL] & FLAG_LOW_BAND) != 0;
+    *quick_tune = (buf[NIOS_PKT_RETUNE_DC_IDX_BANDSEL] & FLAG_QUICK_TUNE) != 0;
+    *vcocap = buf[NIOS_PKT_RETUNE_DC_IDX_BANDSEL] & 0x3f;
+    *xb_gpio = buf[NIOS_PKT_RETUNE_DC_IDX_XB_GPIO];
+    *dc_i = buf[NIOS_PKT_RETUNE_DC_IDX_DC_I];
+    *dc_q = buf[NIOS_PKT_RETUNE_DC_IDX_DC_Q];
+}
+
 
 /*
  *                             Response
@@ -2321,6 +2321,7 @@ int lms_set_precalculated_frequency(struct bladerf *dev, bladerf_module mod,
 
     uint8_t data;
     uint8_t vcocap_reg_state;
+    uint8_t pll_addr[4], pll_data[4];
     int status, dsm_status;
 
     /* Utilize atomic writes to the PLL registers, if possible. This
@@ -2353,44 +2354,38 @@ int lms_set_precalculated_frequency(struct bladerf *dev, bladerf_module mod,
      * this register and perform a RMW, as bit 7 is VOVCOREG[0]. */
     status = LMS_READ(dev, base + 9, &vcocap_reg_state);
     if (status != 0) {
-        goto error;
+        goto out;
     }
 
     vcocap_reg_state &= ~(0x3f);
 
     status = write_vcocap(dev, base, f->vcocap, vcocap_reg_state);
     if (status != 0) {
-        goto error;
+        goto out;
     }
 
     status = write_pll_config(dev, mod, f->freqsel,
                               (f->flags & LMS_FREQ_FLAGS_LOW_BAND) != 0);
     if (status != 0) {
-        goto error;
+        goto out;
     }
 
-    data = f->nint >> 1;
-    status = LMS_WRITE(dev, pll_base + 0, data);
-    if (status != 0) {
-        goto error;
-    }
+    /* NINT and NFRAC are written in a single batch, when supported */
+    pll_addr[0] = pll_base + 0;
+    pll_data[0] = f->nint >> 1;
 
-    data = ((f->nint & 1) << 7) | ((f->nfrac >> 16) & 0x7f);
-    status = LMS_WRITE(dev, pll_base + 1, data);
-    if (status != 0) {
-        goto error;
-    }
+    pll_addr[1] = pll_base + 1;
+    pll_data[1] = ((f->nint & 1) << 7) | ((f->nfrac >> 16) & 0x7f);
 
-    data = ((f->nfrac >> 8) & 0xff);
-    status = LMS_WRITE(dev, pll_base + 2, data);
-    if (status != 0) {
-        goto error;
-    }
+    pll_addr[2] = pll_base + 2;
+    pll_data[2] = ((f->nfrac >> 8) & 0xff);
+
+    pll_addr[3] = pll_base + 3;
+    pll_data[3] = (f->nfrac & 0xff);
 
-    data = (f->nfrac & 0xff);
-    status = LMS_WRITE(dev, pll_base + 3, data);
+    status = LMS_WRITE_BATCH(dev, pll_addr, pll_data, ARRAY_SIZE(pll_addr));
     if (status != 0) {
-        goto error;
+        goto out;
     }
 
     /* Perform tuning algorithm unless we've been instructed to just use
@@ -2398,12 +2393,27 @@ int lms_set_precalculated_frequency(struct bladerf *dev, bladerf_module mod,
     if (f->flags & LMS_FREQ_FLAGS_FORCE_VCOCAP) {
         f->vcocap_result = f->vcocap;
     } else {
+        if (f->flags & LMS_FREQ_FLAGS_VERIFY_VCOCAP) {
+            status = get_vtune(dev, base, VTUNE_DELAY_LARGE, &data);
+            if (status != 0) {
+                goto out;
+            } else if (data == VCO_NORM) {
+                log_verbose("VCOCAP=%u verified\n", f->vcocap);
+                f->vcocap_result = f->vcocap;
+                goto out;
+            }
+
+            log_verbose("VCOCAP=%u is %s. Searching...\n", f->vcocap,
+                        vtune_str(data));
+            f->flags &= ~LMS_FREQ_FLAGS_VERIFY_VCOCAP;
+        }
+
         /* Walk down VCOCAP values find an optimal values */
         status = tune_vcocap(dev, f->vcocap, base, vcocap_reg_state,
                              &f->vcocap_result);
     }
 
-error:
+out:
     /* Turn off the DSMs */
     dsm_status = LMS_READ(dev, 0x09, &data);
     if (dsm_status == 0) {
@@ -2443,6 +2453,7 @@ static int lms_dc_cal_loop(struct bladerf *dev, uint8_t base,
 {
     int status;
     uint8_t i, val;
+    uint8_t addr[6], data[6];
     bool done = false;
     const unsigned int max_cal_count = 25;
 
@@ -2457,39 +2468,27 @@ static int lms_dc_cal_loop(struct bladerf *dev, uint8_t base,
     val &= ~(0x07);
     val |= cal_address&0x07;
 
-    status = LMS_WRITE(dev, base + 0x03, val);
-    if (status != 0) {
-        return status;
-    }
+    addr[0] = base + 0x03;
+    data[0] = val;
 
     /* Set and latch the DC_CNTVAL  */
-    status = LMS_WRITE(dev, base + 0x02, dc_cntval);
-    if (status != 0) {
-        return status;
-    }
+    addr[1] = base + 0x02;
+    data[1] = dc_cntval;
 
-    val |= (1 << 4);
-    status = LMS_WRITE(dev, base + 0x03, val);
-    if (status != 0) {
-        return status;
-    }
-
-    val &= ~(1 << 4);
-    status = LMS_WRITE(dev, base + 0x03, val);
-    if (status != 0) {
-        return status;
-    }
+    addr[2] = base + 0x03;
+    data[2] = val | (1 << 4);
 
+    addr[3] = base + 0x03;
+    data[3] = val;
 
     /* Start the calibration by toggling DC_START_CLBR */
-    val |= (1 << 5);
-    status = LMS_WRITE(dev, base + 0x03, val);
-    if (status != 0) {
-        return status;
-    }
+    addr[4] = base + 0x03;
+    data[4] = val | (1 << 5);
+
+    addr[5] = base + 0x03;
+    data[5] = val;
 
-    val &= ~(1 << 5);
-    status = LMS_WRITE(dev, base + 0x03, val);
+    status = LMS_WRITE_BATCH(dev, addr, data, ARRAY_SIZE(addr));
     if (status != 0) {
         return status;
     }
@@ -3573,6 +3572,49 @@ int lms_set_dc_offset_q(struct bladerf *dev,
 }
 #endif
 
+#ifndef BLADERF_NIOS_BUILD
+uint8_t lms_dc_offset_to_reg(bladerf_module module, int16_t value)
+{
+    return scale_dc_offset(module, value);
+}
+#endif
+
+int lms_set_dc_offset_regs(struct bladerf *dev, bladerf_module module,
+                           uint8_t reg_i, uint8_t reg_q)
+{
+    int status;
+    uint8_t addr[2];
+    uint8_t data[2];
+
+    switch (module) {
+        case BLADERF_MODULE_RX:
+            addr[0] = 0x71;
+            addr[1] = 0x72;
+
+            status = LMS_READ_BATCH(dev, addr, data, ARRAY_SIZE(addr));
+            if (status != 0) {
+                return status;
+            }
+
+            /* Bit 7 is unrelated to lms dc correction, save its state */
+            data[0] = (data[0] & (1 << 7)) | (reg_i & 0x7f);
+            data[1] = (data[1] & (1 << 7)) | (reg_q & 0x7f);
+            break;
+
+        case BLADERF_MODULE_TX:
+            addr[0] = 0x42;
+            addr[1] = 0x43;
+            data[0] = reg_i;
+            data[1] = reg_q;
+            break;
+
+        default:
+            return BLADERF_ERR_INVAL;
+    }
+
+    return LMS_WRITE_BATCH(dev, addr, data, ARRAY_SIZE(addr));
+}
+
 #ifndef BLADERF_NIOS_BUILD
 int get_dc_offset(struct bladerf *dev, bladerf_module module,
                   uint8_t addr, int16_t *value)
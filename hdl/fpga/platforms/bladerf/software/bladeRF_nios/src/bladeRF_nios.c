@@ -80,7 +80,9 @@
  */
 static const struct pkt_handler pkt_handlers[] = {
     PKT_RETUNE,
+    PKT_RETUNE_DC,
     PKT_8x8,
+    PKT_8x8_BATCH,
     PKT_8x16,
     PKT_8x32,
     PKT_8x64,
@@ -45,6 +45,7 @@ uint8_t vctcxo_tamer_ctrl_reg = 0x00;
 #ifdef BOARD_BLADERF_MICRO
 /* Common bladeRF2 header */
 #include "bladerf2_common.h"
+#include "ad936x_correction.h"
 
 /* Cached version of ADF400x registers */
 uint32_t adf400x_reg[4] = { 0 };
@@ -474,6 +475,10 @@ void adi_fastlock_save(bool is_tx, uint8_t rffe_profile, uint16_t nios_profile)
 
     /* Update profile state */
     fastlocks[nios_profile].state = FASTLOCK_STATE_BBP_RFFE;
+
+    /* Corrections stored for the profile's previous frequency no longer
+     * apply */
+    fastlocks[nios_profile].iq_corr_valid = 0;
 }
 #endif  // BOARD_BLADERF_MICRO
 
@@ -611,6 +616,47 @@ void adi_rfspdt_select(bladerf_module m, fastlock_profile *p)
 }
 #endif  // BOARD_BLADERF_MICRO
 
+#ifdef BOARD_BLADERF_MICRO
+void adi_iq_corr_apply(bladerf_module m, uint8_t chan, bool low_band,
+                       const int16_t *values)
+{
+    struct ad936x_reg_update updates[AD936X_CORR_MAX_UPDATES];
+    unsigned int count, i;
+    uint16_t addr;
+    uint64_t data;
+
+    count = ad936x_correction_updates(chan, BLADERF_CHANNEL_IS_TX(m),
+                                      low_band, 0xf, values, updates);
+
+    for (i = 0; i < count; i++) {
+        data = updates[i].data;
+
+        if (updates[i].mask != 0xff) {
+            /* Preserve the bits belonging to other corrections */
+            addr = (0x0 << 15) | (0x0 << 12) | (updates[i].addr & 0x3ff);
+            data |= (adi_spi_read(addr) >> 56) & ~updates[i].mask;
+        }
+
+        addr = (0x1 << 15) | (0x0 << 12) | (updates[i].addr & 0x3ff);
+        adi_spi_write(addr, (data & 0xff) << 56);
+    }
+}
+#endif  // BOARD_BLADERF_MICRO
+
+#ifdef BOARD_BLADERF_MICRO
+void adi_iq_corr_recall(bladerf_module m, fastlock_profile *p)
+{
+    uint8_t chan;
+
+    for (chan = 0; chan < 2; chan++) {
+        if (p->iq_corr_valid & (1 << chan)) {
+            adi_iq_corr_apply(m, chan, (p->iq_corr_low_band >> chan) & 0x1,
+                              p->iq_corr[chan]);
+        }
+    }
+}
+#endif  // BOARD_BLADERF_MICRO
+
 uint8_t si5338_read(uint8_t addr)
 {
     uint8_t data;
@@ -146,6 +146,11 @@ typedef struct {
     uint8_t port;
     uint8_t spdt;
     volatile enum fastlock_state state;
+
+    /* I/Q corrections applied along with the profile, per channel index */
+    uint8_t iq_corr_valid;      /* Bitmask of channels with corrections */
+    uint8_t iq_corr_low_band;   /* Bitmask of channels using B/C or TXB */
+    int16_t iq_corr[2][4];      /* Values, indexed by bladerf_correction */
 } fastlock_profile;
 
 /* Define the fast lock profile storage arrays */
@@ -268,6 +273,25 @@ void adi_rfport_select(fastlock_profile *p);
  */
 void adi_rfspdt_select(bladerf_module m, fastlock_profile *p);
 
+/**
+ * Apply AD9361 I/Q corrections to a channel.
+ *
+ * @param m         Which module's corrections to apply.
+ * @param chan      Channel index (0 = RX1/TX1, 1 = RX2/TX2)
+ * @param low_band  True for RX input B/C or TX output B
+ * @param *values   Correction values, indexed by bladerf_correction
+ */
+void adi_iq_corr_apply(bladerf_module m, uint8_t chan, bool low_band,
+                       const int16_t *values);
+
+/**
+ * Apply the I/Q corrections stored with a fast lock profile.
+ *
+ * @param m    Which module's corrections to apply.
+ * @param *p   Fast lock profile structure
+ */
+void adi_iq_corr_recall(bladerf_module m, fastlock_profile *p);
+
 /**
  * Read from Si5338 clock generator register
  *
@@ -80,6 +80,22 @@ struct bladerf;
         0; /* "Return" 0 */ \
     })
 
+#   define LMS_WRITE_BATCH(dev, addr, data, n) ({ \
+        size_t i_; \
+        for (i_ = 0; i_ < (n); i_++) { \
+            lms6_write((addr)[i_], (data)[i_]); \
+        } \
+        0; /* "Return" 0 */ \
+    })
+
+#   define LMS_READ_BATCH(dev, addr, data, n) ({ \
+        size_t i_; \
+        for (i_ = 0; i_ < (n); i_++) { \
+            (data)[i_] = lms6_read((addr)[i_]); \
+        } \
+        0; /* "Return" 0 */ \
+    })
+
 #   define CONFIG_GPIO_READ(dev, data_ptr) ({ \
         *(data_ptr) = control_reg_read(); \
         0; /* "Return" 0 */ \
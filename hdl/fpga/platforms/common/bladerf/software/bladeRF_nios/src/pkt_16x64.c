@@ -28,6 +28,50 @@
 #include "devices.h"
 #include "debug.h"
 
+#ifdef BOARD_BLADERF_MICRO
+static bool iq_corr_write(uint16_t addr, uint64_t data)
+{
+    const bool is_tx     = (addr & NIOS_PKT_16x64_IQ_CORR_TX) != 0;
+    const bool low_band  = (addr & NIOS_PKT_16x64_IQ_CORR_LOW_BAND) != 0;
+    const uint8_t chan   = (addr & NIOS_PKT_16x64_IQ_CORR_CHAN) ? 1 : 0;
+    const uint16_t index = addr & NIOS_PKT_16x64_IQ_CORR_PROFILE;
+    fastlock_profile *p;
+    int16_t values[4];
+
+    nios_pkt_16x64_iq_corr_unpack(data, values);
+
+    if ((addr & NIOS_PKT_16x64_IQ_CORR_STORE) == 0) {
+        adi_iq_corr_apply(is_tx ? BLADERF_MODULE_TX : BLADERF_MODULE_RX, chan,
+                          low_band, values);
+        return true;
+    }
+
+    if (index >= NUM_BBP_FASTLOCK_PROFILES) {
+        DBG("Invalid fast lock profile: %u\n", index);
+        return false;
+    }
+
+    p = is_tx ? &fastlocks_tx[index] : &fastlocks_rx[index];
+
+    if (addr & NIOS_PKT_16x64_IQ_CORR_CLEAR) {
+        p->iq_corr_valid &= ~(1 << chan);
+        return true;
+    }
+
+    memcpy(p->iq_corr[chan], values, sizeof(values));
+
+    if (low_band) {
+        p->iq_corr_low_band |= (1 << chan);
+    } else {
+        p->iq_corr_low_band &= ~(1 << chan);
+    }
+
+    p->iq_corr_valid |= (1 << chan);
+
+    return true;
+}
+#endif  // BOARD_BLADERF_MICRO
+
 static inline bool perform_write(uint8_t id, uint16_t addr, uint64_t data)
 {
     bool success = true;
@@ -45,6 +89,12 @@ static inline bool perform_write(uint8_t id, uint16_t addr, uint64_t data)
             break;
 #endif  // BLADERF_NIOS_LIBAD936X
 
+#ifdef BOARD_BLADERF_MICRO
+        case NIOS_PKT_16x64_TARGET_IQ_CORR:
+            success = iq_corr_write(addr, data);
+            break;
+#endif  // BOARD_BLADERF_MICRO
+
         /* Add user customizations here
 
         case NIOS_PKT_16x64_TARGET_USR1:
@@ -144,3 +144,32 @@ void pkt_8x8(struct pkt_buf *b)
 
     nios_pkt_8x8_resp_pack(b->resp, id, is_write, addr, data, success);
 }
+
+void pkt_8x8_batch(struct pkt_buf *b)
+{
+    uint8_t id;
+    uint8_t addr[NIOS_PKT_8x8_BATCH_MAX_OPS];
+    uint8_t data[NIOS_PKT_8x8_BATCH_MAX_OPS];
+    uint8_t count;
+    uint8_t i;
+    bool    is_write;
+    bool    success = true;
+
+    nios_pkt_8x8_batch_unpack(b->req, &id, &is_write, addr, data, &count);
+
+    /* Accesses are performed in order, stopping at the first failure */
+    for (i = 0; i < count && success; i++) {
+        if (is_write) {
+            success = perform_write(id, addr[i], data[i]);
+        } else {
+            success = perform_read(id, addr[i], &data[i]);
+        }
+    }
+
+    if (!success) {
+        count = i - 1;
+    }
+
+    nios_pkt_8x8_batch_resp_pack(b->resp, id, is_write, addr, data, count,
+                                 success);
+}
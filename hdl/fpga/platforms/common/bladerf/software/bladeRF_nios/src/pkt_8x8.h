@@ -27,8 +27,10 @@
 #include <stdint.h>
 #include "pkt_handler.h"
 #include "nios_pkt_8x8.h"
+#include "nios_pkt_8x8_batch.h"
 
 void pkt_8x8(struct pkt_buf *b);
+void pkt_8x8_batch(struct pkt_buf *b);
 
 #define PKT_8x8 { \
     .magic          = NIOS_PKT_8x8_MAGIC, \
@@ -37,4 +39,11 @@ void pkt_8x8(struct pkt_buf *b);
     .do_work        = NULL, \
 }
 
+#define PKT_8x8_BATCH { \
+    .magic          = NIOS_PKT_8x8_BATCH_MAGIC, \
+    .init           = NULL, \
+    .exec           = pkt_8x8_batch, \
+    .do_work        = NULL, \
+}
+
 #endif
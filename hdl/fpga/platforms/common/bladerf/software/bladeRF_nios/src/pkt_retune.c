@@ -52,9 +52,17 @@ enum entry_state {
                                * handle this retune */
 };
 
+/* DC offset correction register values to apply after a retune */
+struct dc_corr {
+    bool valid;
+    uint8_t i;
+    uint8_t q;
+};
+
 struct queue_entry {
     volatile enum entry_state state;
     struct lms_freq freq;
+    struct dc_corr dc;
     uint64_t timestamp;
 };
 
@@ -70,6 +78,7 @@ static struct queue {
  * not enqueue the requested item */
 static inline uint8_t enqueue_retune(struct queue *q,
                                      const struct lms_freq *f,
+                                     const struct dc_corr *dc,
                                      uint64_t timestamp)
 {
     uint8_t ret;
@@ -79,6 +88,7 @@ static inline uint8_t enqueue_retune(struct queue *q,
     }
 
     memcpy(&q->entries[q->ins_idx].freq, f, sizeof(f[0]));
+    memcpy(&q->entries[q->ins_idx].dc, dc, sizeof(dc[0]));
 
     q->entries[q->ins_idx].state = ENTRY_STATE_NEW;
     q->entries[q->ins_idx].timestamp = timestamp;
@@ -281,6 +291,11 @@ static inline void perform_work(struct queue *q, bladerf_module module)
                 }
 
                 xb_config_write(e->freq.xb_gpio);
+
+                if (e->dc.valid &&
+                    lms_set_dc_offset_regs(NULL, module, e->dc.i, e->dc.q)) {
+                    INCREMENT_ERROR_COUNT();
+                }
             }
 
             /* Drop the item from the queue */
@@ -299,27 +314,21 @@ void pkt_retune_work(void)
     perform_work(&tx_queue, BLADERF_MODULE_TX);
 }
 
-void pkt_retune(struct pkt_buf *b)
+/* Handle an unpacked retune request, and fill in the response */
+static void retune(struct pkt_buf *b, bladerf_module module,
+                   uint64_t timestamp, struct lms_freq f, bool low_band,
+                   uint8_t xb_gpio, bool quick_tune, const struct dc_corr *dc)
 {
     int status = -1;
-    bladerf_module module;
     uint8_t flags;
-    struct lms_freq f;
-    uint64_t timestamp;
     uint64_t start_time;
     uint64_t end_time;
     uint64_t duration = 0;
-    bool low_band;
-    uint8_t xb_gpio;
-    bool quick_tune;
 
     flags = NIOS_PKT_RETUNERESP_FLAG_SUCCESS;
 
-    nios_pkt_retune_unpack(b->req, &module, &timestamp,
-                           &f.nint, &f.nfrac, &f.freqsel, &f.vcocap,
-                           &low_band, &xb_gpio, &quick_tune);
-
     f.vcocap_result = 0xff;
+    f.xb_gpio = xb_gpio;
 
     if (low_band) {
         f.flags = LMS_FREQ_FLAGS_LOW_BAND;
@@ -352,6 +361,14 @@ void pkt_retune(struct pkt_buf *b)
 
                 xb_config_write(xb_gpio);
 
+                if (dc->valid) {
+                    status = lms_set_dc_offset_regs(NULL, module,
+                                                    dc->i, dc->q);
+                    if (status != 0) {
+                        goto out;
+                    }
+                }
+
                 status = 0;
                 break;
 
@@ -381,11 +398,11 @@ void pkt_retune(struct pkt_buf *b)
 
         switch (module) {
             case BLADERF_MODULE_RX:
-                queue_size = enqueue_retune(&rx_queue, &f, timestamp);
+                queue_size = enqueue_retune(&rx_queue, &f, dc, timestamp);
                 break;
 
             case BLADERF_MODULE_TX:
-                queue_size = enqueue_retune(&tx_queue, &f, timestamp);
+                queue_size = enqueue_retune(&tx_queue, &f, dc, timestamp);
                 break;
 
             default:
@@ -411,3 +428,42 @@ out:
 
     nios_pkt_retune_resp_pack(b->resp, duration, f.vcocap_result, flags);
 }
+
+void pkt_retune(struct pkt_buf *b)
+{
+    bladerf_module module;
+    struct lms_freq f;
+    uint64_t timestamp;
+    bool low_band;
+    uint8_t xb_gpio;
+    bool quick_tune;
+    const struct dc_corr dc = { false, 0, 0 };
+
+    nios_pkt_retune_unpack(b->req, &module, &timestamp,
+                           &f.nint, &f.nfrac, &f.freqsel, &f.vcocap,
+                           &low_band, &xb_gpio, &quick_tune);
+
+    retune(b, module, timestamp, f, low_band, xb_gpio, quick_tune, &dc);
+}
+
+void pkt_retune_dc(struct pkt_buf *b)
+{
+    bladerf_module module;
+    struct lms_freq f;
+    uint64_t timestamp;
+    bool low_band;
+    uint8_t xb_gpio;
+    bool quick_tune;
+    struct dc_corr dc;
+
+    nios_pkt_retune_dc_unpack(b->req, &module, &timestamp,
+                              &f.nint, &f.nfrac, &f.freqsel, &f.vcocap,
+                              &low_band, &xb_gpio, &quick_tune,
+                              &dc.i, &dc.q);
+
+    dc.valid = true;
+
+    retune(b, module, timestamp, f, low_band, xb_gpio, quick_tune, &dc);
+
+    b->resp[NIOS_PKT_RETUNERESP_IDX_MAGIC] = NIOS_PKT_RETUNE_DC_MAGIC;
+}
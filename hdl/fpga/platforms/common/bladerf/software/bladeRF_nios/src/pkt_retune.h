@@ -32,6 +32,8 @@ void pkt_retune_init(void);
 
 void pkt_retune(struct pkt_buf *b);
 
+void pkt_retune_dc(struct pkt_buf *b);
+
 void pkt_retune_work(void);
 
 #define PKT_RETUNE { \
@@ -41,4 +43,12 @@ void pkt_retune_work(void);
     .do_work        = pkt_retune_work, \
 }
 
+/* Shares the retune queue, which is initialized and serviced by PKT_RETUNE */
+#define PKT_RETUNE_DC { \
+    .magic          = NIOS_PKT_RETUNE_DC_MAGIC, \
+    .init           = NULL, \
+    .exec           = pkt_retune_dc, \
+    .do_work        = NULL, \
+}
+
 #endif
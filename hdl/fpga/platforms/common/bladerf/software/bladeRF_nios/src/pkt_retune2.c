@@ -40,8 +40,18 @@ void rfic_invalidate_frequency(bladerf_module module);
 #   define INCREMENT_ERROR_COUNT() do {} while (0)
 #endif
 
-/* The enqueue/dequeue routines require that this be a power of two */
-#define RETUNE2_QUEUE_MAX   16
+/* Depth of each direction's retune queue. This may be overridden at build
+ * time. The enqueue/dequeue routines require that this be a power of two,
+ * and the count must remain distinguishable from QUEUE_FULL/QUEUE_EMPTY. */
+#ifndef RETUNE2_QUEUE_MAX
+#   define RETUNE2_QUEUE_MAX   64
+#endif
+
+#if (RETUNE2_QUEUE_MAX & (RETUNE2_QUEUE_MAX - 1)) != 0 || \
+    RETUNE2_QUEUE_MAX > 128
+#   error "RETUNE2_QUEUE_MAX must be a power of two, no greater than 128"
+#endif
+
 #define QUEUE_FULL          0xff
 #define QUEUE_EMPTY         0xfe
 
@@ -217,6 +227,9 @@ static inline void profile_activate(bladerf_module module, fastlock_profile *p)
 
     /* Adjust the RF switches */
     adi_rfspdt_select(module, p);
+
+    /* Apply the I/Q corrections that go along with this profile */
+    adi_iq_corr_recall(module, p);
 }
 
 static inline void retune_isr(struct queue *q)
@@ -34,6 +34,27 @@
 extern "C" {
 #endif
 
+/**
+ * Method used to search for the RX DC correction values that minimize
+ * the DC offset. These do not apply to TX calibrations.
+ */
+enum dc_calibration_search {
+    /**
+     * Sweep the correction values around a coarse estimate, in steps of the
+     * LMS6002D's resolution. This is the most thorough, but also the slowest,
+     * option: each frequency requires dozens of captures.
+     */
+    DC_CAL_SEARCH_SWEEP = 0,
+
+    /**
+     * Apply the secant method to the sample mean, starting from the coarse
+     * estimate. The I and Q corrections are searched concurrently, and the
+     * search is bracketed to guard against non-linearity near the limits of
+     * the correction range. This typically converges in a handful of captures.
+     */
+    DC_CAL_SEARCH_SECANT,
+};
+
 struct dc_calibration_params {
     uint64_t frequency;
     int16_t corr_i;
@@ -47,6 +68,19 @@ struct dc_calibration_params {
     int16_t mid_dc_q;
     int16_t min_dc_i;
     int16_t min_dc_q;
+
+    /* RX search method. Zero-initialized parameters select the sweep. */
+    enum dc_calibration_search search;
+
+    /* Stop a DC_CAL_SEARCH_SECANT search once the magnitude of the sample
+     * mean is at or below this value. With 0.0, the search continues until
+     * the correction value is resolved to the LMS6002D's resolution. */
+    float tolerance;
+
+    /* RX only: Number of captures taken for this entry, and the time spent on
+     * it (including tuning), in microseconds of sample time. */
+    unsigned int captures;
+    uint64_t elapsed_us;
 };
 
 /**
@@ -90,13 +124,22 @@ int dc_calibration_lms6(struct bladerf *dev, const char *module);
  *                              list should be populated to describe the
  *                              frequencies over which to calibrate. The
  *                              `corr_i` and `corr_q` fields will be filled in
- *                              for each entry.
+ *                              for each entry. The `search` and `tolerance`
+ *                              fields select how each entry is calibrated.
  *
  * @param[in]       num_params  Number of entries in the `params` list.
  *
  * @param[in]       show_status Print status information to stdout
  *
+ * When calibrating multiple entries, quick tune parameters are first obtained
+ * for all of their frequencies. The retune to each entry is then scheduled to
+ * occur immediately after the last capture for the previous one, so that
+ * tuning overlaps with the processing of the previous entry's samples.
+ * Entries are tuned individually if the FPGA does not support scheduled
+ * retunes.
+ *
  * @return 0 on success or libbladeRF return value on failure.
+ *         BLADERF_ERR_INVAL is returned if an entry's `search` is invalid.
  */
 int dc_calibration_rx(struct bladerf *dev,
                       struct dc_calibration_params *params,
@@ -144,6 +187,24 @@ int dc_calibration(struct bladerf *dev, bladerf_module module,
                    struct dc_calibration_params *params,
                    size_t num_params, bool show_status);
 
+/**
+ * Write calibration results to a DC calibration table file, in the format
+ * read by libbladeRF when loading a table. The LMS6002D's current DC
+ * calibration values are included in the table.
+ *
+ * @param[in]       dev         Device handle
+ * @param[in]       module      BLADERF_MODULE_RX or BLADERF_MODULE_TX
+ * @param[in]       params      Calibration results, in ascending order of
+ *                              frequency
+ * @param[in]       num_params  Number of entries in the `params` list.
+ * @param[in]       filename    Table file to write
+ *
+ * @return 0 on success or libbladeRF return value on failure.
+ */
+int dc_calibration_save_table(struct bladerf *dev, bladerf_module module,
+                              const struct dc_calibration_params *params,
+                              size_t num_params, const char *filename);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
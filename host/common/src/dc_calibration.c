@@ -321,6 +321,11 @@ static int rx_samples(struct bladerf *dev, int16_t *samples,
 
 #define RX_CAL_MAX_SWEEP_LEN    (2 * 2048 / 32) /* -2048 : 32 : 2048 */
 
+/* Limit on the number of captures taken by a secant search, beyond the two
+ * coarse estimate points */
+#define RX_CAL_SEARCH_MAX_ITER  (16)
+#define RX_CAL_SEARCH_MAX_PTS   (RX_CAL_SEARCH_MAX_ITER + 2)
+
 struct rx_cal {
     struct bladerf *dev;
 
@@ -332,8 +337,45 @@ struct rx_cal {
     uint64_t ts;
 
     uint64_t tx_freq;
+
+    /* Measure DC offsets for the AGC's gain modes */
+    bool agc;
+
+    /* Number of captures taken */
+    unsigned int captures;
+};
+
+/* The two points measured to form a coarse estimate */
+struct rx_cal_coarse {
+    int16_t x1, x2;
+    float y1i, y1q;
+    float y2i, y2q;
+};
+
+/* State of a secant search for a single (I or Q) correction value */
+struct rx_cal_secant {
+    int16_t x[RX_CAL_SEARCH_MAX_PTS];
+    float y[RX_CAL_SEARCH_MAX_PTS];
+    unsigned int n;
+
+    /* Index of the point with the smallest |mean| */
+    unsigned int best;
+
+    /* Indices of the nearest points on either side of the zero crossing,
+     * or -1 if the zero crossing has not yet been bracketed */
+    int lo, hi;
+};
+
+/* Gain modes whose DC offsets are measured for the AGC */
+static const struct gain_mode rx_cal_agc_gains[] = {
+    { .lna_gain = BLADERF_LNA_GAIN_MAX, .rxvga1 = 30, .rxvga2 = 15 },  /* AGC Max Gain */
+    { .lna_gain = BLADERF_LNA_GAIN_MID, .rxvga1 = 30, .rxvga2 = 0  },  /* AGC Mid Gain */
+    { .lna_gain = BLADERF_LNA_GAIN_MID, .rxvga1 = 12, .rxvga2 = 0  }   /* AGC Min Gain */
 };
 
+#define RX_CAL_AGC_CAPTURES \
+    (sizeof(rx_cal_agc_gains) / sizeof(rx_cal_agc_gains[0]))
+
 struct rx_cal_backup {
     struct bladerf_rational_rate rational_sample_rate;
     unsigned int bandwidth;
@@ -389,7 +431,7 @@ static int set_rx_cal_backup(struct bladerf *dev, struct rx_cal_backup *b)
 
 /* Ensure TX >= 1 MHz away from the RX frequency to avoid any potential
  * artifacts from the PLLs interfering with one another */
-static int rx_cal_update_frequency(struct rx_cal *cal, uint64_t rx_freq)
+static int rx_cal_update_tx_frequency(struct rx_cal *cal, uint64_t rx_freq)
 {
     int status = 0;
     uint64_t f_diff;
@@ -419,6 +461,18 @@ static int rx_cal_update_frequency(struct rx_cal *cal, uint64_t rx_freq)
         PR_DBG("Adjusted TX frequency: %u\n", cal->tx_freq);
     }
 
+    return status;
+}
+
+static int rx_cal_update_frequency(struct rx_cal *cal, uint64_t rx_freq)
+{
+    int status;
+
+    status = rx_cal_update_tx_frequency(cal, rx_freq);
+    if (status != 0) {
+        return status;
+    }
+
     status = bladerf_set_frequency(cal->dev, BLADERF_MODULE_RX, rx_freq);
     if (status != 0) {
         return status;
@@ -454,6 +508,15 @@ static inline void sample_mean(int16_t *samples, size_t count,
     *mean_q = ((float) accum_q) / count;
 }
 
+/* Capture the next block of samples */
+static inline int rx_cal_capture(struct rx_cal *cal)
+{
+    cal->captures++;
+
+    return rx_samples(cal->dev, cal->samples, cal->num_samples,
+                      &cal->ts, RX_CAL_TS_INC);
+}
+
 static inline int set_rx_dc_corr(struct bladerf *dev, int16_t i, int16_t q)
 {
     int status;
@@ -486,8 +549,7 @@ static int rx_cal_coarse_means(struct rx_cal *cal, int16_t *corr_value,
             return status;
         }
 
-        status = rx_samples(cal->dev, cal->samples, cal->num_samples,
-                            &cal->ts, RX_CAL_TS_INC);
+        status = rx_cal_capture(cal);
         if (status != 0) {
             return status;
         }
@@ -523,9 +585,11 @@ static int rx_cal_coarse_means(struct rx_cal *cal, int16_t *corr_value,
 }
 
 /* Estimate the DC correction values that yield zero DC offset via a linear
- * approximation */
+ * approximation. If `coarse` is non-NULL, the measured points are stored
+ * there. */
 static int rx_cal_coarse_estimate(struct rx_cal *cal,
-                                  int16_t *i_est, int16_t *q_est)
+                                  int16_t *i_est, int16_t *q_est,
+                                  struct rx_cal_coarse *coarse)
 {
     int status;
     int16_t x1 = -2048;
@@ -580,6 +644,15 @@ static int rx_cal_coarse_estimate(struct rx_cal *cal,
 
     PR_DBG("Coarse estimate: I=%d, Q=%d\n", *i_est, *q_est);
 
+    if (coarse != NULL) {
+        coarse->x1  = x1;
+        coarse->x2  = x2;
+        coarse->y1i = y1i;
+        coarse->y1q = y1q;
+        coarse->y2i = y2i;
+        coarse->y2q = y2q;
+    }
+
     return 0;
 }
 
@@ -648,7 +721,7 @@ static int save_gains(struct rx_cal *cal, struct gain_mode *gain) {
     return status;
 }
 
-static int load_gains(struct rx_cal *cal, struct gain_mode *gain) {
+static int load_gains(struct rx_cal *cal, const struct gain_mode *gain) {
     int status;
 
     status = bladerf_set_lna_gain(cal->dev, gain->lna_gain);
@@ -669,7 +742,7 @@ static int load_gains(struct rx_cal *cal, struct gain_mode *gain) {
     return status;
 }
 
-static int rx_cal_dc_off(struct rx_cal *cal, struct gain_mode *gains,
+static int rx_cal_dc_off(struct rx_cal *cal, const struct gain_mode *gains,
                         int16_t *dc_i, int16_t *dc_q)
 {
     int status = BLADERF_ERR_UNEXPECTED;
@@ -681,8 +754,7 @@ static int rx_cal_dc_off(struct rx_cal *cal, struct gain_mode *gains,
         return status;
     }
 
-    status = rx_samples(cal->dev, cal->samples, cal->num_samples,
-                        &cal->ts, RX_CAL_TS_INC);
+    status = rx_cal_capture(cal);
     if (status != 0) {
         return status;
     }
@@ -716,8 +788,7 @@ static int rx_cal_sweep(struct rx_cal *cal,
             return status;
         }
 
-        status = rx_samples(cal->dev, cal->samples, cal->num_samples,
-                            &cal->ts, RX_CAL_TS_INC);
+        status = rx_cal_capture(cal);
         if (status != 0) {
             return status;
         }
@@ -755,85 +826,415 @@ static int rx_cal_sweep(struct rx_cal *cal,
     return 0;
 }
 
-static int perform_rx_cal(struct rx_cal *cal, struct dc_calibration_params *p)
+/* Not using fabs() to avoid adding a -lm dependency */
+static inline float abs_float(float val)
+{
+    return val < 0 ? -val : val;
+}
+
+/* Round to the nearest correction value the LMS6002D can represent */
+static inline int16_t rx_cal_quantize(float val)
+{
+    if (val <= -2048) {
+        return -2048;
+    } else if (val >= 2048) {
+        return 2048;
+    }
+
+    return float_to_int16(val / 32) * 32;
+}
+
+static void secant_add(struct rx_cal_secant *s, int16_t x, float y)
+{
+    const unsigned int n = s->n;
+
+    assert(n < RX_CAL_SEARCH_MAX_PTS);
+
+    s->x[n] = x;
+    s->y[n] = y;
+    s->n++;
+
+    if (n == 0 || abs_float(y) < abs_float(s->y[s->best])) {
+        s->best = n;
+    }
+
+    /* Narrow the bracket around the zero crossing */
+    if (s->lo >= 0 && x > s->x[s->lo] && x < s->x[s->hi]) {
+        if ((y < 0) == (s->y[s->lo] < 0)) {
+            s->lo = n;
+        } else {
+            s->hi = n;
+        }
+    }
+}
+
+static void secant_init(struct rx_cal_secant *s,
+                        int16_t x1, float y1, int16_t x2, float y2)
+{
+    s->n    = 0;
+    s->best = 0;
+    s->lo   = -1;
+    s->hi   = -1;
+
+    secant_add(s, x1, y1);
+    secant_add(s, x2, y2);
+
+    if (x1 < x2 && (y1 < 0) != (y2 < 0)) {
+        s->lo = 0;
+        s->hi = 1;
+    }
+}
+
+static bool secant_measured(const struct rx_cal_secant *s, int16_t x)
+{
+    unsigned int i;
+
+    for (i = 0; i < s->n; i++) {
+        if (s->x[i] == x) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Determine the next correction value to measure. Returns false when the
+ * search is complete, in which case the best point is the result. */
+static bool secant_next(const struct rx_cal_secant *s, float tolerance,
+                        int16_t *next)
+{
+    const unsigned int a = s->n - 2;
+    const unsigned int b = s->n - 1;
+    const bool bracketed = (s->lo >= 0);
+    float slope = 0;
+    float est;
+    int16_t x;
+    int dir;
+
+    if (abs_float(s->y[s->best]) <= tolerance ||
+        s->n >= RX_CAL_SEARCH_MAX_PTS) {
+        return false;
+    }
+
+    if (s->x[b] != s->x[a] && s->y[b] != s->y[a]) {
+        slope = (s->y[b] - s->y[a]) / (s->x[b] - s->x[a]);
+        est   = s->x[b] - s->y[b] / slope;
+    } else if (bracketed) {
+        est = (s->x[s->lo] + s->x[s->hi]) / 2.0f;
+    } else {
+        return false;
+    }
+
+    /* Fall back to bisection if the secant leaves the bracket */
+    if (bracketed && (est <= s->x[s->lo] || est >= s->x[s->hi])) {
+        est = (s->x[s->lo] + s->x[s->hi]) / 2.0f;
+    }
+
+    x = rx_cal_quantize(est);
+
+    if (secant_measured(s, x)) {
+        /* We've converged to the correction value's resolution. The zero
+         * crossing may still lie closer to the adjacent value on the other
+         * side of it, so check that one unless it's already known. */
+        if (bracketed && s->best == (unsigned int) s->lo) {
+            dir = 1;
+        } else if (bracketed && s->best == (unsigned int) s->hi) {
+            dir = -1;
+        } else if (slope != 0) {
+            dir = ((s->y[s->best] > 0) == (slope > 0)) ? -1 : 1;
+        } else {
+            return false;
+        }
+
+        x = s->x[s->best] + dir * 32;
+        if (x < -2048 || x > 2048 || secant_measured(s, x)) {
+            return false;
+        }
+    }
+
+    *next = x;
+    return true;
+}
+
+/* Search for the I and Q correction values using the secant method, starting
+ * from the points used to form the coarse estimate. Since the I and Q
+ * corrections are largely independent, both searches share each capture. */
+static int rx_cal_secant(struct rx_cal *cal, const struct rx_cal_coarse *c,
+                         float tolerance,
+                         int16_t *result_i, int16_t *result_q,
+                         float *error_i, float *error_q)
 {
     int status;
-    int16_t i_est, q_est;
-    unsigned int sweep_len = RX_CAL_MAX_SWEEP_LEN;
-    struct gain_mode saved_gains;
+    struct rx_cal_secant s_i, s_q;
+    int16_t next_i, next_q;
+    int16_t corr_i, corr_q;
+    bool more_i, more_q;
+    float mean_i, mean_q;
 
-    struct gain_mode agc_gains[] = {
-        { .lna_gain = BLADERF_LNA_GAIN_MAX, .rxvga1 = 30, .rxvga2 = 15 },  /* AGC Max Gain */
-        { .lna_gain = BLADERF_LNA_GAIN_MID, .rxvga1 = 30, .rxvga2 = 0  },  /* AGC Mid Gain */
-        { .lna_gain = BLADERF_LNA_GAIN_MID, .rxvga1 = 12, .rxvga2 = 0  }   /* AGC Min Gain */
-    };
+    secant_init(&s_i, c->x1, c->y1i, c->x2, c->y2i);
+    secant_init(&s_q, c->x1, c->y1q, c->x2, c->y2q);
 
-    status = rx_cal_update_frequency(cal, p->frequency);
-    if (status != 0) {
-        return status;
+    more_i = secant_next(&s_i, tolerance, &next_i);
+    more_q = secant_next(&s_q, tolerance, &next_q);
+
+    while (more_i || more_q) {
+        corr_i = more_i ? next_i : s_i.x[s_i.best];
+        corr_q = more_q ? next_q : s_q.x[s_q.best];
+
+        status = set_rx_dc_corr(cal->dev, corr_i, corr_q);
+        if (status != 0) {
+            return status;
+        }
+
+        status = rx_cal_capture(cal);
+        if (status != 0) {
+            return status;
+        }
+
+        sample_mean(cal->samples, cal->num_samples, &mean_i, &mean_q);
+
+        PR_VERBOSE("  Corr=(%4d, %4d), Mean_I=%4.2f, Mean_Q=%4.2f\n",
+                   corr_i, corr_q, mean_i, mean_q);
+
+        if (more_i) {
+            secant_add(&s_i, corr_i, mean_i);
+            more_i = secant_next(&s_i, tolerance, &next_i);
+        }
+
+        if (more_q) {
+            secant_add(&s_q, corr_q, mean_q);
+            more_q = secant_next(&s_q, tolerance, &next_q);
+        }
     }
 
+    PR_DBG("Secant search: %u I points, %u Q points\n", s_i.n, s_q.n);
+
+    *result_i = s_i.x[s_i.best];
+    *result_q = s_q.x[s_q.best];
+    *error_i  = abs_float(s_i.y[s_i.best]);
+    *error_q  = abs_float(s_q.y[s_q.best]);
+
+    return 0;
+}
+
+/* Determine the correction values for the current frequency, and apply them */
+static int rx_cal_search(struct rx_cal *cal, struct dc_calibration_params *p)
+{
+    int status;
+    int16_t i_est, q_est;
+    unsigned int sweep_len = RX_CAL_MAX_SWEEP_LEN;
+    struct rx_cal_coarse coarse;
+
     /* Get an initial guess at our correction values */
-    status = rx_cal_coarse_estimate(cal, &i_est, &q_est);
+    status = rx_cal_coarse_estimate(cal, &i_est, &q_est, &coarse);
     if (status != 0) {
         return status;
     }
 
-    /* Perform a finer sweep of correction values */
-    init_rx_cal_sweep(cal->corr_sweep, &sweep_len, i_est, q_est);
-
     /* Advance our timestmap just to account for any time we may have lost */
     cal->ts += RX_CAL_TS_INC;
 
-    status = rx_cal_sweep(cal, cal->corr_sweep, sweep_len,
-                          &p->corr_i, &p->corr_q,
-                          &p->error_i, &p->error_q);
+    if (p->search == DC_CAL_SEARCH_SECANT) {
+        /* Refine the coarse estimate */
+        status = rx_cal_secant(cal, &coarse, p->tolerance,
+                               &p->corr_i, &p->corr_q,
+                               &p->error_i, &p->error_q);
+    } else {
+        /* Perform a finer sweep of correction values */
+        init_rx_cal_sweep(cal->corr_sweep, &sweep_len, i_est, q_est);
+
+        status = rx_cal_sweep(cal, cal->corr_sweep, sweep_len,
+                              &p->corr_i, &p->corr_q,
+                              &p->error_i, &p->error_q);
+    }
 
     if (status != 0) {
         return status;
     }
 
     /* Apply the nominal correction values */
-    status = set_rx_dc_corr(cal->dev, p->corr_i, p->corr_q);
+    return set_rx_dc_corr(cal->dev, p->corr_i, p->corr_q);
+}
+
+/* Measure DC correction for AGC. This takes RX_CAL_AGC_CAPTURES captures. */
+static int rx_cal_agc(struct rx_cal *cal, struct dc_calibration_params *p)
+{
+    int status;
+    struct gain_mode saved_gains;
+
+    status = save_gains(cal, &saved_gains);
     if (status != 0) {
         return status;
     }
 
-    bladerf_fpga_size fpga_size;
-    status = bladerf_get_fpga_size(cal->dev, &fpga_size);
+    status = rx_cal_dc_off(cal, &rx_cal_agc_gains[2],
+                           &p->min_dc_i, &p->min_dc_q);
     if (status != 0) {
         return status;
     }
 
-    if (fpga_size != BLADERF_FPGA_40KLE &&
-         fpga_size != BLADERF_FPGA_115KLE) {
-        return 0;
+    status = rx_cal_dc_off(cal, &rx_cal_agc_gains[1],
+                           &p->mid_dc_i, &p->mid_dc_q);
+    if (status != 0) {
+        return status;
     }
 
-    /* Measure DC correction for AGC */
-    status = save_gains(cal, &saved_gains);
+    status = rx_cal_dc_off(cal, &rx_cal_agc_gains[0],
+                           &p->max_dc_i, &p->max_dc_q);
     if (status != 0) {
         return status;
     }
 
-    status = rx_cal_dc_off(cal, &agc_gains[2], &p->min_dc_i, &p->min_dc_q);
+    status = load_gains(cal, &saved_gains);
+
+    return status;
+}
+
+/* Calibrate the entry `p`. If `tuned` is true, the retune to its frequency has
+ * already been scheduled.
+ *
+ * If `next` is non-NULL, the retune to the next entry's frequency is scheduled
+ * to occur as soon as the last capture for this entry completes, and
+ * `*next_scheduled` is set to true. Otherwise, or if this cannot be done,
+ * `*next_scheduled` is set to false. */
+static int perform_rx_cal(struct rx_cal *cal, struct dc_calibration_params *p,
+                          bool tuned,
+                          const struct dc_calibration_params *next,
+                          struct bladerf_quick_tune *next_qt,
+                          bool *next_scheduled)
+{
+    int status;
+    uint64_t ts_retune = 0;
+    const uint64_t ts_start = cal->ts;
+    const unsigned int captures = cal->captures;
+
+    *next_scheduled = false;
+
+    if (p->search != DC_CAL_SEARCH_SWEEP &&
+        p->search != DC_CAL_SEARCH_SECANT) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    if (tuned) {
+        status = rx_cal_update_tx_frequency(cal, p->frequency);
+    } else {
+        status = rx_cal_update_frequency(cal, p->frequency);
+    }
+
     if (status != 0) {
         return status;
     }
 
-    status = rx_cal_dc_off(cal, &agc_gains[1], &p->mid_dc_i, &p->mid_dc_q);
+    status = rx_cal_search(cal, p);
     if (status != 0) {
         return status;
     }
 
-    status = rx_cal_dc_off(cal, &agc_gains[0], &p->max_dc_i, &p->max_dc_q);
+    /* The remaining captures are at known timestamps, so the FPGA can retune
+     * to the next frequency right after the last of them, while we are still
+     * busy with this one. */
+    if (next != NULL) {
+        ts_retune = cal->ts;
+        if (cal->agc) {
+            ts_retune += RX_CAL_AGC_CAPTURES *
+                            ((uint64_t) cal->num_samples + RX_CAL_TS_INC);
+        }
+
+        status = bladerf_schedule_retune(cal->dev, BLADERF_CHANNEL_RX(0),
+                                         ts_retune, next->frequency, next_qt);
+        if (status == 0) {
+            *next_scheduled = true;
+        } else if (status == BLADERF_ERR_UNSUPPORTED) {
+            PR_DBG("Scheduled retunes are not supported.\n");
+            status = 0;
+        } else {
+            return status;
+        }
+    }
+
+    if (cal->agc) {
+        status = rx_cal_agc(cal, p);
+        if (status != 0) {
+            return status;
+        }
+    }
+
+    if (*next_scheduled && cal->ts != ts_retune) {
+        /* A capture had to be retried, so the retune may have occurred in
+         * the middle of one. Measure the AGC's DC offsets again. */
+        PR_DBG("Capture overlapped retune at %" PRIu64 "\n", ts_retune);
+
+        *next_scheduled = false;
+
+        status = bladerf_cancel_scheduled_retunes(cal->dev,
+                                                  BLADERF_CHANNEL_RX(0));
+        if (status != 0) {
+            return status;
+        }
+
+        status = rx_cal_update_frequency(cal, p->frequency);
+        if (status != 0) {
+            return status;
+        }
+
+        status = rx_cal_agc(cal, p);
+        if (status != 0) {
+            return status;
+        }
+    }
+
+    if (*next_scheduled) {
+        /* Allow the retune to settle */
+        cal->ts += RX_CAL_TS_INC;
+    }
+
+    p->captures   = cal->captures - captures;
+    p->elapsed_us = (cal->ts - ts_start) * 1000000 / RX_CAL_RATE;
+
+    return 0;
+}
+
+/* Obtain quick tune parameters for each entry, which allows the retunes between
+ * them to be scheduled. Returns NULL if this is not possible. */
+static struct bladerf_quick_tune *rx_cal_hop_set(
+                                    struct bladerf *dev,
+                                    const struct dc_calibration_params *params,
+                                    size_t params_count)
+{
+    int status;
+    bladerf_frequency *frequencies;
+    struct bladerf_quick_tune *qt;
+    size_t i;
+
+    if (params_count < 2 || params_count > UINT_MAX) {
+        return NULL;
+    }
+
+    frequencies = malloc(params_count * sizeof(frequencies[0]));
+    qt          = malloc(params_count * sizeof(qt[0]));
+
+    if (frequencies == NULL || qt == NULL) {
+        goto error;
+    }
+
+    for (i = 0; i < params_count; i++) {
+        frequencies[i] = params[i].frequency;
+    }
+
+    status = bladerf_build_hop_set(dev, BLADERF_CHANNEL_RX(0), frequencies,
+                                   (unsigned int) params_count, qt);
     if (status != 0) {
-        return status;
+        PR_DBG("Failed to build hop set: %s\n", bladerf_strerror(status));
+        goto error;
     }
 
-    status = load_gains(cal, &saved_gains);
+    free(frequencies);
+    return qt;
 
-    return status;
+error:
+    free(frequencies);
+    free(qt);
+    return NULL;
 }
 
 static int rx_cal_init_state(struct bladerf *dev,
@@ -841,6 +1242,7 @@ static int rx_cal_init_state(struct bladerf *dev,
                              struct rx_cal *state)
 {
     int status;
+    bladerf_fpga_size fpga_size;
 
     state->dev = dev;
 
@@ -858,6 +1260,14 @@ static int rx_cal_init_state(struct bladerf *dev,
 
     state->tx_freq = backup->tx_freq;
 
+    status = bladerf_get_fpga_size(dev, &fpga_size);
+    if (status != 0) {
+        return status;
+    }
+
+    state->agc = (fpga_size == BLADERF_FPGA_40KLE ||
+                  fpga_size == BLADERF_FPGA_115KLE);
+
     status = bladerf_get_timestamp(dev, BLADERF_MODULE_RX, &state->ts);
     if (status != 0) {
         return status;
@@ -906,6 +1316,8 @@ int dc_calibration_rx(struct bladerf *dev,
     int retval = 0;
     struct rx_cal state;
     struct rx_cal_backup backup;
+    struct bladerf_quick_tune *qt = NULL;
+    bool scheduled = false;
     size_t i;
 
     memset(&state, 0, sizeof(state));
@@ -915,6 +1327,9 @@ int dc_calibration_rx(struct bladerf *dev,
         return status;
     }
 
+    /* If this fails, each entry is simply tuned as we get to it */
+    qt = rx_cal_hop_set(dev, params, params_count);
+
     status = rx_cal_init(dev);
     if (status != 0) {
         goto out;
@@ -926,7 +1341,12 @@ int dc_calibration_rx(struct bladerf *dev,
     }
 
     for (i = 0; i < params_count && status == 0; i++) {
-        status = perform_rx_cal(&state, &params[i]);
+        const bool have_next = (qt != NULL && (i + 1) < params_count);
+
+        status = perform_rx_cal(&state, &params[i], scheduled,
+                                have_next ? &params[i + 1] : NULL,
+                                have_next ? &qt[i + 1] : NULL,
+                                &scheduled);
 
         if (status == 0 && print_status) {
 #           ifdef DEBUG_DC_CALIBRATION
@@ -937,11 +1357,12 @@ int dc_calibration_rx(struct bladerf *dev,
             const char eol = '\0';
 #           endif
             printf("%cCalibrated @ %10" PRIu64 " Hz: I=%4d (Error: %4.2f), "
-                   "Q=%4d (Error: %4.2f)      ",
+                   "Q=%4d (Error: %4.2f) in %3u captures, %4" PRIu64 " ms      ",
                    sol,
                    params[i].frequency,
                    params[i].corr_i, params[i].error_i,
-                   params[i].corr_q, params[i].error_q);
+                   params[i].corr_q, params[i].error_q,
+                   params[i].captures, params[i].elapsed_us / 1000);
             printf("DC-LUT: Max (I=%3d, Q=%3d) Mid (I=%3d, Q=%3d)"
                    " Min (I=%3d, Q=%3d)%c",
                        params[i].max_dc_i, params[i].max_dc_q, params[i].mid_dc_i, params[i].mid_dc_q,
@@ -957,9 +1378,18 @@ int dc_calibration_rx(struct bladerf *dev,
 out:
     free(state.samples);
     free(state.corr_sweep);
+    free(qt);
 
     retval = status;
 
+    /* A retune may still be pending if we bailed out early */
+    if (scheduled) {
+        status = bladerf_cancel_scheduled_retunes(dev, BLADERF_CHANNEL_RX(0));
+        if (status != 0 && retval == 0) {
+            retval = status;
+        }
+    }
+
     status = bladerf_enable_module(dev, BLADERF_MODULE_RX, false);
     if (status != 0 && retval == 0) {
         retval = status;
@@ -1743,3 +2173,127 @@ int dc_calibration(struct bladerf *dev, bladerf_module module,
 
     return status;
 }
+
+/* See libbladeRF's dc_cal_table.c for the packed table data format */
+int dc_calibration_save_table(struct bladerf *dev, bladerf_module module,
+                              const struct dc_calibration_params *params,
+                              size_t num_params, const char *filename)
+{
+    int status = 0;
+    struct bladerf_lms_dc_cals lms_dc_cals;
+    struct bladerf_image *image = NULL;
+    size_t i;
+    size_t off = 0;
+    uint32_t n_frequencies_le = 0;
+
+    static const uint16_t magic = HOST_TO_LE16_CONST(0x1ab1);
+    static const uint32_t reserved = HOST_TO_LE32_CONST(0x00000000);
+    static const uint32_t tbl_version = HOST_TO_LE32_CONST(0x00000002);
+    static const size_t lms_data_size = 10; /* 10 uint8_t register values */
+
+
+    const size_t entry_size = sizeof(uint32_t) +   /* Frequency */
+                              8 * sizeof(int16_t); /* DC I and Q valus */
+
+    const size_t table_size = num_params * entry_size;
+
+    const size_t data_size = sizeof(magic) + sizeof(reserved) +
+                             sizeof(tbl_version) + sizeof(n_frequencies_le) +
+                             lms_data_size + table_size;
+
+    assert(num_params < UINT32_MAX);
+    assert(data_size <= UINT_MAX);
+
+    n_frequencies_le = HOST_TO_LE32((uint32_t) num_params);
+
+    status = bladerf_lms_get_dc_cals(dev, &lms_dc_cals);
+    if (status != 0) {
+        return status;
+    }
+
+    if (module == BLADERF_MODULE_RX) {
+        image = bladerf_alloc_image(dev, BLADERF_IMAGE_TYPE_RX_DC_CAL,
+                                    0xffffffff, (unsigned int) data_size);
+    } else {
+        image = bladerf_alloc_image(dev, BLADERF_IMAGE_TYPE_TX_DC_CAL,
+                                    0xffffffff, (unsigned int) data_size);
+    }
+
+    if (image == NULL) {
+        return BLADERF_ERR_MEM;
+    }
+
+    /* Fill in header */
+    memcpy(&image->data[off], &magic, sizeof(magic));
+    off += sizeof(magic);
+
+    memcpy(&image->data[off], &reserved, sizeof(reserved));
+    off += sizeof(reserved);
+
+    memcpy(&image->data[off], &tbl_version, sizeof(tbl_version));
+    off += sizeof(tbl_version);
+
+    memcpy(&image->data[off], &n_frequencies_le, sizeof(n_frequencies_le));
+    off += sizeof(n_frequencies_le);
+
+    image->data[off++] = (uint8_t)lms_dc_cals.lpf_tuning;
+    image->data[off++] = (uint8_t)lms_dc_cals.tx_lpf_i;
+    image->data[off++] = (uint8_t)lms_dc_cals.tx_lpf_q;
+    image->data[off++] = (uint8_t)lms_dc_cals.rx_lpf_i;
+    image->data[off++] = (uint8_t)lms_dc_cals.rx_lpf_q;
+    image->data[off++] = (uint8_t)lms_dc_cals.dc_ref;
+    image->data[off++] = (uint8_t)lms_dc_cals.rxvga2a_i;
+    image->data[off++] = (uint8_t)lms_dc_cals.rxvga2a_q;
+    image->data[off++] = (uint8_t)lms_dc_cals.rxvga2b_i;
+    image->data[off++] = (uint8_t)lms_dc_cals.rxvga2b_q;
+
+    for (i = 0; i < num_params; i++) {
+        uint32_t freq;
+        int16_t corr_i, corr_q;
+        int16_t max_dc_i, max_dc_q;
+        int16_t mid_dc_i, mid_dc_q;
+        int16_t min_dc_i, min_dc_q;
+
+        freq   = HOST_TO_LE32((uint32_t) params[i].frequency);
+        corr_i = HOST_TO_LE16(params[i].corr_i);
+        corr_q = HOST_TO_LE16(params[i].corr_q);
+        max_dc_i = HOST_TO_LE16(params[i].max_dc_i);
+        max_dc_q = HOST_TO_LE16(params[i].max_dc_q);
+        mid_dc_i = HOST_TO_LE16(params[i].mid_dc_i);
+        mid_dc_q = HOST_TO_LE16(params[i].mid_dc_q);
+        min_dc_i = HOST_TO_LE16(params[i].min_dc_i);
+        min_dc_q = HOST_TO_LE16(params[i].min_dc_q);
+
+        memcpy(&image->data[off], &freq, sizeof(freq));
+        off += sizeof(freq);
+
+        memcpy(&image->data[off], &corr_i, sizeof(corr_i));
+        off += sizeof(corr_q);
+
+        memcpy(&image->data[off], &corr_q, sizeof(corr_q));
+        off += sizeof(corr_q);
+
+        memcpy(&image->data[off], &max_dc_i, sizeof(max_dc_i));
+        off += sizeof(max_dc_i);
+
+        memcpy(&image->data[off], &max_dc_q, sizeof(max_dc_q));
+        off += sizeof(max_dc_q);
+
+        memcpy(&image->data[off], &mid_dc_i, sizeof(mid_dc_i));
+        off += sizeof(mid_dc_i);
+
+        memcpy(&image->data[off], &mid_dc_q, sizeof(mid_dc_q));
+        off += sizeof(mid_dc_q);
+
+        memcpy(&image->data[off], &min_dc_i, sizeof(min_dc_i));
+        off += sizeof(min_dc_i);
+
+        memcpy(&image->data[off], &min_dc_q, sizeof(min_dc_q));
+        off += sizeof(min_dc_q);
+    }
+
+    status = bladerf_image_write(dev, image, filename);
+
+    bladerf_free_image(image);
+    return status;
+}
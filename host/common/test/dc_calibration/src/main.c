@@ -128,6 +128,7 @@ int main(int argc, char *argv[])
 
         if (argc == 3) {
             struct dc_calibration_params p;
+            memset(&p, 0, sizeof(p));
             p.frequency = f_start;
             p.corr_i  = p.corr_q = 0;
             p.error_i = p.error_q = 0;
@@ -1273,6 +1273,43 @@ int CALL_CONV bladerf_calibrate_dc(struct bladerf *dev,
 
 /** @} (End of FN_BLADERF1_DC_CAL) */
 
+/**
+ * @defgroup FN_BLADERF1_VCOCAP_CACHE VCOCAP cache
+ *
+ * When tuning from the host, the VCOCAP value that each retune's search
+ * converges to is cached in 1 MHz bins. Subsequent retunes within a bin start
+ * from the cached value, which is used as-is if a single VTUNE reading shows
+ * it to still be valid. bladerf_get_quick_tune_stats() reports the cache's
+ * effectiveness, and bladerf_clear_quick_tune_cache() discards its contents.
+ *
+ * The cache is loaded from, and saved to, a `<serial>_vcocap.tbl` file if one
+ * is found in the same locations as DC calibration tables when the device is
+ * opened.
+ *
+ * These functions are thread-safe.
+ *
+ * @{
+ */
+
+/**
+ * Persist the VCOCAP cache in the specified file
+ *
+ * Values in the file replace any that are cached. The file is created if it
+ * does not exist, and is written when the device is closed.
+ *
+ * @param       dev         Device handle
+ * @param[in]   path        Cache file path, or NULL to stop persisting the
+ *                          cache
+ *
+ * @return 0 on success, BLADERF_ERR_INVAL if the file is not a VCOCAP cache
+ *         for this device, or a value from \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV bladerf_set_vcocap_cache_file(struct bladerf *dev,
+                                            const char *path);
+
+/** @} (End of FN_BLADERF1_VCOCAP_CACHE) */
+
 /**
  * @defgroup FN_BLADERF1_LOW_LEVEL Low-level accessors
  *
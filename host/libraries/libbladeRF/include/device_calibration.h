@@ -24,12 +24,24 @@
 
 #include <stdint.h>
 #include "libbladeRF.h"
+#include "helpers/gain_cal_lut.h"
+
+/**
+ * Contents of a table file whose entries are used in place
+ */
+struct gain_cal_map {
+    void *addr;  /**< File contents */
+    size_t len;  /**< Length of the file */
+    bool mapped; /**< `addr` is a mapping of the file, rather than a copy */
+};
 
 /**
  * @brief Converts gain calibration CSV data to a binary format.
  *
  * This function reads frequency and gain data from a CSV file and writes it
- * to a binary file.
+ * to a version 2 table file, in a single pass over the CSV file. Only the
+ * measurements used for gain compensation are written, along with a SHA-256
+ * digest of the file's contents.
  *
  * @param csv_path     Path to the input CSV file.
  * @param binary_path  Path to the output binary file.
@@ -44,6 +56,10 @@ int gain_cal_csv_to_bin(struct bladerf *dev, const char *csv_path, const char *b
  * This function reads frequency and gain calibration data from a binary file and
  * loads it into the specified bladeRF device.
  *
+ * Version 2 table files are verified against their SHA-256 digest and, where
+ * possible, mapped and used in place. Version 1 tables, stored as a
+ * bladerf_image, are also accepted.
+ *
  * @param dev         Pointer to the bladeRF device structure.
  * @param ch          Channel for which the gain calibration data is loaded.
  * @param binary_path Path to the binary file containing frequency-gain data.
@@ -101,6 +117,77 @@ int get_gain_cal_entry(const struct bladerf_gain_cal_tbl *tbl,
                        bladerf_frequency freq,
                        struct bladerf_gain_cal_entry *result);
 
+/**
+ * Frees a channel's calibration table, its lookup, and the file contents
+ * backing it, if any.
+ *
+ * @param dev   Device handle
+ * @param ch    Channel
+ */
+void gain_cal_release(struct bladerf *dev, bladerf_channel ch);
+
+/**
+ * Retrieves the gain correction for a frequency from a channel's compiled
+ * lookup.
+ *
+ * As with get_gain_cal_entry(), frequencies below the start of the table use
+ * its first entry, and frequencies beyond its end are an error.
+ *
+ * @param[in]  dev    Device handle
+ * @param[in]  ch     Channel
+ * @param[in]  freq   Frequency
+ * @param[out] corr   Gain correction
+ *
+ * @return 0 on success, BLADERF_ERR_UNEXPECTED if no table is loaded or
+ *         `freq` is beyond the end of the table.
+ */
+int lookup_gain_correction(struct bladerf *dev,
+                           bladerf_channel ch,
+                           bladerf_frequency freq,
+                           double *corr);
+
+/**
+ * Retrieves gain corrections for a list of frequencies.
+ *
+ * @see bladerf_get_gain_corrections()
+ */
+int get_gain_corrections(struct bladerf *dev,
+                         bladerf_channel ch,
+                         const bladerf_frequency *frequencies,
+                         unsigned int count,
+                         double *corrections);
+
+/**
+ * Retrieves a channel's current frequency for the purpose of gain
+ * compensation. The frequency last applied through bladerf_set_frequency() is
+ * used if it is known, to avoid querying the device. Otherwise, such as while
+ * a scheduled retune may be pending, the device is queried on every call.
+ *
+ * @param[in]  dev        Device handle
+ * @param[in]  ch         Channel
+ * @param[out] frequency  Current frequency
+ *
+ * @return 0 on success, BLADERF_ERR_* code on failure.
+ */
+int get_gain_cal_frequency(struct bladerf *dev,
+                           bladerf_channel ch,
+                           bladerf_frequency *frequency);
+
+/**
+ * Records the frequency a channel was tuned to for the purpose of gain
+ * compensation, or forgets it if `frequency` is 0.
+ *
+ * Channels of the same direction share an LO, so the frequency is recorded
+ * for every channel in the direction of `ch`.
+ *
+ * @param      dev        Device handle
+ * @param[in]  ch         Channel
+ * @param[in]  frequency  Frequency, or 0 if unknown
+ */
+void set_gain_cal_frequency(struct bladerf *dev,
+                            bladerf_channel ch,
+                            bladerf_frequency frequency);
+
 /**
  * Applies compensated gain given the current gain target and center frequency
  *
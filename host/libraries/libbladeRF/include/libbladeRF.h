@@ -51,7 +51,7 @@
  *
  *  https://github.com/Nuand/bladeRF/blob/master/doc/development/versioning.md
  */
-#define LIBBLADERF_API_VERSION (0x02050100)
+#define LIBBLADERF_API_VERSION (0x02060000)
 
 #ifdef __cplusplus
 extern "C" {
@@ -1842,6 +1842,12 @@ struct bladerf_quick_tune {
             uint32_t nfrac;  /**< Fractional portion of LO frequency value */
             uint8_t flags;   /**< Flag bits used internally by libbladeRF */
             uint8_t xb_gpio;   /**< Flag bits used to configure XB */
+            uint8_t dc_i;    /**< DC offset correction register value for the
+                                  I channel, from the loaded DC calibration
+                                  table. Only valid if indicated by `flags`. */
+            uint8_t dc_q;    /**< DC offset correction register value for the
+                                  Q channel. Only valid if indicated by
+                                  `flags`. */
         };
         /* bladeRF2 quick tune parameters */
         struct {
@@ -1849,6 +1855,8 @@ struct bladerf_quick_tune {
             uint8_t rffe_profile;  /**< Profile number in RFFE */
             uint8_t port;          /**< RFFE port settings */
             uint8_t spdt;          /**< External SPDT settings */
+            uint32_t profile_gen;  /**< Profile cache generation, used
+                                        internally by libbladeRF */
         };
     };
 };
@@ -1874,14 +1882,31 @@ struct bladerf_quick_tune {
  *                              according to a previous state retrieved via
  *                              bladerf_get_quick_tune().
  *
- * @return 0 on success, value from \ref RETCODES list on failure.
+ * @return 0 on success, value from \ref RETCODES list on failure. An error
+ *         encountered while submitting a previously held retune (see below)
+ *         for the channel's direction is reported by the next call for that
+ *         direction, in which case this retune is not scheduled.
+ *
+ * @note Retunes are queued by the FPGA, separately for RX and TX. If the
+ *       FPGA's queue is full, retunes are held by libbladeRF, and submitted in
+ *       order as earlier retunes occur. This allows an entire hop pattern to
+ *       be scheduled at once. Retunes held by libbladeRF are discarded by
+ *       bladerf_cancel_scheduled_retunes() and bladerf_close().
+ *
+ * @note Quick tune parameters are validated when the retune is submitted to
+ *       the FPGA. On the bladeRF 2.0 micro, the quick tune profile of a held
+ *       retune must not be reassigned before then; see
+ *       bladerf_get_quick_tune().
  *
- * @note If the underlying queue of scheduled retune requests becomes full, \ref
- *       BLADERF_ERR_QUEUE_FULL will be returned. In this case, it should be
- *       possible to schedule a retune after the timestamp of one of the earlier
- *       requests occurs.
-
  * @note NULL quick_tune parameters are not supported by the bladeRF 2.0 micro.
+ *
+ * @note On the bladeRF x40/x115, if a DC calibration table is loaded, its
+ *       correction values for the new frequency are applied by the FPGA
+ *       along with the retune, using those bundled with `quick_tune` by
+ *       bladerf_get_quick_tune() or bladerf_build_hop_set() when available.
+ *       This requires FPGA v0.16.0 or later, and a timestamp below 2^48.
+ *       Otherwise, the correction values are only applied by
+ *       bladerf_set_frequency().
  */
 API_EXPORT
 int CALL_CONV bladerf_schedule_retune(struct bladerf *dev,
@@ -1893,6 +1918,9 @@ int CALL_CONV bladerf_schedule_retune(struct bladerf *dev,
 /**
  * Cancel all pending scheduled retune operations for the specified channel.
  *
+ * As scheduled retunes are queued per direction, this cancels the retunes of
+ * all channels of the same direction.
+ *
  * This will be done automatically during bladerf_close() to ensure that
  * previously queued retunes do not continue to occur after closing and then
  * later re-opening a device.
@@ -1917,6 +1945,14 @@ int CALL_CONV bladerf_cancel_scheduled_retunes(struct bladerf *dev,
  *       and should be "refreshed" if planning to use the "quick retune"
  *       functionality over a long period of time.
  *
+ * On the bladeRF 2.0 micro, quick tune parameters refer to fast lock profiles
+ * stored in the FPGA. These are managed as a cache keyed by frequency and RF
+ * port: requesting parameters for a frequency that already has a profile
+ * returns that profile, and once all profiles are in use, the least recently
+ * used one is reassigned. Parameters that refer to a reassigned profile are
+ * rejected by bladerf_schedule_retune() with ::BLADERF_ERR_INVAL, and must be
+ * fetched again. See bladerf_get_quick_tune_stats().
+ *
  * @pre bladerf_set_frequency() or bladerf_schedule_retune() have previously
  *      been used to retune to the desired frequency.
  *
@@ -1950,6 +1986,153 @@ API_EXPORT
 int bladerf_print_quick_tune(struct bladerf *dev,
                              const struct bladerf_quick_tune *qt);
 
+/**
+ * Quick tune profile cache statistics
+ *
+ * @see bladerf_get_quick_tune_stats()
+ */
+struct bladerf_quick_tune_stats {
+    uint64_t hits;          /**< Requests served by an existing profile */
+    uint64_t misses;        /**< Requests that stored a new profile */
+    uint64_t evictions;     /**< Profiles reassigned to a new frequency */
+    unsigned int profiles;  /**< Number of profiles currently in use */
+    unsigned int capacity;  /**< Maximum number of profiles */
+};
+
+/**
+ * Retrieve statistics for the quick tune profile cache of a direction
+ *
+ * On the bladeRF1, these describe the VCOCAP cache used when tuning from the
+ * host. Hits are cached values that were verified and used as-is, and
+ * evictions are cached values that had to be searched for again.
+ *
+ * @note supported devices: bladeRF1, bladeRF2
+ *
+ * @param       dev         Device handle
+ * @param[in]   dir         Direction
+ * @param[out]  stats       Updated with the current statistics
+ *
+ * @return 0 on success, ::BLADERF_ERR_UNSUPPORTED if the device does not use
+ *         a profile cache, or value from \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV bladerf_get_quick_tune_stats(
+    struct bladerf *dev,
+    bladerf_direction dir,
+    struct bladerf_quick_tune_stats *stats);
+
+/**
+ * Discard all cached quick tune profiles of a direction, and reset its
+ * statistics
+ *
+ * Previously retrieved quick tune parameters for this direction become
+ * invalid. This may be used to "refresh" profiles after a change in the
+ * operating environment. On the bladeRF1, this discards the cached VCOCAP
+ * values, and previously retrieved quick tune parameters remain valid.
+ *
+ * @note supported devices: bladeRF1, bladeRF2
+ *
+ * @param       dev         Device handle
+ * @param[in]   dir         Direction
+ *
+ * @return 0 on success, ::BLADERF_ERR_UNSUPPORTED if the device does not use
+ *         a profile cache, or value from \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV bladerf_clear_quick_tune_cache(struct bladerf *dev,
+                                             bladerf_direction dir);
+
+/**
+ * Build quick tune parameters for a set of hop frequencies
+ *
+ * This is equivalent to calling bladerf_set_frequency() and
+ * bladerf_get_quick_tune() for each of the provided frequencies, but is
+ * considerably faster for large hop sets.
+ *
+ * On the bladeRF x40/x115, tuning parameters are calculated on the host and
+ * the VCOCAP search for each frequency is seeded with the result of its
+ * neighbor. When the FPGA tuning mode is in use, each search is performed
+ * by the FPGA in a single request.
+ *
+ * On the bladeRF 2.0 micro, frequencies that already have a cached quick tune
+ * profile are not retuned. The number of frequencies may not exceed the
+ * capacity of the quick tune profile cache; see
+ * bladerf_get_quick_tune_stats().
+ *
+ * The channel is retuned to each of the provided frequencies in the process,
+ * and then restored to its original frequency.
+ *
+ * @param       dev             Device handle
+ * @param[in]   ch              Channel
+ * @param[in]   frequencies     Hop set frequencies, in Hz
+ * @param[in]   n               Number of entries in `frequencies`
+ * @param[out]  quick_tunes     Quick tune parameters. Entry `i` corresponds
+ *                              to `frequencies[i]`, and must have room for
+ *                              `n` entries.
+ *
+ * @return 0 on success, ::BLADERF_ERR_RANGE if a frequency is out of range,
+ *         or value from \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV bladerf_build_hop_set(struct bladerf *dev,
+                                    bladerf_channel ch,
+                                    const bladerf_frequency *frequencies,
+                                    unsigned int n,
+                                    struct bladerf_quick_tune *quick_tunes);
+
+/**
+ * Write a hop set built by bladerf_build_hop_set() to a file
+ *
+ * @param       dev             Device handle
+ * @param[in]   filename        File to write to
+ * @param[in]   ch              Channel the hop set was built for
+ * @param[in]   frequencies     Hop set frequencies, in Hz
+ * @param[in]   quick_tunes     Quick tune parameters for `frequencies`
+ * @param[in]   n               Number of hop set entries
+ *
+ * @return 0 on success, value from \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV bladerf_save_hop_set(struct bladerf *dev,
+                                   const char *filename,
+                                   bladerf_channel ch,
+                                   const bladerf_frequency *frequencies,
+                                   const struct bladerf_quick_tune *quick_tunes,
+                                   unsigned int n);
+
+/**
+ * Read a hop set written by bladerf_save_hop_set()
+ *
+ * Stored bladeRF x40/x115 quick tune parameters are used as-is if the file
+ * was created with this device. Otherwise, including for all bladeRF 2.0 micro
+ * hop sets (whose profiles do not persist across power cycles), the
+ * parameters are rebuilt from the stored frequencies via
+ * bladerf_build_hop_set().
+ *
+ * @param       dev             Device handle
+ * @param[in]   filename        File to read from
+ * @param[in]   ch              Channel to load the hop set for. This must
+ *                              match the channel the file was created for.
+ * @param[out]  frequencies     Hop set frequencies, in Hz. If NULL, along with
+ *                              `quick_tunes`, only `n` is updated.
+ * @param[out]  quick_tunes     Quick tune parameters for `frequencies`
+ * @param[in]   max             Number of entries `frequencies` and
+ *                              `quick_tunes` have room for
+ * @param[out]  n               Number of entries in the hop set
+ *
+ * @return 0 on success, ::BLADERF_ERR_INVAL if the file is not a hop set for
+ *         `ch` or contains more than `max` entries, or value from
+ *         \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV bladerf_load_hop_set(struct bladerf *dev,
+                                   const char *filename,
+                                   bladerf_channel ch,
+                                   bladerf_frequency *frequencies,
+                                   struct bladerf_quick_tune *quick_tunes,
+                                   unsigned int max,
+                                   unsigned int *n);
+
 /** @} (End of FN_SCHEDULED_TUNING) */
 
 /**
@@ -2050,8 +2233,246 @@ int CALL_CONV bladerf_get_correction(struct bladerf *dev,
                                      bladerf_correction corr,
                                      bladerf_correction_value *value);
 
+/**
+ * A complete set of corrections for a channel
+ *
+ * @see bladerf_set_correction_profile()
+ * @see bladerf_get_correction_profile()
+ */
+struct bladerf_correction_profile {
+    bladerf_correction_value dcoff_i; /**< ::BLADERF_CORR_DCOFF_I value */
+    bladerf_correction_value dcoff_q; /**< ::BLADERF_CORR_DCOFF_Q value */
+    bladerf_correction_value phase;   /**< ::BLADERF_CORR_PHASE value */
+    bladerf_correction_value gain;    /**< ::BLADERF_CORR_GAIN value */
+};
+
+/**
+ * Apply all of a channel's corrections at once
+ *
+ * This has the same effect as calling bladerf_set_correction() for each
+ * correction, but coalesces the underlying register accesses. On the bladeRF2,
+ * with FPGA v0.16.0 or later, the corrections are applied by the FPGA in a
+ * single request.
+ *
+ * @param       dev         Device handle
+ * @param[in]   ch          Channel
+ * @param[in]   profile     Corrections to apply
+ *
+ * @return 0 on success, value from \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV bladerf_set_correction_profile(
+    struct bladerf *dev,
+    bladerf_channel ch,
+    const struct bladerf_correction_profile *profile);
+
+/**
+ * Obtain the current values of all of a channel's corrections
+ *
+ * @param       dev         Device handle
+ * @param[in]   ch          Channel
+ * @param[out]  profile     Current corrections
+ *
+ * @return 0 on success, value from \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV bladerf_get_correction_profile(
+    struct bladerf *dev,
+    bladerf_channel ch,
+    struct bladerf_correction_profile *profile);
+
+/**
+ * Associate corrections with a quick tune, so that they are applied whenever
+ * the quick tune is used with bladerf_schedule_retune().
+ *
+ * The corrections are applied by the FPGA as part of the retune, including
+ * retunes scheduled for a future timestamp, so they take effect at the same
+ * time as the new frequency.
+ *
+ * The corrections are stored with the quick tune's fast lock profile, and are
+ * discarded if that profile is reassigned. On the bladeRF2, the corrections of
+ * both channels in a direction may be associated with the same quick tune.
+ *
+ * @note On the bladeRF1, quick tunes obtained via a loaded DC calibration table
+ *       already include the table's DC corrections, and this function is not
+ *       supported.
+ *
+ * Supported devices:
+ *   - bladeRF2, with FPGA v0.16.0 or later
+ *
+ * @param       dev         Device handle
+ * @param[in]   ch          Channel
+ * @param[in]   quick_tune  Quick tune, obtained via bladerf_get_quick_tune()
+ * @param[in]   profile     Corrections to apply, or NULL to remove any
+ *                          previously associated corrections
+ *
+ * @return 0 on success, ::BLADERF_ERR_INVAL if the quick tune's fast lock
+ *         profile has since been reassigned, ::BLADERF_ERR_UNSUPPORTED if the
+ *         device or FPGA does not support this, or value from \ref RETCODES
+ *         list on failure
+ */
+API_EXPORT
+int CALL_CONV bladerf_set_quick_tune_correction_profile(
+    struct bladerf *dev,
+    bladerf_channel ch,
+    const struct bladerf_quick_tune *quick_tune,
+    const struct bladerf_correction_profile *profile);
+
 /** @} (End of FN_CORR) */
 
+/**
+ * @defgroup FN_CONTROL_QUEUE Asynchronous control
+ *
+ * This group provides a non-blocking alternative to the frequency, gain,
+ * bandwidth, sample rate and correction functions.
+ *
+ * Commands are placed on a per-device queue and return immediately. A worker
+ * thread, started on the first submission, performs them in submission order
+ * using the corresponding blocking function (e.g., bladerf_set_frequency()).
+ * Completion is reported via an optional callback and/or a handle that may be
+ * waited upon. This allows, for example, a streaming thread to request a gain
+ * change without stalling on the device's control path.
+ *
+ * These functions are thread-safe.
+ *
+ * @{
+ */
+
+/**
+ * Maximum number of commands that may be outstanding on a device at once
+ */
+#define BLADERF_CONTROL_QUEUE_LEN 64
+
+/**
+ * Operation performed by a queued control command
+ */
+typedef enum {
+    BLADERF_CONTROL_FREQUENCY,   /**< bladerf_set_frequency() */
+    BLADERF_CONTROL_GAIN,        /**< bladerf_set_gain() */
+    BLADERF_CONTROL_GAIN_MODE,   /**< bladerf_set_gain_mode() */
+    BLADERF_CONTROL_BANDWIDTH,   /**< bladerf_set_bandwidth() */
+    BLADERF_CONTROL_SAMPLE_RATE, /**< bladerf_set_sample_rate() */
+    BLADERF_CONTROL_CORRECTION   /**< bladerf_set_correction() */
+} bladerf_control_op;
+
+/**
+ * Control command description
+ *
+ * Only the member of `value` corresponding to `op` is used.
+ */
+struct bladerf_control_cmd {
+    bladerf_control_op op; /**< Operation to perform */
+    bladerf_channel ch;    /**< Channel to apply the operation to */
+
+    /** Value to apply */
+    union {
+        bladerf_frequency frequency;     /**< BLADERF_CONTROL_FREQUENCY */
+        bladerf_gain gain;               /**< BLADERF_CONTROL_GAIN */
+        bladerf_gain_mode gain_mode;     /**< BLADERF_CONTROL_GAIN_MODE */
+        bladerf_bandwidth bandwidth;     /**< BLADERF_CONTROL_BANDWIDTH */
+        bladerf_sample_rate sample_rate; /**< BLADERF_CONTROL_SAMPLE_RATE */
+
+        /** BLADERF_CONTROL_CORRECTION */
+        struct {
+            bladerf_correction corr;        /**< Correction type */
+            bladerf_correction_value value; /**< Value to apply */
+        } correction;
+    } value;
+};
+
+/**
+ * Handle to a submitted control command
+ *
+ * @see bladerf_control_wait()
+ */
+struct bladerf_control_handle;
+
+/**
+ * Control command completion callback
+ *
+ * This is called from the device's control worker thread after the command
+ * has been performed. The device handle lock is not held at this point, so
+ * blocking libbladeRF functions may be called. However, doing so delays any
+ * commands queued behind this one.
+ *
+ * This callback must not call bladerf_control_flush() or
+ * bladerf_control_wait(), as these would wait on the calling thread.
+ *
+ * @param       dev         Device handle
+ * @param[in]   cmd         Command that was performed
+ * @param[in]   status      Return value of the underlying function
+ * @param       user_data   User data provided to bladerf_control_submit()
+ */
+typedef void (*bladerf_control_cb)(struct bladerf *dev,
+                                   const struct bladerf_control_cmd *cmd,
+                                   int status,
+                                   void *user_data);
+
+/**
+ * Queue a control command for asynchronous execution
+ *
+ * This function does not acquire the device handle lock, and does not wait
+ * for any device I/O.
+ *
+ * @param       dev         Device handle
+ * @param[in]   cmd         Command to perform. This is copied, and need not
+ *                          remain valid after this call returns.
+ * @param[in]   cb          Optional completion callback. May be NULL.
+ * @param       user_data   Data passed to `cb`
+ * @param[out]  handle      If non-NULL, updated with a handle that must later
+ *                          be passed to bladerf_control_wait() to release it.
+ *                          If NULL, the command's resources are released
+ *                          automatically upon completion.
+ *
+ * @return 0 on success,
+ *         ::BLADERF_ERR_QUEUE_FULL if ::BLADERF_CONTROL_QUEUE_LEN commands are
+ *         already outstanding,
+ *         ::BLADERF_ERR_INVAL for an invalid `op`,
+ *         or value from \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV bladerf_control_submit(struct bladerf *dev,
+                                     const struct bladerf_control_cmd *cmd,
+                                     bladerf_control_cb cb,
+                                     void *user_data,
+                                     struct bladerf_control_handle **handle);
+
+/**
+ * Wait for a submitted control command to complete
+ *
+ * On success, `handle` is released and must not be used again. On timeout,
+ * `handle` remains valid and this function may be called again.
+ *
+ * @param       dev         Device handle
+ * @param       handle      Handle obtained from bladerf_control_submit()
+ * @param[in]   timeout_ms  Timeout, in milliseconds. 0 implies no timeout.
+ * @param[out]  cmd_status  Updated with the return value of the command's
+ *                          underlying function. May be NULL.
+ *
+ * @return 0 once the command has completed, ::BLADERF_ERR_TIMEOUT on timeout,
+ *         or value from \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV bladerf_control_wait(struct bladerf *dev,
+                                   struct bladerf_control_handle *handle,
+                                   unsigned int timeout_ms,
+                                   int *cmd_status);
+
+/**
+ * Wait for all previously submitted control commands to complete
+ *
+ * @param       dev         Device handle
+ * @param[in]   timeout_ms  Timeout, in milliseconds. 0 implies no timeout.
+ *
+ * @return 0 on success, ::BLADERF_ERR_TIMEOUT on timeout,
+ *         or value from \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV bladerf_control_flush(struct bladerf *dev,
+                                    unsigned int timeout_ms);
+
+/** @} (End of FN_CONTROL_QUEUE) */
+
 /** @} (End of FN_CHANNEL) */
 
 /**
@@ -2596,6 +3017,269 @@ int CALL_CONV bladerf_deinterleave_stream_buffer(bladerf_channel_layout layout,
                                                  unsigned int buffer_size,
                                                  void *samples);
 
+/**
+ * Interleaves contiguous blocks of samples in preparation for MIMO TX, using a
+ * caller-supplied scratch buffer.
+ *
+ * This behaves as bladerf_interleave_stream_buffer(), but rather than
+ * allocating a temporary buffer on each call, it uses `scratch`. Callers
+ * processing many buffers may allocate one scratch buffer and reuse it.
+ *
+ * @param[in]   layout        Stream direction and layout
+ * @param[in]   format        Data format to use
+ * @param[in]   buffer_size   The size of the buffer, in samples. Note that this
+ *                            is the entire buffer, not just a single channel.
+ * @param       samples       Buffer to process. The user is responsible for
+ *                            ensuring this buffer contains exactly
+ *                            `buffer_size` samples.
+ * @param       scratch       Scratch buffer with room for `buffer_size`
+ *                            samples. This must not overlap `samples`, and its
+ *                            contents are undefined afterwards.
+ *
+ * @return 0 on success, value from \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV
+    bladerf_interleave_stream_buffer_scratch(bladerf_channel_layout layout,
+                                             bladerf_format format,
+                                             unsigned int buffer_size,
+                                             void *samples,
+                                             void *scratch);
+
+/**
+ * Deinterleaves samples into contiguous blocks after MIMO RX, using a
+ * caller-supplied scratch buffer.
+ *
+ * This behaves as bladerf_deinterleave_stream_buffer(), but rather than
+ * allocating a temporary buffer on each call, it uses `scratch`.
+ *
+ * @param[in]   layout          Stream direction and layout
+ * @param[in]   format          Data format to use
+ * @param[in]   buffer_size     The size of the buffer, in samples. Note that
+ *                              this is the entire buffer, not just a single
+ *                              channel.
+ * @param       samples         Buffer to process. The user is responsible for
+ *                              ensuring this buffer contains exactly
+ *                              `buffer_size` samples.
+ * @param       scratch         Scratch buffer with room for `buffer_size`
+ *                              samples. This must not overlap `samples`, and
+ *                              its contents are undefined afterwards.
+ *
+ * @return 0 on success, value from \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV
+    bladerf_deinterleave_stream_buffer_scratch(bladerf_channel_layout layout,
+                                               bladerf_format format,
+                                               unsigned int buffer_size,
+                                               void *samples,
+                                               void *scratch);
+
+/**
+ * Interleaves separate per-channel sample arrays into a buffer for MIMO TX.
+ *
+ * This is the out-of-place counterpart to bladerf_interleave_stream_buffer().
+ * Rather than rearranging a buffer of concatenated channels in place, the
+ * samples for each channel are read from their own array and written,
+ * interleaved, to `samples`. No memory is allocated by this function.
+ *
+ * If a metadata format is specified, the first 16 bytes of `samples` are left
+ * untouched, and each channel array must provide the correspondingly reduced
+ * number of samples.
+ *
+ * @param[in]   layout        Stream direction and layout
+ * @param[in]   format        Data format to use
+ * @param[in]   buffer_size   The size of the output buffer, in samples. Note
+ *                            that this is the entire buffer, not just a single
+ *                            channel.
+ * @param[in]   channels      Array of pointers to the per-channel samples, one
+ *                            per channel in `layout`. Each must contain
+ *                            `buffer_size / num_channels` samples (less any
+ *                            metadata).
+ * @param[out]  samples       Output buffer of `buffer_size` samples. This
+ *                            must not overlap any of the `channels` arrays.
+ *
+ * @return 0 on success, value from \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV
+    bladerf_interleave_stream_buffer_from_channels(bladerf_channel_layout layout,
+                                                   bladerf_format format,
+                                                   unsigned int buffer_size,
+                                                   const void *const *channels,
+                                                   void *samples);
+
+/**
+ * Deinterleaves a buffer received via MIMO RX into separate per-channel
+ * sample arrays.
+ *
+ * This is the out-of-place counterpart to
+ * bladerf_deinterleave_stream_buffer(), and avoids both the memory allocation
+ * and the extra copy that the in-place version requires.
+ *
+ * If a metadata format is specified, the first 16 bytes of `samples` are
+ * skipped.
+ *
+ * @param[in]   layout          Stream direction and layout
+ * @param[in]   format          Data format to use
+ * @param[in]   buffer_size     The size of the input buffer, in samples. Note
+ *                              that this is the entire buffer, not just a
+ *                              single channel.
+ * @param[in]   samples         Interleaved buffer of `buffer_size` samples
+ * @param[out]  channels        Array of pointers to the per-channel output
+ *                              arrays, one per channel in `layout`. Each must
+ *                              have room for `buffer_size / num_channels`
+ *                              samples, and must not overlap `samples`.
+ *
+ * @return 0 on success, value from \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV
+    bladerf_deinterleave_stream_buffer_to_channels(bladerf_channel_layout layout,
+                                                   bladerf_format format,
+                                                   unsigned int buffer_size,
+                                                   const void *samples,
+                                                   void *const *channels);
+
+/**
+ * Host-side sample representations supported by bladerf_convert_from_format()
+ * and bladerf_convert_to_format().
+ *
+ * All are interleaved I/Q pairs, with I first.
+ */
+typedef enum {
+    /**
+     * Single-precision floating point, where [-1.0, 1.0) is full scale
+     */
+    BLADERF_HOST_FORMAT_CF32,
+
+    /**
+     * Double-precision floating point, where [-1.0, 1.0) is full scale
+     */
+    BLADERF_HOST_FORMAT_CF64,
+
+    /**
+     * Signed 16-bit integers in Q15 format, where [-32768, 32768) represents
+     * [-1.0, 1.0)
+     */
+    BLADERF_HOST_FORMAT_CI16,
+} bladerf_host_format;
+
+/**
+ * Options and state for sample format conversions.
+ *
+ * A zero-initialized structure performs a plain format conversion. The same
+ * structure should be passed to successive calls on a stream so that the DC
+ * estimate carries over from one buffer to the next.
+ */
+struct bladerf_conversion {
+    /**
+     * Gain applied to the normalized samples. A value of 0 is treated as 1.0.
+     */
+    float scale;
+
+    /**
+     * Subtract the running DC estimate (`dc_i`, `dc_q`) from each sample,
+     * and update the estimate from the mean of the converted buffer.
+     *
+     * The estimate is applied before it is updated, so the first buffer of a
+     * stream is only corrected by whatever initial estimate is supplied.
+     */
+    bool remove_dc;
+
+    /**
+     * Weight, in (0, 1], given to each buffer's mean when updating the DC
+     * estimate. Smaller values track more slowly but are less noisy. A value
+     * of 0 is treated as 1.0, i.e., the previous buffer's mean is used.
+     */
+    float dc_alpha;
+
+    /**
+     * Running DC estimate for the I and Q components, in normalized units
+     * (i.e., before `scale` is applied).
+     */
+    float dc_i;
+    float dc_q; /**< See `dc_i` */
+
+    /**
+     * Only used with the metadata formats. When non-zero, the device-format
+     * buffer is treated as a series of messages of this many bytes, each
+     * beginning with a 16-byte metadata header, as is the case for buffers
+     * passed to the asynchronous stream callback. Headers are skipped when
+     * reading, and left untouched when writing. Messages are 2048 bytes on a
+     * SuperSpeed connection and 1024 bytes on a HighSpeed connection; see
+     * bladerf_device_speed().
+     *
+     * When 0, the buffer is assumed to contain samples only, as is the case
+     * for sample buffers used with bladerf_sync_rx() and bladerf_sync_tx().
+     */
+    unsigned int msg_size;
+};
+
+/**
+ * Convert samples in a device format to a host format, in a single pass.
+ *
+ * Device samples are normalized per their format (e.g., 2048 represents 1.0
+ * for ::BLADERF_FORMAT_SC16_Q11), DC-corrected and scaled as specified by
+ * `conv`, and written to `output` in the requested host format. Integer
+ * outputs are rounded to the nearest value and saturated.
+ *
+ * Where the host CPU supports it, SIMD implementations are selected at
+ * runtime.
+ *
+ * @param[in]   format        Device format of `samples`.
+ *                            ::BLADERF_FORMAT_PACKET_META is not supported.
+ * @param[in]   samples       Samples to convert
+ * @param[in]   num_samples   Size of `samples`, in samples, including any
+ *                            space occupied by metadata headers
+ * @param[in]   host_format   Format to convert to
+ * @param[out]  output        Output buffer, with room for `num_samples`
+ *                            samples of `host_format`. This must not overlap
+ *                            `samples`.
+ * @param       conv          Conversion options and DC estimate state. May be
+ *                            NULL for a plain format conversion.
+ *
+ * @return Number of samples written to `output` on success, or a value from
+ *         \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV bladerf_convert_from_format(bladerf_format format,
+                                          const void *samples,
+                                          unsigned int num_samples,
+                                          bladerf_host_format host_format,
+                                          void *output,
+                                          struct bladerf_conversion *conv);
+
+/**
+ * Convert samples in a host format to a device format, in a single pass.
+ *
+ * This is the inverse of bladerf_convert_from_format(). Outputs are rounded
+ * to the nearest value and saturated to the range permitted by `format`
+ * (e.g., [-2048, 2047] for ::BLADERF_FORMAT_SC16_Q11).
+ *
+ * @param[in]   host_format   Format of `input`
+ * @param[in]   input         Samples to convert
+ * @param[in]   format        Device format to convert to.
+ *                            ::BLADERF_FORMAT_PACKET_META is not supported.
+ * @param[out]  samples       Output buffer. This must not overlap `input`.
+ * @param[in]   num_samples   Size of `samples`, in samples, including any
+ *                            space occupied by metadata headers. `input` must
+ *                            provide one sample for each of the remaining
+ *                            sample slots.
+ * @param       conv          Conversion options and DC estimate state. May be
+ *                            NULL for a plain format conversion.
+ *
+ * @return Number of samples read from `input` on success, or a value from
+ *         \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV bladerf_convert_to_format(bladerf_host_format host_format,
+                                        const void *input,
+                                        bladerf_format format,
+                                        void *samples,
+                                        unsigned int num_samples,
+                                        struct bladerf_conversion *conv);
+
 /** @} (End of STREAMING_FORMAT) */
 
 /**
@@ -2827,6 +3511,332 @@ int CALL_CONV bladerf_sync_rx(struct bladerf *dev,
                               struct bladerf_metadata *metadata,
                               unsigned int timeout_ms);
 
+/**
+ * Obtain direct access to received IQ samples, without copying them.
+ *
+ * This is a zero-copy alternative to bladerf_sync_rx(). Rather than copying
+ * samples into a caller-provided array, this function provides a pointer to
+ * the next contiguous block of samples held in the synchronous interface's
+ * internal buffers. These samples may be read (or modified in place) until
+ * they are returned via bladerf_sync_rx_release().
+ *
+ * The block provided by this function is:
+ *  - ::BLADERF_FORMAT_SC16_Q11 and ::BLADERF_FORMAT_SC8_Q7: The remainder of
+ *      the current stream buffer.
+ *  - ::BLADERF_FORMAT_SC16_Q11_META and ::BLADERF_FORMAT_SC8_Q7_META: The
+ *      remainder of the current message. bladerf_metadata::timestamp is
+ *      updated with the timestamp of the first sample, and
+ *      bladerf_metadata::status with the message's hardware flags. The
+ *      ::BLADERF_META_FLAG_RX_NOW behavior is always used. If samples were
+ *      dropped between the previously released samples and these,
+ *      ::BLADERF_META_STATUS_OVERRUN is set in bladerf_metadata::status.
+ *  - ::BLADERF_FORMAT_PACKET_META: The payload of the current packet.
+ *
+ * While samples are held, the underlying buffer is unavailable to the stream.
+ * Holding samples for an extended period of time may therefore result in
+ * overruns, just as with long delays between bladerf_sync_rx() calls.
+ *
+ * This function may be intermixed with bladerf_sync_rx(), provided that any
+ * acquired samples have been released first.
+ *
+ * @pre A bladerf_sync_config() call has been to configure the device for
+ *      synchronous data transfer.
+ *
+ * @param       dev         Device handle
+ * @param[out]  samples     Updated to point to the first available sample
+ * @param[out]  num_samples Updated with the number of samples available at
+ *                          `samples`
+ * @param[out]  metadata    Sample metadata. This must be provided when using
+ *                          a metadata format, but may be NULL otherwise.
+ * @param[in]   timeout_ms  Timeout (milliseconds) for this call to complete.
+ *                          Zero implies "infinite."
+ *
+ * @return 0 on success,
+ *         ::BLADERF_ERR_INVAL if previously acquired samples have not been
+ *         released, or a value from \ref RETCODES list on failures.
+ */
+API_EXPORT
+int CALL_CONV bladerf_sync_rx_acquire(struct bladerf *dev,
+                                      void **samples,
+                                      unsigned int *num_samples,
+                                      struct bladerf_metadata *metadata,
+                                      unsigned int timeout_ms);
+
+/**
+ * Return samples obtained via bladerf_sync_rx_acquire().
+ *
+ * Only the first `num_samples` of the acquired samples are consumed. Any
+ * remaining samples will be provided by the next call to
+ * bladerf_sync_rx_acquire() or bladerf_sync_rx(). With the
+ * ::BLADERF_FORMAT_PACKET_META format, the entire packet is always consumed.
+ *
+ * @param       dev         Device handle
+ * @param[in]   num_samples Number of samples consumed. This must not exceed
+ *                          the number of samples that were acquired.
+ *
+ * @return 0 on success, value from \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV bladerf_sync_rx_release(struct bladerf *dev,
+                                      unsigned int num_samples);
+
+/**
+ * Obtain direct access to buffer space for IQ samples to transmit, without
+ * copying them.
+ *
+ * This is a zero-copy alternative to bladerf_sync_tx(). Rather than copying
+ * samples from a caller-provided array, this function provides a pointer into
+ * the synchronous interface's internal buffers, which the caller may write
+ * samples into directly. These samples are then submitted via
+ * bladerf_sync_tx_commit().
+ *
+ * The space provided by this function is the remainder of the current stream
+ * buffer, or of the current message when using the
+ * ::BLADERF_FORMAT_SC16_Q11_META or ::BLADERF_FORMAT_SC8_Q7_META formats.
+ *
+ * When using ::BLADERF_FORMAT_SC16_Q11_META, the
+ * ::BLADERF_META_FLAG_TX_BURST_START and ::BLADERF_META_FLAG_TX_NOW flags are
+ * handled by this function, while ::BLADERF_META_FLAG_TX_BURST_END must be
+ * passed to bladerf_sync_tx_commit(). ::BLADERF_META_FLAG_TX_UPDATE_TIMESTAMP
+ * is not supported by this function.
+ *
+ * This function may be intermixed with bladerf_sync_tx(), provided that any
+ * acquired space has been committed first.
+ *
+ * @pre A bladerf_sync_config() call has been to configure the device for
+ *      synchronous data transfer.
+ *
+ * @param       dev         Device handle
+ * @param[out]  samples     Updated to point to where samples may be written
+ * @param[out]  num_samples Updated with the number of samples that may be
+ *                          written to `samples`
+ * @param[in]   metadata    Sample metadata. This must be provided when using
+ *                          the ::BLADERF_FORMAT_SC16_Q11_META format, but may
+ *                          be NULL otherwise.
+ * @param[in]   timeout_ms  Timeout (milliseconds) for this call to complete.
+ *                          Zero implies "infinite."
+ *
+ * @return 0 on success,
+ *         ::BLADERF_ERR_INVAL if previously acquired space has not been
+ *         committed, or a value from \ref RETCODES list on failures.
+ */
+API_EXPORT
+int CALL_CONV bladerf_sync_tx_acquire(struct bladerf *dev,
+                                      void **samples,
+                                      unsigned int *num_samples,
+                                      struct bladerf_metadata *metadata,
+                                      unsigned int timeout_ms);
+
+/**
+ * Commit samples written to the space obtained via bladerf_sync_tx_acquire().
+ *
+ * As with bladerf_sync_tx(), samples will only be sent to the FPGA when a
+ * buffer has been filled, or when a burst is ended via the
+ * ::BLADERF_META_FLAG_TX_BURST_END flag.
+ *
+ * @param       dev         Device handle
+ * @param[in]   num_samples Number of samples written. This must not exceed
+ *                          the number of samples that were acquired.
+ * @param[in]   metadata    Sample metadata. May be NULL if no flags are
+ *                          required.
+ *
+ * @return 0 on success, value from \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV bladerf_sync_tx_commit(struct bladerf *dev,
+                                     unsigned int num_samples,
+                                     struct bladerf_metadata *metadata);
+
+/**
+ * Synchronous stream statistics
+ *
+ * These counters are intended to aid in sizing the `num_buffers` and
+ * `num_transfers` parameters of bladerf_sync_config(), and to detect dropped
+ * samples without enabling verbose logging. They are reset by each call to
+ * bladerf_sync_config().
+ *
+ * Fields that are not applicable to a stream's direction are always zero.
+ */
+struct bladerf_stream_stats {
+    /**
+     * Number of buffers that have completed transfer over USB
+     */
+    uint64_t buffers_transferred;
+
+    /**
+     * RX: Number of occasions on which a full buffer could not be handed to
+     * the caller because all of the buffers were still waiting to be read.
+     * Samples are dropped on each of these occasions.
+     */
+    uint64_t overruns;
+
+    /**
+     * TX: Number of occasions on which every queued buffer had been
+     * transmitted and no further samples were available. For the metadata
+     * formats, this also occurs at the end of each burst.
+     */
+    uint64_t underruns;
+
+    /**
+     * RX: Number of buffers whose contents were discarded and resubmitted
+     * while recovering from an overrun.
+     */
+    uint64_t resubmissions;
+
+    /**
+     * Number of transfers that completed with fewer bytes than requested
+     */
+    uint64_t short_transfers;
+
+    /**
+     * RX: Number of timestamp discontinuities detected in received metadata.
+     * Each of these results in ::BLADERF_META_STATUS_OVERRUN being reported.
+     */
+    uint64_t timestamp_discontinuities;
+
+    /**
+     * Longest time spent handling a single transfer completion, in
+     * nanoseconds
+     */
+    uint64_t max_callback_latency_ns;
+
+    /**
+     * Largest number of buffers observed to be in use at once. For RX, these
+     * are the buffers being filled by the device, plus full buffers awaiting
+     * bladerf_sync_rx(). For TX, these are the buffers filled by
+     * bladerf_sync_tx() that are awaiting or undergoing transmission.
+     *
+     * A value equal to `num_buffers` indicates that the buffers were
+     * exhausted at some point.
+     */
+    unsigned int queue_high_water;
+
+    /**
+     * Number of buffers configured via bladerf_sync_config()
+     */
+    unsigned int num_buffers;
+};
+
+/**
+ * Retrieve the statistics of a synchronous stream
+ *
+ * This may be called from a thread other than the one performing
+ * bladerf_sync_rx() or bladerf_sync_tx() calls, without blocking them.
+ *
+ * @pre A bladerf_sync_config() call has been made to configure the specified
+ *      direction for synchronous data transfer.
+ *
+ * @param       dev         Device handle
+ * @param[in]   dir         Stream direction
+ * @param[out]  stats       Updated with a snapshot of the stream statistics
+ *
+ * @return 0 on success,
+ *         ::BLADERF_ERR_INVAL if the synchronous interface has not been
+ *         configured for the specified direction, or a value from
+ *         \ref RETCODES list on failure.
+ */
+API_EXPORT
+int CALL_CONV bladerf_get_stream_stats(struct bladerf *dev,
+                                       bladerf_direction dir,
+                                       struct bladerf_stream_stats *stats);
+
+/**
+ * Scheduling policy of a stream's worker thread
+ */
+typedef enum {
+    /** Leave the policy and priority inherited from the creating thread */
+    BLADERF_THREAD_SCHED_DEFAULT = 0,
+
+    /** Real-time, first-in first-out scheduling (`SCHED_FIFO`) */
+    BLADERF_THREAD_SCHED_FIFO,
+
+    /** Real-time, round-robin scheduling (`SCHED_RR`) */
+    BLADERF_THREAD_SCHED_RR,
+} bladerf_thread_sched;
+
+/**
+ * Placement and scheduling of the thread servicing a synchronous stream
+ *
+ * The synchronous interface creates one worker thread per direction. This
+ * thread also handles USB events for the stream, so its timely execution is
+ * what keeps transfers queued with the device. Pinning it to an otherwise
+ * idle core and raising its priority can substantially reduce overruns and
+ * underruns on a loaded host.
+ *
+ * A zero-initialized structure leaves the thread unmodified.
+ */
+struct bladerf_stream_thread_config {
+    /** Pin the thread to the CPU specified by `cpu` */
+    bool pin_cpu;
+
+    /** Index of the CPU to pin the thread to, if `pin_cpu` is set */
+    unsigned int cpu;
+
+    /** Scheduling policy */
+    bladerf_thread_sched policy;
+
+    /**
+     * Real-time priority, used when `policy` is not
+     * ::BLADERF_THREAD_SCHED_DEFAULT. Zero selects the lowest real-time
+     * priority available for the policy.
+     */
+    int priority;
+};
+
+/**
+ * Configure the placement and scheduling of the worker thread used by the
+ * synchronous interface.
+ *
+ * If the synchronous interface is already configured for the specified
+ * direction, the settings are applied immediately. They are also applied
+ * each time bladerf_sync_config() creates the worker thread, in which case a
+ * failure to apply them causes bladerf_sync_config() to fail.
+ *
+ * Settings cannot be reverted on a running worker; to return to the default
+ * behavior, provide a zero-initialized structure and call
+ * bladerf_sync_config() again.
+ *
+ * Real-time scheduling generally requires elevated privileges (e.g.,
+ * `CAP_SYS_NICE` or an `rtprio` limit on Linux). CPU pinning is currently
+ * only supported on Linux.
+ *
+ * @note When using the \ref FN_STREAMING_ASYNC, USB events are handled in the
+ *       thread that calls bladerf_stream(). Its placement and scheduling are
+ *       left to the caller.
+ *
+ * @param       dev         Device handle
+ * @param[in]   dir         Stream direction
+ * @param[in]   config      Thread configuration
+ *
+ * @return 0 on success,
+ *         ::BLADERF_ERR_PERMISSION if the process lacks the privileges
+ *         required for the requested scheduling policy or priority,
+ *         ::BLADERF_ERR_UNSUPPORTED if the request is not supported on this
+ *         platform, ::BLADERF_ERR_INVAL for an invalid CPU or priority, or a
+ *         value from \ref RETCODES list on other failures. On failure, the
+ *         previous configuration is retained, although a running worker may
+ *         have been pinned before a scheduling failure occurred.
+ */
+API_EXPORT
+int CALL_CONV bladerf_set_stream_thread_config(
+    struct bladerf *dev,
+    bladerf_direction dir,
+    const struct bladerf_stream_thread_config *config);
+
+/**
+ * Get the worker thread configuration of the synchronous interface
+ *
+ * @param       dev         Device handle
+ * @param[in]   dir         Stream direction
+ * @param[out]  config      Updated with the current thread configuration
+ *
+ * @return 0 on success, value from \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV bladerf_get_stream_thread_config(
+    struct bladerf *dev,
+    bladerf_direction dir,
+    struct bladerf_stream_thread_config *config);
 
 /** @} (End of FN_STREAMING_SYNC) */
 
@@ -3110,6 +4120,103 @@ int CALL_CONV bladerf_get_stream_timeout(struct bladerf *dev,
                                          bladerf_direction dir,
                                          unsigned int *timeout);
 
+/**
+ * @defgroup BLADERF_STREAM_BUF Stream buffer allocation flags
+ *
+ * These flags control how the sample buffers of streams are allocated.
+ * See bladerf_set_stream_buffer_config().
+ *
+ * @{
+ */
+
+/**
+ * Do not allocate sample buffers from memory provided by the USB driver.
+ *
+ * By default, libbladeRF attempts to allocate sample buffers from memory
+ * that the USB driver can DMA to and from directly (e.g., via
+ * `libusb_dev_mem_alloc()` with libusb >= 1.0.21 on Linux), which avoids a
+ * copy of each transfer in the kernel. Host memory is used if this is not
+ * available, or if any of the other flags below are specified.
+ */
+#define BLADERF_STREAM_BUF_NO_DEVICE_MEM (1 << 0)
+
+/**
+ * Back sample buffers with 2 MiB huge pages.
+ *
+ * Explicitly reserved huge pages (e.g., `vm.nr_hugepages` on Linux) are used
+ * when available. Otherwise, transparent huge pages are requested for the
+ * allocation. Currently only supported on Linux.
+ */
+#define BLADERF_STREAM_BUF_HUGEPAGES (1 << 1)
+
+/**
+ * Lock sample buffers into memory, so that they may never be paged out.
+ *
+ * This may require elevated privileges or an increased `RLIMIT_MEMLOCK`.
+ */
+#define BLADERF_STREAM_BUF_MLOCK (1 << 2)
+
+/**
+ * Touch every page of the sample buffers when the stream is initialized,
+ * rather than taking page faults once samples start flowing.
+ */
+#define BLADERF_STREAM_BUF_PREFAULT (1 << 3)
+
+/**
+ * Bind sample buffers to the NUMA node specified by
+ * bladerf_stream_buffer_config::numa_node. Typically, this should be the node
+ * to which the USB host controller is attached. Currently only supported on
+ * Linux.
+ */
+#define BLADERF_STREAM_BUF_NUMA_NODE (1 << 4)
+
+/** @} (End of BLADERF_STREAM_BUF) */
+
+/**
+ * Stream buffer allocation settings
+ *
+ * A zero-initialized structure selects the default behavior.
+ */
+struct bladerf_stream_buffer_config {
+    /** Bitmask of \ref BLADERF_STREAM_BUF flags */
+    uint32_t flags;
+
+    /** NUMA node to bind buffers to, if ::BLADERF_STREAM_BUF_NUMA_NODE is
+     *  set */
+    unsigned int numa_node;
+};
+
+/**
+ * Configure how sample buffers are allocated for streams.
+ *
+ * This applies to streams subsequently created by bladerf_init_stream() and
+ * bladerf_sync_config(); existing streams are not affected. If the requested
+ * settings cannot be satisfied when a stream is created, stream creation
+ * fails.
+ *
+ * @param       dev         Device handle
+ * @param[in]   config      Buffer allocation settings
+ *
+ * @return 0 on success,
+ *         ::BLADERF_ERR_UNSUPPORTED if a requested option is not supported on
+ *         this platform, or a value from \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV bladerf_set_stream_buffer_config(
+    struct bladerf *dev, const struct bladerf_stream_buffer_config *config);
+
+/**
+ * Get the current stream buffer allocation settings
+ *
+ * @param       dev         Device handle
+ * @param[out]  config      Updated with the current settings
+ *
+ * @return 0 on success, value from \ref RETCODES list on failure
+ */
+API_EXPORT
+int CALL_CONV bladerf_get_stream_buffer_config(
+    struct bladerf *dev, struct bladerf_stream_buffer_config *config);
+
 /** @} (End of FN_STREAMING_ASYNC) */
 
 /** @} (End of STREAMING) */
@@ -3290,6 +4397,7 @@ typedef enum {
     BLADERF_IMAGE_TYPE_TX_IQ_CAL,    /**< TX IQ balance calibration table */
     BLADERF_IMAGE_TYPE_FPGA_A5,      /**< FPGA bitstream for A5 device */
     BLADERF_IMAGE_TYPE_GAIN_CAL,     /**< Gain calibration */
+    BLADERF_IMAGE_TYPE_HOP_SET,      /**< Quick tune hop set */
 } bladerf_image_type;
 
 /** Size of the magic signature at the beginning of bladeRF image files */
@@ -4222,6 +5330,10 @@ struct bladerf_gain_cal_tbl {
  * optimized gain settings across its frequency range. The operation is
  * protected by mutex locks to maintain thread safety.
  *
+ * Binary tables are verified against the SHA-256 digest they carry, and are
+ * used in place from a mapping of the file where possible. Binary tables
+ * written by earlier versions of libbladeRF are also accepted.
+ *
  * @param[in] dev          Pointer to the initialized bladeRF device.
  * @param[in] ch           The target channel (RX or TX) for gain calibration.
  * @param[in] cal_file_loc Path to the calibration file, either in CSV or binary
@@ -4300,6 +5412,39 @@ int CALL_CONV bladerf_enable_gain_calibration(struct bladerf *dev,
 API_EXPORT
 int CALL_CONV bladerf_get_gain_calibration(struct bladerf *dev, bladerf_channel ch, const struct bladerf_gain_cal_tbl **tbl);
 
+/**
+ * @brief Retrieves gain calibration corrections for a list of frequencies.
+ *
+ * Loaded calibration tables are resampled onto a uniform frequency grid, so
+ * each correction is obtained by interpolating between two adjacent points.
+ * This allows sweeping and scanning applications to compensate large numbers
+ * of frequencies without per-frequency overhead. The corrections are those
+ * applied by gain calibration: the compensated gain for a frequency is the
+ * gain target minus its correction.
+ *
+ * Frequencies below the start of the table use the correction at its start.
+ *
+ * @note This operation is thread-safe.
+ *
+ * @param[in]  dev          Non-NULL pointer to a bladeRF device.
+ * @param[in]  ch           Channel whose calibration table is used. The table
+ *                          need not be enabled.
+ * @param[in]  frequencies  Frequencies to retrieve corrections for (Hz)
+ * @param[in]  count        Number of entries in `frequencies`
+ * @param[out] corrections  Gain correction for each entry in `frequencies`
+ *                          (dB). This must have room for `count` values.
+ *
+ * @return 0 on success, BLADERF_ERR_UNEXPECTED if no calibration table is
+ * loaded for `ch`, BLADERF_ERR_RANGE if a frequency is beyond the end of the
+ * table, or other BLADERF_ERR_* codes for different failures.
+ */
+API_EXPORT
+int CALL_CONV bladerf_get_gain_corrections(struct bladerf *dev,
+                                           bladerf_channel ch,
+                                           const bladerf_frequency *frequencies,
+                                           unsigned int count,
+                                           double *corrections);
+
 /**
  * @brief Computes the gain target for a specified channel, incorporating
  * calibration corrections.
@@ -187,6 +187,10 @@ struct backend_fns {
     /* LMS6002D accessors */
     int (*lms_write)(struct bladerf *dev, uint8_t addr, uint8_t data);
     int (*lms_read)(struct bladerf *dev, uint8_t addr, uint8_t *data);
+    int (*lms_write_batch)(struct bladerf *dev, const uint8_t *addr,
+                           const uint8_t *data, size_t n);
+    int (*lms_read_batch)(struct bladerf *dev, const uint8_t *addr,
+                          uint8_t *data, size_t n);
 
     /* INA219 accessors */
     int (*ina219_write)(struct bladerf *dev, uint8_t addr, uint16_t data);
@@ -218,6 +222,12 @@ struct backend_fns {
                               uint8_t rffe_profile,
                               uint16_t nios_profile);
 
+    /* Nios I/Q correction writer, for the NIOS_PKT_16x64_TARGET_IQ_CORR
+     * sub-address and data layout */
+    int (*rffe_iq_corr_write)(struct bladerf *dev,
+                              uint16_t addr,
+                              uint64_t data);
+
     /* AD56X1 VCTCXO Trim DAC accessors */
     int (*ad56x1_vctcxo_trim_dac_write)(struct bladerf *dev, uint16_t value);
     int (*ad56x1_vctcxo_trim_dac_read)(struct bladerf *dev, uint16_t *value);
@@ -256,7 +266,14 @@ struct backend_fns {
                                 bool nonblock);
     void (*deinit_stream)(struct bladerf_stream *stream);
 
-    /* Schedule a frequency retune operation */
+    /* Optional. Allocate and free memory for stream buffers, which the
+     * backend can transfer samples to and from without copying. The memory
+     * must be freed before the device is closed. */
+    void *(*alloc_stream_mem)(struct bladerf *dev, size_t len);
+    void (*free_stream_mem)(struct bladerf *dev, void *mem, size_t len);
+
+    /* Schedule a frequency retune operation. If vcocap_result is non-NULL,
+     * it is updated with the VCOCAP value selected by an immediate retune. */
     int (*retune)(struct bladerf *dev,
                   bladerf_channel ch,
                   uint64_t timestamp,
@@ -266,7 +283,23 @@ struct backend_fns {
                   uint8_t vcocap,
                   bool low_band,
                   uint8_t xb_gpio,
-                  bool quick_tune);
+                  bool quick_tune,
+                  uint8_t *vcocap_result);
+
+    /* Schedule a frequency retune operation, after which the specified DC
+     * offset correction register values are written */
+    int (*retune_dc)(struct bladerf *dev,
+                     bladerf_channel ch,
+                     uint64_t timestamp,
+                     uint16_t nint,
+                     uint32_t nfrac,
+                     uint8_t freqsel,
+                     uint8_t vcocap,
+                     bool low_band,
+                     uint8_t xb_gpio,
+                     bool quick_tune,
+                     uint8_t dc_i,
+                     uint8_t dc_q);
 
     /* Schedule a frequency retune2 operation */
     int (*retune2)(struct bladerf *dev,
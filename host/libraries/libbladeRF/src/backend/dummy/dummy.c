@@ -249,6 +249,18 @@ static int dummy_lms_read(struct bladerf *dev, uint8_t addr, uint8_t *data)
     return 0;
 }
 
+static int dummy_lms_write_batch(struct bladerf *dev, const uint8_t *addr,
+                                 const uint8_t *data, size_t n)
+{
+    return 0;
+}
+
+static int dummy_lms_read_batch(struct bladerf *dev, const uint8_t *addr,
+                                uint8_t *data, size_t n)
+{
+    return 0;
+}
+
 static int dummy_ina219_write(struct bladerf *dev, uint8_t cmd, uint16_t data)
 {
     return 0;
@@ -305,6 +317,13 @@ static int dummy_rffe_fastlock_save(struct bladerf *dev,
     return 0;
 }
 
+static int dummy_rffe_iq_corr_write(struct bladerf *dev,
+                                    uint16_t addr,
+                                    uint64_t data)
+{
+    return 0;
+}
+
 static int dummy_ad56x1_vctcxo_trim_dac_write(struct bladerf *dev,
                                               uint16_t value)
 {
@@ -410,7 +429,25 @@ static int dummy_retune(struct bladerf *dev,
                         uint8_t freqsel,
                         uint8_t vcocap,
                         bool low_band,
-                        bool quick_tune)
+                        uint8_t xb_gpio,
+                        bool quick_tune,
+                        uint8_t *vcocap_result)
+{
+    return 0;
+}
+
+static int dummy_retune_dc(struct bladerf *dev,
+                           bladerf_channel ch,
+                           uint64_t timestamp,
+                           uint16_t nint,
+                           uint32_t nfrac,
+                           uint8_t freqsel,
+                           uint8_t vcocap,
+                           bool low_band,
+                           uint8_t xb_gpio,
+                           bool quick_tune,
+                           uint8_t dc_i,
+                           uint8_t dc_q)
 {
     return 0;
 }
@@ -501,6 +538,8 @@ const struct backend_fns backend_fns_dummy = {
 
     FIELD_INIT(.lms_write, dummy_lms_write),
     FIELD_INIT(.lms_read, dummy_lms_read),
+    FIELD_INIT(.lms_write_batch, dummy_lms_write_batch),
+    FIELD_INIT(.lms_read_batch, dummy_lms_read_batch),
 
     FIELD_INIT(.ina219_write, dummy_ina219_write),
     FIELD_INIT(.ina219_read, dummy_ina219_read),
@@ -515,6 +554,7 @@ const struct backend_fns backend_fns_dummy = {
     FIELD_INIT(.rffe_control_read, dummy_rffe_control_read),
 
     FIELD_INIT(.rffe_fastlock_save, dummy_rffe_fastlock_save),
+    FIELD_INIT(.rffe_iq_corr_write, dummy_rffe_iq_corr_write),
 
     FIELD_INIT(.ad56x1_vctcxo_trim_dac_write,
                dummy_ad56x1_vctcxo_trim_dac_write),
@@ -540,8 +580,11 @@ const struct backend_fns backend_fns_dummy = {
     FIELD_INIT(.stream, dummy_stream),
     FIELD_INIT(.submit_stream_buffer, dummy_submit_stream_buffer),
     FIELD_INIT(.deinit_stream, dummy_deinit_stream),
+    FIELD_INIT(.alloc_stream_mem, NULL),
+    FIELD_INIT(.free_stream_mem, NULL),
 
     FIELD_INIT(.retune, dummy_retune),
+    FIELD_INIT(.retune_dc, dummy_retune_dc),
 
     FIELD_INIT(.load_fw_from_bootloader, dummy_load_fw_from_bootloader),
 
@@ -35,6 +35,7 @@ extern "C" {
 #include "backend/usb/usb.h"
 #include "streaming/async.h"
 #include "helpers/timeout.h"
+#include "helpers/wallclock.h"
 #include "log.h"
 }
 
@@ -536,10 +537,10 @@ out:
 #ifdef LOGGING_ENABLED
 static inline int find_buf(void* ptr, struct bladerf_stream *stream)
 {
-    for (unsigned int i=0; i<stream->num_buffers; i++) {
-        if (stream->buffers[i] == ptr) {
-            return i;
-        }
+    size_t i = async_stream_buf_idx(stream, ptr);
+
+    if (i < stream->num_buffers) {
+        return (int)i;
     }
 
     log_debug("Unabled to find buffer %p\n:", ptr);
@@ -692,11 +693,18 @@ static int cyapi_stream(void *driver, struct bladerf_stream *stream,
                                            xfer->handle);
 
         if (success) {
+            const uint64_t cb_start = wallclock_get_current_nsec();
+
             next_buffer = stream->cb(stream->dev, stream, &meta,
                                      data->transfers[i].buffer,
                                      bytes_to_samples(stream->format, (LONG &)len),
                                      stream->user_data);
 
+            async_record_transfer(stream,
+                                  stream->format != BLADERF_FORMAT_PACKET_META &&
+                                    (size_t)len != async_stream_buf_bytes(stream),
+                                  cb_start);
+
         } else {
             done = true;
             status = BLADERF_ERR_IO;
@@ -843,6 +851,8 @@ extern "C" {
         FIELD_INIT(.stream, cyapi_stream),
         FIELD_INIT(.submit_stream_buffer, cyapi_submit_stream_buffer),
         FIELD_INIT(.deinit_stream, cyapi_deinit_stream),
+        FIELD_INIT(.alloc_stream_mem, NULL),
+        FIELD_INIT(.free_stream_mem, NULL),
         FIELD_INIT(.open_bootloader, cyapi_open_bootloader),
         FIELD_INIT(.close_bootloader, cyapi_close),
     };
@@ -36,6 +36,7 @@
 #include "backend/usb/usb.h"
 #include "streaming/async.h"
 #include "helpers/timeout.h"
+#include "helpers/wallclock.h"
 
 #include "bladeRF.h"
 
@@ -61,12 +62,20 @@ typedef enum {
     TRANSFER_CANCEL_PENDING
 } transfer_status;
 
+/* Provided to lusb_stream_cb() as each transfer's user_data, so that the
+ * index of a completed transfer is known without having to search for it */
+struct lusb_transfer_ctx {
+    struct bladerf_stream *stream;
+    size_t idx;
+};
+
 struct lusb_stream_data {
     size_t num_transfers;               /* Total # of allocated transfers */
     size_t num_avail;                   /* # of currently available transfers */
     size_t i;                           /* Index to next transfer */
     struct libusb_transfer **transfers; /* Array of transfer metadata */
     transfer_status *transfer_status;   /* Status of each transfer */
+    struct lusb_transfer_ctx *transfer_ctx; /* Context for each transfer */
 
    /* Warn the first time we get a transfer callback out of order.
     * This shouldn't happen normally, but we've seen it intermittently on
@@ -1040,35 +1049,23 @@ static inline void cancel_all_transfers(struct bladerf_stream *stream)
 #endif
 }
 
-static inline size_t transfer_idx(struct lusb_stream_data *stream_data,
-                                  struct libusb_transfer *transfer)
-{
-    size_t i;
-    for (i = 0; i < stream_data->num_transfers; i++) {
-        if (stream_data->transfers[i] == transfer) {
-            return i;
-        }
-    }
-
-    return UINT_MAX;
-}
-
 static int submit_transfer(struct bladerf_stream *stream, void *buffer, size_t len);
 
 static void LIBUSB_CALL lusb_stream_cb(struct libusb_transfer *transfer)
 {
-    struct bladerf_stream *stream = transfer->user_data;
+    struct lusb_transfer_ctx *ctx = transfer->user_data;
+    struct bladerf_stream *stream = ctx->stream;
     void *next_buffer             = NULL;
     struct bladerf_metadata metadata;
     struct lusb_stream_data *stream_data = stream->backend_data;
-    size_t transfer_i;
+    const size_t transfer_i              = ctx->idx;
 
     /* Currently unused - zero out for out own debugging sanity... */
     memset(&metadata, 0, sizeof(metadata));
 
     MUTEX_LOCK(&stream->lock);
 
-    transfer_i = transfer_idx(stream_data, transfer);
+    assert(stream_data->transfers[transfer_i] == transfer);
     assert(stream_data->transfer_status[transfer_i] == TRANSFER_IN_FLIGHT ||
            stream_data->transfer_status[transfer_i] == TRANSFER_CANCEL_PENDING);
 
@@ -1126,23 +1123,25 @@ static void LIBUSB_CALL lusb_stream_cb(struct libusb_transfer *transfer)
     }
 
     if (stream->state == STREAM_RUNNING) {
-        if (stream->format == BLADERF_FORMAT_PACKET_META) {
-            /* Call user callback requesting more data to transmit */
-            next_buffer = stream->cb(
-                stream->dev, stream, &metadata, transfer->buffer,
-                bytes_to_samples(stream->format, transfer->actual_length), stream->user_data);
-        } else {
+        bool short_transfer = false;
+        uint64_t cb_start;
+
+        if (stream->format != BLADERF_FORMAT_PACKET_META) {
             /* Sanity check for debugging purposes */
             if (transfer->length != transfer->actual_length) {
                 log_warning("Received short transfer\n");
+                short_transfer = true;
             }
-
-            /* Call user callback requesting more data to transmit */
-            next_buffer = stream->cb(
-                stream->dev, stream, &metadata, transfer->buffer,
-                bytes_to_samples(stream->format, transfer->actual_length), stream->user_data);
         }
 
+        /* Call user callback requesting more data to transmit */
+        cb_start    = wallclock_get_current_nsec();
+        next_buffer = stream->cb(
+            stream->dev, stream, &metadata, transfer->buffer,
+            bytes_to_samples(stream->format, transfer->actual_length), stream->user_data);
+
+        async_record_transfer(stream, short_transfer, cb_start);
+
         if (next_buffer == BLADERF_STREAM_SHUTDOWN) {
             stream->state = STREAM_SHUTTING_DOWN;
         } else if (next_buffer != BLADERF_STREAM_NO_DATA) {
@@ -1226,7 +1225,7 @@ static int submit_transfer(struct bladerf_stream *stream, void *buffer, size_t l
                               buffer,
                               (int)len,
                               lusb_stream_cb,
-                              stream,
+                              &stream_data->transfer_ctx[stream_data->i],
                               stream->transfer_timeout);
 
     prev_idx = stream_data->i;
@@ -1286,6 +1285,7 @@ static int lusb_init_stream(void *driver, struct bladerf_stream *stream,
     stream->backend_data = stream_data;
     stream_data->transfers = NULL;
     stream_data->transfer_status = NULL;
+    stream_data->transfer_ctx = NULL;
     stream_data->num_transfers = num_transfers;
     stream_data->num_avail = 0;
     stream_data->i = 0;
@@ -1309,6 +1309,20 @@ static int lusb_init_stream(void *driver, struct bladerf_stream *stream,
         goto error;
     }
 
+    stream_data->transfer_ctx =
+        malloc(num_transfers * sizeof(struct lusb_transfer_ctx));
+
+    if (stream_data->transfer_ctx == NULL) {
+        log_error("Failed to allocate libusb transfer context array\n");
+        status = BLADERF_ERR_MEM;
+        goto error;
+    }
+
+    for (i = 0; i < num_transfers; i++) {
+        stream_data->transfer_ctx[i].stream = stream;
+        stream_data->transfer_ctx[i].idx    = i;
+    }
+
     /* Create the libusb transfers */
     for (i = 0; i < stream_data->num_transfers; i++) {
         stream_data->transfers[i] = libusb_alloc_transfer(0);
@@ -1338,6 +1352,7 @@ static int lusb_init_stream(void *driver, struct bladerf_stream *stream,
 
 error:
     if (status != 0) {
+        free(stream_data->transfer_ctx);
         free(stream_data->transfer_status);
         free(stream_data->transfers);
         free(stream_data);
@@ -1483,6 +1498,23 @@ int lusb_submit_stream_buffer(void *driver, struct bladerf_stream *stream,
     }
 }
 
+#if defined(LIBUSB_API_VERSION) && (LIBUSB_API_VERSION >= 0x01000105)
+/* libusb >= 1.0.21 can provide memory that the kernel may DMA to and from
+ * directly, rather than copying each transfer. Currently, this is only
+ * implemented for Linux; elsewhere, this returns NULL. */
+static void *lusb_alloc_stream_mem(void *driver, size_t len)
+{
+    struct bladerf_lusb *lusb = (struct bladerf_lusb *) driver;
+    return libusb_dev_mem_alloc(lusb->handle, len);
+}
+
+static void lusb_free_stream_mem(void *driver, void *mem, size_t len)
+{
+    struct bladerf_lusb *lusb = (struct bladerf_lusb *) driver;
+    libusb_dev_mem_free(lusb->handle, (unsigned char *) mem, len);
+}
+#endif
+
 static int lusb_deinit_stream(void *driver, struct bladerf_stream *stream)
 {
     size_t i;
@@ -1496,6 +1528,7 @@ static int lusb_deinit_stream(void *driver, struct bladerf_stream *stream)
 
     free(stream_data->transfers);
     free(stream_data->transfer_status);
+    free(stream_data->transfer_ctx);
     free(stream->backend_data);
 
     stream->backend_data = NULL;
@@ -1518,6 +1551,13 @@ static const struct usb_fns libusb_fns = {
     FIELD_INIT(.stream, lusb_stream),
     FIELD_INIT(.submit_stream_buffer, lusb_submit_stream_buffer),
     FIELD_INIT(.deinit_stream, lusb_deinit_stream),
+#if defined(LIBUSB_API_VERSION) && (LIBUSB_API_VERSION >= 0x01000105)
+    FIELD_INIT(.alloc_stream_mem, lusb_alloc_stream_mem),
+    FIELD_INIT(.free_stream_mem, lusb_free_stream_mem),
+#else
+    FIELD_INIT(.alloc_stream_mem, NULL),
+    FIELD_INIT(.free_stream_mem, NULL),
+#endif
     FIELD_INIT(.open_bootloader, lusb_open_bootloader),
     FIELD_INIT(.close_bootloader, lusb_close_bootloader),
 };
@@ -33,6 +33,7 @@
 #include "nios_pkt_formats.h"
 
 #include "board/board.h"
+#include "helpers/have_cap.h"
 #include "helpers/version.h"
 
 #if 0
@@ -156,6 +157,66 @@ static int nios_8x8_write(struct bladerf *dev, uint8_t id,
     }
 }
 
+/* Perform `n` accesses to target `id` using as few 8x8 batch packets as
+ * possible. Writes take their data from `wdata`, reads return data in `rdata`.
+ * Falls back to individual 8x8 accesses on FPGA images that do not support
+ * the batch packet. */
+static int nios_8x8_batch(struct bladerf *dev, uint8_t id, bool write,
+                          const uint8_t *addr, const uint8_t *wdata,
+                          uint8_t *rdata, size_t n)
+{
+    int status;
+    uint8_t buf[NIOS_PKT_LEN];
+    uint8_t count, resp_count;
+    size_t i;
+    bool success;
+
+    if (!have_cap(dev->board->get_capabilities(dev),
+                  BLADERF_CAP_NIOS_8x8_BATCH)) {
+        for (i = 0; i < n; i++) {
+            if (write) {
+                status = nios_8x8_write(dev, id, addr[i], wdata[i]);
+            } else {
+                status = nios_8x8_read(dev, id, addr[i], &rdata[i]);
+            }
+
+            if (status != 0) {
+                return status;
+            }
+        }
+
+        return 0;
+    }
+
+    for (i = 0; i < n; i += count) {
+        if (n - i > NIOS_PKT_8x8_BATCH_MAX_OPS) {
+            count = NIOS_PKT_8x8_BATCH_MAX_OPS;
+        } else {
+            count = (uint8_t)(n - i);
+        }
+
+        nios_pkt_8x8_batch_pack(buf, id, write, &addr[i],
+                                write ? &wdata[i] : NULL, count);
+
+        status = nios_access(dev, buf);
+        if (status != 0) {
+            return status;
+        }
+
+        nios_pkt_8x8_batch_resp_unpack(buf, NULL, NULL, NULL,
+                                       write ? NULL : &rdata[i],
+                                       &resp_count, &success);
+
+        if (!success || resp_count != count) {
+            log_debug("%s: response packet reported failure after %u of %u "
+                      "accesses.\n", __FUNCTION__, resp_count, count);
+            return BLADERF_ERR_FPGA_OP;
+        }
+    }
+
+    return 0;
+}
+
 static int nios_8x16_read(struct bladerf *dev, uint8_t id,
                           uint8_t addr, uint16_t *data)
 {
@@ -593,6 +654,20 @@ int nios_lms6_write(struct bladerf *dev, uint8_t addr, uint8_t data)
     return status;
 }
 
+int nios_lms6_read_batch(struct bladerf *dev, const uint8_t *addr,
+                         uint8_t *data, size_t n)
+{
+    return nios_8x8_batch(dev, NIOS_PKT_8x8_TARGET_LMS6, false, addr, NULL,
+                          data, n);
+}
+
+int nios_lms6_write_batch(struct bladerf *dev, const uint8_t *addr,
+                          const uint8_t *data, size_t n)
+{
+    return nios_8x8_batch(dev, NIOS_PKT_8x8_TARGET_LMS6, true, addr, data,
+                          NULL, n);
+}
+
 int nios_ina219_read(struct bladerf *dev, uint8_t addr, uint16_t *data)
 {
     int status;
@@ -825,6 +900,22 @@ int nios_rffe_fastlock_save(struct bladerf *dev, bool is_tx,
     return status;
 }
 
+int nios_rffe_iq_corr_write(struct bladerf *dev, uint16_t addr, uint64_t data)
+{
+    int status;
+
+    status = nios_16x64_write(dev, NIOS_PKT_16x64_TARGET_IQ_CORR, addr, data);
+
+#ifdef ENABLE_LIBBLADERF_NIOS_ACCESS_LOG_VERBOSE
+    if (status == 0) {
+        log_verbose("%s: Wrote 0x%04x: 0x%016" PRIx64 "\n", __FUNCTION__, addr,
+                    data);
+    }
+#endif
+
+    return status;
+}
+
 int nios_ad56x1_vctcxo_trim_dac_read(struct bladerf *dev, uint16_t *value)
 {
     int status;
@@ -1139,7 +1230,7 @@ int nios_expansion_gpio_dir_write(struct bladerf *dev,
 int nios_retune(struct bladerf *dev, bladerf_channel ch,
                 uint64_t timestamp, uint16_t nint, uint32_t nfrac,
                 uint8_t freqsel, uint8_t vcocap, bool low_band,
-                uint8_t xb_gpio, bool quick_tune)
+                uint8_t xb_gpio, bool quick_tune, uint8_t *vcocap_result)
 {
     int status;
     uint8_t buf[NIOS_PKT_LEN];
@@ -1167,6 +1258,71 @@ int nios_retune(struct bladerf *dev, bladerf_channel ch,
 
     nios_pkt_retune_resp_unpack(buf, &duration, &vcocap, &resp_flags);
 
+    if (vcocap_result != NULL) {
+        *vcocap_result = 0xff;
+    }
+
+    if (resp_flags & NIOS_PKT_RETUNERESP_FLAG_TSVTUNE_VALID) {
+        log_verbose("%s retune operation: vcocap=%u, duration=%"PRIu64"\n",
+                    channel2str(ch), vcocap, duration);
+
+        if (vcocap_result != NULL) {
+            *vcocap_result = vcocap;
+        }
+    } else {
+        log_verbose("%s operation duration: %"PRIu64"\n",
+                    channel2str(ch), duration);
+    }
+
+    if ((resp_flags & NIOS_PKT_RETUNERESP_FLAG_SUCCESS) == 0) {
+        if (timestamp == BLADERF_RETUNE_NOW) {
+            log_debug("FPGA tuning reported failure.\n");
+            status = BLADERF_ERR_UNEXPECTED;
+        } else {
+            log_debug("The FPGA's retune queue is full. Try again after "
+                      "a previous request has completed.\n");
+            status = BLADERF_ERR_QUEUE_FULL;
+        }
+    }
+
+    return status;
+}
+
+int nios_retune_dc(struct bladerf *dev, bladerf_channel ch,
+                   uint64_t timestamp, uint16_t nint, uint32_t nfrac,
+                   uint8_t freqsel, uint8_t vcocap, bool low_band,
+                   uint8_t xb_gpio, bool quick_tune,
+                   uint8_t dc_i, uint8_t dc_q)
+{
+    int status;
+    uint8_t buf[NIOS_PKT_LEN];
+
+    uint8_t resp_flags;
+    uint64_t duration;
+
+    if (timestamp > NIOS_PKT_RETUNE_DC_TIME_MAX) {
+        log_debug("%s: timestamp %"PRIu64" exceeds the packet's range\n",
+                  __FUNCTION__, timestamp);
+        return BLADERF_ERR_RANGE;
+    }
+
+    log_verbose("%s: channel=%s timestamp=%"PRIu64" nint=%u nfrac=%u\n\t\t\t\t"
+                "freqsel=0x%02x vcocap=0x%02x low_band=%d quick_tune=%d\n\t\t\t\t"
+                "dc_i=0x%02x dc_q=0x%02x\n",
+                __FUNCTION__, channel2str(ch), timestamp, nint, nfrac,
+                freqsel, vcocap, low_band, quick_tune, dc_i, dc_q);
+
+    nios_pkt_retune_dc_pack(buf, ch, timestamp,
+                            nint, nfrac, freqsel, vcocap, low_band,
+                            xb_gpio, quick_tune, dc_i, dc_q);
+
+    status = nios_access(dev, buf);
+    if (status != 0) {
+        return status;
+    }
+
+    nios_pkt_retune_resp_unpack(buf, &duration, &vcocap, &resp_flags);
+
     if (resp_flags & NIOS_PKT_RETUNERESP_FLAG_TSVTUNE_VALID) {
         log_verbose("%s retune operation: vcocap=%u, duration=%"PRIu64"\n",
                     channel2str(ch), vcocap, duration);
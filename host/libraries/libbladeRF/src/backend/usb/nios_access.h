@@ -127,6 +127,38 @@ int nios_lms6_read(struct bladerf *dev, uint8_t addr, uint8_t *data);
  */
 int nios_lms6_write(struct bladerf *dev, uint8_t addr, uint8_t data);
 
+/**
+ * Read a sequence of LMS6002D registers, in order
+ *
+ * Up to NIOS_PKT_8x8_BATCH_MAX_OPS reads are issued per request on FPGA
+ * images supporting BLADERF_CAP_NIOS_8x8_BATCH.
+ *
+ * @param       dev         Device handle
+ * @param[in]   addr        Register addresses
+ * @param[out]  data        On success, updated with data read from the device
+ * @param[in]   n           Number of registers to read
+ *
+ * @return 0 on success, BLADERF_ERR_* code on error.
+ */
+int nios_lms6_read_batch(struct bladerf *dev, const uint8_t *addr,
+                         uint8_t *data, size_t n);
+
+/**
+ * Write a sequence of LMS6002D registers, in order
+ *
+ * Up to NIOS_PKT_8x8_BATCH_MAX_OPS writes are issued per request on FPGA
+ * images supporting BLADERF_CAP_NIOS_8x8_BATCH.
+ *
+ * @param       dev         Device handle
+ * @param[in]   addr        Register addresses
+ * @param[in]   data        Register data
+ * @param[in]   n           Number of registers to write
+ *
+ * @return 0 on success, BLADERF_ERR_* code on error.
+ */
+int nios_lms6_write_batch(struct bladerf *dev, const uint8_t *addr,
+                          const uint8_t *data, size_t n);
+
 /**
  * Read from an INA219 register
  *
@@ -272,6 +304,17 @@ int nios_rffe_control_write(struct bladerf *dev, uint32_t value);
 int nios_rffe_fastlock_save(struct bladerf *dev, bool is_tx,
                             uint8_t rffe_profile, uint16_t nios_profile);
 
+/**
+ * Apply or store I/Q corrections in the Nios.
+ *
+ * @param           dev         Device handle
+ * @param[in]       addr        Sub-address; see NIOS_PKT_16x64_TARGET_IQ_CORR
+ * @param[in]       data        Packed correction values
+ *
+ * @return 0 on success, BLADERF_ERR_* code on error.
+ */
+int nios_rffe_iq_corr_write(struct bladerf *dev, uint16_t addr, uint64_t data);
+
 /**
  * Write to the AD56X1 VCTCXO trim DAC.
  *
@@ -505,6 +548,9 @@ int nios_expansion_gpio_dir_write(struct bladerf *dev,
  * @param[in]   xb_gpio     XB configuration bits
  * @param[in]   quick_tune  Denotes quick tune should be used instead of
  *                          tuning algorithm
+ * @param[out]  vcocap_result   If non-NULL, updated with the VCOCAP value
+ *                              used by an immediate retune. Set to 0xff if
+ *                              the FPGA did not report one.
  *
  * @return BLADERF_ERR_UNSUPPORTED
  */
@@ -517,7 +563,41 @@ int nios_retune(struct bladerf *dev,
                 uint8_t vcocap,
                 bool low_band,
                 uint8_t xb_gpio,
-                bool quick_tune);
+                bool quick_tune,
+                uint8_t *vcocap_result);
+
+/**
+ * Handler for a retune request that also carries the DC offset correction
+ * register values to write after the retune.
+ *
+ * @param       dev         Device handle
+ * @param[in]   ch          Channel
+ * @param[in]   timestamp   Time to schedule retune at. Must not exceed
+ *                          NIOS_PKT_RETUNE_DC_TIME_MAX.
+ * @param[in]   nint        Integer portion of frequency multiplier
+ * @param[in]   nfrac       Fractional portion of frequency multiplier
+ * @param[in]   freqsel     VCO and divider selection
+ * @param[in]   low_band    High vs low band selection
+ * @param[in]   xb_gpio     XB configuration bits
+ * @param[in]   quick_tune  Denotes quick tune should be used instead of
+ *                          tuning algorithm
+ * @param[in]   dc_i        I channel DC offset register value
+ * @param[in]   dc_q        Q channel DC offset register value
+ *
+ * @return 0 on success, BLADERF_ERR_* code on error.
+ */
+int nios_retune_dc(struct bladerf *dev,
+                   bladerf_channel ch,
+                   uint64_t timestamp,
+                   uint16_t nint,
+                   uint32_t nfrac,
+                   uint8_t freqsel,
+                   uint8_t vcocap,
+                   bool low_band,
+                   uint8_t xb_gpio,
+                   bool quick_tune,
+                   uint8_t dc_i,
+                   uint8_t dc_q);
 
 /**
  * Handler for a retune request on bladeRF2 devices. The RFFEs used in these
@@ -360,6 +360,33 @@ int nios_legacy_lms6_write(struct bladerf *dev, uint8_t addr, uint8_t data)
     return status;
 }
 
+/* The legacy packet format carries a single LMS6002D access per request */
+int nios_legacy_lms6_read_batch(struct bladerf *dev, const uint8_t *addr,
+                                uint8_t *data, size_t n)
+{
+    int status = 0;
+    size_t i;
+
+    for (i = 0; i < n && status == 0; i++) {
+        status = nios_legacy_lms6_read(dev, addr[i], &data[i]);
+    }
+
+    return status;
+}
+
+int nios_legacy_lms6_write_batch(struct bladerf *dev, const uint8_t *addr,
+                                 const uint8_t *data, size_t n)
+{
+    int status = 0;
+    size_t i;
+
+    for (i = 0; i < n && status == 0; i++) {
+        status = nios_legacy_lms6_write(dev, addr[i], data[i]);
+    }
+
+    return status;
+}
+
 int nios_legacy_ina219_read(struct bladerf *dev, uint8_t addr, uint16_t *data)
 {
     log_debug("This operation is not supported by the legacy NIOS packet format\n");
@@ -435,6 +462,14 @@ int nios_legacy_rffe_fastlock_save(struct bladerf *dev, bool is_tx,
     return BLADERF_ERR_UNSUPPORTED;
 }
 
+int nios_legacy_rffe_iq_corr_write(struct bladerf *dev,
+                                   uint16_t addr,
+                                   uint64_t data)
+{
+    log_debug("This operation is not supported by the legacy NIOS packet format\n");
+    return BLADERF_ERR_UNSUPPORTED;
+}
+
 int nios_legacy_ad56x1_vctcxo_trim_dac_read(struct bladerf *dev, uint16_t *value)
 {
     log_debug("This operation is not supported by the legacy NIOS packet format\n");
@@ -153,6 +153,32 @@ int nios_legacy_lms6_read(struct bladerf *dev, uint8_t addr, uint8_t *data);
  */
 int nios_legacy_lms6_write(struct bladerf *dev, uint8_t addr, uint8_t data);
 
+/**
+ * Read a sequence of LMS6002D registers, one request per register
+ *
+ * @param       dev         Device handle
+ * @param[in]   addr        Register addresses
+ * @param[out]  data        On success, updated with data read from the device
+ * @param[in]   n           Number of registers to read
+ *
+ * @return 0 on success, BLADERF_ERR_* code on error.
+ */
+int nios_legacy_lms6_read_batch(struct bladerf *dev, const uint8_t *addr,
+                                uint8_t *data, size_t n);
+
+/**
+ * Write a sequence of LMS6002D registers, one request per register
+ *
+ * @param       dev         Device handle
+ * @param[in]   addr        Register addresses
+ * @param[in]   data        Register data
+ * @param[in]   n           Number of registers to write
+ *
+ * @return 0 on success, BLADERF_ERR_* code on error.
+ */
+int nios_legacy_lms6_write_batch(struct bladerf *dev, const uint8_t *addr,
+                                 const uint8_t *data, size_t n);
+
 /**
  * Read from an INA219 register
  *
@@ -289,6 +315,19 @@ int nios_legacy_rffe_fastlock_save(struct bladerf *dev, bool is_tx,
                                    uint8_t rffe_profile,
                                    uint16_t nios_profile);
 
+/**
+ * Apply or store I/Q corrections in the Nios.
+ *
+ * @param           dev         Device handle
+ * @param[in]       addr        Sub-address
+ * @param[in]       data        Packed correction values
+ *
+ * @return BLADERF_ERR_UNSUPPORTED
+ */
+int nios_legacy_rffe_iq_corr_write(struct bladerf *dev,
+                                   uint16_t addr,
+                                   uint64_t data);
+
 /**
  * Write to the AD56X1 VCTCXO trim DAC.
  *
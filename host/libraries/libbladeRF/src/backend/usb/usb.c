@@ -954,6 +954,23 @@ static void usb_deinit_stream(struct bladerf_stream *stream)
     usb->fn->deinit_stream(usb->driver, stream);
 }
 
+static void *usb_alloc_stream_mem(struct bladerf *dev, size_t len)
+{
+    struct bladerf_usb *usb = dev->backend_data;
+
+    if (usb->fn->alloc_stream_mem == NULL) {
+        return NULL;
+    }
+
+    return usb->fn->alloc_stream_mem(usb->driver, len);
+}
+
+static void usb_free_stream_mem(struct bladerf *dev, void *mem, size_t len)
+{
+    struct bladerf_usb *usb = dev->backend_data;
+    usb->fn->free_stream_mem(usb->driver, mem, len);
+}
+
 /*
  * Information about the boot image format and boot over USB can be found in
  * Cypress AN76405: EZ-USB (R) FX3 (TM) Boot Options:
@@ -1258,6 +1275,8 @@ const struct backend_fns backend_fns_usb_legacy = {
 
     FIELD_INIT(.lms_write, nios_legacy_lms6_write),
     FIELD_INIT(.lms_read, nios_legacy_lms6_read),
+    FIELD_INIT(.lms_write_batch, nios_legacy_lms6_write_batch),
+    FIELD_INIT(.lms_read_batch, nios_legacy_lms6_read_batch),
 
     FIELD_INIT(.ina219_write, nios_legacy_ina219_write),
     FIELD_INIT(.ina219_read, nios_legacy_ina219_read),
@@ -1275,6 +1294,7 @@ const struct backend_fns backend_fns_usb_legacy = {
     FIELD_INIT(.rffe_control_read, nios_legacy_rffe_control_read),
 
     FIELD_INIT(.rffe_fastlock_save, nios_legacy_rffe_fastlock_save),
+    FIELD_INIT(.rffe_iq_corr_write, nios_legacy_rffe_iq_corr_write),
 
     FIELD_INIT(.ad56x1_vctcxo_trim_dac_write, nios_legacy_ad56x1_vctcxo_trim_dac_write),
     FIELD_INIT(.ad56x1_vctcxo_trim_dac_read, nios_legacy_ad56x1_vctcxo_trim_dac_read),
@@ -1299,8 +1319,11 @@ const struct backend_fns backend_fns_usb_legacy = {
     FIELD_INIT(.stream, usb_stream),
     FIELD_INIT(.submit_stream_buffer, usb_submit_stream_buffer),
     FIELD_INIT(.deinit_stream, usb_deinit_stream),
+    FIELD_INIT(.alloc_stream_mem, usb_alloc_stream_mem),
+    FIELD_INIT(.free_stream_mem, usb_free_stream_mem),
 
     FIELD_INIT(.retune, nios_retune),
+    FIELD_INIT(.retune_dc, nios_retune_dc),
     FIELD_INIT(.retune2, nios_retune2),
 
     FIELD_INIT(.load_fw_from_bootloader, usb_load_fw_from_bootloader),
@@ -1371,6 +1394,8 @@ const struct backend_fns backend_fns_usb = {
 
     FIELD_INIT(.lms_write, nios_lms6_write),
     FIELD_INIT(.lms_read, nios_lms6_read),
+    FIELD_INIT(.lms_write_batch, nios_lms6_write_batch),
+    FIELD_INIT(.lms_read_batch, nios_lms6_read_batch),
 
     FIELD_INIT(.ina219_write, nios_ina219_write),
     FIELD_INIT(.ina219_read, nios_ina219_read),
@@ -1391,6 +1416,7 @@ const struct backend_fns backend_fns_usb = {
     FIELD_INIT(.rffe_control_read, nios_rffe_control_read),
 
     FIELD_INIT(.rffe_fastlock_save, nios_rffe_fastlock_save),
+    FIELD_INIT(.rffe_iq_corr_write, nios_rffe_iq_corr_write),
 
     FIELD_INIT(.ad56x1_vctcxo_trim_dac_write, nios_ad56x1_vctcxo_trim_dac_write),
     FIELD_INIT(.ad56x1_vctcxo_trim_dac_read, nios_ad56x1_vctcxo_trim_dac_read),
@@ -1415,8 +1441,11 @@ const struct backend_fns backend_fns_usb = {
     FIELD_INIT(.stream, usb_stream),
     FIELD_INIT(.submit_stream_buffer, usb_submit_stream_buffer),
     FIELD_INIT(.deinit_stream, usb_deinit_stream),
+    FIELD_INIT(.alloc_stream_mem, usb_alloc_stream_mem),
+    FIELD_INIT(.free_stream_mem, usb_free_stream_mem),
 
     FIELD_INIT(.retune, nios_retune),
+    FIELD_INIT(.retune_dc, nios_retune_dc),
     FIELD_INIT(.retune2, nios_retune2),
 
     FIELD_INIT(.load_fw_from_bootloader, usb_load_fw_from_bootloader),
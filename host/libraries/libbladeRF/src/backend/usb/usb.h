@@ -151,6 +151,10 @@ struct usb_fns {
 
     int (*deinit_stream)(void *driver, struct bladerf_stream *stream);
 
+    /* Optional - may be NULL */
+    void *(*alloc_stream_mem)(void *driver, size_t len);
+    void (*free_stream_mem)(void *driver, void *mem, size_t len);
+
     int (*open_bootloader)(void **driver, uint8_t bus, uint8_t addr);
     void (*close_bootloader)(void *driver);
 };
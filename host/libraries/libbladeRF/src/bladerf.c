@@ -36,6 +36,9 @@
 #include "backend/backend.h"
 #include "backend/usb/usb.h"
 #include "board/board.h"
+#include "control_queue.h"
+#include "hop_set.h"
+#include "retune_queue.h"
 #include "conversions.h"
 #include "driver/fx3_fw.h"
 #include "device_calibration.h"
@@ -51,6 +54,7 @@
 #include "helpers/file.h"
 #include "helpers/have_cap.h"
 #include "helpers/interleave.h"
+#include "helpers/sample_convert.h"
 
 #define CHECK_NULL(...) do { \
     const void* _args[] = { __VA_ARGS__, NULL }; \
@@ -150,6 +154,21 @@ int bladerf_open_with_devinfo(struct bladerf **opened_device,
 
     MUTEX_INIT(&dev->lock);
 
+    status = control_queue_init(dev);
+    if (status < 0) {
+        dev->backend->close(dev);
+        free(dev);
+        return status;
+    }
+
+    status = retune_queue_init(dev);
+    if (status < 0) {
+        control_queue_deinit(dev);
+        dev->backend->close(dev);
+        free(dev);
+        return status;
+    }
+
     /* Open board */
     status = dev->board->open(dev, devinfo);
 
@@ -202,6 +221,11 @@ int bladerf_get_backendinfo(struct bladerf *dev, struct bladerf_backendinfo *inf
 void bladerf_close(struct bladerf *dev)
 {
     if (dev) {
+        /* The control and retune workers acquire the device lock, so they
+         * must be stopped before the lock is taken here */
+        control_queue_deinit(dev);
+        retune_queue_deinit(dev);
+
         MUTEX_LOCK(&dev->lock);
 
         dev->board->close(dev);
@@ -212,7 +236,7 @@ void bladerf_close(struct bladerf *dev)
 
         /** Free gain table entries */
         for (int i = 0; i < NUM_GAIN_CAL_TBLS; i++) {
-            gain_cal_tbl_free(&dev->gain_tbls[i]);
+            gain_cal_release(dev, i);
         }
 
         MUTEX_UNLOCK(&dev->lock);
@@ -572,7 +596,7 @@ int bladerf_set_gain(struct bladerf *dev, bladerf_channel ch, int gain)
     dev->gain_tbls[ch].gain_target = gain;
 
     if (dev->gain_tbls[ch].enabled == true) {
-        dev->board->get_frequency(dev, ch, &freq);
+        get_gain_cal_frequency(dev, ch, &freq);
         get_gain_correction(dev, freq, ch, &assigned_gain);
     }
 
@@ -828,6 +852,9 @@ int bladerf_set_frequency(struct bladerf *dev,
 
     status = dev->board->set_frequency(dev, ch, frequency);
 
+    /* Remembered for gain compensation. Unknown if the retune failed. */
+    set_gain_cal_frequency(dev, ch, (status == 0) ? frequency : 0);
+
     if (dev->gain_tbls[ch].enabled && status == 0) {
         status = apply_gain_correction(dev, ch, frequency);
         if (status != 0) {
@@ -976,8 +1003,12 @@ int bladerf_schedule_retune(struct bladerf *dev,
     int status;
     MUTEX_LOCK(&dev->lock);
 
-    status =
-        dev->board->schedule_retune(dev, ch, timestamp, frequency, quick_tune);
+    status = retune_queue_schedule(dev, ch, timestamp, frequency, quick_tune);
+
+    /* The frequency now depends upon when the retune occurs */
+    if (status == 0) {
+        set_gain_cal_frequency(dev, ch, 0);
+    }
 
     MUTEX_UNLOCK(&dev->lock);
     return status;
@@ -988,7 +1019,83 @@ int bladerf_cancel_scheduled_retunes(struct bladerf *dev, bladerf_channel ch)
     int status;
     MUTEX_LOCK(&dev->lock);
 
-    status = dev->board->cancel_scheduled_retunes(dev, ch);
+    status = retune_queue_cancel(dev, ch);
+
+    MUTEX_UNLOCK(&dev->lock);
+    return status;
+}
+
+int bladerf_get_quick_tune_stats(struct bladerf *dev,
+                                 bladerf_direction dir,
+                                 struct bladerf_quick_tune_stats *stats)
+{
+    int status;
+    CHECK_NULL(stats);
+    MUTEX_LOCK(&dev->lock);
+
+    status = dev->board->get_quick_tune_stats(dev, dir, stats);
+
+    MUTEX_UNLOCK(&dev->lock);
+    return status;
+}
+
+int bladerf_clear_quick_tune_cache(struct bladerf *dev, bladerf_direction dir)
+{
+    int status;
+    MUTEX_LOCK(&dev->lock);
+
+    status = dev->board->clear_quick_tune_cache(dev, dir);
+
+    MUTEX_UNLOCK(&dev->lock);
+    return status;
+}
+
+int bladerf_build_hop_set(struct bladerf *dev,
+                          bladerf_channel ch,
+                          const bladerf_frequency *frequencies,
+                          unsigned int n,
+                          struct bladerf_quick_tune *quick_tunes)
+{
+    int status;
+    CHECK_NULL(frequencies, quick_tunes);
+    MUTEX_LOCK(&dev->lock);
+
+    status = dev->board->build_hop_set(dev, ch, frequencies, n, quick_tunes);
+
+    MUTEX_UNLOCK(&dev->lock);
+    return status;
+}
+
+int bladerf_save_hop_set(struct bladerf *dev,
+                         const char *filename,
+                         bladerf_channel ch,
+                         const bladerf_frequency *frequencies,
+                         const struct bladerf_quick_tune *quick_tunes,
+                         unsigned int n)
+{
+    int status;
+    CHECK_NULL(filename, frequencies, quick_tunes);
+    MUTEX_LOCK(&dev->lock);
+
+    status = hop_set_save(dev, filename, ch, frequencies, quick_tunes, n);
+
+    MUTEX_UNLOCK(&dev->lock);
+    return status;
+}
+
+int bladerf_load_hop_set(struct bladerf *dev,
+                         const char *filename,
+                         bladerf_channel ch,
+                         bladerf_frequency *frequencies,
+                         struct bladerf_quick_tune *quick_tunes,
+                         unsigned int max,
+                         unsigned int *n)
+{
+    int status;
+    CHECK_NULL(filename, n);
+    MUTEX_LOCK(&dev->lock);
+
+    status = hop_set_load(dev, filename, ch, frequencies, quick_tunes, max, n);
 
     MUTEX_UNLOCK(&dev->lock);
     return status;
@@ -1012,6 +1119,38 @@ int bladerf_get_correction(struct bladerf *dev,
     return status;
 }
 
+/******************************************************************************/
+/* Asynchronous control */
+/******************************************************************************/
+
+int bladerf_control_submit(struct bladerf *dev,
+                           const struct bladerf_control_cmd *cmd,
+                           bladerf_control_cb cb,
+                           void *user_data,
+                           struct bladerf_control_handle **handle)
+{
+    CHECK_NULL(cmd);
+
+    /* The device lock is intentionally not taken; the worker thread
+     * acquires it when performing the command. */
+    return control_queue_submit(dev, cmd, cb, user_data, handle);
+}
+
+int bladerf_control_wait(struct bladerf *dev,
+                         struct bladerf_control_handle *handle,
+                         unsigned int timeout_ms,
+                         int *cmd_status)
+{
+    CHECK_NULL(handle);
+
+    return control_queue_wait(dev, handle, timeout_ms, cmd_status);
+}
+
+int bladerf_control_flush(struct bladerf *dev, unsigned int timeout_ms)
+{
+    return control_queue_flush(dev, timeout_ms);
+}
+
 int bladerf_set_correction(struct bladerf *dev,
                            bladerf_channel ch,
                            bladerf_correction corr,
@@ -1026,6 +1165,64 @@ int bladerf_set_correction(struct bladerf *dev,
     return status;
 }
 
+int bladerf_get_correction_profile(struct bladerf *dev,
+                                   bladerf_channel ch,
+                                   struct bladerf_correction_profile *profile)
+{
+    int status;
+
+    if (NULL == profile) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    MUTEX_LOCK(&dev->lock);
+
+    status = dev->board->get_correction_profile(dev, ch, profile);
+
+    MUTEX_UNLOCK(&dev->lock);
+    return status;
+}
+
+int bladerf_set_correction_profile(
+    struct bladerf *dev,
+    bladerf_channel ch,
+    const struct bladerf_correction_profile *profile)
+{
+    int status;
+
+    if (NULL == profile) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    MUTEX_LOCK(&dev->lock);
+
+    status = dev->board->set_correction_profile(dev, ch, profile);
+
+    MUTEX_UNLOCK(&dev->lock);
+    return status;
+}
+
+int bladerf_set_quick_tune_correction_profile(
+    struct bladerf *dev,
+    bladerf_channel ch,
+    const struct bladerf_quick_tune *quick_tune,
+    const struct bladerf_correction_profile *profile)
+{
+    int status;
+
+    if (NULL == quick_tune) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    MUTEX_LOCK(&dev->lock);
+
+    status = dev->board->set_quick_tune_correction_profile(dev, ch, quick_tune,
+                                                           profile);
+
+    MUTEX_UNLOCK(&dev->lock);
+    return status;
+}
+
 /******************************************************************************/
 /* Trigger */
 /******************************************************************************/
@@ -1190,6 +1387,31 @@ int bladerf_get_stream_timeout(struct bladerf *dev,
     return status;
 }
 
+int bladerf_set_stream_buffer_config(
+    struct bladerf *dev, const struct bladerf_stream_buffer_config *config)
+{
+    int status;
+    MUTEX_LOCK(&dev->lock);
+
+    status = stream_mem_validate(config);
+    if (status == 0) {
+        dev->stream_buf_config = *config;
+    }
+
+    MUTEX_UNLOCK(&dev->lock);
+    return status;
+}
+
+int bladerf_get_stream_buffer_config(
+    struct bladerf *dev, struct bladerf_stream_buffer_config *config)
+{
+    MUTEX_LOCK(&dev->lock);
+    *config = dev->stream_buf_config;
+    MUTEX_UNLOCK(&dev->lock);
+
+    return 0;
+}
+
 int bladerf_sync_config(struct bladerf *dev,
                         bladerf_channel_layout layout,
                         bladerf_format format,
@@ -1235,6 +1457,81 @@ int bladerf_sync_rx(struct bladerf *dev,
     return dev->board->sync_rx(dev, samples, num_samples, metadata, timeout_ms);
 }
 
+int bladerf_sync_rx_acquire(struct bladerf *dev,
+                            void **samples,
+                            unsigned int *num_samples,
+                            struct bladerf_metadata *metadata,
+                            unsigned int timeout_ms)
+{
+    CHECK_NULL(samples, num_samples);
+    return dev->board->sync_rx_acquire(dev, samples, num_samples, metadata,
+                                       timeout_ms);
+}
+
+int bladerf_sync_rx_release(struct bladerf *dev, unsigned int num_samples)
+{
+    return dev->board->sync_rx_release(dev, num_samples);
+}
+
+int bladerf_sync_tx_acquire(struct bladerf *dev,
+                            void **samples,
+                            unsigned int *num_samples,
+                            struct bladerf_metadata *metadata,
+                            unsigned int timeout_ms)
+{
+    CHECK_NULL(samples, num_samples);
+    return dev->board->sync_tx_acquire(dev, samples, num_samples, metadata,
+                                       timeout_ms);
+}
+
+int bladerf_sync_tx_commit(struct bladerf *dev,
+                           unsigned int num_samples,
+                           struct bladerf_metadata *metadata)
+{
+    return dev->board->sync_tx_commit(dev, num_samples, metadata);
+}
+
+int bladerf_get_stream_stats(struct bladerf *dev,
+                             bladerf_direction dir,
+                             struct bladerf_stream_stats *stats)
+{
+    int status;
+    MUTEX_LOCK(&dev->lock);
+
+    status = dev->board->get_stream_stats(dev, dir, stats);
+
+    MUTEX_UNLOCK(&dev->lock);
+    return status;
+}
+
+int bladerf_set_stream_thread_config(
+    struct bladerf *dev,
+    bladerf_direction dir,
+    const struct bladerf_stream_thread_config *config)
+{
+    int status;
+    MUTEX_LOCK(&dev->lock);
+
+    status = dev->board->set_stream_thread_config(dev, dir, config);
+
+    MUTEX_UNLOCK(&dev->lock);
+    return status;
+}
+
+int bladerf_get_stream_thread_config(
+    struct bladerf *dev,
+    bladerf_direction dir,
+    struct bladerf_stream_thread_config *config)
+{
+    int status;
+    MUTEX_LOCK(&dev->lock);
+
+    status = dev->board->get_stream_thread_config(dev, dir, config);
+
+    MUTEX_UNLOCK(&dev->lock);
+    return status;
+}
+
 int bladerf_get_timestamp(struct bladerf *dev,
                           bladerf_direction dir,
                           bladerf_timestamp *timestamp)
@@ -1256,6 +1553,20 @@ int bladerf_interleave_stream_buffer(bladerf_channel_layout layout,
     return _interleave_interleave_buf(layout, format, buffer_size, samples);
 }
 
+int bladerf_interleave_stream_buffer_scratch(bladerf_channel_layout layout,
+                                             bladerf_format format,
+                                             unsigned int buffer_size,
+                                             void *samples,
+                                             void *scratch)
+{
+    if (NULL == scratch) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    return _interleave_interleave_buf_scratch(layout, format, buffer_size,
+                                              samples, scratch);
+}
+
 int bladerf_deinterleave_stream_buffer(bladerf_channel_layout layout,
                                        bladerf_format format,
                                        unsigned int buffer_size,
@@ -1264,6 +1575,70 @@ int bladerf_deinterleave_stream_buffer(bladerf_channel_layout layout,
     return _interleave_deinterleave_buf(layout, format, buffer_size, samples);
 }
 
+int bladerf_deinterleave_stream_buffer_scratch(bladerf_channel_layout layout,
+                                               bladerf_format format,
+                                               unsigned int buffer_size,
+                                               void *samples,
+                                               void *scratch)
+{
+    if (NULL == scratch) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    return _interleave_deinterleave_buf_scratch(layout, format, buffer_size,
+                                                samples, scratch);
+}
+
+int bladerf_interleave_stream_buffer_from_channels(bladerf_channel_layout layout,
+                                                   bladerf_format format,
+                                                   unsigned int buffer_size,
+                                                   const void *const *channels,
+                                                   void *samples)
+{
+    CHECK_NULL(channels, samples);
+
+    return _interleave_interleave_from_channels(layout, format, buffer_size,
+                                                channels, samples);
+}
+
+int bladerf_deinterleave_stream_buffer_to_channels(bladerf_channel_layout layout,
+                                                   bladerf_format format,
+                                                   unsigned int buffer_size,
+                                                   const void *samples,
+                                                   void *const *channels)
+{
+    CHECK_NULL(samples, channels);
+
+    return _interleave_deinterleave_to_channels(layout, format, buffer_size,
+                                                samples, channels);
+}
+
+int bladerf_convert_from_format(bladerf_format format,
+                                const void *samples,
+                                unsigned int num_samples,
+                                bladerf_host_format host_format,
+                                void *output,
+                                struct bladerf_conversion *conv)
+{
+    CHECK_NULL(samples, output);
+
+    return _sample_convert_from_format(format, samples, num_samples,
+                                       host_format, output, conv);
+}
+
+int bladerf_convert_to_format(bladerf_host_format host_format,
+                              const void *input,
+                              bladerf_format format,
+                              void *samples,
+                              unsigned int num_samples,
+                              struct bladerf_conversion *conv)
+{
+    CHECK_NULL(input, samples);
+
+    return _sample_convert_to_format(host_format, input, format, samples,
+                                     num_samples, conv);
+}
+
 /******************************************************************************/
 /* FPGA/Firmware Loading/Flashing */
 /******************************************************************************/
@@ -2346,6 +2721,27 @@ int bladerf_get_gain_calibration(struct bladerf *dev, bladerf_channel ch, const
     return 0;
 }
 
+int bladerf_get_gain_corrections(struct bladerf *dev,
+                                 bladerf_channel ch,
+                                 const bladerf_frequency *frequencies,
+                                 unsigned int count,
+                                 double *corrections)
+{
+    int status;
+    CHECK_NULL(dev);
+
+    if (count > 0 && (frequencies == NULL || corrections == NULL)) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    MUTEX_LOCK(&dev->lock);
+
+    status = get_gain_corrections(dev, ch, frequencies, count, corrections);
+
+    MUTEX_UNLOCK(&dev->lock);
+    return status;
+}
+
 int bladerf_get_gain_target(struct bladerf *dev, bladerf_channel ch, int *gain_target)
 {
     int status = 0;
@@ -2353,7 +2749,7 @@ int bladerf_get_gain_target(struct bladerf *dev, bladerf_channel ch, int *gain_t
     MUTEX_LOCK(&dev->lock);
     bladerf_frequency current_frequency;
     struct bladerf_gain_cal_tbl *cal_table = &dev->gain_tbls[ch];
-    struct bladerf_gain_cal_entry current_entry;
+    double current_corr;
     bladerf_gain current_gain;
     bladerf_gain_mode gain_mode;
 
@@ -2377,9 +2773,10 @@ int bladerf_get_gain_target(struct bladerf *dev, bladerf_channel ch, int *gain_t
     }
 
     CHECK_STATUS(dev->board->get_gain(dev, ch, &current_gain));
-    CHECK_STATUS(dev->board->get_frequency(dev, ch, &current_frequency));
-    CHECK_STATUS(get_gain_cal_entry(cal_table, current_frequency, &current_entry));
-    *gain_target = current_gain + current_entry.gain_corr;
+    CHECK_STATUS(get_gain_cal_frequency(dev, ch, &current_frequency));
+    CHECK_STATUS(lookup_gain_correction(dev, ch, current_frequency, &current_corr));
+
+    *gain_target = current_gain + current_corr;
 
 error:
     MUTEX_UNLOCK(&dev->lock);
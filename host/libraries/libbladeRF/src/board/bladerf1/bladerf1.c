@@ -20,6 +20,7 @@
  */
 
 #include <string.h>
+#include <stdlib.h>
 #include <errno.h>
 #include <limits.h>
 
@@ -27,6 +28,7 @@
 
 #include "log.h"
 #include "conversions.h"
+#include "range.h"
 #include "bladeRF.h"
 
 #include "board/board.h"
@@ -35,6 +37,7 @@
 #include "capabilities.h"
 #include "calibration.h"
 #include "flash.h"
+#include "vcocap_cache.h"
 
 #include "driver/smb_clock.h"
 #include "driver/si5338.h"
@@ -92,6 +95,9 @@ struct bladerf1_board_data {
     } cal;
     uint16_t dac_trim;
 
+    /* VCOCAP values found when tuning on the host */
+    struct vcocap_cache vcocap_cache;
+
     /* Board properties */
     bladerf_fpga_size fpga_size;
     /* Data message size */
@@ -838,6 +844,9 @@ static int bladerf1_open(struct bladerf *dev, struct bladerf_devinfo *devinfo)
     board_data->module_format[BLADERF_RX] = -1;
     board_data->module_format[BLADERF_TX] = -1;
 
+    vcocap_cache_reset(&board_data->vcocap_cache, BLADERF_RX);
+    vcocap_cache_reset(&board_data->vcocap_cache, BLADERF_TX);
+
     dev->flash_arch->status          = STATUS_FLASH_UNINITIALIZED;
     dev->flash_arch->manufacturer_id = 0x0;
     dev->flash_arch->device_id       = 0x0;
@@ -1045,6 +1054,18 @@ static int bladerf1_open(struct bladerf *dev, struct bladerf_devinfo *devinfo)
     free(full_path);
     full_path = NULL;
 
+    /* VCOCAP values found in previous sessions are persisted if a cache file
+     * is present */
+    snprintf(filename, sizeof(filename), "%s_vcocap.tbl", dev->ident.serial);
+    full_path = file_find(filename);
+    if (full_path != NULL) {
+        log_debug("Using VCOCAP cache %s\n", full_path);
+        vcocap_cache_set_file(&board_data->vcocap_cache, dev->ident.serial,
+                              full_path);
+    }
+    free(full_path);
+    full_path = NULL;
+
     status = dev->backend->is_fpga_configured(dev);
     if (status < 0) {
         return status;
@@ -1172,6 +1193,15 @@ static void bladerf1_close(struct bladerf *dev)
         dc_cal_tbl_free(&board_data->cal.dc_rx);
         dc_cal_tbl_free(&board_data->cal.dc_tx);
 
+        status = vcocap_cache_save(&board_data->vcocap_cache,
+                                   dev->ident.serial);
+        if (status != 0) {
+            log_warning("Failed to save VCOCAP cache: %s\n",
+                        bladerf_strerror(status));
+        }
+
+        vcocap_cache_deinit(&board_data->vcocap_cache);
+
         free(board_data);
         board_data = NULL;
     }
@@ -2016,6 +2046,42 @@ static int bladerf1_get_bandwidth_range(struct bladerf *dev,
 /* Frequency */
 /******************************************************************************/
 
+/* Tune the LMS6002D from the host, starting the VCOCAP search from the value
+ * previously found for this frequency, if there is one */
+static int lms_set_frequency_cached(struct bladerf *dev,
+                                    bladerf_channel ch,
+                                    uint32_t frequency)
+{
+    struct bladerf1_board_data *board_data = dev->board_data;
+    const bladerf_direction dir =
+        BLADERF_CHANNEL_IS_TX(ch) ? BLADERF_TX : BLADERF_RX;
+    struct lms_freq f;
+    bool cached;
+    int status;
+
+    status = lms_calculate_tuning_params(frequency, &f);
+    if (status != 0) {
+        return status;
+    }
+
+    cached = vcocap_cache_lookup(&board_data->vcocap_cache, dir, frequency,
+                                 &f.vcocap);
+    if (cached) {
+        f.flags |= LMS_FREQ_FLAGS_VERIFY_VCOCAP;
+    }
+
+    status = lms_set_precalculated_frequency(dev, ch, &f);
+    if (status != 0) {
+        return status;
+    }
+
+    vcocap_cache_update(&board_data->vcocap_cache, dir, frequency, cached,
+                        (f.flags & LMS_FREQ_FLAGS_VERIFY_VCOCAP) != 0,
+                        f.vcocap_result);
+
+    return 0;
+}
+
 static int bladerf1_set_frequency(struct bladerf *dev,
                                   bladerf_channel ch,
                                   bladerf_frequency frequency)
@@ -2023,8 +2089,8 @@ static int bladerf1_set_frequency(struct bladerf *dev,
     struct bladerf1_board_data *board_data = dev->board_data;
     const bladerf_xb attached              = dev->xb;
     int status;
-    int16_t dc_i, dc_q;
-    struct dc_cal_entry entry;
+    const struct dc_cal_lut_entry *dc_lut  = NULL;
+    bool dc_applied                        = false;
     const struct dc_cal_tbl *dc_cal = (ch == BLADERF_CHANNEL_RX(0))
                                           ? board_data->cal.dc_rx
                                           : board_data->cal.dc_tx;
@@ -2057,7 +2123,7 @@ static int bladerf1_set_frequency(struct bladerf *dev,
 
     switch (board_data->tuning_mode) {
         case BLADERF_TUNING_MODE_HOST:
-            status = lms_set_frequency(dev, ch, (uint32_t)frequency);
+            status = lms_set_frequency_cached(dev, ch, (uint32_t)frequency);
             if (status != 0) {
                 return status;
             }
@@ -2068,6 +2134,10 @@ static int bladerf1_set_frequency(struct bladerf *dev,
         case BLADERF_TUNING_MODE_FPGA: {
             status = dev->board->schedule_retune(dev, ch, BLADERF_RETUNE_NOW,
                                                  frequency, NULL);
+
+            /* The FPGA applies the DC correction along with the retune */
+            dc_applied = have_cap(board_data->capabilities,
+                                  BLADERF_CAP_RETUNE_DC);
             break;
         }
 
@@ -2081,38 +2151,36 @@ static int bladerf1_set_frequency(struct bladerf *dev,
     }
 
     if (dc_cal != NULL) {
-        dc_cal_tbl_entry(dc_cal, (uint32_t)frequency, &entry);
-
-        dc_i = entry.dc_i;
-        dc_q = entry.dc_q;
-
-        status = lms_set_dc_offset_i(dev, ch, dc_i);
-        if (status != 0) {
-            return status;
-        }
+        dc_lut = dc_cal_tbl_lut(dc_cal, (uint32_t)frequency);
 
-        status = lms_set_dc_offset_q(dev, ch, dc_q);
-        if (status != 0) {
-            return status;
+        if (!dc_applied) {
+            status = lms_set_dc_offset_regs(dev, ch, dc_lut->reg_i,
+                                            dc_lut->reg_q);
+            if (status != 0) {
+                return status;
+            }
         }
 
         if (ch == BLADERF_CHANNEL_RX(0) &&
             have_cap(board_data->capabilities, BLADERF_CAP_AGC_DC_LUT)) {
+            const struct dc_cal_entry *entry = &dc_lut->vals;
+
             status = dev->backend->set_agc_dc_correction(
-                dev, entry.max_dc_q, entry.max_dc_i, entry.mid_dc_q,
-                entry.mid_dc_i, entry.min_dc_q, entry.min_dc_i);
+                dev, entry->max_dc_q, entry->max_dc_i, entry->mid_dc_q,
+                entry->mid_dc_i, entry->min_dc_q, entry->min_dc_i);
             if (status != 0) {
                 return status;
             }
 
             log_verbose("Set AGC DC offset cal (I, Q) to: Max (%d, %d) "
                         " Mid (%d, %d) Min (%d, %d)\n",
-                        entry.max_dc_q, entry.max_dc_i, entry.mid_dc_q,
-                        entry.mid_dc_i, entry.min_dc_q, entry.min_dc_i);
+                        entry->max_dc_q, entry->max_dc_i, entry->mid_dc_q,
+                        entry->mid_dc_i, entry->min_dc_q, entry->min_dc_i);
         }
 
         log_verbose("Set %s DC offset cal (I, Q) to: (%d, %d)\n",
-                    (ch == BLADERF_CHANNEL_RX(0)) ? "RX" : "TX", dc_i, dc_q);
+                    (ch == BLADERF_CHANNEL_RX(0)) ? "RX" : "TX",
+                    dc_lut->vals.dc_i, dc_lut->vals.dc_q);
     }
 
     return 0;
@@ -2360,13 +2428,53 @@ static int bladerf1_get_rf_ports(struct bladerf *dev,
 /* Scheduled Tuning */
 /******************************************************************************/
 
+/* Bundle the DC calibration table's correction values for the quick tune
+ * parameters' frequency with them, if a table is loaded for the channel */
+static void quick_tune_add_dc_corr(struct bladerf *dev,
+                                   bladerf_channel ch,
+                                   struct bladerf_quick_tune *quick_tune)
+{
+    struct bladerf1_board_data *board_data = dev->board_data;
+    const struct dc_cal_lut_entry *dc_lut;
+    struct lms_freq f;
+    const struct dc_cal_tbl *dc_cal = (ch == BLADERF_CHANNEL_RX(0))
+                                          ? board_data->cal.dc_rx
+                                          : board_data->cal.dc_tx;
+
+    quick_tune->flags &= ~LMS_FREQ_FLAGS_DC_CORR;
+    quick_tune->dc_i = 0;
+    quick_tune->dc_q = 0;
+
+    if (dc_cal == NULL) {
+        return;
+    }
+
+    f.freqsel = quick_tune->freqsel;
+    f.nint    = quick_tune->nint;
+    f.nfrac   = quick_tune->nfrac;
+    f.x       = 1 << ((f.freqsel & 7) - 3);
+
+    dc_lut = dc_cal_tbl_lut(dc_cal, lms_frequency_to_hz(&f));
+
+    quick_tune->dc_i   = dc_lut->reg_i;
+    quick_tune->dc_q   = dc_lut->reg_q;
+    quick_tune->flags |= LMS_FREQ_FLAGS_DC_CORR;
+}
+
 static int bladerf1_get_quick_tune(struct bladerf *dev,
                                    bladerf_channel ch,
                                    struct bladerf_quick_tune *quick_tune)
 {
+    int status;
+
     CHECK_BOARD_STATE(STATE_INITIALIZED);
 
-    return lms_get_quick_tune(dev, ch, quick_tune);
+    status = lms_get_quick_tune(dev, ch, quick_tune);
+    if (status == 0) {
+        quick_tune_add_dc_corr(dev, ch, quick_tune);
+    }
+
+    return status;
 }
 
 static int bladerf1_schedule_retune(struct bladerf *dev,
@@ -2379,6 +2487,11 @@ static int bladerf1_schedule_retune(struct bladerf *dev,
     struct bladerf1_board_data *board_data = dev->board_data;
     int status;
     struct lms_freq f;
+    bool dc_corr = false;
+    uint8_t dc_i = 0, dc_q = 0;
+    const struct dc_cal_tbl *dc_cal = (ch == BLADERF_CHANNEL_RX(0))
+                                          ? board_data->cal.dc_rx
+                                          : board_data->cal.dc_tx;
 
     CHECK_BOARD_STATE(STATE_FPGA_LOADED);
 
@@ -2401,6 +2514,15 @@ static int bladerf1_schedule_retune(struct bladerf *dev,
         if (status != 0) {
             return status;
         }
+
+        if (dc_cal != NULL) {
+            const struct dc_cal_lut_entry *dc_lut =
+                dc_cal_tbl_lut(dc_cal, (uint32_t)frequency);
+
+            dc_corr = true;
+            dc_i    = dc_lut->reg_i;
+            dc_q    = dc_lut->reg_q;
+        }
     } else {
         f.freqsel       = quick_tune->freqsel;
         f.vcocap        = quick_tune->vcocap;
@@ -2410,13 +2532,38 @@ static int bladerf1_schedule_retune(struct bladerf *dev,
         f.xb_gpio       = quick_tune->xb_gpio;
         f.x             = 0;
         f.vcocap_result = 0;
+
+        if (quick_tune->flags & LMS_FREQ_FLAGS_DC_CORR) {
+            dc_corr = true;
+            dc_i    = quick_tune->dc_i;
+            dc_q    = quick_tune->dc_q;
+        } else if (dc_cal != NULL) {
+            struct bladerf_quick_tune qt = *quick_tune;
+
+            quick_tune_add_dc_corr(dev, ch, &qt);
+
+            dc_corr = true;
+            dc_i    = qt.dc_i;
+            dc_q    = qt.dc_q;
+        }
+    }
+
+    /* Have the FPGA apply the DC correction once it has retuned, rather
+     * than requiring a separate request at the time of the retune */
+    if (dc_corr && timestamp <= NIOS_PKT_RETUNE_DC_TIME_MAX &&
+        have_cap(board_data->capabilities, BLADERF_CAP_RETUNE_DC)) {
+        return dev->backend->retune_dc(
+            dev, ch, timestamp, f.nint, f.nfrac, f.freqsel, f.vcocap,
+            (f.flags & LMS_FREQ_FLAGS_LOW_BAND) != 0, f.xb_gpio,
+            (f.flags & LMS_FREQ_FLAGS_FORCE_VCOCAP) != 0, dc_i, dc_q);
     }
 
     return dev->backend->retune(dev, ch, timestamp, f.nint, f.nfrac, f.freqsel,
                                 f.vcocap,
                                 (f.flags & LMS_FREQ_FLAGS_LOW_BAND) != 0,
                                 f.xb_gpio,
-                                (f.flags & LMS_FREQ_FLAGS_FORCE_VCOCAP) != 0);
+                                (f.flags & LMS_FREQ_FLAGS_FORCE_VCOCAP) != 0,
+                                NULL);
 }
 
 static int bladerf1_cancel_scheduled_retunes(struct bladerf *dev,
@@ -2429,7 +2576,7 @@ static int bladerf1_cancel_scheduled_retunes(struct bladerf *dev,
 
     if (have_cap(board_data->capabilities, BLADERF_CAP_SCHEDULED_RETUNE)) {
         status = dev->backend->retune(dev, ch, NIOS_PKT_RETUNE_CLEAR_QUEUE, 0,
-                                      0, 0, 0, false, 0, false);
+                                      0, 0, 0, false, 0, false, NULL);
     } else {
         log_debug("This FPGA version (%u.%u.%u) does not support "
                   "scheduled retunes.\n",
@@ -2443,6 +2590,234 @@ static int bladerf1_cancel_scheduled_retunes(struct bladerf *dev,
     return status;
 }
 
+/* bladeRF1 quick tune parameters carry the full LMS6002D tuning state, and do
+ * not occupy FPGA storage. What is cached instead are the VCOCAP values found
+ * when tuning, which spare subsequent retunes the VCOCAP search. */
+static int bladerf1_get_quick_tune_stats(struct bladerf *dev,
+                                         bladerf_direction dir,
+                                         struct bladerf_quick_tune_stats *stats)
+{
+    struct bladerf1_board_data *board_data = dev->board_data;
+
+    CHECK_BOARD_STATE(STATE_INITIALIZED);
+
+    if (dir != BLADERF_RX && dir != BLADERF_TX) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    *stats = board_data->vcocap_cache.stats[dir];
+
+    return 0;
+}
+
+static int bladerf1_clear_quick_tune_cache(struct bladerf *dev,
+                                           bladerf_direction dir)
+{
+    struct bladerf1_board_data *board_data = dev->board_data;
+
+    CHECK_BOARD_STATE(STATE_INITIALIZED);
+
+    if (dir != BLADERF_RX && dir != BLADERF_TX) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    vcocap_cache_reset(&board_data->vcocap_cache, dir);
+
+    return 0;
+}
+
+/* Hop set frequency, with its position in the caller's list */
+struct hop_point {
+    bladerf_frequency frequency;
+    unsigned int idx;
+};
+
+static int hop_point_cmp(const void *a, const void *b)
+{
+    const struct hop_point *p = a;
+    const struct hop_point *q = b;
+
+    if (p->frequency < q->frequency) {
+        return -1;
+    } else if (p->frequency > q->frequency) {
+        return 1;
+    } else {
+        return 0;
+    }
+}
+
+static int bladerf1_build_hop_set(struct bladerf *dev,
+                                  bladerf_channel ch,
+                                  const bladerf_frequency *frequencies,
+                                  unsigned int n,
+                                  struct bladerf_quick_tune *quick_tunes)
+{
+    struct bladerf1_board_data *board_data = dev->board_data;
+    const struct bladerf_range *range      = NULL;
+    struct hop_point *points               = NULL;
+    struct bladerf_quick_tune *qt          = NULL;
+    struct bladerf_quick_tune *prev        = NULL;
+    struct lms_freq f;
+    bladerf_frequency orig_freq;
+    bool fpga_tune;
+    const bladerf_direction dir =
+        BLADERF_CHANNEL_IS_TX(ch) ? BLADERF_TX : BLADERF_RX;
+    uint8_t vcocap_est;
+    int vcocap, vcocap_err = 0;
+    bool cached;
+    unsigned int i;
+    int status, restore_status;
+
+    CHECK_BOARD_STATE(STATE_FPGA_LOADED);
+
+    if (ch != BLADERF_CHANNEL_RX(0) && ch != BLADERF_CHANNEL_TX(0)) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    status = bladerf1_get_frequency_range(dev, ch, &range);
+    if (status != 0) {
+        return status;
+    }
+
+    for (i = 0; i < n; i++) {
+        if (!is_within_range(range, frequencies[i])) {
+            log_debug("Hop set frequency %" BLADERF_PRIuFREQ " is out of "
+                      "range.\n", frequencies[i]);
+            return BLADERF_ERR_RANGE;
+        }
+    }
+
+    status = bladerf1_get_frequency(dev, ch, &orig_freq);
+    if (status != 0) {
+        return status;
+    }
+
+    /* The XB-200 path and filter are selected per frequency, so each entry
+     * must be visited via a full retune */
+    if (dev->xb == BLADERF_XB_200) {
+        for (i = 0; i < n && status == 0; i++) {
+            status = bladerf1_set_frequency(dev, ch, frequencies[i]);
+            if (status == 0) {
+                status = bladerf1_get_quick_tune(dev, ch, &quick_tunes[i]);
+            }
+        }
+
+        goto out;
+    }
+
+    points = malloc(n * sizeof(points[0]));
+    if (points == NULL) {
+        return BLADERF_ERR_MEM;
+    }
+
+    for (i = 0; i < n; i++) {
+        points[i].frequency = frequencies[i];
+        points[i].idx       = i;
+    }
+
+    /* Visiting frequencies in ascending order keeps successive entries within
+     * the same VCO band, where the VCOCAP estimate's error changes slowly */
+    qsort(points, n, sizeof(points[0]), hop_point_cmp);
+
+    /* When the FPGA tunes, each VCOCAP search costs a single NIOS request
+     * rather than a register access per step */
+    fpga_tune =
+        board_data->tuning_mode == BLADERF_TUNING_MODE_FPGA &&
+        have_cap(board_data->capabilities, BLADERF_CAP_SCHEDULED_RETUNE);
+
+    for (i = 0; i < n; i++) {
+        qt = &quick_tunes[points[i].idx];
+
+        if (prev != NULL && points[i].frequency == points[i - 1].frequency) {
+            *qt = *prev;
+            continue;
+        }
+
+        status = lms_calculate_tuning_params((uint32_t)points[i].frequency,
+                                             &f);
+        if (status != 0) {
+            goto out;
+        }
+
+        /* Start the search from where the previous one ended up, relative
+         * to its estimate */
+        vcocap_est = f.vcocap;
+        if (prev != NULL && prev->freqsel == f.freqsel) {
+            vcocap = (int)vcocap_est + vcocap_err;
+
+            if (vcocap < 0) {
+                vcocap = 0;
+            } else if (vcocap > 0x3f) {
+                vcocap = 0x3f;
+            }
+
+            f.vcocap = (uint8_t)vcocap;
+        }
+
+        /* A value found by an earlier search is a better starting point
+         * still, and need only be verified when tuning from the host */
+        cached = vcocap_cache_lookup(&board_data->vcocap_cache, dir,
+                                     (uint32_t)points[i].frequency,
+                                     &f.vcocap);
+        if (cached && !fpga_tune) {
+            f.flags |= LMS_FREQ_FLAGS_VERIFY_VCOCAP;
+        }
+
+        if (fpga_tune) {
+            status = dev->backend->retune(
+                dev, ch, BLADERF_RETUNE_NOW, f.nint, f.nfrac, f.freqsel,
+                f.vcocap, (f.flags & LMS_FREQ_FLAGS_LOW_BAND) != 0, 0, false,
+                &f.vcocap_result);
+
+            if (status == 0 && f.vcocap_result > 0x3f) {
+                log_debug("FPGA did not report a VCOCAP value.\n");
+                status = BLADERF_ERR_UNEXPECTED;
+            }
+        } else {
+            status = lms_set_precalculated_frequency(dev, ch, &f);
+        }
+
+        if (status != 0) {
+            log_debug("Failed to tune to %" BLADERF_PRIuFREQ " Hz: %s\n",
+                      points[i].frequency, bladerf_strerror(status));
+            goto out;
+        }
+
+        /* The FPGA always searches, but a search that stays put confirms
+         * the cached value just the same */
+        if (fpga_tune && cached && f.vcocap_result == f.vcocap) {
+            f.flags |= LMS_FREQ_FLAGS_VERIFY_VCOCAP;
+        }
+
+        vcocap_cache_update(&board_data->vcocap_cache, dir,
+                            (uint32_t)points[i].frequency, cached,
+                            (f.flags & LMS_FREQ_FLAGS_VERIFY_VCOCAP) != 0,
+                            f.vcocap_result);
+
+        vcocap_err = (int)f.vcocap_result - (int)vcocap_est;
+
+        qt->freqsel = f.freqsel;
+        qt->vcocap  = f.vcocap_result;
+        qt->nint    = f.nint;
+        qt->nfrac   = f.nfrac;
+        qt->flags   = LMS_FREQ_FLAGS_FORCE_VCOCAP |
+                    (f.flags & LMS_FREQ_FLAGS_LOW_BAND);
+        qt->xb_gpio = 0;
+
+        quick_tune_add_dc_corr(dev, ch, qt);
+
+        prev = qt;
+    }
+
+out:
+    free(points);
+
+    /* Leave the channel tuned as we found it */
+    restore_status = bladerf1_set_frequency(dev, ch, orig_freq);
+
+    return (status == 0) ? restore_status : status;
+}
+
 /******************************************************************************/
 /* DC/Phase/Gain Correction */
 /******************************************************************************/
@@ -2520,6 +2895,81 @@ static int bladerf1_set_correction(struct bladerf *dev, bladerf_channel ch,
     return status;
 }
 
+static int bladerf1_get_correction_profile(
+    struct bladerf *dev,
+    bladerf_channel ch,
+    struct bladerf_correction_profile *profile)
+{
+    int status;
+
+    CHECK_BOARD_STATE(STATE_INITIALIZED);
+
+    status = bladerf1_get_correction(dev, ch, BLADERF_CORR_DCOFF_I,
+                                     &profile->dcoff_i);
+    if (status != 0) {
+        return status;
+    }
+
+    status = bladerf1_get_correction(dev, ch, BLADERF_CORR_DCOFF_Q,
+                                     &profile->dcoff_q);
+    if (status != 0) {
+        return status;
+    }
+
+    status = bladerf1_get_correction(dev, ch, BLADERF_CORR_PHASE,
+                                     &profile->phase);
+    if (status != 0) {
+        return status;
+    }
+
+    return bladerf1_get_correction(dev, ch, BLADERF_CORR_GAIN, &profile->gain);
+}
+
+static int bladerf1_set_correction_profile(
+    struct bladerf *dev,
+    bladerf_channel ch,
+    const struct bladerf_correction_profile *profile)
+{
+    int status;
+
+    CHECK_BOARD_STATE(STATE_INITIALIZED);
+
+    if (ch != BLADERF_CHANNEL_RX(0) && ch != BLADERF_CHANNEL_TX(0)) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    /* Both LMS6002D DC offset registers are written in one batch */
+    status = lms_set_dc_offset_regs(dev, ch,
+                                    lms_dc_offset_to_reg(ch, profile->dcoff_i),
+                                    lms_dc_offset_to_reg(ch, profile->dcoff_q));
+    if (status != 0) {
+        return status;
+    }
+
+    status = dev->backend->set_iq_phase_correction(dev, ch, profile->phase);
+    if (status != 0) {
+        return status;
+    }
+
+    /* Gain correction requires than an offset be applied */
+    return dev->backend->set_iq_gain_correction(
+        dev, ch, profile->gain + (int16_t)4096);
+}
+
+static int bladerf1_set_quick_tune_correction_profile(
+    struct bladerf *dev,
+    bladerf_channel ch,
+    const struct bladerf_quick_tune *quick_tune,
+    const struct bladerf_correction_profile *profile)
+{
+    /* The phase and gain corrections are FPGA registers, which the NIOS does
+     * not update on a retune. Quick tunes already carry the DC corrections
+     * from a loaded DC calibration table. */
+    log_debug("Quick tune correction profiles are not supported by the "
+              "bladeRF1.\n");
+    return BLADERF_ERR_UNSUPPORTED;
+}
+
 /******************************************************************************/
 /* Trigger */
 /******************************************************************************/
@@ -2864,6 +3314,111 @@ static int bladerf1_sync_rx(struct bladerf *dev,
     return status;
 }
 
+static int bladerf1_sync_rx_acquire(struct bladerf *dev,
+                                    void **samples,
+                                    unsigned int *num_samples,
+                                    struct bladerf_metadata *metadata,
+                                    unsigned int timeout_ms)
+{
+    struct bladerf1_board_data *board_data = dev->board_data;
+
+    if (!board_data->sync[BLADERF_RX].initialized) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    return sync_rx_acquire(&board_data->sync[BLADERF_RX], samples,
+                           num_samples, metadata, timeout_ms);
+}
+
+static int bladerf1_sync_rx_release(struct bladerf *dev,
+                                    unsigned int num_samples)
+{
+    struct bladerf1_board_data *board_data = dev->board_data;
+
+    if (!board_data->sync[BLADERF_RX].initialized) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    return sync_rx_release(&board_data->sync[BLADERF_RX], num_samples);
+}
+
+static int bladerf1_sync_tx_acquire(struct bladerf *dev,
+                                    void **samples,
+                                    unsigned int *num_samples,
+                                    struct bladerf_metadata *metadata,
+                                    unsigned int timeout_ms)
+{
+    struct bladerf1_board_data *board_data = dev->board_data;
+
+    if (!board_data->sync[BLADERF_TX].initialized) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    return sync_tx_acquire(&board_data->sync[BLADERF_TX], samples,
+                           num_samples, metadata, timeout_ms);
+}
+
+static int bladerf1_sync_tx_commit(struct bladerf *dev,
+                                   unsigned int num_samples,
+                                   struct bladerf_metadata *metadata)
+{
+    struct bladerf1_board_data *board_data = dev->board_data;
+
+    if (!board_data->sync[BLADERF_TX].initialized) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    return sync_tx_commit(&board_data->sync[BLADERF_TX], num_samples,
+                          metadata);
+}
+
+static int bladerf1_get_stream_stats(struct bladerf *dev,
+                                     bladerf_direction dir,
+                                     struct bladerf_stream_stats *stats)
+{
+    struct bladerf1_board_data *board_data = dev->board_data;
+
+    if (dir != BLADERF_RX && dir != BLADERF_TX) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    if (!board_data->sync[dir].initialized) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    return sync_get_stats(&board_data->sync[dir], stats);
+}
+
+static int bladerf1_set_stream_thread_config(
+    struct bladerf *dev,
+    bladerf_direction dir,
+    const struct bladerf_stream_thread_config *config)
+{
+    struct bladerf1_board_data *board_data = dev->board_data;
+
+    if (dir != BLADERF_RX && dir != BLADERF_TX) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    return sync_set_thread_config(&board_data->sync[dir], config);
+}
+
+static int bladerf1_get_stream_thread_config(
+    struct bladerf *dev,
+    bladerf_direction dir,
+    struct bladerf_stream_thread_config *config)
+{
+    struct bladerf1_board_data *board_data = dev->board_data;
+
+    if (dir != BLADERF_RX && dir != BLADERF_TX) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    *config = board_data->sync[dir].thread_config;
+
+    return 0;
+}
+
 static int bladerf1_get_timestamp(struct bladerf *dev,
                                   bladerf_direction dir,
                                   bladerf_timestamp *value)
@@ -3567,8 +4122,15 @@ const struct board_fns bladerf1_board_fns = {
     FIELD_INIT(.get_quick_tune, bladerf1_get_quick_tune),
     FIELD_INIT(.schedule_retune, bladerf1_schedule_retune),
     FIELD_INIT(.cancel_scheduled_retunes, bladerf1_cancel_scheduled_retunes),
+    FIELD_INIT(.get_quick_tune_stats, bladerf1_get_quick_tune_stats),
+    FIELD_INIT(.clear_quick_tune_cache, bladerf1_clear_quick_tune_cache),
+    FIELD_INIT(.build_hop_set, bladerf1_build_hop_set),
     FIELD_INIT(.get_correction, bladerf1_get_correction),
     FIELD_INIT(.set_correction, bladerf1_set_correction),
+    FIELD_INIT(.get_correction_profile, bladerf1_get_correction_profile),
+    FIELD_INIT(.set_correction_profile, bladerf1_set_correction_profile),
+    FIELD_INIT(.set_quick_tune_correction_profile,
+               bladerf1_set_quick_tune_correction_profile),
     FIELD_INIT(.trigger_init, bladerf1_trigger_init),
     FIELD_INIT(.trigger_arm, bladerf1_trigger_arm),
     FIELD_INIT(.trigger_fire, bladerf1_trigger_fire),
@@ -3583,6 +4145,13 @@ const struct board_fns bladerf1_board_fns = {
     FIELD_INIT(.sync_config, bladerf1_sync_config),
     FIELD_INIT(.sync_tx, bladerf1_sync_tx),
     FIELD_INIT(.sync_rx, bladerf1_sync_rx),
+    FIELD_INIT(.sync_rx_acquire, bladerf1_sync_rx_acquire),
+    FIELD_INIT(.sync_rx_release, bladerf1_sync_rx_release),
+    FIELD_INIT(.sync_tx_acquire, bladerf1_sync_tx_acquire),
+    FIELD_INIT(.sync_tx_commit, bladerf1_sync_tx_commit),
+    FIELD_INIT(.get_stream_stats, bladerf1_get_stream_stats),
+    FIELD_INIT(.set_stream_thread_config, bladerf1_set_stream_thread_config),
+    FIELD_INIT(.get_stream_thread_config, bladerf1_get_stream_thread_config),
     FIELD_INIT(.get_timestamp, bladerf1_get_timestamp),
     FIELD_INIT(.load_fpga, bladerf1_load_fpga),
     FIELD_INIT(.flash_fpga, bladerf1_flash_fpga),
@@ -4025,6 +4594,36 @@ int bladerf_calibrate_dc(struct bladerf *dev, bladerf_cal_module module)
     return status;
 }
 
+/******************************************************************************/
+/* VCOCAP cache */
+/******************************************************************************/
+
+int bladerf_set_vcocap_cache_file(struct bladerf *dev, const char *path)
+{
+    struct bladerf1_board_data *board_data;
+    int status;
+
+    if (dev->board != &bladerf1_board_fns)
+        return BLADERF_ERR_UNSUPPORTED;
+
+    MUTEX_LOCK(&dev->lock);
+
+    CHECK_BOARD_STATE_LOCKED(STATE_INITIALIZED);
+
+    board_data = dev->board_data;
+
+    /* Save what has been found so far to the file being replaced */
+    status = vcocap_cache_save(&board_data->vcocap_cache, dev->ident.serial);
+    if (status == 0) {
+        status = vcocap_cache_set_file(&board_data->vcocap_cache,
+                                       dev->ident.serial, path);
+    }
+
+    MUTEX_UNLOCK(&dev->lock);
+
+    return status;
+}
+
 /******************************************************************************/
 /* Low-level Si5338 access */
 /******************************************************************************/
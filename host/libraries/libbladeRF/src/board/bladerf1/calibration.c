@@ -42,16 +42,24 @@
  *        [uint32_t: Frequency]
  *        [int16_t:  DC I correction value]
  *        [int16_t:  DC Q correction value]
+ *
+ * For table format version 2 and later, an entry is followed by the DC I and
+ * Q correction values for the max, mid and min AGC gain settings, each as an
+ * int16_t.
+ *
+ * When a table is loaded, the entries are compiled into a lookup table with
+ * uniformly spaced frequencies, so a retune only needs to index into it.
  */
 
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
-#include <float.h>
 
 #include "host_config.h"
 #include "minmax.h"
 
+#include "lms.h"
+
 #include "calibration.h"
 
 #ifdef TEST_DC_CAL_TABLE
@@ -70,6 +78,14 @@
 #define DC_CAL_TBL_ENTRY_SIZE   (sizeof(uint32_t) + 2 * sizeof(int16_t))
 #define DC_CAL_TBL_MIN_SIZE     (DC_CAL_TBL_META_SIZE + DC_CAL_TBL_ENTRY_SIZE)
 
+/* Size of the AGC values that follow each entry in version 2+ tables */
+#define DC_CAL_TBL_AGC_SIZE     (6 * sizeof(int16_t))
+
+/* Lookup table frequency spacing. This is increased for tables spanning a
+ * range that would otherwise require more than DC_CAL_LUT_MAX_LEN entries. */
+#define DC_CAL_LUT_STEP         1000000u
+#define DC_CAL_LUT_MAX_LEN      8192u
+
 static inline bool entry_matches(const struct dc_cal_tbl *tbl,
                                  unsigned int entry_idx, unsigned int freq)
 {
@@ -142,11 +158,118 @@ unsigned int dc_cal_tbl_lookup(const struct dc_cal_tbl *tbl, unsigned int freq)
     return find_entry(tbl, tbl->curr_idx, 0, tbl->n_entries - 1, freq, &limit);
 }
 
-struct dc_cal_tbl * dc_cal_tbl_load(const uint8_t *buf, size_t buf_len)
+/* Interpolate a y value given two points and a desired x value, rounding to
+ * the nearest integer
+ *
+ * y = interp( (x0, y0), (x1, y1), x )
+ */
+static inline int16_t interp(unsigned int x0, int16_t y0,
+                             unsigned int x1, int16_t y1,
+                             unsigned int x)
+{
+    const int64_t den = (int64_t) x1 - x0;
+    int64_t num;
+
+    if (den <= 0) {
+        return y0;
+    }
+
+    num  = ((int64_t) y1 - y0) * ((int64_t) x - x0);
+    num += (num < 0) ? -(den / 2) : (den / 2);
+
+    return (int16_t) (y0 + num / den);
+}
+
+static inline void dc_cal_interp_entry(const struct dc_cal_tbl *tbl,
+                                       unsigned int idx_low,
+                                       unsigned int idx_high,
+                                       unsigned int freq,
+                                       struct dc_cal_entry *entry)
+{
+    const unsigned int f_low = tbl->entries[idx_low].freq;
+    const unsigned int f_high = tbl->entries[idx_high].freq;
+
+#define ENTRY_VAR(x)                                                        \
+    entry->x    = interp(f_low, tbl->entries[idx_low].x,                    \
+                         f_high, tbl->entries[idx_high].x,                  \
+                         freq)
+
+    entry->freq = freq;
+
+    ENTRY_VAR(dc_i);
+    ENTRY_VAR(dc_q);
+
+    ENTRY_VAR(max_dc_i);
+    ENTRY_VAR(max_dc_q);
+    ENTRY_VAR(mid_dc_i);
+    ENTRY_VAR(mid_dc_q);
+    ENTRY_VAR(min_dc_i);
+    ENTRY_VAR(min_dc_q);
+
+#undef ENTRY_VAR
+}
+
+/* Populate the lookup table from the table's entries */
+static int dc_cal_tbl_compile(struct dc_cal_tbl *tbl, bladerf_module module)
+{
+    const unsigned int f_first = tbl->entries[0].freq;
+    const unsigned int f_last  = tbl->entries[tbl->n_entries - 1].freq;
+    unsigned int step = DC_CAL_LUT_STEP;
+    unsigned int i, idx = 0;
+
+    /* Entries are interpolated between, so their frequencies must be
+     * strictly ascending */
+    for (i = 1; i < tbl->n_entries; i++) {
+        if (tbl->entries[i].freq <= tbl->entries[i - 1].freq) {
+            log_debug("DC cal table entries are not sorted by frequency.\n");
+            return BLADERF_ERR_INVAL;
+        }
+    }
+
+    if ((f_last - f_first) / step >= DC_CAL_LUT_MAX_LEN) {
+        step = (f_last - f_first) / (DC_CAL_LUT_MAX_LEN - 1) + 1;
+    }
+
+    tbl->lut_start = f_first;
+    tbl->lut_step  = step;
+    tbl->lut_len   = (f_last - f_first) / step + 1;
+
+    tbl->lut = malloc(sizeof(tbl->lut[0]) * tbl->lut_len);
+    if (tbl->lut == NULL) {
+        return BLADERF_ERR_MEM;
+    }
+
+    /* The lookup table frequencies are ascending, so the entries
+     * surrounding each of them can be found in a single pass */
+    for (i = 0; i < tbl->lut_len; i++) {
+        const unsigned int freq = f_first + i * step;
+        struct dc_cal_lut_entry *e = &tbl->lut[i];
+
+        while (idx < (tbl->n_entries - 1) && tbl->entries[idx + 1].freq <= freq) {
+            idx++;
+        }
+
+        if (idx == (tbl->n_entries - 1)) {
+            e->vals      = tbl->entries[idx];
+            e->vals.freq = freq;
+        } else {
+            dc_cal_interp_entry(tbl, idx, idx + 1, freq, &e->vals);
+        }
+
+        e->reg_i = lms_dc_offset_to_reg(module, e->vals.dc_i);
+        e->reg_q = lms_dc_offset_to_reg(module, e->vals.dc_q);
+    }
+
+    return 0;
+}
+
+struct dc_cal_tbl * dc_cal_tbl_load(const uint8_t *buf, size_t buf_len,
+                                    bladerf_module module)
 {
     struct dc_cal_tbl *ret;
     uint32_t i;
     uint16_t magic;
+    size_t entry_size;
 
     if (buf_len < DC_CAL_TBL_MIN_SIZE) {
         return NULL;
@@ -159,7 +282,7 @@ struct dc_cal_tbl * dc_cal_tbl_load(const uint8_t *buf, size_t buf_len)
     }
     buf += sizeof(magic);
 
-    ret = malloc(sizeof(ret[0]));
+    ret = calloc(1, sizeof(ret[0]));
     if (ret == NULL) {
         return NULL;
     }
@@ -174,14 +297,19 @@ struct dc_cal_tbl * dc_cal_tbl_load(const uint8_t *buf, size_t buf_len)
     ret->n_entries = LE32_TO_HOST(ret->n_entries);
     buf += sizeof(ret->n_entries);
 
-    if (buf_len <
-         (DC_CAL_TBL_META_SIZE + DC_CAL_TBL_ENTRY_SIZE * ret->n_entries) ) {
+    entry_size = DC_CAL_TBL_ENTRY_SIZE;
+    if (ret->version >= 2) {
+        entry_size += DC_CAL_TBL_AGC_SIZE;
+    }
+
+    if (ret->n_entries == 0 ||
+        (buf_len - DC_CAL_TBL_META_SIZE) / entry_size < ret->n_entries) {
 
         free(ret);
         return NULL;
     }
 
-    ret->entries = malloc(sizeof(ret->entries[0]) * ret->n_entries);
+    ret->entries = calloc(ret->n_entries, sizeof(ret->entries[0]));
     if (ret->entries == NULL) {
         free(ret);
         return NULL;
@@ -241,6 +369,10 @@ struct dc_cal_tbl * dc_cal_tbl_load(const uint8_t *buf, size_t buf_len)
         }
     }
 
+    if (dc_cal_tbl_compile(ret, module) != 0) {
+        dc_cal_tbl_free(&ret);
+    }
+
     return ret;
 }
 
@@ -260,9 +392,11 @@ int dc_cal_tbl_image_load(struct bladerf *dev,
         return status;
     }
 
-    if (img->type == BLADERF_IMAGE_TYPE_RX_DC_CAL ||
-            img->type == BLADERF_IMAGE_TYPE_TX_DC_CAL) {
-        *tbl = dc_cal_tbl_load(img->data, img->length);
+    if (img->type == BLADERF_IMAGE_TYPE_RX_DC_CAL) {
+        *tbl = dc_cal_tbl_load(img->data, img->length, BLADERF_MODULE_RX);
+        status = 0;
+    } else if (img->type == BLADERF_IMAGE_TYPE_TX_DC_CAL) {
+        *tbl = dc_cal_tbl_load(img->data, img->length, BLADERF_MODULE_TX);
         status = 0;
     } else {
         status = BLADERF_ERR_INVAL;
@@ -273,66 +407,16 @@ int dc_cal_tbl_image_load(struct bladerf *dev,
     return status;
 }
 
-/* Interpolate a y value given two points and a desired x value
- *
- * y = interp( (x0, y0), (x1, y1), x )
- *
- * Returns
- */
-static inline unsigned int interp(unsigned int x0, unsigned int y0,
-                           unsigned int x1, unsigned int y1,
-                           unsigned int x)
-{
-    const float num = (float) y1 - y0;
-    const float den = (float) x1 - x0;
-    const float m = den == 0 ? FLT_MAX : num / den;
-    const float y = (x - x0) * m + y0;
-
-    return (unsigned int) y;
-}
-
-static inline void dc_cal_interp_entry(const struct dc_cal_tbl *tbl,
-                                       unsigned int idx_low,
-                                       unsigned int idx_high,
-                                       unsigned int freq,
-                                       struct dc_cal_entry *entry)
-{
-    const unsigned int f_low = tbl->entries[idx_low].freq;
-    const unsigned int f_high = tbl->entries[idx_high].freq;
-
-#define ENTRY_VAR(x)                                                        \
-    entry->x    = (int16_t) interp(f_low, tbl->entries[idx_low].x,          \
-                             f_high, tbl->entries[idx_low].x,               \
-                             freq)
-
-    ENTRY_VAR(dc_i);
-    ENTRY_VAR(dc_q);
-
-    ENTRY_VAR(max_dc_i);
-    ENTRY_VAR(max_dc_q);
-    ENTRY_VAR(mid_dc_i);
-    ENTRY_VAR(mid_dc_q);
-    ENTRY_VAR(min_dc_i);
-    ENTRY_VAR(min_dc_q);
-}
-
 void dc_cal_tbl_entry(const struct dc_cal_tbl *tbl, unsigned int freq,
                       struct dc_cal_entry *entry)
 {
-    const unsigned int idx = dc_cal_tbl_lookup(tbl, freq);
-
-    if (tbl->entries[idx].freq == freq) {
-        memcpy(entry, &tbl->entries[idx], sizeof(struct dc_cal_entry));
-    } else if (idx == (tbl->n_entries - 1)) {
-        dc_cal_interp_entry(tbl, idx - 1, idx, freq, entry);
-    } else {
-        dc_cal_interp_entry(tbl, idx, idx + 1, freq, entry);
-    }
+    *entry = dc_cal_tbl_lut(tbl, freq)->vals;
 }
 
 void dc_cal_tbl_free(struct dc_cal_tbl **tbl)
 {
     if (*tbl != NULL) {
+        free((*tbl)->lut);
         free((*tbl)->entries);
         free(*tbl);
         *tbl = NULL;
@@ -39,6 +39,16 @@ struct dc_cal_entry {
     int16_t min_dc_q;
 };
 
+/* DC calibration values at a point in a dc_cal_tbl's lookup table */
+struct dc_cal_lut_entry {
+    struct dc_cal_entry vals; /* Values interpolated from the table entries */
+
+    /* LMS6002D DC offset register values for vals.dc_i and vals.dc_q, which
+     * may be written with lms_set_dc_offset_regs() */
+    uint8_t reg_i;
+    uint8_t reg_q;
+};
+
 struct dc_cal_tbl {
     uint32_t version;
     uint32_t n_entries;
@@ -46,6 +56,13 @@ struct dc_cal_tbl {
 
     unsigned int curr_idx;
     struct dc_cal_entry *entries; /* Sorted (increasing) by freq */
+
+    /* Lookup table spanning the frequency range of the entries, at uniformly
+     * spaced frequencies: lut[i] applies to lut_start + i * lut_step Hz */
+    unsigned int lut_start;
+    unsigned int lut_step;
+    unsigned int lut_len;
+    struct dc_cal_lut_entry *lut;
 };
 
 extern struct dc_cal_tbl rx_cal_test;
@@ -60,11 +77,40 @@ extern struct dc_cal_tbl rx_cal_test;
  */
 unsigned int dc_cal_tbl_lookup(const struct dc_cal_tbl *tbl, unsigned int freq);
 
+/**
+ * Get the lookup table entry nearest to the specified frequency. Frequencies
+ * outside of the table's range use the first or last entry.
+ *
+ * This is a constant time operation.
+ *
+ * @param[in]   tbl     Table to search
+ * @param[in]   freq    Desired frequency
+ *
+ * @return lookup table entry
+ */
+static inline const struct dc_cal_lut_entry *dc_cal_tbl_lut(
+                                                const struct dc_cal_tbl *tbl,
+                                                unsigned int freq)
+{
+    unsigned int idx = 0;
+
+    if (freq > tbl->lut_start) {
+        idx = (freq - tbl->lut_start + tbl->lut_step / 2) / tbl->lut_step;
+        if (idx >= tbl->lut_len) {
+            idx = tbl->lut_len - 1;
+        }
+    }
+
+    return &tbl->lut[idx];
+}
+
 /**
  * Get the DC cal values associated with the specified frequencies. If the
  * specified frequency is not in the table, the DC calibration values will
  * be interpolated from surrounding entries.
  *
+ * The values are taken from the table's lookup table, via dc_cal_tbl_lut().
+ *
  * @param[in]   tbl      Table to search
  * @param[in]   freq     Desired frequency
  * @param[out]  entry    Found or interpolated DC calibration values
@@ -74,14 +120,18 @@ void dc_cal_tbl_entry(const struct dc_cal_tbl *tbl,
                       struct dc_cal_entry *entry);
 
 /**
- * Load a DC calibration table from the provided data
+ * Load a DC calibration table from the provided data, and compile its lookup
+ * table.
  *
- * @param[in]   buf   Packed table data
- * @param[in]   len   Length of packed data, in bytes
+ * @param[in]   buf     Packed table data
+ * @param[in]   len     Length of packed data, in bytes
+ * @param[in]   module  Module the table applies to. This determines how the
+ *                      LMS6002D register values are computed.
  *
  * @return Loaded DC calibration table, or NULL on error
  */
-struct dc_cal_tbl *dc_cal_tbl_load(const uint8_t *buf, size_t buf_len);
+struct dc_cal_tbl *dc_cal_tbl_load(const uint8_t *buf, size_t buf_len,
+                                   bladerf_module module);
 
 /**
  * Load a DC calibration table from an image file
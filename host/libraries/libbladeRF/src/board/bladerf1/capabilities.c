@@ -114,5 +114,10 @@ uint64_t bladerf1_get_fpga_capabilities(const struct bladerf_version *fpga_versi
         capabilities |= BLADERF_CAP_FPGA_8BIT_SAMPLES;
     }
 
+    if (version_fields_greater_or_equal(fpga_version, 0, 16, 0)) {
+        capabilities |= BLADERF_CAP_NIOS_8x8_BATCH;
+        capabilities |= BLADERF_CAP_RETUNE_DC;
+    }
+
     return capabilities;
 }
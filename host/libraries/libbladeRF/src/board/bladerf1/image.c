@@ -141,6 +141,7 @@ static bool image_type_is_valid(bladerf_image_type type) {
         case BLADERF_IMAGE_TYPE_RX_IQ_CAL:
         case BLADERF_IMAGE_TYPE_TX_IQ_CAL:
         case BLADERF_IMAGE_TYPE_GAIN_CAL:
+        case BLADERF_IMAGE_TYPE_HOP_SET:
             return true;
 
         default:
@@ -329,6 +330,8 @@ const char* bladerf_image_type_to_string(bladerf_image_type type) {
             return "FPGA A5 Bitstream";
         case BLADERF_IMAGE_TYPE_GAIN_CAL:
             return "Gain Calibration";
+        case BLADERF_IMAGE_TYPE_HOP_SET:
+            return "Quick Tune Hop Set";
         default:
             return "Unknown Type";
     }
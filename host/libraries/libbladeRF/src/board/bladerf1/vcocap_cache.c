@@ -0,0 +1,287 @@
+/*
+ * This file is part of the bladeRF project:
+ *   http://www.github.com/nuand/bladeRF
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/* VCOCAP cache files are stored as follows. All values are little-endian
+ * byte order.
+ *
+ * 0x0000 [8 bytes:  "BRFVCAP", NUL-terminated]
+ * 0x0008 [uint32_t: File format version]
+ * 0x000c [uint32_t: Frequency bin width (Hz)]
+ * 0x0010 [uint32_t: Frequency of the first bin (Hz)]
+ * 0x0014 [uint32_t: Number of bins, N]
+ * 0x0018 [33 bytes: Device serial number, NUL-terminated]
+ * 0x0039 [N bytes:  RX VCOCAP values, 0xff where unknown]
+ * 0x0039 + N [N bytes: TX VCOCAP values, 0xff where unknown]
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_config.h"
+#include "log.h"
+
+#include "vcocap_cache.h"
+
+#define VCOCAP_CACHE_MAGIC   "BRFVCAP"
+#define VCOCAP_CACHE_VERSION 1
+
+#define VCOCAP_CACHE_HDR_LEN (8 + 4 * sizeof(uint32_t) + BLADERF_SERIAL_LENGTH)
+
+static inline size_t freq_to_bin(uint32_t freq)
+{
+    if (freq < BLADERF_FREQUENCY_MIN) {
+        freq = BLADERF_FREQUENCY_MIN;
+    } else if (freq > BLADERF_FREQUENCY_MAX) {
+        freq = BLADERF_FREQUENCY_MAX;
+    }
+
+    return (freq - BLADERF_FREQUENCY_MIN) / VCOCAP_CACHE_BIN_HZ;
+}
+
+static unsigned int count_profiles(const uint8_t *vcocap)
+{
+    unsigned int count = 0;
+    size_t i;
+
+    for (i = 0; i < VCOCAP_CACHE_BINS; i++) {
+        count += (vcocap[i] != VCOCAP_CACHE_EMPTY);
+    }
+
+    return count;
+}
+
+static inline void put_le32(uint8_t *buf, uint32_t val)
+{
+    val = HOST_TO_LE32(val);
+    memcpy(buf, &val, sizeof(val));
+}
+
+static inline uint32_t get_le32(const uint8_t *buf)
+{
+    uint32_t val;
+    memcpy(&val, buf, sizeof(val));
+    return LE32_TO_HOST(val);
+}
+
+void vcocap_cache_reset(struct vcocap_cache *cache, bladerf_direction dir)
+{
+    memset(cache->vcocap[dir], VCOCAP_CACHE_EMPTY, VCOCAP_CACHE_BINS);
+    memset(&cache->stats[dir], 0, sizeof(cache->stats[dir]));
+    cache->stats[dir].capacity = VCOCAP_CACHE_BINS;
+    cache->dirty = true;
+}
+
+bool vcocap_cache_lookup(const struct vcocap_cache *cache,
+                         bladerf_direction dir,
+                         uint32_t freq,
+                         uint8_t *vcocap)
+{
+    const uint8_t value = cache->vcocap[dir][freq_to_bin(freq)];
+
+    if (value == VCOCAP_CACHE_EMPTY) {
+        return false;
+    }
+
+    *vcocap = value;
+    return true;
+}
+
+void vcocap_cache_update(struct vcocap_cache *cache,
+                         bladerf_direction dir,
+                         uint32_t freq,
+                         bool looked_up,
+                         bool verified,
+                         uint8_t vcocap)
+{
+    struct bladerf_quick_tune_stats *stats = &cache->stats[dir];
+    uint8_t *entry = &cache->vcocap[dir][freq_to_bin(freq)];
+
+    if (verified) {
+        stats->hits++;
+        return;
+    }
+
+    stats->misses++;
+
+    if (looked_up) {
+        stats->evictions++;
+    } else if (*entry == VCOCAP_CACHE_EMPTY) {
+        stats->profiles++;
+    }
+
+    if (*entry != vcocap) {
+        *entry       = vcocap;
+        cache->dirty = true;
+    }
+}
+
+/* Load the values in a cache file. A file that does not exist is not an
+ * error, and leaves the cache as-is with `found` cleared. */
+static int load_file(struct vcocap_cache *cache, const char *serial,
+                     const char *path, bool *found)
+{
+    uint8_t hdr[VCOCAP_CACHE_HDR_LEN];
+    uint8_t (*values)[VCOCAP_CACHE_BINS];
+    char file_serial[BLADERF_SERIAL_LENGTH];
+    int status = 0;
+    FILE *f;
+    int dir;
+
+    *found = false;
+
+    f = fopen(path, "rb");
+    if (f == NULL) {
+        if (errno == ENOENT) {
+            log_debug("VCOCAP cache %s will be created\n", path);
+            return 0;
+        }
+
+        log_debug("Failed to open VCOCAP cache %s: %s\n", path,
+                  strerror(errno));
+        return BLADERF_ERR_IO;
+    }
+
+    *found = true;
+
+    values = malloc(sizeof(cache->vcocap));
+    if (values == NULL) {
+        fclose(f);
+        return BLADERF_ERR_MEM;
+    }
+
+    if (fread(hdr, sizeof(hdr), 1, f) != 1 ||
+        memcmp(hdr, VCOCAP_CACHE_MAGIC, sizeof(VCOCAP_CACHE_MAGIC)) != 0 ||
+        get_le32(&hdr[0x08]) != VCOCAP_CACHE_VERSION ||
+        get_le32(&hdr[0x0c]) != VCOCAP_CACHE_BIN_HZ ||
+        get_le32(&hdr[0x10]) != BLADERF_FREQUENCY_MIN ||
+        get_le32(&hdr[0x14]) != VCOCAP_CACHE_BINS ||
+        fread(values, sizeof(cache->vcocap), 1, f) != 1) {
+        log_warning("%s is not a valid VCOCAP cache file.\n", path);
+        status = BLADERF_ERR_INVAL;
+        goto out;
+    }
+
+    memcpy(file_serial, &hdr[0x18], sizeof(file_serial));
+    file_serial[sizeof(file_serial) - 1] = '\0';
+
+    if (strcmp(file_serial, serial) != 0) {
+        log_warning("VCOCAP cache %s is for device %s, not %s.\n",
+                    path, file_serial, serial);
+        status = BLADERF_ERR_INVAL;
+        goto out;
+    }
+
+    memcpy(cache->vcocap, values, sizeof(cache->vcocap));
+
+    for (dir = BLADERF_RX; dir <= BLADERF_TX; dir++) {
+        cache->stats[dir].profiles = count_profiles(cache->vcocap[dir]);
+    }
+
+    log_debug("Loaded VCOCAP cache %s (RX: %u, TX: %u values)\n", path,
+              cache->stats[BLADERF_RX].profiles,
+              cache->stats[BLADERF_TX].profiles);
+
+out:
+    free(values);
+    fclose(f);
+    return status;
+}
+
+int vcocap_cache_set_file(struct vcocap_cache *cache,
+                          const char *serial,
+                          const char *path)
+{
+    char *path_copy = NULL;
+    bool found      = false;
+    int status;
+
+    if (path != NULL) {
+        path_copy = strdup(path);
+        if (path_copy == NULL) {
+            return BLADERF_ERR_MEM;
+        }
+
+        status = load_file(cache, serial, path, &found);
+        if (status != 0) {
+            free(path_copy);
+            return status;
+        }
+    }
+
+    free(cache->path);
+    cache->path  = path_copy;
+
+    /* Create a file that does not exist yet upon the next save */
+    cache->dirty = (path_copy != NULL && !found);
+
+    return 0;
+}
+
+int vcocap_cache_save(struct vcocap_cache *cache, const char *serial)
+{
+    uint8_t hdr[VCOCAP_CACHE_HDR_LEN];
+    int status = 0;
+    FILE *f;
+
+    if (cache->path == NULL || !cache->dirty) {
+        return 0;
+    }
+
+    memset(hdr, 0, sizeof(hdr));
+    memcpy(hdr, VCOCAP_CACHE_MAGIC, sizeof(VCOCAP_CACHE_MAGIC));
+    put_le32(&hdr[0x08], VCOCAP_CACHE_VERSION);
+    put_le32(&hdr[0x0c], VCOCAP_CACHE_BIN_HZ);
+    put_le32(&hdr[0x10], BLADERF_FREQUENCY_MIN);
+    put_le32(&hdr[0x14], VCOCAP_CACHE_BINS);
+    strncpy((char *)&hdr[0x18], serial, BLADERF_SERIAL_LENGTH - 1);
+
+    f = fopen(cache->path, "wb");
+    if (f == NULL) {
+        log_debug("Failed to create VCOCAP cache %s: %s\n", cache->path,
+                  strerror(errno));
+        return BLADERF_ERR_IO;
+    }
+
+    if (fwrite(hdr, sizeof(hdr), 1, f) != 1 ||
+        fwrite(cache->vcocap, sizeof(cache->vcocap), 1, f) != 1) {
+        log_debug("Failed to write VCOCAP cache %s: %s\n", cache->path,
+                  strerror(errno));
+        status = BLADERF_ERR_IO;
+    }
+
+    if (fclose(f) != 0 && status == 0) {
+        status = BLADERF_ERR_IO;
+    }
+
+    if (status == 0) {
+        cache->dirty = false;
+    }
+
+    return status;
+}
+
+void vcocap_cache_deinit(struct vcocap_cache *cache)
+{
+    free(cache->path);
+    cache->path = NULL;
+}
@@ -0,0 +1,132 @@
+/*
+ * This file is part of the bladeRF project:
+ *   http://www.github.com/nuand/bladeRF
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef BLADERF1_VCOCAP_CACHE_H_
+#define BLADERF1_VCOCAP_CACHE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <libbladeRF.h>
+
+/* The VCOCAP value that the LMS6002D's VTUNE search converges to for a given
+ * frequency is stable for a particular unit at a particular temperature. The
+ * cache records the values found, in frequency bins, so that subsequent
+ * retunes may start from them and verify them with a single VTUNE reading. */
+
+/* Width of a frequency bin */
+#define VCOCAP_CACHE_BIN_HZ 1000000u
+
+/* Number of bins covering the LMS6002D's frequency range */
+#define VCOCAP_CACHE_BINS \
+    ((BLADERF_FREQUENCY_MAX - BLADERF_FREQUENCY_MIN) / VCOCAP_CACHE_BIN_HZ + 1)
+
+/* Marks a bin for which no value is known */
+#define VCOCAP_CACHE_EMPTY 0xff
+
+struct vcocap_cache {
+    /* Cached values, indexed by bladerf_direction and then bin */
+    uint8_t vcocap[2][VCOCAP_CACHE_BINS];
+
+    /* Hits are verified values, misses are full searches, and evictions are
+     * values that failed verification */
+    struct bladerf_quick_tune_stats stats[2];
+
+    /* File the cache is persisted to, or NULL */
+    char *path;
+
+    /* Values have changed since the cache was loaded or saved */
+    bool dirty;
+};
+
+/**
+ * Discard all cached values of a direction, and reset its statistics
+ *
+ * @param       cache       Cache
+ * @param[in]   dir         Direction
+ */
+void vcocap_cache_reset(struct vcocap_cache *cache, bladerf_direction dir);
+
+/**
+ * Look up the VCOCAP value found for a frequency
+ *
+ * @param       cache       Cache
+ * @param[in]   dir         Direction
+ * @param[in]   freq        LMS6002D frequency
+ * @param[out]  vcocap      Cached value
+ *
+ * @return true if a value is cached, false otherwise
+ */
+bool vcocap_cache_lookup(const struct vcocap_cache *cache,
+                         bladerf_direction dir,
+                         uint32_t freq,
+                         uint8_t *vcocap);
+
+/**
+ * Record the outcome of a retune
+ *
+ * @param       cache       Cache
+ * @param[in]   dir         Direction
+ * @param[in]   freq        LMS6002D frequency
+ * @param[in]   looked_up   A cached value was used as the starting point
+ * @param[in]   verified    The cached value was used as-is
+ * @param[in]   vcocap      VCOCAP value that the retune resulted in
+ */
+void vcocap_cache_update(struct vcocap_cache *cache,
+                         bladerf_direction dir,
+                         uint32_t freq,
+                         bool looked_up,
+                         bool verified,
+                         uint8_t vcocap);
+
+/**
+ * Persist the cache in a file. Values in the file replace any that are cached.
+ * A file that does not yet exist is created when the cache is saved.
+ *
+ * @param       cache       Cache
+ * @param[in]   serial      Serial number of the device
+ * @param[in]   path        File path, or NULL to stop persisting the cache
+ *
+ * @return 0 on success, BLADERF_ERR_INVAL if the file is not a cache file for
+ *         this device, or a value from \ref RETCODES list on failure
+ */
+int vcocap_cache_set_file(struct vcocap_cache *cache,
+                          const char *serial,
+                          const char *path);
+
+/**
+ * Write the cache to its file, if it has one and values have changed
+ *
+ * @param       cache       Cache
+ * @param[in]   serial      Serial number of the device
+ *
+ * @return 0 on success, value from \ref RETCODES list on failure
+ */
+int vcocap_cache_save(struct vcocap_cache *cache, const char *serial);
+
+/**
+ * Release the resources associated with a cache, without saving it
+ *
+ * @param       cache       Cache
+ */
+void vcocap_cache_deinit(struct vcocap_cache *cache);
+
+#endif
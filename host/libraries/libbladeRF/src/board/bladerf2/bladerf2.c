@@ -37,7 +37,9 @@
 #include "compatibility.h"
 
 #include "ad936x.h"
+#include "ad936x_correction.h"
 #include "ad936x_helpers.h"
+#include "nios_pkt_16x64.h"
 
 #include "driver/fpga_trigger.h"
 #include "driver/fx3_fw.h"
@@ -200,9 +202,9 @@ static int _bladerf2_initialize(struct bladerf *dev)
     /* Configure PLL */
     CHECK_STATUS(bladerf_set_pll_refclk(dev, BLADERF_REFIN_DEFAULT));
 
-    /* Reset current quick tune profile number */
-    board_data->quick_tune_rx_profile = 0;
-    board_data->quick_tune_tx_profile = 0;
+    /* Reset quick tune profile caches */
+    fastlock_cache_reset(&board_data->quick_tune_cache[BLADERF_RX]);
+    fastlock_cache_reset(&board_data->quick_tune_cache[BLADERF_TX]);
 
     log_debug("%s: complete\n", __FUNCTION__);
 
@@ -1391,6 +1393,36 @@ static int bladerf2_get_rf_ports(struct bladerf *dev,
 /* Scheduled Tuning */
 /******************************************************************************/
 
+/* Determine the retune2 port and SPDT settings for a frequency */
+static void quick_tune_port_spdt(bladerf_channel ch,
+                                 bladerf_frequency freq,
+                                 uint8_t *port,
+                                 uint8_t *spdt)
+{
+    struct band_port_map const *pm = _get_band_port_map_by_freq(ch, freq);
+
+    if (BLADERF_CHANNEL_IS_TX(ch)) {
+        /* Set the TX band */
+        *port = (pm->rfic_port << 6);
+
+        /* Set the TX SPDTs */
+        *spdt = (pm->spdt << 6) | (pm->spdt << 4);
+    } else {
+        /* Set the RX bit */
+        *port = NIOS_PKT_RETUNE2_PORT_IS_RX_MASK;
+
+        /* Set the RX band */
+        if (pm->rfic_port < 3) {
+            *port |= (3 << (pm->rfic_port << 1));
+        } else {
+            *port |= (1 << (pm->rfic_port - 3));
+        }
+
+        /* Set the RX SPDTs */
+        *spdt = (pm->spdt << 2) | (pm->spdt);
+    }
+}
+
 static int bladerf2_get_quick_tune(struct bladerf *dev,
                                    bladerf_channel ch,
                                    struct bladerf_quick_tune *quick_tune)
@@ -1400,9 +1432,13 @@ static int bladerf2_get_quick_tune(struct bladerf *dev,
 
     struct bladerf2_board_data *board_data = dev->board_data;
     struct controller_fns const *rfic      = board_data->rfic;
-    struct band_port_map const *pm         = NULL;
+    struct bladerf2_fastlock_cache *cache  = NULL;
+    struct bladerf2_fastlock_entry *e      = NULL;
 
     bladerf_frequency freq;
+    uint8_t port, spdt;
+    int profile, status;
+    bool is_tx = BLADERF_CHANNEL_IS_TX(ch);
 
     if (ch != BLADERF_CHANNEL_RX(0) && ch != BLADERF_CHANNEL_RX(1) &&
         ch != BLADERF_CHANNEL_TX(0) && ch != BLADERF_CHANNEL_TX(1)) {
@@ -1411,74 +1447,45 @@ static int bladerf2_get_quick_tune(struct bladerf *dev,
 
     CHECK_STATUS(dev->board->get_frequency(dev, ch, &freq));
 
-    pm = _get_band_port_map_by_freq(ch, freq);
-
-    if (BLADERF_CHANNEL_IS_TX(ch)) {
-        if (board_data->quick_tune_tx_profile < NUM_BBP_FASTLOCK_PROFILES) {
-            /* Assign Nios and RFFE profile numbers */
-            quick_tune->nios_profile = board_data->quick_tune_tx_profile++;
-            log_verbose("Quick tune assigned Nios TX fast lock index: %u\n",
-                        quick_tune->nios_profile);
-            quick_tune->rffe_profile =
-                quick_tune->nios_profile % NUM_RFFE_FASTLOCK_PROFILES;
-            log_verbose("Quick tune assigned RFFE TX fast lock index: %u\n",
-                        quick_tune->rffe_profile);
-        } else {
-            log_error("Reached maximum number of TX quick tune profiles.");
-            return BLADERF_ERR_UNEXPECTED;
-        }
-
-        /* Create a fast lock profile in the RFIC */
-        CHECK_STATUS(
-            rfic->store_fastlock_profile(dev, ch, quick_tune->rffe_profile));
-
-        /* Save a copy of the TX fast lock profile to the Nios */
-        dev->backend->rffe_fastlock_save(dev, true, quick_tune->rffe_profile,
-                                         quick_tune->nios_profile);
+    quick_tune_port_spdt(ch, freq, &port, &spdt);
 
-        /* Set the TX band */
-        quick_tune->port = (pm->rfic_port << 6);
-
-        /* Set the TX SPDTs */
-        quick_tune->spdt = (pm->spdt << 6) | (pm->spdt << 4);
+    cache = &board_data->quick_tune_cache[is_tx ? BLADERF_TX : BLADERF_RX];
 
+    profile = fastlock_cache_lookup(cache, freq, port, spdt);
+    if (profile >= 0) {
+        log_verbose("Quick tune %s profile cache hit: Nios %d\n",
+                    is_tx ? "TX" : "RX", profile);
     } else {
-        if (board_data->quick_tune_rx_profile < NUM_BBP_FASTLOCK_PROFILES) {
-            /* Assign Nios and RFFE profile numbers */
-            quick_tune->nios_profile = board_data->quick_tune_rx_profile++;
-            log_verbose("Quick tune assigned Nios RX fast lock index: %u\n",
-                        quick_tune->nios_profile);
-            quick_tune->rffe_profile =
-                quick_tune->nios_profile % NUM_RFFE_FASTLOCK_PROFILES;
-            log_verbose("Quick tune assigned RFFE RX fast lock index: %u\n",
-                        quick_tune->rffe_profile);
-        } else {
-            log_error("Reached maximum number of RX quick tune profiles.");
-            return BLADERF_ERR_UNEXPECTED;
-        }
-
-        /* Create a fast lock profile in the RFIC */
-        CHECK_STATUS(
-            rfic->store_fastlock_profile(dev, ch, quick_tune->rffe_profile));
+        /* Assign Nios and RFFE profile numbers */
+        profile = fastlock_cache_insert(cache, freq, port, spdt);
+        e       = &cache->entries[profile];
 
-        /* Save a copy of the RX fast lock profile to the Nios */
-        dev->backend->rffe_fastlock_save(dev, false, quick_tune->rffe_profile,
-                                         quick_tune->nios_profile);
+        log_verbose("Quick tune assigned Nios %s fast lock index: %d\n",
+                    is_tx ? "TX" : "RX", profile);
+        log_verbose("Quick tune assigned RFFE %s fast lock index: %u\n",
+                    is_tx ? "TX" : "RX", e->rffe_profile);
 
-        /* Set the RX bit */
-        quick_tune->port = NIOS_PKT_RETUNE2_PORT_IS_RX_MASK;
-
-        /* Set the RX band */
-        if (pm->rfic_port < 3) {
-            quick_tune->port |= (3 << (pm->rfic_port << 1));
-        } else {
-            quick_tune->port |= (1 << (pm->rfic_port - 3));
+        /* Create a fast lock profile in the RFIC */
+        status = rfic->store_fastlock_profile(dev, ch, e->rffe_profile);
+        if (status < 0) {
+            e->valid = false;
+            cache->stats.profiles--;
+            RETURN_ERROR_STATUS("store_fastlock_profile", status);
         }
 
-        /* Set the RX SPDTs */
-        quick_tune->spdt = (pm->spdt << 2) | (pm->spdt);
+        /* Save a copy of the fast lock profile to the Nios */
+        dev->backend->rffe_fastlock_save(dev, is_tx, e->rffe_profile,
+                                         (uint16_t)profile);
     }
 
+    e = &cache->entries[profile];
+
+    quick_tune->nios_profile = (uint16_t)profile;
+    quick_tune->rffe_profile = e->rffe_profile;
+    quick_tune->port         = e->port;
+    quick_tune->spdt         = e->spdt;
+    quick_tune->profile_gen  = e->gen;
+
     /* Workaround: the RFIC can end up in a bad state after fastlock use, and
      * needs to be reset and re-initialized. This is likely due to our direct
      * SPI writes causing state incongruence. */
@@ -1497,6 +1504,9 @@ static int bladerf2_schedule_retune(struct bladerf *dev,
     NULL_CHECK(quick_tune);
 
     struct bladerf2_board_data *board_data = dev->board_data;
+    struct bladerf2_fastlock_cache *cache =
+        &board_data->quick_tune_cache[BLADERF_CHANNEL_IS_TX(ch) ? BLADERF_TX
+                                                                 : BLADERF_RX];
 
     if (!have_cap(board_data->capabilities, BLADERF_CAP_SCHEDULED_RETUNE)) {
         log_debug("This FPGA version (%u.%u.%u) does not support "
@@ -1508,11 +1518,130 @@ static int bladerf2_schedule_retune(struct bladerf *dev,
         return BLADERF_ERR_UNSUPPORTED;
     }
 
+    if (!fastlock_cache_touch(cache, quick_tune)) {
+        RETURN_INVAL("quick_tune",
+                     "profile has been reassigned; call "
+                     "bladerf_get_quick_tune() again");
+    }
+
     return dev->backend->retune2(dev, ch, timestamp, quick_tune->nios_profile,
                                  quick_tune->rffe_profile, quick_tune->port,
                                  quick_tune->spdt);
 }
 
+static int bladerf2_get_quick_tune_stats(struct bladerf *dev,
+                                         bladerf_direction dir,
+                                         struct bladerf_quick_tune_stats *stats)
+{
+    CHECK_BOARD_STATE(STATE_INITIALIZED);
+    NULL_CHECK(stats);
+
+    struct bladerf2_board_data *board_data = dev->board_data;
+
+    if (dir != BLADERF_RX && dir != BLADERF_TX) {
+        RETURN_INVAL_ARG("direction", dir, "is not valid");
+    }
+
+    *stats = board_data->quick_tune_cache[dir].stats;
+
+    return 0;
+}
+
+static int bladerf2_clear_quick_tune_cache(struct bladerf *dev,
+                                           bladerf_direction dir)
+{
+    CHECK_BOARD_STATE(STATE_INITIALIZED);
+
+    struct bladerf2_board_data *board_data = dev->board_data;
+
+    if (dir != BLADERF_RX && dir != BLADERF_TX) {
+        RETURN_INVAL_ARG("direction", dir, "is not valid");
+    }
+
+    fastlock_cache_reset(&board_data->quick_tune_cache[dir]);
+
+    return 0;
+}
+
+static int bladerf2_build_hop_set(struct bladerf *dev,
+                                  bladerf_channel ch,
+                                  bladerf_frequency const *frequencies,
+                                  unsigned int n,
+                                  struct bladerf_quick_tune *quick_tunes)
+{
+    CHECK_BOARD_STATE(STATE_INITIALIZED);
+
+    struct bladerf2_board_data *board_data = dev->board_data;
+    struct bladerf2_fastlock_cache *cache  = NULL;
+    struct bladerf2_fastlock_entry *e      = NULL;
+    struct bladerf_range const *range      = NULL;
+
+    bladerf_frequency orig_freq;
+    uint8_t port, spdt;
+    unsigned int i;
+    int profile, status = 0;
+
+    if (ch != BLADERF_CHANNEL_RX(0) && ch != BLADERF_CHANNEL_RX(1) &&
+        ch != BLADERF_CHANNEL_TX(0) && ch != BLADERF_CHANNEL_TX(1)) {
+        RETURN_INVAL_ARG("channel", ch, "is not valid");
+    }
+
+    /* Building more profiles than the cache holds would evict the earliest
+     * entries of the hop set */
+    if (n > NUM_BBP_FASTLOCK_PROFILES) {
+        RETURN_INVAL_ARG("hop set size", n, "exceeds the quick tune cache");
+    }
+
+    CHECK_STATUS(dev->board->get_frequency_range(dev, ch, &range));
+
+    for (i = 0; i < n; i++) {
+        if (!is_within_range(range, frequencies[i])) {
+            log_error("%s: frequency %" BLADERF_PRIuFREQ " is out of range\n",
+                      __FUNCTION__, frequencies[i]);
+            return BLADERF_ERR_RANGE;
+        }
+    }
+
+    CHECK_STATUS(dev->board->get_frequency(dev, ch, &orig_freq));
+
+    cache = &board_data->quick_tune_cache[BLADERF_CHANNEL_IS_TX(ch) ? BLADERF_TX
+                                                                    : BLADERF_RX];
+
+    for (i = 0; i < n; i++) {
+        quick_tune_port_spdt(ch, frequencies[i], &port, &spdt);
+
+        /* Frequencies with a cached profile do not need a synthesizer lock */
+        profile = fastlock_cache_lookup(cache, frequencies[i], port, spdt);
+        if (profile >= 0) {
+            e = &cache->entries[profile];
+
+            quick_tunes[i].nios_profile = (uint16_t)profile;
+            quick_tunes[i].rffe_profile = e->rffe_profile;
+            quick_tunes[i].port         = e->port;
+            quick_tunes[i].spdt         = e->spdt;
+            quick_tunes[i].profile_gen  = e->gen;
+            continue;
+        }
+
+        status = dev->board->set_frequency(dev, ch, frequencies[i]);
+        if (status == 0) {
+            status = bladerf2_get_quick_tune(dev, ch, &quick_tunes[i]);
+        }
+
+        if (status < 0) {
+            log_error("%s: failed to build profile for %" BLADERF_PRIuFREQ
+                      " Hz: %s\n",
+                      __FUNCTION__, frequencies[i], bladerf_strerror(status));
+            break;
+        }
+    }
+
+    /* Leave the channel tuned as we found it */
+    CHECK_STATUS(dev->board->set_frequency(dev, ch, orig_freq));
+
+    return status;
+}
+
 static int bladerf2_cancel_scheduled_retunes(struct bladerf *dev,
                                              bladerf_channel ch)
 {
@@ -1562,7 +1691,7 @@ static const struct {
         },
         [BLADERF_CORR_GAIN] = {
             FIELD_INIT(.reg, {  AD936X_REG_RX1_INPUT_A_GAIN_CORR,
-                                AD936X_REG_RX1_INPUT_BC_PHASE_CORR  }),
+                                AD936X_REG_RX1_INPUT_BC_GAIN_CORR   }),
             FIELD_INIT(.shift, 6),
         }
     },
@@ -1582,7 +1711,7 @@ static const struct {
         },
         [BLADERF_CORR_GAIN] = {
             FIELD_INIT(.reg, {  AD936X_REG_RX2_INPUT_A_GAIN_CORR,
-                                AD936X_REG_RX2_INPUT_BC_PHASE_CORR  }),
+                                AD936X_REG_RX2_INPUT_BC_GAIN_CORR   }),
             FIELD_INIT(.shift, 6),
         }
     },
@@ -1671,23 +1800,65 @@ static const struct {
         },
     },
 };
-
-static const int ad9361_correction_force_bit[2][4][2] = {
-    [0] = {
-        [BLADERF_CORR_DCOFF_I] = {2, 6},
-        [BLADERF_CORR_DCOFF_Q] = {2, 6},
-        [BLADERF_CORR_PHASE]   = {0, 4},
-        [BLADERF_CORR_GAIN]    = {0, 4},
-    },
-    [1] = {
-        [BLADERF_CORR_DCOFF_I] = {3, 7},
-        [BLADERF_CORR_DCOFF_Q] = {3, 7},
-        [BLADERF_CORR_PHASE]   = {1, 5},
-        [BLADERF_CORR_GAIN]    = {1, 5},
-    },
-};
 // clang-format on
 
+/* Look up whether a channel's corrections apply to the low band registers,
+ * i.e., RX input B/C or TX output B, based on its current RF port */
+static int _get_correction_band(struct bladerf *dev,
+                                bladerf_channel ch,
+                                bool *low_band)
+{
+    struct bladerf2_board_data *board_data = dev->board_data;
+    struct ad9361_rf_phy *phy              = board_data->phy;
+    uint32_t mode;
+
+    if (BLADERF_CHANNEL_IS_TX(ch)) {
+        CHECK_AD936X(ad9361_get_tx_rf_port_output(phy, &mode));
+
+        *low_band = (mode != AD936X_TXA);
+    } else {
+        CHECK_AD936X(ad9361_get_rx_rf_port_input(phy, &mode));
+
+        /* Check if RX RF port mode is supported */
+        if (mode != AD936X_A_BALANCED && mode != AD936X_B_BALANCED &&
+            mode != AD936X_C_BALANCED) {
+            RETURN_ERROR_STATUS("mode", BLADERF_ERR_UNSUPPORTED);
+        }
+
+        *low_band = (mode != AD936X_A_BALANCED);
+    }
+
+    return 0;
+}
+
+/* Perform register updates from ad936x_correction_updates(), reading back
+ * only those registers that are partially updated */
+static int _write_correction_updates(struct ad9361_rf_phy *phy,
+                                     struct ad936x_reg_update const *updates,
+                                     unsigned int count)
+{
+    unsigned int i;
+    uint8_t data;
+    int32_t val;
+
+    for (i = 0; i < count; i++) {
+        data = updates[i].data;
+
+        if (updates[i].mask != 0xff) {
+            val = ad9361_spi_read(phy->spi, updates[i].addr);
+            if (val < 0) {
+                RETURN_ERROR_AD9361("ad9361_spi_read", val);
+            }
+
+            data |= (val & ~updates[i].mask);
+        }
+
+        CHECK_AD936X(ad9361_spi_write(phy->spi, updates[i].addr, data));
+    }
+
+    return 0;
+}
+
 static int bladerf2_get_correction(struct bladerf *dev,
                                    bladerf_channel ch,
                                    bladerf_correction corr,
@@ -1702,6 +1873,7 @@ static int bladerf2_get_correction(struct bladerf *dev,
     uint16_t reg, data;
     unsigned int shift;
     int32_t val;
+    int status;
 
     IF_COMMAND_MODE(dev, RFIC_COMMAND_FPGA, {
         log_debug("%s: FPGA command mode not supported\n", __FUNCTION__);
@@ -1720,25 +1892,9 @@ static int bladerf2_get_correction(struct bladerf *dev,
         RETURN_ERROR_STATUS("corr", BLADERF_ERR_UNSUPPORTED);
     }
 
-    /* Look up band */
-    if (BLADERF_CHANNEL_IS_TX(ch)) {
-        uint32_t mode;
-
-        CHECK_AD936X(ad9361_get_tx_rf_port_output(phy, &mode));
-
-        low_band = (mode != AD936X_TXA);
-    } else {
-        uint32_t mode;
-
-        CHECK_AD936X(ad9361_get_rx_rf_port_input(phy, &mode));
-
-        /* Check if RX RF port mode is supported */
-        if (mode != AD936X_A_BALANCED && mode != AD936X_B_BALANCED &&
-            mode != AD936X_C_BALANCED) {
-            RETURN_ERROR_STATUS("mode", BLADERF_ERR_UNSUPPORTED);
-        }
-
-        low_band = (mode != AD936X_A_BALANCED);
+    status = _get_correction_band(dev, ch, &low_band);
+    if (status < 0) {
+        return status;
     }
 
     if ((corr == BLADERF_CORR_DCOFF_I || corr == BLADERF_CORR_DCOFF_Q) &&
@@ -1785,9 +1941,9 @@ static int bladerf2_get_correction(struct bladerf *dev,
                 /* bottom: | x x x x x x 1 0 | */
                 data = (data_top << 2) | (data_bot & 0x3);
             } else {
-                /*    top: | x x 9 8 7 6 5 4 | */
+                /*    top: | 9 8 7 6 5 4 x x | */
                 /* bottom: | 3 2 1 0 x x x x | */
-                data = (data_top << 4) | (data_bot >> 4);
+                data = ((data_top & 0xfc) << 2) | (data_bot >> 4);
             }
         }
 
@@ -1829,11 +1985,11 @@ static int bladerf2_set_correction(struct bladerf *dev,
     CHECK_BOARD_STATE(STATE_INITIALIZED);
 
     struct bladerf2_board_data *board_data = dev->board_data;
-    struct ad9361_rf_phy *phy              = board_data->phy;
+    struct ad936x_reg_update updates[AD936X_CORR_MAX_UPDATES];
+    int16_t values[AD936X_CORR_COUNT] = { 0 };
+    unsigned int count;
     bool low_band;
-    uint16_t reg, data;
-    unsigned int shift;
-    int32_t val;
+    int status;
 
     IF_COMMAND_MODE(dev, RFIC_COMMAND_FPGA, {
         log_debug("%s: FPGA command mode not supported\n", __FUNCTION__);
@@ -1852,123 +2008,170 @@ static int bladerf2_set_correction(struct bladerf *dev,
         RETURN_ERROR_STATUS("corr", BLADERF_ERR_UNSUPPORTED);
     }
 
-    /* Look up band */
-    if (BLADERF_CHANNEL_IS_TX(ch)) {
-        uint32_t mode;
+    status = _get_correction_band(dev, ch, &low_band);
+    if (status < 0) {
+        return status;
+    }
 
-        CHECK_AD936X(ad9361_get_tx_rf_port_output(phy, &mode));
+    values[corr] = value;
 
-        low_band = (mode != AD936X_TXA);
-    } else {
-        uint32_t mode;
+    count = ad936x_correction_updates(ch >> 1, BLADERF_CHANNEL_IS_TX(ch),
+                                      low_band, (1 << corr), values, updates);
 
-        CHECK_AD936X(ad9361_get_rx_rf_port_input(phy, &mode));
+    return _write_correction_updates(board_data->phy, updates, count);
+}
 
-        /* Check if RX RF port mode is supported */
-        if (mode != AD936X_A_BALANCED && mode != AD936X_B_BALANCED &&
-            mode != AD936X_C_BALANCED) {
-            RETURN_ERROR_STATUS("mode", BLADERF_ERR_UNSUPPORTED);
-        }
+static int bladerf2_get_correction_profile(
+    struct bladerf *dev,
+    bladerf_channel ch,
+    struct bladerf_correction_profile *profile)
+{
+    CHECK_BOARD_STATE(STATE_INITIALIZED);
+    NULL_CHECK(profile);
 
-        low_band = (mode != AD936X_A_BALANCED);
+    int status;
+
+    status = bladerf2_get_correction(dev, ch, BLADERF_CORR_DCOFF_I,
+                                     &profile->dcoff_i);
+    if (status < 0) {
+        return status;
     }
 
-    if ((corr == BLADERF_CORR_DCOFF_I || corr == BLADERF_CORR_DCOFF_Q) &&
-        (ch & BLADERF_DIRECTION_MASK) == BLADERF_RX) {
-        /* RX DC offset corrections are stuffed in a super convoluted way in
-         * the register map. See AD9361 register map page 51. */
-        bool is_q = (corr == BLADERF_CORR_DCOFF_Q);
-        uint8_t data_top, data_bot;
+    status = bladerf2_get_correction(dev, ch, BLADERF_CORR_DCOFF_Q,
+                                     &profile->dcoff_q);
+    if (status < 0) {
+        return status;
+    }
 
-        /* Scale 13-bit to 10-bit */
-        data = value >> 3;
+    status = bladerf2_get_correction(dev, ch, BLADERF_CORR_PHASE,
+                                     &profile->phase);
+    if (status < 0) {
+        return status;
+    }
 
-        /* Read top register */
-        val = ad9361_spi_read(
-            phy->spi,
-            ad9361_correction_rx_dcoff_reg_table[ch][low_band][is_q].reg_top);
-        if (val < 0) {
-            RETURN_ERROR_AD9361("ad9361_spi_read(top)", val);
-        }
+    return bladerf2_get_correction(dev, ch, BLADERF_CORR_GAIN, &profile->gain);
+}
 
-        data_top = val;
+static int bladerf2_set_correction_profile(
+    struct bladerf *dev,
+    bladerf_channel ch,
+    const struct bladerf_correction_profile *profile)
+{
+    CHECK_BOARD_STATE(STATE_INITIALIZED);
+    NULL_CHECK(profile);
 
-        /* Read bottom register */
-        val = ad9361_spi_read(
-            phy->spi,
-            ad9361_correction_rx_dcoff_reg_table[ch][low_band][is_q].reg_bot);
-        if (val < 0) {
-            RETURN_ERROR_AD9361("ad9361_spi_read(bottom)", val);
-        }
+    struct bladerf2_board_data *board_data = dev->board_data;
+    struct ad936x_reg_update updates[AD936X_CORR_MAX_UPDATES];
+    int16_t values[AD936X_CORR_COUNT];
+    unsigned int count;
+    uint16_t addr;
+    bool low_band;
+    int status;
 
-        data_bot = val;
+    /* Validate channel */
+    if (ch != BLADERF_CHANNEL_RX(0) && ch != BLADERF_CHANNEL_RX(1) &&
+        ch != BLADERF_CHANNEL_TX(0) && ch != BLADERF_CHANNEL_TX(1)) {
+        RETURN_INVAL_ARG("channel", ch, "is not valid");
+    }
 
-        /* Modify registers */
-        if (ch == BLADERF_CHANNEL_RX(0)) {
-            if (!is_q) {
-                /*    top: | x x x x 9 8 7 6 | */
-                /* bottom: | 5 4 3 2 1 0 x x | */
-                data_top = (data_top & 0xf0) | ((data >> 6) & 0x0f);
-                data_bot = (data_bot & 0x03) | ((data & 0x3f) << 2);
-            } else {
-                /*    top: | x x x x x x 9 8 | */
-                /* bottom: | 7 6 5 4 3 2 1 0 | */
-                data_top = (data_top & 0xfc) | ((data >> 8) & 0x03);
-                data_bot = data & 0xff;
-            }
-        } else {
-            if (!is_q) {
-                /*    top: | 9 8 7 6 5 4 3 2 | */
-                /* bottom: | x x x x x x 1 0 | */
-                data_top = (data >> 2) & 0xff;
-                data_bot = (data_bot & 0xfc) | (data & 0x03);
-            } else {
-                /*    top: | x x 9 8 7 6 5 4 | */
-                /* bottom: | 3 2 1 0 x x x x | */
-                data_top = (data & 0xc0) | ((data >> 4) & 0x3f);
-                data_bot = (data & 0x0f) | ((data & 0x0f) << 4);
-            }
-        }
+    values[BLADERF_CORR_DCOFF_I] = profile->dcoff_i;
+    values[BLADERF_CORR_DCOFF_Q] = profile->dcoff_q;
+    values[BLADERF_CORR_PHASE]   = profile->phase;
+    values[BLADERF_CORR_GAIN]    = profile->gain;
 
-        /* Write top register */
-        CHECK_AD936X(ad9361_spi_write(
-            phy->spi,
-            ad9361_correction_rx_dcoff_reg_table[ch][low_band][is_q].reg_top,
-            data_top));
+    IF_COMMAND_MODE(dev, RFIC_COMMAND_FPGA, {
+        log_debug("%s: FPGA command mode not supported\n", __FUNCTION__);
+        return BLADERF_ERR_UNSUPPORTED;
+    });
 
-        /* Write bottom register */
-        CHECK_AD936X(ad9361_spi_write(
-            phy->spi,
-            ad9361_correction_rx_dcoff_reg_table[ch][low_band][is_q].reg_bot,
-            data_bot));
-    } else {
-        /* Look up correction register and value shift in table */
-        reg   = ad9361_correction_reg_table[ch].corr[corr].reg[low_band];
-        shift = ad9361_correction_reg_table[ch].corr[corr].shift;
+    status = _get_correction_band(dev, ch, &low_band);
+    if (status < 0) {
+        return status;
+    }
 
-        /* Scale 12-bit/13-bit to 8-bit */
-        data = (value >> shift) & 0xff;
+    if (have_cap(board_data->capabilities, BLADERF_CAP_IQ_CORR_PROFILE)) {
+        /* The Nios performs all of the register updates */
+        addr = ((ch >> 1) ? NIOS_PKT_16x64_IQ_CORR_CHAN : 0) |
+               (BLADERF_CHANNEL_IS_TX(ch) ? NIOS_PKT_16x64_IQ_CORR_TX : 0) |
+               (low_band ? NIOS_PKT_16x64_IQ_CORR_LOW_BAND : 0);
 
-        /* Write register */
-        CHECK_AD936X(ad9361_spi_write(phy->spi, reg, data & 0xff));
+        return dev->backend->rffe_iq_corr_write(
+            dev, addr, nios_pkt_16x64_iq_corr_pack(values));
     }
 
-    reg = (BLADERF_CHANNEL_IS_TX(ch)) ? AD936X_REG_TX_FORCE_BITS
-                                      : AD936X_REG_FORCE_BITS;
+    count = ad936x_correction_updates(ch >> 1, BLADERF_CHANNEL_IS_TX(ch),
+                                      low_band, (1 << AD936X_CORR_COUNT) - 1,
+                                      values, updates);
 
-    /* Read force bit register */
-    val = ad9361_spi_read(phy->spi, reg);
-    if (val < 0) {
-        RETURN_ERROR_AD9361("ad9361_spi_read(force)", val);
+    return _write_correction_updates(board_data->phy, updates, count);
+}
+
+static int bladerf2_set_quick_tune_correction_profile(
+    struct bladerf *dev,
+    bladerf_channel ch,
+    const struct bladerf_quick_tune *quick_tune,
+    const struct bladerf_correction_profile *profile)
+{
+    CHECK_BOARD_STATE(STATE_INITIALIZED);
+    NULL_CHECK(quick_tune);
+
+    struct bladerf2_board_data *board_data = dev->board_data;
+    struct bladerf2_fastlock_cache *cache;
+    int16_t values[AD936X_CORR_COUNT] = { 0 };
+    uint16_t addr;
+    bool low_band;
+
+    /* Validate channel */
+    if (ch != BLADERF_CHANNEL_RX(0) && ch != BLADERF_CHANNEL_RX(1) &&
+        ch != BLADERF_CHANNEL_TX(0) && ch != BLADERF_CHANNEL_TX(1)) {
+        RETURN_INVAL_ARG("channel", ch, "is not valid");
     }
 
-    /* Modify register */
-    data = val | (1 << ad9361_correction_force_bit[ch >> 1][corr][low_band]);
+    if (!have_cap(board_data->capabilities, BLADERF_CAP_IQ_CORR_PROFILE)) {
+        log_debug("This FPGA version (%u.%u.%u) does not support "
+                  "quick tune correction profiles.\n",
+                  board_data->fpga_version.major,
+                  board_data->fpga_version.minor,
+                  board_data->fpga_version.patch);
 
-    /* Write force bit register */
-    CHECK_AD936X(ad9361_spi_write(phy->spi, reg, data));
+        return BLADERF_ERR_UNSUPPORTED;
+    }
 
-    return 0;
+    cache = &board_data->quick_tune_cache[BLADERF_CHANNEL_IS_TX(ch)
+                                              ? BLADERF_TX
+                                              : BLADERF_RX];
+
+    if (!fastlock_cache_touch(cache, quick_tune)) {
+        RETURN_INVAL("quick_tune",
+                     "profile has been reassigned; call "
+                     "bladerf_get_quick_tune() again");
+    }
+
+    /* The band is that of the quick tune's port, rather than the current one */
+    if (BLADERF_CHANNEL_IS_TX(ch)) {
+        low_band = ((quick_tune->port >> 6) != AD936X_TXA);
+    } else {
+        low_band = ((quick_tune->port & ~NIOS_PKT_RETUNE2_PORT_IS_RX_MASK) !=
+                    (3 << (AD936X_A_BALANCED << 1)));
+    }
+
+    addr = NIOS_PKT_16x64_IQ_CORR_STORE |
+           ((ch >> 1) ? NIOS_PKT_16x64_IQ_CORR_CHAN : 0) |
+           (BLADERF_CHANNEL_IS_TX(ch) ? NIOS_PKT_16x64_IQ_CORR_TX : 0) |
+           (low_band ? NIOS_PKT_16x64_IQ_CORR_LOW_BAND : 0) |
+           (quick_tune->nios_profile & NIOS_PKT_16x64_IQ_CORR_PROFILE);
+
+    if (NULL == profile) {
+        addr |= NIOS_PKT_16x64_IQ_CORR_CLEAR;
+    } else {
+        values[BLADERF_CORR_DCOFF_I] = profile->dcoff_i;
+        values[BLADERF_CORR_DCOFF_Q] = profile->dcoff_q;
+        values[BLADERF_CORR_PHASE]   = profile->phase;
+        values[BLADERF_CORR_GAIN]    = profile->gain;
+    }
+
+    return dev->backend->rffe_iq_corr_write(
+        dev, addr, nios_pkt_16x64_iq_corr_pack(values));
 }
 
 
@@ -2212,6 +2415,128 @@ static int bladerf2_sync_rx(struct bladerf *dev,
                    metadata, timeout_ms);
 }
 
+static int bladerf2_sync_rx_acquire(struct bladerf *dev,
+                                    void **samples,
+                                    unsigned int *num_samples,
+                                    struct bladerf_metadata *metadata,
+                                    unsigned int timeout_ms)
+{
+    CHECK_BOARD_STATE(STATE_INITIALIZED);
+
+    struct bladerf2_board_data *board_data = dev->board_data;
+
+    if (!board_data->sync[BLADERF_RX].initialized) {
+        RETURN_INVAL("sync rx", "not initialized");
+    }
+
+    return sync_rx_acquire(&board_data->sync[BLADERF_RX], samples,
+                           num_samples, metadata, timeout_ms);
+}
+
+static int bladerf2_sync_rx_release(struct bladerf *dev,
+                                    unsigned int num_samples)
+{
+    CHECK_BOARD_STATE(STATE_INITIALIZED);
+
+    struct bladerf2_board_data *board_data = dev->board_data;
+
+    if (!board_data->sync[BLADERF_RX].initialized) {
+        RETURN_INVAL("sync rx", "not initialized");
+    }
+
+    return sync_rx_release(&board_data->sync[BLADERF_RX], num_samples);
+}
+
+static int bladerf2_sync_tx_acquire(struct bladerf *dev,
+                                    void **samples,
+                                    unsigned int *num_samples,
+                                    struct bladerf_metadata *metadata,
+                                    unsigned int timeout_ms)
+{
+    CHECK_BOARD_STATE(STATE_INITIALIZED);
+
+    struct bladerf2_board_data *board_data = dev->board_data;
+
+    if (!board_data->sync[BLADERF_TX].initialized) {
+        RETURN_INVAL("sync tx", "not initialized");
+    }
+
+    return sync_tx_acquire(&board_data->sync[BLADERF_TX], samples,
+                           num_samples, metadata, timeout_ms);
+}
+
+static int bladerf2_sync_tx_commit(struct bladerf *dev,
+                                   unsigned int num_samples,
+                                   struct bladerf_metadata *metadata)
+{
+    CHECK_BOARD_STATE(STATE_INITIALIZED);
+
+    struct bladerf2_board_data *board_data = dev->board_data;
+
+    if (!board_data->sync[BLADERF_TX].initialized) {
+        RETURN_INVAL("sync tx", "not initialized");
+    }
+
+    return sync_tx_commit(&board_data->sync[BLADERF_TX], num_samples,
+                          metadata);
+}
+
+static int bladerf2_get_stream_stats(struct bladerf *dev,
+                                     bladerf_direction dir,
+                                     struct bladerf_stream_stats *stats)
+{
+    CHECK_BOARD_STATE(STATE_INITIALIZED);
+    NULL_CHECK(stats);
+
+    struct bladerf2_board_data *board_data = dev->board_data;
+
+    if (dir != BLADERF_RX && dir != BLADERF_TX) {
+        RETURN_INVAL("direction", "is not valid");
+    }
+
+    if (!board_data->sync[dir].initialized) {
+        RETURN_INVAL("sync", "not initialized");
+    }
+
+    return sync_get_stats(&board_data->sync[dir], stats);
+}
+
+static int bladerf2_set_stream_thread_config(
+    struct bladerf *dev,
+    bladerf_direction dir,
+    const struct bladerf_stream_thread_config *config)
+{
+    CHECK_BOARD_STATE(STATE_INITIALIZED);
+    NULL_CHECK(config);
+
+    struct bladerf2_board_data *board_data = dev->board_data;
+
+    if (dir != BLADERF_RX && dir != BLADERF_TX) {
+        RETURN_INVAL("direction", "is not valid");
+    }
+
+    return sync_set_thread_config(&board_data->sync[dir], config);
+}
+
+static int bladerf2_get_stream_thread_config(
+    struct bladerf *dev,
+    bladerf_direction dir,
+    struct bladerf_stream_thread_config *config)
+{
+    CHECK_BOARD_STATE(STATE_INITIALIZED);
+    NULL_CHECK(config);
+
+    struct bladerf2_board_data *board_data = dev->board_data;
+
+    if (dir != BLADERF_RX && dir != BLADERF_TX) {
+        RETURN_INVAL("direction", "is not valid");
+    }
+
+    *config = board_data->sync[dir].thread_config;
+
+    return 0;
+}
+
 static int bladerf2_get_timestamp(struct bladerf *dev,
                                   bladerf_direction dir,
                                   bladerf_timestamp *value)
@@ -2911,8 +3236,15 @@ struct board_fns const bladerf2_board_fns = {
     FIELD_INIT(.get_quick_tune, bladerf2_get_quick_tune),
     FIELD_INIT(.schedule_retune, bladerf2_schedule_retune),
     FIELD_INIT(.cancel_scheduled_retunes, bladerf2_cancel_scheduled_retunes),
+    FIELD_INIT(.get_quick_tune_stats, bladerf2_get_quick_tune_stats),
+    FIELD_INIT(.clear_quick_tune_cache, bladerf2_clear_quick_tune_cache),
+    FIELD_INIT(.build_hop_set, bladerf2_build_hop_set),
     FIELD_INIT(.get_correction, bladerf2_get_correction),
     FIELD_INIT(.set_correction, bladerf2_set_correction),
+    FIELD_INIT(.get_correction_profile, bladerf2_get_correction_profile),
+    FIELD_INIT(.set_correction_profile, bladerf2_set_correction_profile),
+    FIELD_INIT(.set_quick_tune_correction_profile,
+               bladerf2_set_quick_tune_correction_profile),
     FIELD_INIT(.trigger_init, bladerf2_trigger_init),
     FIELD_INIT(.trigger_arm, bladerf2_trigger_arm),
     FIELD_INIT(.trigger_fire, bladerf2_trigger_fire),
@@ -2927,6 +3259,13 @@ struct board_fns const bladerf2_board_fns = {
     FIELD_INIT(.sync_config, bladerf2_sync_config),
     FIELD_INIT(.sync_tx, bladerf2_sync_tx),
     FIELD_INIT(.sync_rx, bladerf2_sync_rx),
+    FIELD_INIT(.sync_rx_acquire, bladerf2_sync_rx_acquire),
+    FIELD_INIT(.sync_rx_release, bladerf2_sync_rx_release),
+    FIELD_INIT(.sync_tx_acquire, bladerf2_sync_tx_acquire),
+    FIELD_INIT(.sync_tx_commit, bladerf2_sync_tx_commit),
+    FIELD_INIT(.get_stream_stats, bladerf2_get_stream_stats),
+    FIELD_INIT(.set_stream_thread_config, bladerf2_set_stream_thread_config),
+    FIELD_INIT(.get_stream_thread_config, bladerf2_get_stream_thread_config),
     FIELD_INIT(.get_timestamp, bladerf2_get_timestamp),
     FIELD_INIT(.load_fpga, bladerf2_load_fpga),
     FIELD_INIT(.flash_fpga, bladerf2_flash_fpga),
@@ -3409,6 +3748,10 @@ int bladerf_set_pll_enable(struct bladerf *dev, bool enable)
         // Update our state flag
         board_data->trim_source = enable ? TRIM_SOURCE_PLL : TRIM_SOURCE_NONE;
 
+        // Fast lock profiles depend on the reference clock
+        fastlock_cache_reset(&board_data->quick_tune_cache[BLADERF_RX]);
+        fastlock_cache_reset(&board_data->quick_tune_cache[BLADERF_TX]);
+
         // Enable the trim DAC if we're done with the
         // PLL
         if (!enable) {
@@ -3475,6 +3818,14 @@ int bladerf_set_pll_refclk(struct bladerf *dev, bladerf_frequency frequency)
 
     CHECK_STATUS(bladerf_pll_configure(dev, R, N));
 
+    WITH_MUTEX(&dev->lock, {
+        struct bladerf2_board_data *board_data = dev->board_data;
+
+        // Fast lock profiles depend on the reference clock
+        fastlock_cache_reset(&board_data->quick_tune_cache[BLADERF_RX]);
+        fastlock_cache_reset(&board_data->quick_tune_cache[BLADERF_TX]);
+    });
+
     return 0;
 }
 
@@ -102,5 +102,10 @@ uint64_t bladerf2_get_fpga_capabilities(
         capabilities |= BLADERF_CAP_FPGA_8BIT_SAMPLES;
     }
 
+    if (version_fields_greater_or_equal(fpga_version, 0, 16, 0)) {
+        capabilities |= BLADERF_CAP_NIOS_8x8_BATCH;
+        capabilities |= BLADERF_CAP_IQ_CORR_PROFILE;
+    }
+
     return capabilities;
 }
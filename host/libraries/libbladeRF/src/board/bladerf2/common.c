@@ -19,6 +19,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#include <inttypes.h>
 #include <string.h>
 
 #include "board/board.h"
@@ -413,3 +414,119 @@ int get_gain_offset(struct bladerf *dev, bladerf_channel ch, float *offset)
 
     return BLADERF_ERR_INVAL;
 }
+
+
+/******************************************************************************/
+/* Quick tune fast lock profile cache */
+/******************************************************************************/
+
+void fastlock_cache_reset(struct bladerf2_fastlock_cache *cache)
+{
+    uint32_t gen = cache->gen;
+
+    memset(cache, 0, sizeof(*cache));
+
+    /* Generations are never reused, so parameters issued prior to the reset
+     * are not mistaken for valid ones */
+    cache->gen = gen;
+
+    cache->stats.capacity = NUM_BBP_FASTLOCK_PROFILES;
+}
+
+int fastlock_cache_lookup(struct bladerf2_fastlock_cache *cache,
+                          bladerf_frequency frequency,
+                          uint8_t port,
+                          uint8_t spdt)
+{
+    struct bladerf2_fastlock_entry *e;
+    size_t i;
+
+    for (i = 0; i < ARRAY_SIZE(cache->entries); ++i) {
+        e = &cache->entries[i];
+
+        if (e->valid && e->frequency == frequency && e->port == port &&
+            e->spdt == spdt) {
+            e->last_used                          = ++cache->clock;
+            cache->rffe_last_used[e->rffe_profile] = cache->clock;
+            cache->stats.hits++;
+            return (int)i;
+        }
+    }
+
+    return -1;
+}
+
+uint16_t fastlock_cache_insert(struct bladerf2_fastlock_cache *cache,
+                               bladerf_frequency frequency,
+                               uint8_t port,
+                               uint8_t spdt)
+{
+    struct bladerf2_fastlock_entry *e;
+    size_t i, victim = 0;
+    uint8_t rffe = 0;
+
+    /* Take the first free entry, or else the least recently used one */
+    for (i = 0; i < ARRAY_SIZE(cache->entries); ++i) {
+        if (!cache->entries[i].valid) {
+            victim = i;
+            break;
+        }
+
+        if (cache->entries[i].last_used <
+            cache->entries[victim].last_used) {
+            victim = i;
+        }
+    }
+
+    for (i = 1; i < ARRAY_SIZE(cache->rffe_last_used); ++i) {
+        if (cache->rffe_last_used[i] < cache->rffe_last_used[rffe]) {
+            rffe = (uint8_t)i;
+        }
+    }
+
+    e = &cache->entries[victim];
+
+    if (e->valid) {
+        log_verbose("Quick tune evicting Nios profile %u (%" PRIu64 " Hz)\n",
+                    (unsigned int)victim, e->frequency);
+        cache->stats.evictions++;
+    } else {
+        cache->stats.profiles++;
+    }
+
+    e->valid        = true;
+    e->frequency    = frequency;
+    e->rffe_profile = rffe;
+    e->port         = port;
+    e->spdt         = spdt;
+    e->gen          = ++cache->gen;
+    e->last_used    = ++cache->clock;
+
+    cache->rffe_last_used[rffe] = cache->clock;
+    cache->stats.misses++;
+
+    return (uint16_t)victim;
+}
+
+bool fastlock_cache_touch(struct bladerf2_fastlock_cache *cache,
+                          struct bladerf_quick_tune const *quick_tune)
+{
+    struct bladerf2_fastlock_entry *e;
+
+    if (quick_tune->nios_profile >= ARRAY_SIZE(cache->entries)) {
+        return false;
+    }
+
+    e = &cache->entries[quick_tune->nios_profile];
+
+    if (!e->valid || e->gen != quick_tune->profile_gen ||
+        e->rffe_profile != quick_tune->rffe_profile ||
+        e->port != quick_tune->port || e->spdt != quick_tune->spdt) {
+        return false;
+    }
+
+    e->last_used                          = ++cache->clock;
+    cache->rffe_last_used[e->rffe_profile] = cache->clock;
+
+    return true;
+}
@@ -132,6 +132,29 @@ struct controller_fns {
     enum bladerf2_rfic_command_mode const command_mode;
 };
 
+/* A fast lock profile stored in the Nios. The entry's index in
+ * bladerf2_fastlock_cache.entries is its Nios profile number. */
+struct bladerf2_fastlock_entry {
+    bool valid;
+    bladerf_frequency frequency; /**< RFIC frequency of the profile */
+    uint8_t rffe_profile;        /**< RFFE slot the profile is loaded into */
+    uint8_t port;                /**< Quick tune RFFE port settings */
+    uint8_t spdt;                /**< Quick tune SPDT settings */
+    uint32_t gen;                /**< Generation at time of storage */
+    uint64_t last_used;          /**< LRU timestamp */
+};
+
+/* Quick tune profiles for one direction, managed with LRU replacement. The
+ * RFIC only holds NUM_RFFE_FASTLOCK_PROFILES profiles at a time; the Nios
+ * reloads a profile into its RFFE slot when it is used for a retune. */
+struct bladerf2_fastlock_cache {
+    struct bladerf2_fastlock_entry entries[NUM_BBP_FASTLOCK_PROFILES];
+    uint64_t rffe_last_used[NUM_RFFE_FASTLOCK_PROFILES];
+    uint64_t clock; /**< Source of LRU timestamps */
+    uint32_t gen;   /**< Incremented each time a profile is stored */
+    struct bladerf_quick_tune_stats stats;
+};
+
 struct bladerf2_board_data {
     /* Board state */
     enum {
@@ -175,9 +198,8 @@ struct bladerf2_board_data {
     uint16_t trimdac_last_value;   /**< saved running value */
     uint16_t trimdac_stored_value; /**< cached value read from SPI flash */
 
-    /* Quick Tune Profile Status */
-    uint16_t quick_tune_tx_profile;
-    uint16_t quick_tune_rx_profile;
+    /* Quick Tune fast lock profile caches, indexed by bladerf_direction */
+    struct bladerf2_fastlock_cache quick_tune_cache[2];
 
     /* RFIC backend command handling */
     struct controller_fns const *rfic;
@@ -491,4 +513,41 @@ bool does_rffe_dir_have_enabled_ch(uint32_t reg, bladerf_direction dir);
 
 int get_gain_offset(struct bladerf *dev, bladerf_channel ch, float *offset);
 
+/**
+ * Discard all profiles in a quick tune cache, and reset its statistics
+ */
+void fastlock_cache_reset(struct bladerf2_fastlock_cache *cache);
+
+/**
+ * Find the profile matching a frequency and RFFE port configuration. On a
+ * hit, the profile is marked as most recently used.
+ *
+ * @return Nios profile number, or -1 if there is no matching profile
+ */
+int fastlock_cache_lookup(struct bladerf2_fastlock_cache *cache,
+                          bladerf_frequency frequency,
+                          uint8_t port,
+                          uint8_t spdt);
+
+/**
+ * Claim a profile for a new frequency, evicting the least recently used
+ * profile if all are in use. An RFFE slot is likewise chosen by least recent
+ * use. The caller must store the profile data.
+ *
+ * @return Nios profile number
+ */
+uint16_t fastlock_cache_insert(struct bladerf2_fastlock_cache *cache,
+                               bladerf_frequency frequency,
+                               uint8_t port,
+                               uint8_t spdt);
+
+/**
+ * Check that quick tune parameters still refer to a cached profile, and mark
+ * it as most recently used
+ *
+ * @return true if valid, false if the profile has since been reassigned
+ */
+bool fastlock_cache_touch(struct bladerf2_fastlock_cache *cache,
+                          struct bladerf_quick_tune const *quick_tune);
+
 #endif  // BLADERF2_COMMON_H_
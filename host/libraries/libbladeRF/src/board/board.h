@@ -30,6 +30,7 @@
 #include "thread.h"
 
 #include "backend/backend.h"
+#include "device_calibration.h"
 
 /* Device capabilities are stored in a 64-bit mask.
  *
@@ -115,6 +116,24 @@
  */
 #define BLADERF_CAP_FPGA_PACKET_META (1 << 12)
 
+/**
+ * FPGA v0.16.0 introduced the 8x8 batch NIOS packet, which carries several
+ * 8-bit register accesses in a single request.
+ */
+#define BLADERF_CAP_NIOS_8x8_BATCH (1 << 13)
+
+/**
+ * FPGA v0.16.0 introduced the retune with DC correction NIOS packet, which
+ * applies the LMS6002D DC offset correction values along with a retune.
+ */
+#define BLADERF_CAP_RETUNE_DC (1 << 14)
+
+/**
+ * FPGA v0.16.0 introduced the I/Q correction NIOS packet target, which applies
+ * I/Q corrections in the NIOS and stores them with fast lock profiles.
+ */
+#define BLADERF_CAP_IQ_CORR_PROFILE (1 << 15)
+
 /**
  * Firmware 1.7.1 introduced firmware-based loopback
  */
@@ -200,6 +219,25 @@ struct bladerf {
 
     /* Calibration */
     struct bladerf_gain_cal_tbl gain_tbls[NUM_GAIN_CAL_TBLS];
+
+    /* Lookups compiled from gain_tbls when they are loaded */
+    struct gain_cal_lut gain_luts[NUM_GAIN_CAL_TBLS];
+
+    /* Files whose contents gain_tbls' entries are used in place from */
+    struct gain_cal_map gain_maps[NUM_GAIN_CAL_TBLS];
+
+    /* Frequency last applied via bladerf_set_frequency(), used to look up gain
+     * corrections without querying the device. 0 if unknown. */
+    bladerf_frequency gain_cal_freq[NUM_GAIN_CAL_TBLS];
+
+    /* Applied to the buffers of subsequently initialized streams */
+    struct bladerf_stream_buffer_config stream_buf_config;
+
+    /* Asynchronous control command queue */
+    struct control_queue *ctrl_queue;
+
+    /* Scheduled retunes waiting for room in the FPGA's queues */
+    struct retune_queue *retune_queue;
 };
 
 struct board_fns {
@@ -327,6 +365,15 @@ struct board_fns {
                            bladerf_frequency frequency,
                            struct bladerf_quick_tune *quick_tune);
     int (*cancel_scheduled_retunes)(struct bladerf *dev, bladerf_channel ch);
+    int (*get_quick_tune_stats)(struct bladerf *dev,
+                                bladerf_direction dir,
+                                struct bladerf_quick_tune_stats *stats);
+    int (*clear_quick_tune_cache)(struct bladerf *dev, bladerf_direction dir);
+    int (*build_hop_set)(struct bladerf *dev,
+                         bladerf_channel ch,
+                         const bladerf_frequency *frequencies,
+                         unsigned int n,
+                         struct bladerf_quick_tune *quick_tunes);
 
     /* DC/Phase/Gain Correction */
     int (*get_correction)(struct bladerf *dev,
@@ -337,6 +384,18 @@ struct board_fns {
                           bladerf_channel ch,
                           bladerf_correction corr,
                           int16_t value);
+    int (*get_correction_profile)(struct bladerf *dev,
+                                  bladerf_channel ch,
+                                  struct bladerf_correction_profile *profile);
+    int (*set_correction_profile)(
+        struct bladerf *dev,
+        bladerf_channel ch,
+        const struct bladerf_correction_profile *profile);
+    int (*set_quick_tune_correction_profile)(
+        struct bladerf *dev,
+        bladerf_channel ch,
+        const struct bladerf_quick_tune *quick_tune,
+        const struct bladerf_correction_profile *profile);
 
     /* Trigger */
     int (*trigger_init)(struct bladerf *dev,
@@ -398,6 +457,31 @@ struct board_fns {
                    unsigned int num_samples,
                    struct bladerf_metadata *metadata,
                    unsigned int timeout_ms);
+    int (*sync_rx_acquire)(struct bladerf *dev,
+                           void **samples,
+                           unsigned int *num_samples,
+                           struct bladerf_metadata *metadata,
+                           unsigned int timeout_ms);
+    int (*sync_rx_release)(struct bladerf *dev, unsigned int num_samples);
+    int (*sync_tx_acquire)(struct bladerf *dev,
+                           void **samples,
+                           unsigned int *num_samples,
+                           struct bladerf_metadata *metadata,
+                           unsigned int timeout_ms);
+    int (*sync_tx_commit)(struct bladerf *dev,
+                          unsigned int num_samples,
+                          struct bladerf_metadata *metadata);
+    int (*get_stream_stats)(struct bladerf *dev,
+                            bladerf_direction dir,
+                            struct bladerf_stream_stats *stats);
+    int (*set_stream_thread_config)(
+        struct bladerf *dev,
+        bladerf_direction dir,
+        const struct bladerf_stream_thread_config *config);
+    int (*get_stream_thread_config)(
+        struct bladerf *dev,
+        bladerf_direction dir,
+        struct bladerf_stream_thread_config *config);
     int (*get_timestamp)(struct bladerf *dev,
                          bladerf_direction dir,
                          bladerf_timestamp *timestamp);
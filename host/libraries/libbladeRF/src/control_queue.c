@@ -0,0 +1,381 @@
+/*
+ * This file is part of the bladeRF project:
+ *   http://www.github.com/nuand/bladeRF
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "log.h"
+#include "thread.h"
+
+#include "board/board.h"
+#include "control_queue.h"
+#include "helpers/timeout.h"
+
+/* A submitted command. Entries live on the pending list until the worker
+ * picks them up. Once complete, entries that the caller holds a handle to are
+ * moved to the done list until bladerf_control_wait() releases them; all
+ * others are freed immediately. */
+struct bladerf_control_handle {
+    struct bladerf_control_cmd cmd;
+    bladerf_control_cb cb;
+    void *user_data;
+
+    bool has_handle;
+    bool done;
+    int status;
+
+    struct bladerf_control_handle *next;
+};
+
+struct control_queue {
+    MUTEX lock;
+    pthread_cond_t pending;   /* Signaled on submission and shutdown */
+    pthread_cond_t completed; /* Broadcast as each command completes */
+
+    pthread_t thread;
+    bool thread_running;
+    bool shutdown;
+
+    struct bladerf_control_handle *head; /* Pending commands, FIFO order */
+    struct bladerf_control_handle *tail;
+    struct bladerf_control_handle *done; /* Completed, awaiting release */
+
+    /* Number of commands queued or being performed */
+    unsigned int outstanding;
+};
+
+static int perform(struct bladerf *dev, const struct bladerf_control_cmd *cmd)
+{
+    switch (cmd->op) {
+        case BLADERF_CONTROL_FREQUENCY:
+            return bladerf_set_frequency(dev, cmd->ch, cmd->value.frequency);
+
+        case BLADERF_CONTROL_GAIN:
+            return bladerf_set_gain(dev, cmd->ch, cmd->value.gain);
+
+        case BLADERF_CONTROL_GAIN_MODE:
+            return bladerf_set_gain_mode(dev, cmd->ch, cmd->value.gain_mode);
+
+        case BLADERF_CONTROL_BANDWIDTH:
+            return bladerf_set_bandwidth(dev, cmd->ch, cmd->value.bandwidth,
+                                         NULL);
+
+        case BLADERF_CONTROL_SAMPLE_RATE:
+            return bladerf_set_sample_rate(dev, cmd->ch,
+                                           cmd->value.sample_rate, NULL);
+
+        case BLADERF_CONTROL_CORRECTION:
+            return bladerf_set_correction(dev, cmd->ch,
+                                          cmd->value.correction.corr,
+                                          cmd->value.correction.value);
+
+        default:
+            return BLADERF_ERR_INVAL;
+    }
+}
+
+static void *control_queue_task(void *arg)
+{
+    struct bladerf *dev = arg;
+    struct control_queue *q = dev->ctrl_queue;
+    struct bladerf_control_handle *e;
+    int status;
+
+    MUTEX_LOCK(&q->lock);
+
+    while (true) {
+        while (q->head == NULL && !q->shutdown) {
+            pthread_cond_wait(&q->pending, &q->lock);
+        }
+
+        /* Anything queued before shutdown is still performed */
+        if (q->head == NULL) {
+            break;
+        }
+
+        e       = q->head;
+        q->head = e->next;
+        if (q->head == NULL) {
+            q->tail = NULL;
+        }
+
+        MUTEX_UNLOCK(&q->lock);
+
+        status = perform(dev, &e->cmd);
+        if (status != 0) {
+            log_debug("%s: control op %d on channel %d failed: %s\n",
+                      __FUNCTION__, e->cmd.op, e->cmd.ch,
+                      bladerf_strerror(status));
+        }
+
+        if (e->cb != NULL) {
+            e->cb(dev, &e->cmd, status, e->user_data);
+        }
+
+        MUTEX_LOCK(&q->lock);
+
+        q->outstanding--;
+
+        if (e->has_handle) {
+            e->status = status;
+            e->done   = true;
+            e->next   = q->done;
+            q->done   = e;
+        } else {
+            free(e);
+        }
+
+        pthread_cond_broadcast(&q->completed);
+    }
+
+    MUTEX_UNLOCK(&q->lock);
+
+    return NULL;
+}
+
+/* Wait for the next command completion. Expects q->lock to be held. A
+ * `timeout_ms` of 0 waits indefinitely; otherwise `t_abs` is the deadline. */
+static int wait_completed(struct control_queue *q, unsigned int timeout_ms,
+                          const struct timespec *t_abs)
+{
+    int status;
+
+    if (timeout_ms == 0) {
+        status = pthread_cond_wait(&q->completed, &q->lock);
+    } else {
+        status = pthread_cond_timedwait(&q->completed, &q->lock, t_abs);
+    }
+
+    if (status == ETIMEDOUT) {
+        return BLADERF_ERR_TIMEOUT;
+    } else if (status != 0) {
+        return BLADERF_ERR_UNEXPECTED;
+    }
+
+    return 0;
+}
+
+int control_queue_init(struct bladerf *dev)
+{
+    struct control_queue *q;
+
+    q = calloc(1, sizeof(*q));
+    if (q == NULL) {
+        return BLADERF_ERR_MEM;
+    }
+
+    MUTEX_INIT(&q->lock);
+    pthread_cond_init(&q->pending, NULL);
+    pthread_cond_init(&q->completed, NULL);
+
+    dev->ctrl_queue = q;
+    return 0;
+}
+
+void control_queue_deinit(struct bladerf *dev)
+{
+    struct control_queue *q = dev->ctrl_queue;
+    struct bladerf_control_handle *e;
+
+    if (q == NULL) {
+        return;
+    }
+
+    MUTEX_LOCK(&q->lock);
+    q->shutdown = true;
+    pthread_cond_signal(&q->pending);
+    MUTEX_UNLOCK(&q->lock);
+
+    if (q->thread_running) {
+        pthread_join(q->thread, NULL);
+    }
+
+    /* Handles that were never waited upon */
+    while (q->done != NULL) {
+        e       = q->done;
+        q->done = e->next;
+        free(e);
+    }
+
+    pthread_cond_destroy(&q->completed);
+    pthread_cond_destroy(&q->pending);
+    MUTEX_DESTROY(&q->lock);
+
+    free(q);
+    dev->ctrl_queue = NULL;
+}
+
+int control_queue_submit(struct bladerf *dev,
+                         const struct bladerf_control_cmd *cmd,
+                         bladerf_control_cb cb,
+                         void *user_data,
+                         struct bladerf_control_handle **handle)
+{
+    struct control_queue *q = dev->ctrl_queue;
+    struct bladerf_control_handle *e;
+    int status = 0;
+
+    switch (cmd->op) {
+        case BLADERF_CONTROL_FREQUENCY:
+        case BLADERF_CONTROL_GAIN:
+        case BLADERF_CONTROL_GAIN_MODE:
+        case BLADERF_CONTROL_BANDWIDTH:
+        case BLADERF_CONTROL_SAMPLE_RATE:
+        case BLADERF_CONTROL_CORRECTION:
+            break;
+
+        default:
+            log_debug("%s: Invalid control op: %d\n", __FUNCTION__, cmd->op);
+            return BLADERF_ERR_INVAL;
+    }
+
+    e = calloc(1, sizeof(*e));
+    if (e == NULL) {
+        return BLADERF_ERR_MEM;
+    }
+
+    e->cmd        = *cmd;
+    e->cb         = cb;
+    e->user_data  = user_data;
+    e->has_handle = (handle != NULL);
+
+    MUTEX_LOCK(&q->lock);
+
+    if (q->shutdown) {
+        status = BLADERF_ERR_NODEV;
+        goto out;
+    }
+
+    if (q->outstanding >= BLADERF_CONTROL_QUEUE_LEN) {
+        status = BLADERF_ERR_QUEUE_FULL;
+        goto out;
+    }
+
+    if (!q->thread_running) {
+        status = pthread_create(&q->thread, NULL, control_queue_task, dev);
+        if (status != 0) {
+            log_debug("%s: pthread_create failed: %s\n", __FUNCTION__,
+                      strerror(status));
+            status = BLADERF_ERR_UNEXPECTED;
+            goto out;
+        }
+
+        q->thread_running = true;
+    }
+
+    if (q->tail == NULL) {
+        q->head = e;
+    } else {
+        q->tail->next = e;
+    }
+    q->tail = e;
+
+    q->outstanding++;
+    pthread_cond_signal(&q->pending);
+
+    if (handle != NULL) {
+        *handle = e;
+    }
+
+out:
+    MUTEX_UNLOCK(&q->lock);
+
+    if (status != 0) {
+        free(e);
+    }
+
+    return status;
+}
+
+int control_queue_wait(struct bladerf *dev,
+                       struct bladerf_control_handle *handle,
+                       unsigned int timeout_ms,
+                       int *cmd_status)
+{
+    struct control_queue *q = dev->ctrl_queue;
+    struct bladerf_control_handle **p;
+    struct timespec t_abs;
+    int status = 0;
+
+    if (!handle->has_handle) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    if (timeout_ms != 0) {
+        status = populate_abs_timeout(&t_abs, timeout_ms);
+        if (status != 0) {
+            return status;
+        }
+    }
+
+    MUTEX_LOCK(&q->lock);
+
+    while (!handle->done && status == 0) {
+        status = wait_completed(q, timeout_ms, &t_abs);
+    }
+
+    if (status == 0) {
+        for (p = &q->done; *p != NULL; p = &(*p)->next) {
+            if (*p == handle) {
+                *p = handle->next;
+                break;
+            }
+        }
+    }
+
+    MUTEX_UNLOCK(&q->lock);
+
+    if (status == 0) {
+        if (cmd_status != NULL) {
+            *cmd_status = handle->status;
+        }
+
+        free(handle);
+    }
+
+    return status;
+}
+
+int control_queue_flush(struct bladerf *dev, unsigned int timeout_ms)
+{
+    struct control_queue *q = dev->ctrl_queue;
+    struct timespec t_abs;
+    int status = 0;
+
+    if (timeout_ms != 0) {
+        status = populate_abs_timeout(&t_abs, timeout_ms);
+        if (status != 0) {
+            return status;
+        }
+    }
+
+    MUTEX_LOCK(&q->lock);
+
+    while (q->outstanding != 0 && status == 0) {
+        status = wait_completed(q, timeout_ms, &t_abs);
+    }
+
+    MUTEX_UNLOCK(&q->lock);
+
+    return status;
+}
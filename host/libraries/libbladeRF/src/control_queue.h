@@ -0,0 +1,73 @@
+/*
+ * This file is part of the bladeRF project:
+ *   http://www.github.com/nuand/bladeRF
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef CONTROL_QUEUE_H_
+#define CONTROL_QUEUE_H_
+
+#include <libbladeRF.h>
+
+/* Per-device queue of asynchronous control commands. Opaque outside of
+ * control_queue.c */
+struct control_queue;
+
+/**
+ * Allocate a device's control queue. The worker thread is not started until
+ * the first command is submitted.
+ *
+ * @param       dev         Device handle
+ *
+ * @return 0 on success, BLADERF_ERR_MEM on allocation failure
+ */
+int control_queue_init(struct bladerf *dev);
+
+/**
+ * Perform any queued commands, stop the worker thread, and free the queue.
+ *
+ * This must be called without holding dev->lock, as the worker thread
+ * acquires it to perform commands.
+ *
+ * @param       dev         Device handle
+ */
+void control_queue_deinit(struct bladerf *dev);
+
+/**
+ * See bladerf_control_submit()
+ */
+int control_queue_submit(struct bladerf *dev,
+                         const struct bladerf_control_cmd *cmd,
+                         bladerf_control_cb cb,
+                         void *user_data,
+                         struct bladerf_control_handle **handle);
+
+/**
+ * See bladerf_control_wait()
+ */
+int control_queue_wait(struct bladerf *dev,
+                       struct bladerf_control_handle *handle,
+                       unsigned int timeout_ms,
+                       int *cmd_status);
+
+/**
+ * See bladerf_control_flush()
+ */
+int control_queue_flush(struct bladerf *dev, unsigned int timeout_ms);
+
+#endif
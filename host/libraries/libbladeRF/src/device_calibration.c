@@ -20,16 +20,31 @@
  */
 
 
+#include <errno.h>
 #include <string.h>
 #include <stdio.h>
 #include <unistd.h>
 #include <limits.h>
 #include "libbladeRF.h"
+#include "host_config.h"
 #include "board/board.h"
+#include "helpers/file.h"
 #include "helpers/version.h"
 #include "device_calibration.h"
 #include "log.h"
 #include "common.h"
+#include "sha256.h"
+
+/* Version 2 table files are mapped and used in place where their layout
+ * matches the host's. Elsewhere, they are read into memory. */
+#if !BLADERF_OS_WINDOWS && !BLADERF_BIG_ENDIAN
+#   define GAIN_CAL_USE_MMAP 1
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#else
+#   define GAIN_CAL_USE_MMAP 0
+#endif
 
 #define GAIN_CAL_HEADER_RX "RX Chain,RX Gain,VSG Power into bladeRF RX (dBm),Frequency of signal (Hz),Frequency of bladeRF+PXI (Hz),AD9361 RSSI register value,Power of Signal from Full Scale (dBFS)\0"
 #define GAIN_CAL_HEADER_TX "TX Chain,TX Gain,Frequency of Signal (Hz),Frequency of bladeRF+PXI (Hz),VSA Measured Power (dBm)\0"
@@ -41,6 +56,52 @@
     .patch = 0, \
 }
 
+/* Version 2 table files consist of a struct gain_cal_file_hdr, followed by
+ * the table's entries. Entries have the layout of a
+ * struct bladerf_gain_cal_entry, and only those that gain compensation uses
+ * are stored. All fields are little-endian. */
+#define GAIN_CAL_FILE_MAGIC   "BRFGCAL"
+#define GAIN_CAL_FILE_VERSION 2
+
+#define GAIN_CAL_FILE_BLADERF_VERSION (struct bladerf_version) { \
+    .describe = "gain calibration table", \
+    .major = GAIN_CAL_FILE_VERSION, \
+    .minor = 0, \
+    .patch = 0, \
+}
+
+/* Gains, in the CSV files, of the measurements that corrections are taken
+ * from */
+#define GAIN_CAL_REF_GAIN_RX 0
+#define GAIN_CAL_REF_GAIN_TX 60
+
+struct gain_cal_file_hdr {
+    char magic[8];                      /* GAIN_CAL_FILE_MAGIC */
+    uint32_t version;                   /* GAIN_CAL_FILE_VERSION */
+    uint32_t header_len;                /* Offset of the first entry */
+    uint32_t entry_len;                 /* Size of each entry */
+    uint32_t n_entries;                 /* Number of entries */
+    uint32_t channel;                   /* bladerf_channel */
+    uint32_t gain;                      /* Reference gain, as above */
+    char serial[48];                    /* Device serial number */
+    uint8_t sha256[SHA256_DIGEST_SIZE]; /* See gain_cal_file_digest() */
+    uint8_t reserved[16];
+};
+
+/* Converts a double between host and little-endian byte order, in place */
+static inline void gain_cal_double_le(double *value)
+{
+#if BLADERF_BIG_ENDIAN
+    uint64_t tmp;
+
+    memcpy(&tmp, value, sizeof(tmp));
+    tmp = LE64_TO_HOST(tmp);
+    memcpy(value, &tmp, sizeof(tmp));
+#else
+    (void)value;
+#endif
+}
+
 #define __round_int(x) (x >= 0 ? (int)(x + 0.5) : (int)(x - 0.5))
 
 #define RETURN_ERROR_STATUS(_what, _status)                   \
@@ -58,38 +119,45 @@
         }                                  \
     } while (0)
 
-static size_t count_csv_entries(const char *filename) {
-    char line[1024]; // Adjust buffer size as needed
-    int count = 0;
-
-    FILE *file = fopen(filename, "r");
-    if (file == NULL) {
-        perror("Error opening file");
-        return -1;
+/* Reads the next line that is not blank. Returns false at the end of the
+ * file. */
+static bool read_csv_line(FILE *f, char *line, size_t len)
+{
+    while (fgets(line, (int)len, f) != NULL) {
+        if (line[strspn(line, " \t\r\n")] != '\0') {
+            return true;
+        }
     }
 
-    while (fgets(line, sizeof(line), file)) {
-        count++;
-    }
+    return false;
+}
 
-    fclose(file);
+/* The file's digest covers its entries, followed by its header with the
+ * digest field zeroed. This allows a converter to hash the entries as they
+ * are written, before the header's contents are known. */
+static void gain_cal_file_digest(SHA256_CTX *ctx,
+                                 const struct gain_cal_file_hdr *hdr,
+                                 uint8_t digest[SHA256_DIGEST_SIZE])
+{
+    struct gain_cal_file_hdr h = *hdr;
 
-    return count - 2; // Subtract 2 to account for the serial number and header lines
+    memset(h.sha256, 0, sizeof(h.sha256));
+    SHA256_Update(ctx, &h, sizeof(h));
+    SHA256_Final(digest, ctx);
 }
 
 int gain_cal_csv_to_bin(struct bladerf *dev, const char *csv_path, const char *binary_path, bladerf_channel ch)
 {
     int status = 0;
-    struct bladerf_image *image;
-    size_t data_size;
-    size_t entry_size;
-    size_t offset = 0;
+    const bool tx = BLADERF_CHANNEL_IS_TX(ch);
+    const char *expected_header = tx ? GAIN_CAL_HEADER_TX : GAIN_CAL_HEADER_RX;
+    struct gain_cal_file_hdr hdr;
+    SHA256_CTX ctx;
+    uint32_t n_entries = 0;
+    unsigned long line_num = 2;
 
     char line[256];
-    char current_dir[1000];
-    char expected_header[1024];
-    char device_serial[BLADERF_SERIAL_LENGTH];
-    char csv_serial[BLADERF_SERIAL_LENGTH];
+    char csv_serial[BLADERF_SERIAL_LENGTH] = { 0 };
 
     uint64_t frequency;
     float power;
@@ -104,16 +172,14 @@ int gain_cal_csv_to_bin(struct bladerf *dev, const char *csv_path, const char *b
     FILE *binaryFile = fopen(binary_path, "wb");
     if (!csvFile || !binaryFile) {
         status = BLADERF_ERR_NO_FILE;
-        if (getcwd(current_dir, sizeof(current_dir)) != NULL) {
-            log_error("Error opening calibration file: %s\n", strcat(current_dir, csv_path));
-        } else {
-            log_error("Error opening calibration file\n");
-        }
+        log_error("Error opening calibration file: %s\n",
+                  csvFile ? binary_path : csv_path);
         goto error;
     }
 
-    strncpy(device_serial, dev->ident.serial, BLADERF_SERIAL_LENGTH);
-    device_serial[BLADERF_SERIAL_LENGTH - 1] = '\0';
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, GAIN_CAL_FILE_MAGIC, sizeof(hdr.magic));
+    strncpy(hdr.serial, dev->ident.serial, sizeof(hdr.serial) - 1);
 
     if (!fgets(line, sizeof(line), csvFile)) {
         status = BLADERF_ERR_INVAL;
@@ -121,94 +187,117 @@ int gain_cal_csv_to_bin(struct bladerf *dev, const char *csv_path, const char *b
         goto error;
     }
 
-    sscanf(line, "Serial: %s", csv_serial);
-    if (strcmp(device_serial, csv_serial) != 0) {
-        log_warning("Gain calibration file serial (%s) does not match device serial (%s)\n", csv_serial, device_serial);
+    sscanf(line, "Serial: %32s", csv_serial);
+    if (strcmp(hdr.serial, csv_serial) != 0) {
+        log_warning("Gain calibration file serial (%s) does not match device serial (%s)\n", csv_serial, hdr.serial);
     }
 
-    size_t num_entries = count_csv_entries(csv_path);
-    if (num_entries == 0) {
+    if (!fgets(line, sizeof(line), csvFile)) {
         status = BLADERF_ERR_INVAL;
         log_error("Error reading header from CSV file or file is empty.\n");
         goto error;
     }
 
-    entry_size = (BLADERF_CHANNEL_IS_TX(ch))
-        ? sizeof(chain) + sizeof(gain) + sizeof(cw_freq) + sizeof(frequency) + sizeof(power)
-        : sizeof(chain) + sizeof(gain) + sizeof(vsg_power) + sizeof(signal_freq) + sizeof(frequency) + sizeof(rssi) + sizeof(power);
-
-    data_size = num_entries * entry_size + BLADERF_SERIAL_LENGTH;
-
-    image = bladerf_alloc_image(dev, BLADERF_IMAGE_TYPE_GAIN_CAL, 0xffffffff, data_size);
-    if (image == NULL) {
-        log_error("Failed to allocate image\n");
-        status = BLADERF_ERR_MEM;
-        goto error;
-    }
-
-    if (!fgets(line, sizeof(line), csvFile)) {
+    if (strncmp(line, expected_header, strlen(expected_header)) != 0) {
         status = BLADERF_ERR_INVAL;
-        log_error("Error reading header from CSV file or file is empty.\n");
+        log_error("CSV format does not match expected %s headers\n", tx ? "TX" : "RX");
         goto error;
     }
 
-    strncpy(expected_header, (BLADERF_CHANNEL_IS_TX(ch)) ? GAIN_CAL_HEADER_TX : GAIN_CAL_HEADER_RX, sizeof(expected_header));
-    if (strncmp(line, expected_header, strlen(expected_header)) != 0) {
-        status = BLADERF_ERR_INVAL;
-        log_error("CSV format does not match expected %s headers\n", (BLADERF_CHANNEL_IS_TX(ch)) ? "TX" : "RX");
+    /* The header is written once the entries have been counted */
+    if (fwrite(&hdr, sizeof(hdr), 1, binaryFile) != 1) {
+        status = BLADERF_ERR_IO;
         goto error;
     }
 
-    image->version = GAIN_CAL_VERSION;
+    SHA256_Init(&ctx);
 
-    memcpy(&image->data[offset], device_serial, BLADERF_SERIAL_LENGTH);
-    offset += BLADERF_SERIAL_LENGTH;
+    /* Only the measurements that gain compensation is relative to are kept,
+     * so the output holds exactly the entries of the loaded table */
+    while (read_csv_line(csvFile, line, sizeof(line))) {
+        struct bladerf_gain_cal_entry entry;
+        uint64_t le_freq;
+        int n;
 
-    for (size_t i = 0; i < num_entries; i++) {
-        if (!fgets(line, sizeof(line), csvFile)) {
-            break;
-        }
+        line_num++;
 
-        if (BLADERF_CHANNEL_IS_TX(ch)) {
-            sscanf(line, "%" SCNu8 ",%" SCNi32 ",%" SCNu64 ",%" SCNu64 ",%f",
-                &chain, &gain, &cw_freq, &frequency, &power);
+        if (tx) {
+            n = sscanf(line, "%" SCNu8 ",%" SCNi32 ",%" SCNu64 ",%" SCNu64 ",%f",
+                       &chain, &gain, &cw_freq, &frequency, &power);
+            if (n != 5) {
+                goto malformed;
+            } else if (chain != 0 || gain != GAIN_CAL_REF_GAIN_TX) {
+                continue;
+            }
 
-            memcpy(&image->data[offset], &chain, sizeof(chain));
-            offset += sizeof(chain);
-            memcpy(&image->data[offset], &gain, sizeof(gain));
-            offset += sizeof(gain);
-            memcpy(&image->data[offset], &cw_freq, sizeof(cw_freq));
-            offset += sizeof(cw_freq);
-            memcpy(&image->data[offset], &frequency, sizeof(frequency));
-            offset += sizeof(frequency);
-            memcpy(&image->data[offset], &power, sizeof(power));
-            offset += sizeof(power);
+            entry.gain_corr = power;
         } else {
-            sscanf(line, "%" SCNu8 ",%" SCNi32 ",%f,%" SCNu64 ",%" SCNu64 ",%" SCNi32 ",%f",
-                &chain, &gain, &vsg_power, &signal_freq, &frequency, &rssi, &power);
+            n = sscanf(line, "%" SCNu8 ",%" SCNi32 ",%f,%" SCNu64 ",%" SCNu64 ",%" SCNi32 ",%f",
+                       &chain, &gain, &vsg_power, &signal_freq, &frequency, &rssi, &power);
+            if (n != 7) {
+                goto malformed;
+            } else if (chain != 0 || gain != GAIN_CAL_REF_GAIN_RX) {
+                continue;
+            }
+
+            entry.gain_corr = power - vsg_power;
+        }
 
-            memcpy(&image->data[offset], &chain, sizeof(chain));
-            offset += sizeof(chain);
-            memcpy(&image->data[offset], &gain, sizeof(gain));
-            offset += sizeof(gain);
-            memcpy(&image->data[offset], &vsg_power, sizeof(vsg_power));
-            offset += sizeof(vsg_power);
-            memcpy(&image->data[offset], &signal_freq, sizeof(signal_freq));
-            offset += sizeof(signal_freq);
-            memcpy(&image->data[offset], &frequency, sizeof(frequency));
-            offset += sizeof(frequency);
-            memcpy(&image->data[offset], &rssi, sizeof(rssi));
-            offset += sizeof(rssi);
-            memcpy(&image->data[offset], &power, sizeof(power));
-            offset += sizeof(power);
+        if (n_entries == UINT32_MAX) {
+            status = BLADERF_ERR_INVAL;
+            log_error("Too many entries in %s\n", csv_path);
+            goto error;
         }
+
+        /* Stored little-endian, as with the header */
+        le_freq = HOST_TO_LE64(frequency);
+        memcpy(&entry.freq, &le_freq, sizeof(entry.freq));
+        gain_cal_double_le(&entry.gain_corr);
+
+        if (fwrite(&entry, sizeof(entry), 1, binaryFile) != 1) {
+            status = BLADERF_ERR_IO;
+            goto error;
+        }
+
+        SHA256_Update(&ctx, &entry, sizeof(entry));
+        n_entries++;
+        continue;
+
+malformed:
+        status = BLADERF_ERR_INVAL;
+        log_error("Malformed entry on line %lu of %s\n", line_num, csv_path);
+        goto error;
+    }
+
+    if (n_entries == 0) {
+        status = BLADERF_ERR_INVAL;
+        log_error("No valid entries found: %s\n", csv_path);
+        goto error;
     }
 
-    log_debug("Writing image to file: %s\n", binary_path);
-    bladerf_image_write(dev, image, binary_path);
-    bladerf_free_image(image);
+    hdr.version    = HOST_TO_LE32(GAIN_CAL_FILE_VERSION);
+    hdr.header_len = HOST_TO_LE32(sizeof(hdr));
+    hdr.entry_len  = HOST_TO_LE32(sizeof(struct bladerf_gain_cal_entry));
+    hdr.n_entries  = HOST_TO_LE32(n_entries);
+    hdr.channel    = HOST_TO_LE32((uint32_t)ch);
+    hdr.gain       = HOST_TO_LE32((uint32_t)(tx ? GAIN_CAL_REF_GAIN_TX
+                                                : GAIN_CAL_REF_GAIN_RX));
+    gain_cal_file_digest(&ctx, &hdr, hdr.sha256);
+
+    log_debug("Writing %u entries to file: %s\n", n_entries, binary_path);
+
+    if (fseek(binaryFile, 0, SEEK_SET) != 0 ||
+        fwrite(&hdr, sizeof(hdr), 1, binaryFile) != 1 ||
+        fflush(binaryFile) != 0) {
+        status = BLADERF_ERR_IO;
+        goto error;
+    }
 
 error:
+    if (status == BLADERF_ERR_IO) {
+        log_error("Failed to write %s: %s\n", binary_path, strerror(errno));
+    }
+
     if (csvFile)
         fclose(csvFile);
     if (binaryFile)
@@ -268,6 +357,221 @@ void gain_cal_tbl_free(struct bladerf_gain_cal_tbl *tbl) {
     tbl->state = BLADERF_GAIN_CAL_UNLOADED;
 }
 
+/* Reads a file's contents into `map`. Where the file's layout matches the
+ * host's, it is mapped so that its entries can be used in place. */
+static int gain_cal_map_file(const char *path, struct gain_cal_map *map)
+{
+#if GAIN_CAL_USE_MMAP
+    struct stat st;
+    void *addr;
+    int fd;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        log_error("Error opening %s: %s\n", path, strerror(errno));
+        return BLADERF_ERR_NO_FILE;
+    }
+
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        log_error("Failed to determine the size of %s\n", path);
+        return BLADERF_ERR_IO;
+    }
+
+    addr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (addr == MAP_FAILED) {
+        log_error("Failed to map %s: %s\n", path, strerror(errno));
+        return BLADERF_ERR_IO;
+    }
+
+    map->addr   = addr;
+    map->len    = (size_t)st.st_size;
+    map->mapped = true;
+    return 0;
+#else
+    uint8_t *buf;
+    size_t len;
+    int status;
+
+    status = file_read_buffer(path, &buf, &len);
+    if (status != 0) {
+        return status;
+    }
+
+    map->addr   = buf;
+    map->len    = len;
+    map->mapped = false;
+    return 0;
+#endif
+}
+
+static void gain_cal_map_free(struct gain_cal_map *map)
+{
+    if (map->addr != NULL) {
+#if GAIN_CAL_USE_MMAP
+        if (map->mapped) {
+            munmap(map->addr, map->len);
+        } else {
+            free(map->addr);
+        }
+#else
+        free(map->addr);
+#endif
+    }
+
+    map->addr   = NULL;
+    map->len    = 0;
+    map->mapped = false;
+}
+
+void gain_cal_release(struct bladerf *dev, bladerf_channel ch)
+{
+    /* The entries of a table loaded in place belong to its file's contents */
+    if (dev->gain_maps[ch].addr != NULL) {
+        dev->gain_tbls[ch].entries = NULL;
+    }
+
+    gain_cal_tbl_free(&dev->gain_tbls[ch]);
+    gain_cal_lut_free(&dev->gain_luts[ch]);
+    gain_cal_map_free(&dev->gain_maps[ch]);
+}
+
+/* Replaces a channel's table, taking ownership of `tbl`, `lut` and `map` */
+static void gain_cal_install(struct bladerf *dev, bladerf_channel ch,
+                             const struct bladerf_gain_cal_tbl *tbl,
+                             const struct gain_cal_lut *lut,
+                             const struct gain_cal_map *map)
+{
+    gain_cal_release(dev, ch);
+
+    dev->gain_tbls[ch] = *tbl;
+    dev->gain_luts[ch] = *lut;
+    dev->gain_maps[ch] = *map;
+}
+
+/* Loads a version 2 table file */
+static int load_gain_cal_file(struct bladerf *dev, bladerf_channel ch,
+                              const char *path, bladerf_gain current_gain)
+{
+    struct gain_cal_map map = { NULL, 0, false };
+    struct bladerf_gain_cal_tbl tbl;
+    struct bladerf_gain_cal_entry *entries;
+    struct gain_cal_file_hdr hdr;
+    struct gain_cal_lut lut;
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    SHA256_CTX ctx;
+    uint32_t header_len, entry_len, n_entries, file_ch;
+    int status;
+
+    status = gain_cal_map_file(path, &map);
+    if (status != 0) {
+        return status;
+    }
+
+    memset(&tbl, 0, sizeof(tbl));
+
+    if (map.len < sizeof(hdr)) {
+        log_error("Gain calibration table is truncated\n");
+        status = BLADERF_ERR_INVAL;
+        goto error;
+    }
+
+    memcpy(&hdr, map.addr, sizeof(hdr));
+    header_len = LE32_TO_HOST(hdr.header_len);
+    entry_len  = LE32_TO_HOST(hdr.entry_len);
+    n_entries  = LE32_TO_HOST(hdr.n_entries);
+    file_ch    = LE32_TO_HOST(hdr.channel);
+
+    if (memcmp(hdr.magic, GAIN_CAL_FILE_MAGIC, sizeof(hdr.magic)) != 0 ||
+        LE32_TO_HOST(hdr.version) != GAIN_CAL_FILE_VERSION) {
+        log_error("Expected gain calibration table: v%u\n",
+                  GAIN_CAL_FILE_VERSION);
+        log_error("Imported gain calibration table: v%u\n",
+                  LE32_TO_HOST(hdr.version));
+        status = BLADERF_ERR_INVAL;
+        goto error;
+    }
+
+    /* Entries must be aligned for use in place */
+    if (header_len < sizeof(hdr) || header_len % sizeof(uint64_t) != 0 ||
+        entry_len != sizeof(struct bladerf_gain_cal_entry) ||
+        n_entries == 0 || header_len > map.len ||
+        (map.len - header_len) / entry_len != n_entries ||
+        (map.len - header_len) % entry_len != 0) {
+        log_error("Gain calibration table size does not match its header\n");
+        status = BLADERF_ERR_INVAL;
+        goto error;
+    }
+
+    entries = (struct bladerf_gain_cal_entry *)((uint8_t *)map.addr + header_len);
+
+    SHA256_Init(&ctx);
+    SHA256_Update(&ctx, entries, (size_t)n_entries * entry_len);
+    gain_cal_file_digest(&ctx, &hdr, digest);
+
+    if (memcmp(digest, hdr.sha256, sizeof(digest)) != 0) {
+        log_error("Gain calibration table checksum mismatch\n");
+        status = BLADERF_ERR_CHECKSUM;
+        goto error;
+    }
+
+    if (BLADERF_CHANNEL_IS_TX(file_ch) != BLADERF_CHANNEL_IS_TX(ch)) {
+        log_error("Gain calibration table is for %s, not %s\n",
+                  BLADERF_CHANNEL_IS_TX(file_ch) ? "TX" : "RX",
+                  BLADERF_CHANNEL_IS_TX(ch) ? "TX" : "RX");
+        status = BLADERF_ERR_INVAL;
+        goto error;
+    }
+
+    hdr.serial[sizeof(hdr.serial) - 1] = '\0';
+    if (strcmp(dev->ident.serial, hdr.serial) != 0) {
+        log_warning("Calibration file serial (%s) does not match device serial (%s)\n", hdr.serial, dev->ident.serial);
+    }
+
+#if BLADERF_BIG_ENDIAN
+    for (uint32_t i = 0; i < n_entries; i++) {
+        entries[i].freq = LE64_TO_HOST(entries[i].freq);
+        gain_cal_double_le(&entries[i].gain_corr);
+    }
+#endif
+
+    tbl.version       = GAIN_CAL_FILE_BLADERF_VERSION;
+    tbl.ch            = ch;
+    tbl.enabled       = true;
+    tbl.n_entries     = n_entries;
+    tbl.start_freq    = entries[0].freq;
+    tbl.stop_freq     = entries[n_entries - 1].freq;
+    tbl.entries       = entries;
+    tbl.gain_target   = current_gain;
+    tbl.file_path_len = PATH_MAX;
+    tbl.state         = BLADERF_GAIN_CAL_LOADED;
+
+    tbl.file_path = calloc(1, tbl.file_path_len + 1);
+    if (tbl.file_path == NULL) {
+        status = BLADERF_ERR_MEM;
+        goto error;
+    }
+
+    strncpy(tbl.file_path, path, tbl.file_path_len);
+
+    status = gain_cal_lut_compile(&tbl, &lut);
+    if (status != 0) {
+        log_error("Failed to compile gain calibration lookup\n");
+        goto error;
+    }
+
+    log_debug("Loaded %u gain calibration entries in place\n", n_entries);
+    gain_cal_install(dev, ch, &tbl, &lut, &map);
+    return 0;
+
+error:
+    free(tbl.file_path);
+    gain_cal_map_free(&map);
+    return status;
+}
+
 int load_gain_calibration(struct bladerf *dev, bladerf_channel ch, const char *binary_path) {
     int num_channels = 4;
     struct bladerf_gain_cal_tbl gain_tbls[num_channels];
@@ -286,10 +590,13 @@ int load_gain_calibration(struct bladerf *dev, bladerf_channel ch, const char *b
     bladerf_frequency signal_freq;
 
     struct bladerf_image *image = NULL;
+    struct gain_cal_lut lut;
     size_t entry_size;
     size_t num_entries;
     char device_serial[BLADERF_SERIAL_LENGTH];
     char file_serial[BLADERF_SERIAL_LENGTH];
+    char magic[sizeof(GAIN_CAL_FILE_MAGIC)];
+    const struct gain_cal_map no_map = { NULL, 0, false };
 
     FILE *binaryFile = fopen(binary_path, "rb");
     if (!binaryFile) {
@@ -304,6 +611,12 @@ int load_gain_calibration(struct bladerf *dev, bladerf_channel ch, const char *b
         goto error;
     }
 
+    if (fread(magic, 1, sizeof(magic), binaryFile) == sizeof(magic) &&
+        memcmp(magic, GAIN_CAL_FILE_MAGIC, sizeof(magic)) == 0) {
+        status = load_gain_cal_file(dev, ch, binary_path, current_gain);
+        goto error;
+    }
+
     status = gain_cal_tbl_init(&gain_tbls[ch], (uint32_t) 10e3);
     if (status != 0) {
         log_error("Error initializing gain calibration table\n");
@@ -372,13 +685,13 @@ int load_gain_calibration(struct bladerf *dev, bladerf_channel ch, const char *b
             offset += sizeof(power);
         }
 
-        if (BLADERF_CHANNEL_IS_TX(ch) && chain == 0 && gain == 60) {
+        if (BLADERF_CHANNEL_IS_TX(ch) && chain == 0 && gain == GAIN_CAL_REF_GAIN_TX) {
             gain_tbls[ch].entries[entry_counter].freq = frequency;
             gain_tbls[ch].entries[entry_counter].gain_corr = power;
             entry_counter++;
         }
 
-        if (!BLADERF_CHANNEL_IS_TX(ch) && chain == 0 && gain == 0) {
+        if (!BLADERF_CHANNEL_IS_TX(ch) && chain == 0 && gain == GAIN_CAL_REF_GAIN_RX) {
             gain_tbls[ch].entries[entry_counter].freq = frequency;
             gain_tbls[ch].entries[entry_counter].gain_corr = power - vsg_power;
             entry_counter++;
@@ -391,18 +704,25 @@ int load_gain_calibration(struct bladerf *dev, bladerf_channel ch, const char *b
         goto error;
     }
 
+    gain_tbls[ch].n_entries = entry_counter;
+
+    status = gain_cal_lut_compile(&gain_tbls[ch], &lut);
+    if (status != 0) {
+        log_error("Failed to compile gain calibration lookup\n");
+        gain_cal_tbl_free(&gain_tbls[ch]);
+        goto error;
+    }
+
     gain_tbls[ch].version = image->version;
     gain_tbls[ch].start_freq = gain_tbls[ch].entries[0].freq;
     gain_tbls[ch].stop_freq = gain_tbls[ch].entries[entry_counter-1].freq;
-    gain_tbls[ch].n_entries = entry_counter;
     gain_tbls[ch].ch = ch;
     gain_tbls[ch].state = BLADERF_GAIN_CAL_LOADED;
     gain_tbls[ch].enabled = true;
     gain_tbls[ch].gain_target = current_gain;
     strncpy(gain_tbls[ch].file_path, binary_path, gain_tbls[ch].file_path_len);
 
-    gain_cal_tbl_free(&dev->gain_tbls[ch]);
-    dev->gain_tbls[ch] = gain_tbls[ch];
+    gain_cal_install(dev, ch, &gain_tbls[ch], &lut, &no_map);
 
 error:
     if (status != 0) {
@@ -482,14 +802,91 @@ int get_gain_cal_entry(const struct bladerf_gain_cal_tbl *tbl, bladerf_frequency
     return 0;
 }
 
+int lookup_gain_correction(struct bladerf *dev,
+                           bladerf_channel ch,
+                           bladerf_frequency freq,
+                           double *corr)
+{
+    const struct bladerf_gain_cal_tbl *tbl = &dev->gain_tbls[ch];
+
+    if (tbl->state != BLADERF_GAIN_CAL_LOADED || dev->gain_luts[ch].len == 0) {
+        log_error("Gain calibration not loaded\n");
+        return BLADERF_ERR_UNEXPECTED;
+    }
+
+    if (freq > tbl->stop_freq) {
+        log_error("Could not find ceil or floor entries in the calibration table\n");
+        return BLADERF_ERR_UNEXPECTED;
+    }
+
+    gain_cal_lut_lookup(&dev->gain_luts[ch], &freq, 1, corr);
+    return 0;
+}
+
+int get_gain_corrections(struct bladerf *dev,
+                         bladerf_channel ch,
+                         const bladerf_frequency *frequencies,
+                         unsigned int count,
+                         double *corrections)
+{
+    const struct bladerf_gain_cal_tbl *tbl = &dev->gain_tbls[ch];
+    bladerf_frequency max_freq = 0;
+    unsigned int i;
+
+    if (tbl->state != BLADERF_GAIN_CAL_LOADED || dev->gain_luts[ch].len == 0) {
+        log_debug("%s: Gain calibration not loaded\n", __FUNCTION__);
+        return BLADERF_ERR_UNEXPECTED;
+    }
+
+    for (i = 0; i < count; i++) {
+        max_freq = (frequencies[i] > max_freq) ? frequencies[i] : max_freq;
+    }
+
+    if (max_freq > tbl->stop_freq) {
+        log_debug("%s: %" PRIu64 " Hz is beyond the end of the table\n",
+                  __FUNCTION__, max_freq);
+        return BLADERF_ERR_RANGE;
+    }
+
+    gain_cal_lut_lookup(&dev->gain_luts[ch], frequencies, count, corrections);
+    return 0;
+}
+
+int get_gain_cal_frequency(struct bladerf *dev,
+                           bladerf_channel ch,
+                           bladerf_frequency *frequency)
+{
+    /* An unknown frequency is not remembered once queried, as a scheduled
+     * retune may still be pending and change it */
+    if (dev->gain_cal_freq[ch] == 0) {
+        return dev->board->get_frequency(dev, ch, frequency);
+    }
+
+    *frequency = dev->gain_cal_freq[ch];
+    return 0;
+}
+
+void set_gain_cal_frequency(struct bladerf *dev,
+                            bladerf_channel ch,
+                            bladerf_frequency frequency)
+{
+    bladerf_channel i;
+
+    for (i = 0; i < NUM_GAIN_CAL_TBLS; i++) {
+        if (BLADERF_CHANNEL_IS_TX(i) == BLADERF_CHANNEL_IS_TX(ch)) {
+            dev->gain_cal_freq[i] = frequency;
+        }
+    }
+}
+
 int get_gain_correction(struct bladerf *dev, bladerf_frequency freq, bladerf_channel ch, bladerf_gain *compensated_gain) {
     int status = 0;
     struct bladerf_gain_cal_tbl *cal_table = &dev->gain_tbls[ch];
-    struct bladerf_gain_cal_entry entry_next;
+    double corr;
 
-    CHECK_STATUS(get_gain_cal_entry(cal_table, freq, &entry_next));
+    CHECK_STATUS(lookup_gain_correction(dev, ch, freq, &corr));
 
-    *compensated_gain = __round_int(cal_table->gain_target - entry_next.gain_corr);
+    *compensated_gain = __round_int(cal_table->gain_target - corr);
 
     log_verbose("Target gain:  %i, Compen. gain: %i\n", dev->gain_tbls[ch].gain_target, *compensated_gain);
     return status;
@@ -497,7 +894,6 @@ int get_gain_correction(struct bladerf *dev, bladerf_frequency freq, bladerf_cha
 
 int apply_gain_correction(struct bladerf *dev, bladerf_channel ch, bladerf_frequency frequency) {
     struct bladerf_range const *gain_range = NULL;
-    bladerf_frequency current_frequency;
     bladerf_gain gain_compensated;
 
     if (dev->gain_tbls[ch].enabled == false) {
@@ -506,7 +902,6 @@ int apply_gain_correction(struct bladerf *dev, bladerf_channel ch, bladerf_frequ
     }
 
     CHECK_STATUS(dev->board->get_gain_range(dev, ch, &gain_range));
-    CHECK_STATUS(dev->board->get_frequency(dev, ch, &current_frequency));
     CHECK_STATUS(get_gain_correction(dev, frequency, ch, &gain_compensated));
 
     if (gain_compensated > gain_range->max || gain_compensated < gain_range->min) {
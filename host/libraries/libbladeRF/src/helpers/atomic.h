@@ -0,0 +1,73 @@
+/**
+ * @file atomic.h
+ *
+ * @brief Minimal atomic access helpers
+ *
+ * These wrap the compiler's atomic builtins for the small number of lock-free
+ * hand-offs performed in the streaming code. On MSVC, only naturally aligned
+ * 32-bit objects (e.g., int, unsigned int, enums) are supported.
+ *
+ * This file is part of the bladeRF project:
+ *   http://www.github.com/nuand/bladeRF
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+#ifndef HELPERS_ATOMIC_H_
+#define HELPERS_ATOMIC_H_
+
+#if defined(__GNUC__) || defined(__clang__)
+
+#   define ATOMIC_LOAD_ACQUIRE(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#   define ATOMIC_LOAD_SEQ_CST(p) __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#   define ATOMIC_STORE_RELEASE(p, v) \
+        __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#   define ATOMIC_FETCH_ADD(p, v) __atomic_fetch_add((p), (v), __ATOMIC_SEQ_CST)
+#   define ATOMIC_FETCH_SUB(p, v) __atomic_fetch_sub((p), (v), __ATOMIC_SEQ_CST)
+
+#   if defined(__x86_64__) || defined(__i386__)
+#       define CPU_RELAX() __builtin_ia32_pause()
+#   elif defined(__aarch64__) || defined(__arm__)
+#       define CPU_RELAX() __asm__ __volatile__("yield" ::: "memory")
+#   else
+#       define CPU_RELAX() __asm__ __volatile__("" ::: "memory")
+#   endif
+
+#elif defined(_MSC_VER)
+
+#   include <intrin.h>
+
+#   define ATOMIC_LOAD_ACQUIRE(p) \
+        _InterlockedOr((volatile long *)(p), 0)
+#   define ATOMIC_LOAD_SEQ_CST(p) \
+        _InterlockedOr((volatile long *)(p), 0)
+#   define ATOMIC_STORE_RELEASE(p, v) \
+        ((void)_InterlockedExchange((volatile long *)(p), (long)(v)))
+#   define ATOMIC_FETCH_ADD(p, v) \
+        _InterlockedExchangeAdd((volatile long *)(p), (long)(v))
+#   define ATOMIC_FETCH_SUB(p, v) \
+        _InterlockedExchangeAdd((volatile long *)(p), -(long)(v))
+#   if defined(_M_ARM64) || defined(_M_ARM)
+#       define CPU_RELAX() __yield()
+#   else
+#       define CPU_RELAX() _mm_pause()
+#   endif
+
+#else
+#   error "Atomic operations are not implemented for this compiler"
+#endif
+
+#endif
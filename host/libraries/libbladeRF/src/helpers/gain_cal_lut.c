@@ -0,0 +1,208 @@
+/*
+ * This file is part of the bladeRF project:
+ *   http://www.github.com/nuand/bladeRF
+ *
+ * Copyright (C) 2023 Nuand LLC
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libbladeRF.h"
+#include "host_config.h"
+#include "log.h"
+
+#include "helpers/gain_cal_lut.h"
+
+/* Bounds the size of a compiled lookup, keeping it cache-resident */
+#define GAIN_CAL_LUT_MAX_LEN 8192u
+
+/* The SSE2 lookup kernel is used wherever SSE2 is part of the baseline */
+#if defined(__SSE2__) || (defined(_MSC_VER) && defined(_M_X64))
+#   include <emmintrin.h>
+#   define GAIN_CAL_HAVE_SSE2 1
+#endif
+
+static bladerf_frequency gcd_freq(bladerf_frequency a, bladerf_frequency b)
+{
+    while (b != 0) {
+        bladerf_frequency t = a % b;
+        a = b;
+        b = t;
+    }
+
+    return a;
+}
+
+int gain_cal_lut_compile(const struct bladerf_gain_cal_tbl *tbl,
+                         struct gain_cal_lut *lut)
+{
+    const struct bladerf_gain_cal_entry *e = tbl->entries;
+    bladerf_frequency span, step = 0;
+    double step_hz;
+    uint64_t len;
+    uint32_t i, j;
+
+    if (tbl->n_entries == 0 || e == NULL) {
+        log_error("Gain calibration table is empty\n");
+        return BLADERF_ERR_INVAL;
+    }
+
+    /* A grid spacing that divides every entry's offset from the start places
+     * a point on each entry */
+    for (i = 1; i < tbl->n_entries; i++) {
+        if (e[i].freq < e[i - 1].freq) {
+            log_error("Gain calibration entries are not sorted by frequency\n");
+            return BLADERF_ERR_INVAL;
+        }
+
+        step = gcd_freq(e[i].freq - e[0].freq, step);
+    }
+
+    span = e[tbl->n_entries - 1].freq - e[0].freq;
+    if (step == 0) {
+        step = 1;
+    }
+
+    len     = span / step + 1;
+    step_hz = (double)step;
+
+    /* Otherwise, the largest grid is spread evenly across the table, so that
+     * its last point remains on the last entry */
+    if (len > GAIN_CAL_LUT_MAX_LEN) {
+        len     = GAIN_CAL_LUT_MAX_LEN;
+        step_hz = (double)span / (double)(len - 1);
+        log_debug("Gain calibration lookup resampled to %f Hz steps\n",
+                  step_hz);
+    }
+
+    lut->corr = malloc((len + 1) * sizeof(lut->corr[0]));
+    if (lut->corr == NULL) {
+        return BLADERF_ERR_MEM;
+    }
+
+    lut->start    = (double)e[0].freq;
+    lut->inv_step = 1.0 / step_hz;
+    lut->max_pos  = (double)(len - 1);
+    lut->len      = (uint32_t)len;
+
+    /* Both the grid and the entries are in ascending order, so the entries
+     * bracketing each point are found in a single pass */
+    for (i = 0, j = 0; i < len; i++) {
+        const double f = (i + 1 == len) ? (double)e[tbl->n_entries - 1].freq
+                                        : (double)e[0].freq + i * step_hz;
+
+        while (j + 1 < tbl->n_entries && (double)e[j + 1].freq <= f) {
+            j++;
+        }
+
+        if (j + 1 == tbl->n_entries || (double)e[j].freq == f) {
+            lut->corr[i] = e[j].gain_corr;
+        } else {
+            lut->corr[i] = e[j].gain_corr +
+                           (f - (double)e[j].freq) *
+                               (e[j + 1].gain_corr - e[j].gain_corr) /
+                               (double)(e[j + 1].freq - e[j].freq);
+        }
+    }
+
+    lut->corr[len] = lut->corr[len - 1];
+
+    return 0;
+}
+
+void gain_cal_lut_free(struct gain_cal_lut *lut)
+{
+    free(lut->corr);
+    memset(lut, 0, sizeof(*lut));
+}
+
+static inline double lut_lookup_one(const struct gain_cal_lut *lut,
+                                    bladerf_frequency freq)
+{
+    double x = ((double)freq - lut->start) * lut->inv_step;
+    double frac;
+    uint32_t i;
+
+    x = (x < 0.0) ? 0.0 : x;
+    x = (x > lut->max_pos) ? lut->max_pos : x;
+
+    i    = (uint32_t)x;
+    frac = x - (double)i;
+
+    return lut->corr[i] + frac * (lut->corr[i + 1] - lut->corr[i]);
+}
+
+#ifdef GAIN_CAL_HAVE_SSE2
+/* Looks up two frequencies at a time. Frequencies below 2^52 are converted to
+ * double by placing them in the mantissa of 2^52 and subtracting it, as SSE2
+ * has no unsigned 64-bit conversion. */
+static unsigned int lut_lookup_sse2(const struct gain_cal_lut *lut,
+                                    const bladerf_frequency *freq,
+                                    unsigned int n,
+                                    double *corr)
+{
+    const __m128i exp   = _mm_set1_epi64x(0x4330000000000000LL);
+    const __m128d bias  = _mm_set1_pd(4503599627370496.0);
+    const __m128d start = _mm_set1_pd(lut->start);
+    const __m128d scale = _mm_set1_pd(lut->inv_step);
+    const __m128d lo    = _mm_setzero_pd();
+    const __m128d hi    = _mm_set1_pd(lut->max_pos);
+    unsigned int i;
+
+    for (i = 0; i + 2 <= n; i += 2) {
+        __m128i f  = _mm_loadu_si128((const __m128i *)(freq + i));
+        __m128d fd = _mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(f, exp)), bias);
+        __m128d x  = _mm_mul_pd(_mm_sub_pd(fd, start), scale);
+        __m128i idx;
+        __m128d frac, p0, p1, c0, c1;
+
+        x    = _mm_min_pd(_mm_max_pd(x, lo), hi);
+        idx  = _mm_cvttpd_epi32(x);
+        frac = _mm_sub_pd(x, _mm_cvtepi32_pd(idx));
+
+        /* Each load yields a point and its successor */
+        p0 = _mm_loadu_pd(lut->corr + _mm_cvtsi128_si32(idx));
+        p1 = _mm_loadu_pd(lut->corr +
+                          _mm_cvtsi128_si32(_mm_shuffle_epi32(idx, 1)));
+        c0 = _mm_unpacklo_pd(p0, p1);
+        c1 = _mm_unpackhi_pd(p0, p1);
+
+        _mm_storeu_pd(corr + i,
+                      _mm_add_pd(c0, _mm_mul_pd(frac, _mm_sub_pd(c1, c0))));
+    }
+
+    return i;
+}
+#endif
+
+void gain_cal_lut_lookup(const struct gain_cal_lut *lut,
+                         const bladerf_frequency *frequencies,
+                         unsigned int count,
+                         double *corrections)
+{
+    unsigned int i = 0;
+
+#ifdef GAIN_CAL_HAVE_SSE2
+    i = lut_lookup_sse2(lut, frequencies, count, corrections);
+#endif
+
+    for (; i < count; i++) {
+        corrections[i] = lut_lookup_one(lut, frequencies[i]);
+    }
+}
@@ -0,0 +1,85 @@
+/**
+ * @file gain_cal_lut.h
+ *
+ * This file is not part of the API and may be changed at any time.
+ * If you're interfacing with libbladeRF, DO NOT use this file.
+ *
+ * This file is part of the bladeRF project:
+ *   http://www.github.com/nuand/bladeRF
+ *
+ * Copyright (C) 2023 Nuand LLC
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef HELPERS_GAIN_CAL_LUT_H_
+#define HELPERS_GAIN_CAL_LUT_H_
+
+#include <stdint.h>
+
+#include "libbladeRF.h"
+
+/**
+ * Gain corrections resampled onto a uniform frequency grid. A lookup is a
+ * single interpolation between two adjacent points, rather than a search of
+ * the calibration table.
+ *
+ * Where the spacing of the table's entries permits, the grid includes every
+ * entry's frequency, so lookups match interpolating within the table itself.
+ * Otherwise, the grid's points are spread evenly from the first entry to the
+ * last.
+ */
+struct gain_cal_lut {
+    double start;    /**< Frequency of the first point (Hz) */
+    double inv_step; /**< Reciprocal of the grid spacing (1/Hz) */
+    double max_pos;  /**< Position of the last point, i.e. len - 1 */
+    uint32_t len;    /**< Number of points */
+    double *corr;    /**< len + 1 gain corrections. The last is repeated, so
+                          that interpolation never reads past the end. */
+};
+
+/**
+ * Builds the uniform-grid lookup for a loaded calibration table.
+ *
+ * @param[in]  tbl  Calibration table, with entries sorted by frequency
+ * @param[out] lut  Lookup to populate. Free with gain_cal_lut_free().
+ *
+ * @return 0 on success, BLADERF_ERR_INVAL if the table is empty or not sorted,
+ *         or BLADERF_ERR_MEM on allocation failure.
+ */
+int gain_cal_lut_compile(const struct bladerf_gain_cal_tbl *tbl,
+                         struct gain_cal_lut *lut);
+
+/**
+ * Frees the points of a lookup and resets it. Safe to call on a lookup that
+ * was never compiled, provided it was zero-initialized.
+ */
+void gain_cal_lut_free(struct gain_cal_lut *lut);
+
+/**
+ * Interpolates gain corrections for a list of frequencies. Frequencies outside
+ * of the lookup's range are clamped to its first or last point.
+ *
+ * @param[in]  lut          Compiled lookup
+ * @param[in]  frequencies  Frequencies to look up, below 2^52 Hz
+ * @param[in]  count        Number of frequencies
+ * @param[out] corrections  Gain corrections, one per frequency
+ */
+void gain_cal_lut_lookup(const struct gain_cal_lut *lut,
+                         const bladerf_frequency *frequencies,
+                         unsigned int count,
+                         double *corrections);
+
+#endif
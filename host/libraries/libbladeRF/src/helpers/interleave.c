@@ -19,12 +19,461 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <libbladeRF.h>
 
+#include "host_config.h"
+
+#include "log.h"
+#include "thread.h"
+
 #include "helpers/interleave.h"
 
+/* Vector kernels are built when the compiler can target them. On x86 the AVX2
+ * kernels are compiled via function target attributes and only selected when
+ * the host CPU reports support at runtime. SSE2 is part of the x86-64
+ * baseline, and NEON is assumed to be available whenever the compiler has been
+ * told it may use it. */
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#   include <immintrin.h>
+#   define INTERLEAVE_HAVE_SSE2 1
+#   define INTERLEAVE_HAVE_AVX2 1
+#   define INTERLEAVE_TARGET(t) __attribute__((target(t)))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#   include <emmintrin.h>
+#   define INTERLEAVE_HAVE_SSE2 1
+#   define INTERLEAVE_TARGET(t)
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#   include <arm_neon.h>
+#   define INTERLEAVE_HAVE_NEON 1
+#endif
+
+/* Two-channel kernels. "zip" produces an interleaved buffer from two
+ * per-channel blocks of n samples; "unzip" is its inverse. Samples are
+ * treated as opaque 16-bit (SC8) or 32-bit (SC16) words. */
+typedef void (*zip_fn)(void *dst, const void *a, const void *b, size_t n);
+typedef void (*unzip_fn)(void *a, void *b, const void *src, size_t n);
+
+struct interleave_kernels {
+    const char *name;
+    zip_fn zip16;
+    zip_fn zip32;
+    unzip_fn unzip16;
+    unzip_fn unzip32;
+};
+
+static void zip16_scalar(void *dst, const void *a, const void *b, size_t n)
+{
+    uint16_t *d       = dst;
+    const uint16_t *x = a;
+    const uint16_t *y = b;
+    size_t i;
+
+    for (i = 0; i < n; ++i) {
+        d[2 * i]     = x[i];
+        d[2 * i + 1] = y[i];
+    }
+}
+
+static void zip32_scalar(void *dst, const void *a, const void *b, size_t n)
+{
+    uint32_t *d       = dst;
+    const uint32_t *x = a;
+    const uint32_t *y = b;
+    size_t i;
+
+    for (i = 0; i < n; ++i) {
+        d[2 * i]     = x[i];
+        d[2 * i + 1] = y[i];
+    }
+}
+
+static void unzip16_scalar(void *a, void *b, const void *src, size_t n)
+{
+    uint16_t *x       = a;
+    uint16_t *y       = b;
+    const uint16_t *s = src;
+    size_t i;
+
+    for (i = 0; i < n; ++i) {
+        x[i] = s[2 * i];
+        y[i] = s[2 * i + 1];
+    }
+}
+
+static void unzip32_scalar(void *a, void *b, const void *src, size_t n)
+{
+    uint32_t *x       = a;
+    uint32_t *y       = b;
+    const uint32_t *s = src;
+    size_t i;
+
+    for (i = 0; i < n; ++i) {
+        x[i] = s[2 * i];
+        y[i] = s[2 * i + 1];
+    }
+}
+
+static const struct interleave_kernels kernels_scalar = {
+    "scalar", zip16_scalar, zip32_scalar, unzip16_scalar, unzip32_scalar,
+};
+
+#ifdef INTERLEAVE_HAVE_SSE2
+INTERLEAVE_TARGET("sse2")
+static void zip16_sse2(void *dst, const void *a, const void *b, size_t n)
+{
+    uint16_t *d       = dst;
+    const uint16_t *x = a;
+    const uint16_t *y = b;
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m128i va = _mm_loadu_si128((const __m128i *)(x + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(y + i));
+        _mm_storeu_si128((__m128i *)(d + 2 * i), _mm_unpacklo_epi16(va, vb));
+        _mm_storeu_si128((__m128i *)(d + 2 * i + 8),
+                         _mm_unpackhi_epi16(va, vb));
+    }
+
+    zip16_scalar(d + 2 * i, x + i, y + i, n - i);
+}
+
+INTERLEAVE_TARGET("sse2")
+static void zip32_sse2(void *dst, const void *a, const void *b, size_t n)
+{
+    uint32_t *d       = dst;
+    const uint32_t *x = a;
+    const uint32_t *y = b;
+    size_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128i va = _mm_loadu_si128((const __m128i *)(x + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(y + i));
+        _mm_storeu_si128((__m128i *)(d + 2 * i), _mm_unpacklo_epi32(va, vb));
+        _mm_storeu_si128((__m128i *)(d + 2 * i + 4),
+                         _mm_unpackhi_epi32(va, vb));
+    }
+
+    zip32_scalar(d + 2 * i, x + i, y + i, n - i);
+}
+
+INTERLEAVE_TARGET("sse2")
+static void unzip16_sse2(void *a, void *b, const void *src, size_t n)
+{
+    uint16_t *x       = a;
+    uint16_t *y       = b;
+    const uint16_t *s = src;
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m128i s0 = _mm_loadu_si128((const __m128i *)(s + 2 * i));
+        __m128i s1 = _mm_loadu_si128((const __m128i *)(s + 2 * i + 8));
+
+        /* Gather each half into [a a a a b b b b] order */
+        s0 = _mm_shufflelo_epi16(s0, _MM_SHUFFLE(3, 1, 2, 0));
+        s0 = _mm_shufflehi_epi16(s0, _MM_SHUFFLE(3, 1, 2, 0));
+        s0 = _mm_shuffle_epi32(s0, _MM_SHUFFLE(3, 1, 2, 0));
+        s1 = _mm_shufflelo_epi16(s1, _MM_SHUFFLE(3, 1, 2, 0));
+        s1 = _mm_shufflehi_epi16(s1, _MM_SHUFFLE(3, 1, 2, 0));
+        s1 = _mm_shuffle_epi32(s1, _MM_SHUFFLE(3, 1, 2, 0));
+
+        _mm_storeu_si128((__m128i *)(x + i), _mm_unpacklo_epi64(s0, s1));
+        _mm_storeu_si128((__m128i *)(y + i), _mm_unpackhi_epi64(s0, s1));
+    }
+
+    unzip16_scalar(x + i, y + i, s + 2 * i, n - i);
+}
+
+INTERLEAVE_TARGET("sse2")
+static void unzip32_sse2(void *a, void *b, const void *src, size_t n)
+{
+    uint32_t *x       = a;
+    uint32_t *y       = b;
+    const uint32_t *s = src;
+    size_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128i s0 = _mm_loadu_si128((const __m128i *)(s + 2 * i));
+        __m128i s1 = _mm_loadu_si128((const __m128i *)(s + 2 * i + 4));
+
+        s0 = _mm_shuffle_epi32(s0, _MM_SHUFFLE(3, 1, 2, 0));
+        s1 = _mm_shuffle_epi32(s1, _MM_SHUFFLE(3, 1, 2, 0));
+
+        _mm_storeu_si128((__m128i *)(x + i), _mm_unpacklo_epi64(s0, s1));
+        _mm_storeu_si128((__m128i *)(y + i), _mm_unpackhi_epi64(s0, s1));
+    }
+
+    unzip32_scalar(x + i, y + i, s + 2 * i, n - i);
+}
+
+static const struct interleave_kernels kernels_sse2 = {
+    "SSE2", zip16_sse2, zip32_sse2, unzip16_sse2, unzip32_sse2,
+};
+#endif
+
+#ifdef INTERLEAVE_HAVE_AVX2
+INTERLEAVE_TARGET("avx2")
+static void zip16_avx2(void *dst, const void *a, const void *b, size_t n)
+{
+    uint16_t *d       = dst;
+    const uint16_t *x = a;
+    const uint16_t *y = b;
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(x + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(y + i));
+        __m256i lo = _mm256_unpacklo_epi16(va, vb);
+        __m256i hi = _mm256_unpackhi_epi16(va, vb);
+
+        /* Unpacks operate per 128-bit lane; stitch the lanes back together */
+        _mm256_storeu_si256((__m256i *)(d + 2 * i),
+                            _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256((__m256i *)(d + 2 * i + 16),
+                            _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+
+    zip16_scalar(d + 2 * i, x + i, y + i, n - i);
+}
+
+INTERLEAVE_TARGET("avx2")
+static void zip32_avx2(void *dst, const void *a, const void *b, size_t n)
+{
+    uint32_t *d       = dst;
+    const uint32_t *x = a;
+    const uint32_t *y = b;
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(x + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(y + i));
+        __m256i lo = _mm256_unpacklo_epi32(va, vb);
+        __m256i hi = _mm256_unpackhi_epi32(va, vb);
+
+        _mm256_storeu_si256((__m256i *)(d + 2 * i),
+                            _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256((__m256i *)(d + 2 * i + 8),
+                            _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+
+    zip32_scalar(d + 2 * i, x + i, y + i, n - i);
+}
+
+INTERLEAVE_TARGET("avx2")
+static void unzip16_avx2(void *a, void *b, const void *src, size_t n)
+{
+    uint16_t *x       = a;
+    uint16_t *y       = b;
+    const uint16_t *s = src;
+    const __m256i mask =
+        _mm256_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15,
+                         0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15);
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        __m256i s0 = _mm256_loadu_si256((const __m256i *)(s + 2 * i));
+        __m256i s1 = _mm256_loadu_si256((const __m256i *)(s + 2 * i + 16));
+
+        /* Per lane: [a a a a b b b b], then gather the a and b quadwords */
+        s0 = _mm256_shuffle_epi8(s0, mask);
+        s1 = _mm256_shuffle_epi8(s1, mask);
+        s0 = _mm256_permute4x64_epi64(s0, _MM_SHUFFLE(3, 1, 2, 0));
+        s1 = _mm256_permute4x64_epi64(s1, _MM_SHUFFLE(3, 1, 2, 0));
+
+        _mm256_storeu_si256((__m256i *)(x + i),
+                            _mm256_permute2x128_si256(s0, s1, 0x20));
+        _mm256_storeu_si256((__m256i *)(y + i),
+                            _mm256_permute2x128_si256(s0, s1, 0x31));
+    }
+
+    unzip16_scalar(x + i, y + i, s + 2 * i, n - i);
+}
+
+INTERLEAVE_TARGET("avx2")
+static void unzip32_avx2(void *a, void *b, const void *src, size_t n)
+{
+    uint32_t *x       = a;
+    uint32_t *y       = b;
+    const uint32_t *s = src;
+    const __m256i idx = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256i s0 = _mm256_loadu_si256((const __m256i *)(s + 2 * i));
+        __m256i s1 = _mm256_loadu_si256((const __m256i *)(s + 2 * i + 8));
+
+        s0 = _mm256_permutevar8x32_epi32(s0, idx);
+        s1 = _mm256_permutevar8x32_epi32(s1, idx);
+
+        _mm256_storeu_si256((__m256i *)(x + i),
+                            _mm256_permute2x128_si256(s0, s1, 0x20));
+        _mm256_storeu_si256((__m256i *)(y + i),
+                            _mm256_permute2x128_si256(s0, s1, 0x31));
+    }
+
+    unzip32_scalar(x + i, y + i, s + 2 * i, n - i);
+}
+
+static const struct interleave_kernels kernels_avx2 = {
+    "AVX2", zip16_avx2, zip32_avx2, unzip16_avx2, unzip32_avx2,
+};
+#endif
+
+#ifdef INTERLEAVE_HAVE_NEON
+static void zip16_neon(void *dst, const void *a, const void *b, size_t n)
+{
+    uint16_t *d       = dst;
+    const uint16_t *x = a;
+    const uint16_t *y = b;
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        uint16x8x2_t v;
+        v.val[0] = vld1q_u16(x + i);
+        v.val[1] = vld1q_u16(y + i);
+        vst2q_u16(d + 2 * i, v);
+    }
+
+    zip16_scalar(d + 2 * i, x + i, y + i, n - i);
+}
+
+static void zip32_neon(void *dst, const void *a, const void *b, size_t n)
+{
+    uint32_t *d       = dst;
+    const uint32_t *x = a;
+    const uint32_t *y = b;
+    size_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        uint32x4x2_t v;
+        v.val[0] = vld1q_u32(x + i);
+        v.val[1] = vld1q_u32(y + i);
+        vst2q_u32(d + 2 * i, v);
+    }
+
+    zip32_scalar(d + 2 * i, x + i, y + i, n - i);
+}
+
+static void unzip16_neon(void *a, void *b, const void *src, size_t n)
+{
+    uint16_t *x       = a;
+    uint16_t *y       = b;
+    const uint16_t *s = src;
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        uint16x8x2_t v = vld2q_u16(s + 2 * i);
+        vst1q_u16(x + i, v.val[0]);
+        vst1q_u16(y + i, v.val[1]);
+    }
+
+    unzip16_scalar(x + i, y + i, s + 2 * i, n - i);
+}
+
+static void unzip32_neon(void *a, void *b, const void *src, size_t n)
+{
+    uint32_t *x       = a;
+    uint32_t *y       = b;
+    const uint32_t *s = src;
+    size_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        uint32x4x2_t v = vld2q_u32(s + 2 * i);
+        vst1q_u32(x + i, v.val[0]);
+        vst1q_u32(y + i, v.val[1]);
+    }
+
+    unzip32_scalar(x + i, y + i, s + 2 * i, n - i);
+}
+
+static const struct interleave_kernels kernels_neon = {
+    "NEON", zip16_neon, zip32_neon, unzip16_neon, unzip32_neon,
+};
+#endif
+
+/* Every kernel set built for this host, scalar first */
+static const struct interleave_kernels *const all_kernels[] = {
+    &kernels_scalar,
+#ifdef INTERLEAVE_HAVE_SSE2
+    &kernels_sse2,
+#endif
+#ifdef INTERLEAVE_HAVE_AVX2
+    &kernels_avx2,
+#endif
+#ifdef INTERLEAVE_HAVE_NEON
+    &kernels_neon,
+#endif
+};
+
+static const struct interleave_kernels *kernels = &kernels_scalar;
+static pthread_once_t kernels_once = PTHREAD_ONCE_INIT;
+
+static bool kernels_supported(const struct interleave_kernels *k)
+{
+#if defined(INTERLEAVE_HAVE_AVX2)
+    __builtin_cpu_init();
+    if (k == &kernels_avx2) {
+        return __builtin_cpu_supports("avx2");
+    } else if (k == &kernels_sse2) {
+        return __builtin_cpu_supports("sse2");
+    }
+#endif
+
+    return true;
+}
+
+static void select_kernels(void)
+{
+    size_t i;
+
+    /* Prefer the last, widest, kernels that the CPU supports */
+    for (i = ARRAY_SIZE(all_kernels); i-- > 0;) {
+        if (kernels_supported(all_kernels[i])) {
+            kernels = all_kernels[i];
+            break;
+        }
+    }
+
+    log_verbose("Using %s sample interleaving kernels\n", kernels->name);
+}
+
+static const struct interleave_kernels *get_kernels(void)
+{
+    pthread_once(&kernels_once, select_kernels);
+    return kernels;
+}
+
+const char *_interleave_kernel_name(void)
+{
+    return get_kernels()->name;
+}
+
+unsigned int _interleave_num_kernels(void)
+{
+    return ARRAY_SIZE(all_kernels);
+}
+
+int _interleave_select_kernel(unsigned int idx)
+{
+    if (idx >= ARRAY_SIZE(all_kernels)) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    if (!kernels_supported(all_kernels[idx])) {
+        return BLADERF_ERR_UNSUPPORTED;
+    }
+
+    /* Ensure the automatic selection has run, so it can't undo this one */
+    get_kernels();
+    kernels = all_kernels[idx];
+
+    return 0;
+}
+
 size_t _interleave_calc_num_channels(bladerf_channel_layout layout)
 {
     switch (layout) {
@@ -70,60 +519,233 @@ size_t _interleave_calc_metadata_bytes(bladerf_format format)
     return 0;
 }
 
+/* Samples per channel in a buffer, excluding any leading metadata */
+static size_t calc_samps_per_ch(size_t num_channels,
+                                size_t samp_size,
+                                size_t meta_size,
+                                unsigned int buffer_size)
+{
+    return (buffer_size / num_channels) - (meta_size / samp_size / num_channels);
+}
+
+int _interleave_interleave_from_channels(bladerf_channel_layout layout,
+                                         bladerf_format format,
+                                         unsigned int buffer_size,
+                                         const void *const *channels,
+                                         void *samples)
+{
+    const struct interleave_kernels *k = get_kernels();
+    size_t num_channels = _interleave_calc_num_channels(layout);
+    size_t samp_size    = _interleave_calc_bytes_per_sample(format);
+    size_t meta_size    = _interleave_calc_metadata_bytes(format);
+    size_t samps_per_ch, samp, ch;
+    uint8_t *dstptr;
+
+    if (0 == num_channels || 0 == samp_size) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    samps_per_ch = calc_samps_per_ch(num_channels, samp_size, meta_size,
+                                     buffer_size);
+    dstptr       = (uint8_t *)samples + meta_size;
+
+    switch (num_channels) {
+        case 1:
+            memcpy(dstptr, channels[0], samps_per_ch * samp_size);
+            break;
+
+        case 2:
+            if (4 == samp_size) {
+                k->zip32(dstptr, channels[0], channels[1], samps_per_ch);
+            } else {
+                k->zip16(dstptr, channels[0], channels[1], samps_per_ch);
+            }
+            break;
+
+        default:
+            for (samp = 0; samp < samps_per_ch; ++samp) {
+                for (ch = 0; ch < num_channels; ++ch) {
+                    memcpy(dstptr, (const uint8_t *)channels[ch] +
+                                       (samp * samp_size),
+                           samp_size);
+                    dstptr += samp_size;
+                }
+            }
+            break;
+    }
+
+    return 0;
+}
+
+int _interleave_deinterleave_to_channels(bladerf_channel_layout layout,
+                                         bladerf_format format,
+                                         unsigned int buffer_size,
+                                         const void *samples,
+                                         void *const *channels)
+{
+    const struct interleave_kernels *k = get_kernels();
+    size_t num_channels = _interleave_calc_num_channels(layout);
+    size_t samp_size    = _interleave_calc_bytes_per_sample(format);
+    size_t meta_size    = _interleave_calc_metadata_bytes(format);
+    size_t samps_per_ch, samp, ch;
+    const uint8_t *srcptr;
+
+    if (0 == num_channels || 0 == samp_size) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    samps_per_ch = calc_samps_per_ch(num_channels, samp_size, meta_size,
+                                     buffer_size);
+    srcptr       = (const uint8_t *)samples + meta_size;
+
+    switch (num_channels) {
+        case 1:
+            memcpy(channels[0], srcptr, samps_per_ch * samp_size);
+            break;
+
+        case 2:
+            if (4 == samp_size) {
+                k->unzip32(channels[0], channels[1], srcptr, samps_per_ch);
+            } else {
+                k->unzip16(channels[0], channels[1], srcptr, samps_per_ch);
+            }
+            break;
+
+        default:
+            for (samp = 0; samp < samps_per_ch; ++samp) {
+                for (ch = 0; ch < num_channels; ++ch) {
+                    memcpy((uint8_t *)channels[ch] + (samp * samp_size),
+                           srcptr, samp_size);
+                    srcptr += samp_size;
+                }
+            }
+            break;
+    }
+
+    return 0;
+}
+
+/* Point channels[] at the per-channel blocks of a deinterleaved buffer */
+static void calc_channel_ptrs(size_t num_channels,
+                              size_t samp_size,
+                              size_t meta_size,
+                              size_t samps_per_ch,
+                              void *base,
+                              void **channels)
+{
+    size_t ch;
+
+    for (ch = 0; ch < num_channels; ++ch) {
+        channels[ch] =
+            (uint8_t *)base + meta_size + (ch * samps_per_ch * samp_size);
+    }
+}
+
+int _interleave_interleave_buf_scratch(bladerf_channel_layout layout,
+                                       bladerf_format format,
+                                       unsigned int buffer_size,
+                                       void *samples,
+                                       void *scratch)
+{
+    void *channels[INTERLEAVE_MAX_CHANNELS];
+    size_t num_channels = _interleave_calc_num_channels(layout);
+    size_t samp_size    = _interleave_calc_bytes_per_sample(format);
+    size_t meta_size    = _interleave_calc_metadata_bytes(format);
+    size_t samps_per_ch;
+    int status;
+
+    // Easy:
+    if (num_channels < 2) {
+        return 0;
+    }
+
+    if (num_channels > INTERLEAVE_MAX_CHANNELS || 0 == samp_size) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    samps_per_ch = calc_samps_per_ch(num_channels, samp_size, meta_size,
+                                     buffer_size);
+    calc_channel_ptrs(num_channels, samp_size, meta_size, samps_per_ch,
+                      samples, channels);
+
+    status = _interleave_interleave_from_channels(
+        layout, format, buffer_size, (const void *const *)channels, scratch);
+    if (status != 0) {
+        return status;
+    }
+
+    // Copy back, leaving the metadata in place
+    memcpy((uint8_t *)samples + meta_size, (uint8_t *)scratch + meta_size,
+           num_channels * samps_per_ch * samp_size);
+
+    return 0;
+}
+
+int _interleave_deinterleave_buf_scratch(bladerf_channel_layout layout,
+                                         bladerf_format format,
+                                         unsigned int buffer_size,
+                                         void *samples,
+                                         void *scratch)
+{
+    void *channels[INTERLEAVE_MAX_CHANNELS];
+    size_t num_channels = _interleave_calc_num_channels(layout);
+    size_t samp_size    = _interleave_calc_bytes_per_sample(format);
+    size_t meta_size    = _interleave_calc_metadata_bytes(format);
+    size_t samps_per_ch;
+    int status;
+
+    // Easy:
+    if (num_channels < 2) {
+        return 0;
+    }
+
+    if (num_channels > INTERLEAVE_MAX_CHANNELS || 0 == samp_size) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    samps_per_ch = calc_samps_per_ch(num_channels, samp_size, meta_size,
+                                     buffer_size);
+    calc_channel_ptrs(num_channels, samp_size, meta_size, samps_per_ch,
+                      scratch, channels);
+
+    status = _interleave_deinterleave_to_channels(layout, format, buffer_size,
+                                                  samples, channels);
+    if (status != 0) {
+        return status;
+    }
+
+    // Copy back, leaving the metadata in place
+    memcpy((uint8_t *)samples + meta_size, (uint8_t *)scratch + meta_size,
+           num_channels * samps_per_ch * samp_size);
+
+    return 0;
+}
+
 int _interleave_interleave_buf(bladerf_channel_layout layout,
                                bladerf_format format,
                                unsigned int buffer_size,
                                void *samples)
 {
-    void *buf;
-    uint8_t *srcptr, *dstptr;
     size_t num_channels = _interleave_calc_num_channels(layout);
-    size_t samp_size, meta_size, samps_per_ch;
-    size_t srcidx, dstidx, samp, ch;
+    void *buf;
+    int status;
 
     // Easy:
     if (num_channels < 2) {
         return 0;
     }
 
-    // Placeholder for an actually efficient algorithm
-    samp_size    = _interleave_calc_bytes_per_sample(format);
-    meta_size    = _interleave_calc_metadata_bytes(format);
-    samps_per_ch = buffer_size / num_channels;
-    buf          = malloc(samp_size * buffer_size);
-    srcptr       = samples;
-    dstptr       = buf;
-
+    buf = malloc(_interleave_calc_bytes_per_sample(format) * buffer_size);
     if (NULL == buf) {
         return BLADERF_ERR_MEM;
     }
 
-    // Copy metadata if applicable
-    if (meta_size > 0) {
-        memcpy(dstptr, srcptr, meta_size);
-        srcptr += meta_size;
-        dstptr += meta_size;
-        samps_per_ch -= (meta_size / samp_size / num_channels);
-    }
-
-    // Iterate...
-    for (ch = 0; ch < num_channels; ++ch) {
-        srcidx = samps_per_ch * ch;
-        for (samp = 0; samp < samps_per_ch; ++samp) {
-            dstidx = (samp * num_channels) + ch;
-            memcpy(dstptr + (dstidx * samp_size),
-                   srcptr + ((srcidx + samp) * samp_size),
-                   samp_size);
-        }
-    }
-
-    // Copy back...
-    memcpy(samples, buf, buffer_size * samp_size);
+    status = _interleave_interleave_buf_scratch(layout, format, buffer_size,
+                                                samples, buf);
 
-    // Done
     free(buf);
 
-    return 0;
+    return status;
 }
 
 int _interleave_deinterleave_buf(bladerf_channel_layout layout,
@@ -131,52 +753,24 @@ int _interleave_deinterleave_buf(bladerf_channel_layout layout,
                                  unsigned int buffer_size,
                                  void *samples)
 {
-    void *buf;
-    uint8_t *srcptr, *dstptr;
     size_t num_channels = _interleave_calc_num_channels(layout);
-    size_t samp_size, meta_size, samps_per_ch;
-    size_t srcidx, dstidx, samp, ch;
+    void *buf;
+    int status;
 
     // Easy:
     if (num_channels < 2) {
         return 0;
     }
 
-    // Placeholder for an actually efficient algorithm
-    samp_size    = _interleave_calc_bytes_per_sample(format);
-    meta_size    = _interleave_calc_metadata_bytes(format);
-    samps_per_ch = buffer_size / num_channels;
-    buf          = malloc(samp_size * buffer_size);
-    srcptr       = samples;
-    dstptr       = buf;
-
+    buf = malloc(_interleave_calc_bytes_per_sample(format) * buffer_size);
     if (NULL == buf) {
         return BLADERF_ERR_MEM;
     }
 
-    // Copy metadata if applicable
-    if (meta_size > 0) {
-        memcpy(dstptr, srcptr, meta_size);
-        srcptr += meta_size;
-        dstptr += meta_size;
-        samps_per_ch -= (meta_size / samp_size / num_channels);
-    }
+    status = _interleave_deinterleave_buf_scratch(layout, format, buffer_size,
+                                                  samples, buf);
 
-    // Iterate...
-    for (samp = 0; samp < samps_per_ch; ++samp) {
-        srcidx = num_channels * samp;
-        for (ch = 0; ch < num_channels; ++ch) {
-            dstidx = (samps_per_ch * ch) + samp;
-            memcpy(dstptr + (dstidx * samp_size),
-                   srcptr + ((srcidx + ch) * samp_size), samp_size);
-        }
-    }
-
-    // Copy back...
-    memcpy(samples, buf, buffer_size * samp_size);
-
-    // Done
     free(buf);
 
-    return 0;
+    return status;
 }
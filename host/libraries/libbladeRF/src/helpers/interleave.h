@@ -27,6 +27,9 @@
 #ifndef HELPERS_INTERLEAVE_H_
 #define HELPERS_INTERLEAVE_H_
 
+/** Largest number of channels a stream layout may carry */
+#define INTERLEAVE_MAX_CHANNELS 2
+
 size_t _interleave_calc_bytes_per_sample(bladerf_format format);
 size_t _interleave_calc_metadata_bytes(bladerf_format format);
 size_t _interleave_calc_num_channels(bladerf_channel_layout layout);
@@ -41,4 +44,64 @@ int _interleave_deinterleave_buf(bladerf_channel_layout layout,
                                  unsigned int buffer_size,
                                  void *samples);
 
+/**
+ * Variants of _interleave_interleave_buf() and _interleave_deinterleave_buf()
+ * that use a caller-supplied scratch buffer instead of allocating one.
+ *
+ * `scratch` must be at least as large as `samples` and must not overlap it.
+ */
+int _interleave_interleave_buf_scratch(bladerf_channel_layout layout,
+                                       bladerf_format format,
+                                       unsigned int buffer_size,
+                                       void *samples,
+                                       void *scratch);
+
+int _interleave_deinterleave_buf_scratch(bladerf_channel_layout layout,
+                                         bladerf_format format,
+                                         unsigned int buffer_size,
+                                         void *samples,
+                                         void *scratch);
+
+/**
+ * Interleave separate per-channel arrays into a stream buffer.
+ *
+ * Any metadata bytes at the start of `samples` are left untouched.
+ */
+int _interleave_interleave_from_channels(bladerf_channel_layout layout,
+                                         bladerf_format format,
+                                         unsigned int buffer_size,
+                                         const void *const *channels,
+                                         void *samples);
+
+/**
+ * Deinterleave a stream buffer into separate per-channel arrays.
+ *
+ * Any metadata bytes at the start of `samples` are skipped.
+ */
+int _interleave_deinterleave_to_channels(bladerf_channel_layout layout,
+                                         bladerf_format format,
+                                         unsigned int buffer_size,
+                                         const void *samples,
+                                         void *const *channels);
+
+/**
+ * @return Name of the instruction set used by the interleaving kernels
+ */
+const char *_interleave_kernel_name(void);
+
+/**
+ * @return Number of interleaving kernel sets built into the library. Index 0
+ *         is always the portable scalar implementation.
+ */
+unsigned int _interleave_num_kernels(void);
+
+/**
+ * Use kernel set `idx` in place of the one selected for this host. This is
+ * intended for testing each implementation against the others.
+ *
+ * @return 0 on success, BLADERF_ERR_INVAL if `idx` is out of range, or
+ *         BLADERF_ERR_UNSUPPORTED if this CPU can't run the kernels
+ */
+int _interleave_select_kernel(unsigned int idx);
+
 #endif
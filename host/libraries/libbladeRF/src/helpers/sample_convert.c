@@ -0,0 +1,955 @@
+/*
+ * This file is part of the bladeRF project:
+ *   http://www.github.com/nuand/bladeRF
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <libbladeRF.h>
+
+#include "log.h"
+#include "thread.h"
+
+#include "helpers/interleave.h"
+#include "helpers/sample_convert.h"
+
+/* Kernel availability follows helpers/interleave.c: AVX2 is compiled via
+ * function target attributes and selected at runtime, SSE2 is part of the
+ * x86-64 baseline, and NEON is used whenever the compiler may emit it. */
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#   include <immintrin.h>
+#   define CONVERT_HAVE_SSE2 1
+#   define CONVERT_HAVE_AVX2 1
+#   define CONVERT_TARGET(t) __attribute__((target(t)))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#   include <emmintrin.h>
+#   define CONVERT_HAVE_SSE2 1
+#   define CONVERT_TARGET(t)
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#   include <arm_neon.h>
+#   define CONVERT_HAVE_NEON 1
+#endif
+
+/* Number of complex samples handed to a kernel at a time. Vector kernels
+ * accumulate their DC sums in single precision, so this bounds the error
+ * before the partial sums are folded into a double. */
+#define CONVERT_CHUNK 4096
+
+/* Scalar element types that samples are stored as */
+enum elem {
+    ELEM_S8,
+    ELEM_S16,
+    ELEM_F32,
+    ELEM_F64,
+    ELEM_COUNT,
+};
+
+/* Description of a sample representation */
+struct sample_type {
+    enum elem elem;
+    size_t elem_size;
+    double full_scale; /* Value that represents 1.0 */
+    double min;        /* Saturation limits for integer types */
+    double max;
+};
+
+/* Each kernel computes, per component,
+ *
+ *      y = x * a - b[component]
+ *
+ * stores y (rounded and saturated to [min, max] for integer outputs) and adds
+ * the unrounded y values to sum[0] (I) and sum[1] (Q). This folds the format
+ * change, scaling and DC offset removal into a single pass. */
+struct convert_params {
+    double a;
+    double b[2];
+    double min;
+    double max;
+};
+
+typedef void (*convert_fn)(void *out,
+                           const void *in,
+                           size_t n,
+                           const struct convert_params *p,
+                           double sum[2]);
+
+struct convert_kernels {
+    const char *name;
+    convert_fn s16_f32;
+    convert_fn f32_s16;
+    convert_fn s8_f32;
+    convert_fn f32_s8;
+};
+
+static inline float round_satf(float y, float min, float max)
+{
+    y = (y < min) ? min : ((y > max) ? max : y);
+    return (y >= 0.0f) ? (y + 0.5f) : (y - 0.5f);
+}
+
+static inline double round_sat(double y, double min, double max)
+{
+    y = (y < min) ? min : ((y > max) ? max : y);
+    return (y >= 0.0) ? (y + 0.5) : (y - 0.5);
+}
+
+#define STORE_FLOAT(y, min, max) (y)
+#define STORE_INTF(y, min, max) round_satf((y), (min), (max))
+#define STORE_INT(y, min, max) round_sat((y), (min), (max))
+
+#define DEFINE_SCALAR_KERNEL(name_, in_t, out_t, real_t, STORE)              \
+    static void name_(void *out, const void *in, size_t n,                   \
+                      const struct convert_params *p, double sum[2])         \
+    {                                                                        \
+        const in_t *x = in;                                                  \
+        out_t *d      = out;                                                 \
+        const real_t a   = (real_t)p->a;                                     \
+        const real_t b0  = (real_t)p->b[0];                                  \
+        const real_t b1  = (real_t)p->b[1];                                  \
+        const real_t min = (real_t)p->min;                                   \
+        const real_t max = (real_t)p->max;                                   \
+        double s0 = 0.0, s1 = 0.0;                                           \
+        size_t i;                                                            \
+                                                                             \
+        (void)min;                                                           \
+        (void)max;                                                           \
+                                                                             \
+        for (i = 0; i < n; ++i) {                                            \
+            real_t y0 = (real_t)x[2 * i] * a - b0;                           \
+            real_t y1 = (real_t)x[2 * i + 1] * a - b1;                       \
+            s0 += y0;                                                        \
+            s1 += y1;                                                        \
+            d[2 * i]     = (out_t)STORE(y0, min, max);                       \
+            d[2 * i + 1] = (out_t)STORE(y1, min, max);                       \
+        }                                                                    \
+                                                                             \
+        sum[0] += s0;                                                        \
+        sum[1] += s1;                                                        \
+    }
+
+/* Device to host */
+DEFINE_SCALAR_KERNEL(s16_f32_scalar, int16_t, float, float, STORE_FLOAT)
+DEFINE_SCALAR_KERNEL(s16_f64_scalar, int16_t, double, double, STORE_FLOAT)
+DEFINE_SCALAR_KERNEL(s16_s16_scalar, int16_t, int16_t, float, STORE_INTF)
+DEFINE_SCALAR_KERNEL(s8_f32_scalar, int8_t, float, float, STORE_FLOAT)
+DEFINE_SCALAR_KERNEL(s8_f64_scalar, int8_t, double, double, STORE_FLOAT)
+DEFINE_SCALAR_KERNEL(s8_s16_scalar, int8_t, int16_t, float, STORE_INTF)
+
+/* Host to device */
+DEFINE_SCALAR_KERNEL(f32_s16_scalar, float, int16_t, float, STORE_INTF)
+DEFINE_SCALAR_KERNEL(f64_s16_scalar, double, int16_t, double, STORE_INT)
+DEFINE_SCALAR_KERNEL(f32_s8_scalar, float, int8_t, float, STORE_INTF)
+DEFINE_SCALAR_KERNEL(f64_s8_scalar, double, int8_t, double, STORE_INT)
+DEFINE_SCALAR_KERNEL(s16_s8_scalar, int16_t, int8_t, float, STORE_INTF)
+
+/* Every supported (input, output) pair, indexed by [input][output]. Only the
+ * most common pairs have vector kernels; see struct convert_kernels. */
+static const convert_fn scalar_table[ELEM_COUNT][ELEM_COUNT] = {
+    /* ELEM_S8 ->  S8, S16, F32, F64 */
+    { NULL, s8_s16_scalar, s8_f32_scalar, s8_f64_scalar },
+    /* ELEM_S16 -> S8, S16, F32, F64 */
+    { s16_s8_scalar, s16_s16_scalar, s16_f32_scalar, s16_f64_scalar },
+    /* ELEM_F32 -> S8, S16, F32, F64 */
+    { f32_s8_scalar, f32_s16_scalar, NULL, NULL },
+    /* ELEM_F64 -> S8, S16, F32, F64 */
+    { f64_s8_scalar, f64_s16_scalar, NULL, NULL },
+};
+
+static const struct convert_kernels kernels_scalar = {
+    "scalar", s16_f32_scalar, f32_s16_scalar, s8_f32_scalar, f32_s8_scalar,
+};
+
+#ifdef CONVERT_HAVE_SSE2
+CONVERT_TARGET("sse2")
+static void s16_f32_sse2(void *out, const void *in, size_t n,
+                         const struct convert_params *p, double sum[2])
+{
+    const int16_t *x = in;
+    float *d         = out;
+    const __m128 a   = _mm_set1_ps((float)p->a);
+    const __m128 b   = _mm_setr_ps((float)p->b[0], (float)p->b[1],
+                                   (float)p->b[0], (float)p->b[1]);
+    __m128 acc = _mm_setzero_ps();
+    float s[4];
+    size_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128i v  = _mm_loadu_si128((const __m128i *)(x + 2 * i));
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        __m128 y0  = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(lo), a), b);
+        __m128 y1  = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(hi), a), b);
+
+        acc = _mm_add_ps(acc, _mm_add_ps(y0, y1));
+        _mm_storeu_ps(d + 2 * i, y0);
+        _mm_storeu_ps(d + 2 * i + 4, y1);
+    }
+
+    _mm_storeu_ps(s, acc);
+    sum[0] += s[0] + s[2];
+    sum[1] += s[1] + s[3];
+
+    s16_f32_scalar(d + 2 * i, x + 2 * i, n - i, p, sum);
+}
+
+CONVERT_TARGET("sse2")
+static void s8_f32_sse2(void *out, const void *in, size_t n,
+                        const struct convert_params *p, double sum[2])
+{
+    const int8_t *x = in;
+    float *d        = out;
+    const __m128 a  = _mm_set1_ps((float)p->a);
+    const __m128 b  = _mm_setr_ps((float)p->b[0], (float)p->b[1],
+                                  (float)p->b[0], (float)p->b[1]);
+    __m128 acc = _mm_setzero_ps();
+    float s[4];
+    size_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128i v  = _mm_loadl_epi64((const __m128i *)(x + 2 * i));
+        __m128i w  = _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8);
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(w, w), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(w, w), 16);
+        __m128 y0  = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(lo), a), b);
+        __m128 y1  = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(hi), a), b);
+
+        acc = _mm_add_ps(acc, _mm_add_ps(y0, y1));
+        _mm_storeu_ps(d + 2 * i, y0);
+        _mm_storeu_ps(d + 2 * i + 4, y1);
+    }
+
+    _mm_storeu_ps(s, acc);
+    sum[0] += s[0] + s[2];
+    sum[1] += s[1] + s[3];
+
+    s8_f32_scalar(d + 2 * i, x + 2 * i, n - i, p, sum);
+}
+
+/* Round half away from zero, as round_satf() does, by adding 0.5 with the
+ * sign of y and truncating */
+CONVERT_TARGET("sse2")
+static inline __m128i round_sse2(__m128 y)
+{
+    const __m128 half = _mm_or_ps(_mm_and_ps(y, _mm_set1_ps(-0.0f)),
+                                  _mm_set1_ps(0.5f));
+
+    return _mm_cvttps_epi32(_mm_add_ps(y, half));
+}
+
+/* Convert four complex floats to eight saturated 16-bit integers */
+CONVERT_TARGET("sse2")
+static inline __m128i f32_to_s16x8_sse2(const float *x,
+                                        __m128 a,
+                                        __m128 b,
+                                        __m128 min,
+                                        __m128 max,
+                                        __m128 *acc)
+{
+    __m128 y0 = _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(x), a), b);
+    __m128 y1 = _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(x + 4), a), b);
+
+    *acc = _mm_add_ps(*acc, _mm_add_ps(y0, y1));
+
+    y0 = _mm_min_ps(_mm_max_ps(y0, min), max);
+    y1 = _mm_min_ps(_mm_max_ps(y1, min), max);
+
+    return _mm_packs_epi32(round_sse2(y0), round_sse2(y1));
+}
+
+CONVERT_TARGET("sse2")
+static void f32_s16_sse2(void *out, const void *in, size_t n,
+                         const struct convert_params *p, double sum[2])
+{
+    const float *x   = in;
+    int16_t *d       = out;
+    const __m128 a   = _mm_set1_ps((float)p->a);
+    const __m128 b   = _mm_setr_ps((float)p->b[0], (float)p->b[1],
+                                   (float)p->b[0], (float)p->b[1]);
+    const __m128 min = _mm_set1_ps((float)p->min);
+    const __m128 max = _mm_set1_ps((float)p->max);
+    __m128 acc       = _mm_setzero_ps();
+    float s[4];
+    size_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128i r = f32_to_s16x8_sse2(x + 2 * i, a, b, min, max, &acc);
+        _mm_storeu_si128((__m128i *)(d + 2 * i), r);
+    }
+
+    _mm_storeu_ps(s, acc);
+    sum[0] += s[0] + s[2];
+    sum[1] += s[1] + s[3];
+
+    f32_s16_scalar(d + 2 * i, x + 2 * i, n - i, p, sum);
+}
+
+CONVERT_TARGET("sse2")
+static void f32_s8_sse2(void *out, const void *in, size_t n,
+                        const struct convert_params *p, double sum[2])
+{
+    const float *x   = in;
+    int8_t *d        = out;
+    const __m128 a   = _mm_set1_ps((float)p->a);
+    const __m128 b   = _mm_setr_ps((float)p->b[0], (float)p->b[1],
+                                   (float)p->b[0], (float)p->b[1]);
+    const __m128 min = _mm_set1_ps((float)p->min);
+    const __m128 max = _mm_set1_ps((float)p->max);
+    __m128 acc       = _mm_setzero_ps();
+    float s[4];
+    size_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128i r = f32_to_s16x8_sse2(x + 2 * i, a, b, min, max, &acc);
+        _mm_storel_epi64((__m128i *)(d + 2 * i), _mm_packs_epi16(r, r));
+    }
+
+    _mm_storeu_ps(s, acc);
+    sum[0] += s[0] + s[2];
+    sum[1] += s[1] + s[3];
+
+    f32_s8_scalar(d + 2 * i, x + 2 * i, n - i, p, sum);
+}
+
+static const struct convert_kernels kernels_sse2 = {
+    "SSE2", s16_f32_sse2, f32_s16_sse2, s8_f32_sse2, f32_s8_sse2,
+};
+#endif
+
+#ifdef CONVERT_HAVE_AVX2
+CONVERT_TARGET("avx2")
+static void s16_f32_avx2(void *out, const void *in, size_t n,
+                         const struct convert_params *p, double sum[2])
+{
+    const int16_t *x = in;
+    float *d         = out;
+    const float b0   = (float)p->b[0];
+    const float b1   = (float)p->b[1];
+    const __m256 a   = _mm256_set1_ps((float)p->a);
+    const __m256 b   = _mm256_setr_ps(b0, b1, b0, b1, b0, b1, b0, b1);
+    __m256 acc       = _mm256_setzero_ps();
+    float s[8];
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m128i v0 = _mm_loadu_si128((const __m128i *)(x + 2 * i));
+        __m128i v1 = _mm_loadu_si128((const __m128i *)(x + 2 * i + 8));
+        __m256 y0  = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(v0));
+        __m256 y1  = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(v1));
+
+        y0 = _mm256_sub_ps(_mm256_mul_ps(y0, a), b);
+        y1 = _mm256_sub_ps(_mm256_mul_ps(y1, a), b);
+
+        acc = _mm256_add_ps(acc, _mm256_add_ps(y0, y1));
+        _mm256_storeu_ps(d + 2 * i, y0);
+        _mm256_storeu_ps(d + 2 * i + 8, y1);
+    }
+
+    _mm256_storeu_ps(s, acc);
+    sum[0] += s[0] + s[2] + s[4] + s[6];
+    sum[1] += s[1] + s[3] + s[5] + s[7];
+
+    s16_f32_scalar(d + 2 * i, x + 2 * i, n - i, p, sum);
+}
+
+CONVERT_TARGET("avx2")
+static void s8_f32_avx2(void *out, const void *in, size_t n,
+                        const struct convert_params *p, double sum[2])
+{
+    const int8_t *x = in;
+    float *d        = out;
+    const float b0  = (float)p->b[0];
+    const float b1  = (float)p->b[1];
+    const __m256 a  = _mm256_set1_ps((float)p->a);
+    const __m256 b  = _mm256_setr_ps(b0, b1, b0, b1, b0, b1, b0, b1);
+    __m256 acc      = _mm256_setzero_ps();
+    float s[8];
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(x + 2 * i));
+        __m256 y0 = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(v));
+        __m256 y1 =
+            _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_srli_si128(v, 8)));
+
+        y0 = _mm256_sub_ps(_mm256_mul_ps(y0, a), b);
+        y1 = _mm256_sub_ps(_mm256_mul_ps(y1, a), b);
+
+        acc = _mm256_add_ps(acc, _mm256_add_ps(y0, y1));
+        _mm256_storeu_ps(d + 2 * i, y0);
+        _mm256_storeu_ps(d + 2 * i + 8, y1);
+    }
+
+    _mm256_storeu_ps(s, acc);
+    sum[0] += s[0] + s[2] + s[4] + s[6];
+    sum[1] += s[1] + s[3] + s[5] + s[7];
+
+    s8_f32_scalar(d + 2 * i, x + 2 * i, n - i, p, sum);
+}
+
+/* Round half away from zero, as round_satf() does */
+CONVERT_TARGET("avx2")
+static inline __m256i round_avx2(__m256 y)
+{
+    const __m256 half = _mm256_or_ps(_mm256_and_ps(y, _mm256_set1_ps(-0.0f)),
+                                     _mm256_set1_ps(0.5f));
+
+    return _mm256_cvttps_epi32(_mm256_add_ps(y, half));
+}
+
+/* Convert eight complex floats to sixteen saturated 16-bit integers */
+CONVERT_TARGET("avx2")
+static inline __m256i f32_to_s16x16_avx2(const float *x,
+                                         __m256 a,
+                                         __m256 b,
+                                         __m256 min,
+                                         __m256 max,
+                                         __m256 *acc)
+{
+    __m256 y0 = _mm256_sub_ps(_mm256_mul_ps(_mm256_loadu_ps(x), a), b);
+    __m256 y1 = _mm256_sub_ps(_mm256_mul_ps(_mm256_loadu_ps(x + 8), a), b);
+    __m256i r;
+
+    *acc = _mm256_add_ps(*acc, _mm256_add_ps(y0, y1));
+
+    y0 = _mm256_min_ps(_mm256_max_ps(y0, min), max);
+    y1 = _mm256_min_ps(_mm256_max_ps(y1, min), max);
+
+    /* Packs operate per 128-bit lane; restore sample order afterwards */
+    r = _mm256_packs_epi32(round_avx2(y0), round_avx2(y1));
+    return _mm256_permute4x64_epi64(r, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+CONVERT_TARGET("avx2")
+static void f32_s16_avx2(void *out, const void *in, size_t n,
+                         const struct convert_params *p, double sum[2])
+{
+    const float *x   = in;
+    int16_t *d       = out;
+    const float b0   = (float)p->b[0];
+    const float b1   = (float)p->b[1];
+    const __m256 a   = _mm256_set1_ps((float)p->a);
+    const __m256 b   = _mm256_setr_ps(b0, b1, b0, b1, b0, b1, b0, b1);
+    const __m256 min = _mm256_set1_ps((float)p->min);
+    const __m256 max = _mm256_set1_ps((float)p->max);
+    __m256 acc       = _mm256_setzero_ps();
+    float s[8];
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256i r = f32_to_s16x16_avx2(x + 2 * i, a, b, min, max, &acc);
+        _mm256_storeu_si256((__m256i *)(d + 2 * i), r);
+    }
+
+    _mm256_storeu_ps(s, acc);
+    sum[0] += s[0] + s[2] + s[4] + s[6];
+    sum[1] += s[1] + s[3] + s[5] + s[7];
+
+    f32_s16_scalar(d + 2 * i, x + 2 * i, n - i, p, sum);
+}
+
+CONVERT_TARGET("avx2")
+static void f32_s8_avx2(void *out, const void *in, size_t n,
+                        const struct convert_params *p, double sum[2])
+{
+    const float *x   = in;
+    int8_t *d        = out;
+    const float b0   = (float)p->b[0];
+    const float b1   = (float)p->b[1];
+    const __m256 a   = _mm256_set1_ps((float)p->a);
+    const __m256 b   = _mm256_setr_ps(b0, b1, b0, b1, b0, b1, b0, b1);
+    const __m256 min = _mm256_set1_ps((float)p->min);
+    const __m256 max = _mm256_set1_ps((float)p->max);
+    __m256 acc       = _mm256_setzero_ps();
+    float s[8];
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256i r = f32_to_s16x16_avx2(x + 2 * i, a, b, min, max, &acc);
+        __m128i q = _mm_packs_epi16(_mm256_castsi256_si128(r),
+                                    _mm256_extracti128_si256(r, 1));
+        _mm_storeu_si128((__m128i *)(d + 2 * i), q);
+    }
+
+    _mm256_storeu_ps(s, acc);
+    sum[0] += s[0] + s[2] + s[4] + s[6];
+    sum[1] += s[1] + s[3] + s[5] + s[7];
+
+    f32_s8_scalar(d + 2 * i, x + 2 * i, n - i, p, sum);
+}
+
+static const struct convert_kernels kernels_avx2 = {
+    "AVX2", s16_f32_avx2, f32_s16_avx2, s8_f32_avx2, f32_s8_avx2,
+};
+#endif
+
+#ifdef CONVERT_HAVE_NEON
+static void s16_f32_neon(void *out, const void *in, size_t n,
+                         const struct convert_params *p, double sum[2])
+{
+    const int16_t *x     = in;
+    float *d             = out;
+    const float32x4_t a  = vdupq_n_f32((float)p->a);
+    const float bv[4]    = { (float)p->b[0], (float)p->b[1], (float)p->b[0],
+                          (float)p->b[1] };
+    const float32x4_t b  = vld1q_f32(bv);
+    float32x4_t acc      = vdupq_n_f32(0.0f);
+    float s[4];
+    size_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        int16x8_t v    = vld1q_s16(x + 2 * i);
+        float32x4_t y0 = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+        float32x4_t y1 = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+
+        y0 = vsubq_f32(vmulq_f32(y0, a), b);
+        y1 = vsubq_f32(vmulq_f32(y1, a), b);
+
+        acc = vaddq_f32(acc, vaddq_f32(y0, y1));
+        vst1q_f32(d + 2 * i, y0);
+        vst1q_f32(d + 2 * i + 4, y1);
+    }
+
+    vst1q_f32(s, acc);
+    sum[0] += s[0] + s[2];
+    sum[1] += s[1] + s[3];
+
+    s16_f32_scalar(d + 2 * i, x + 2 * i, n - i, p, sum);
+}
+
+static void s8_f32_neon(void *out, const void *in, size_t n,
+                        const struct convert_params *p, double sum[2])
+{
+    const int8_t *x      = in;
+    float *d             = out;
+    const float32x4_t a  = vdupq_n_f32((float)p->a);
+    const float bv[4]    = { (float)p->b[0], (float)p->b[1], (float)p->b[0],
+                          (float)p->b[1] };
+    const float32x4_t b  = vld1q_f32(bv);
+    float32x4_t acc      = vdupq_n_f32(0.0f);
+    float s[4];
+    size_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        int16x8_t v    = vmovl_s8(vld1_s8(x + 2 * i));
+        float32x4_t y0 = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+        float32x4_t y1 = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+
+        y0 = vsubq_f32(vmulq_f32(y0, a), b);
+        y1 = vsubq_f32(vmulq_f32(y1, a), b);
+
+        acc = vaddq_f32(acc, vaddq_f32(y0, y1));
+        vst1q_f32(d + 2 * i, y0);
+        vst1q_f32(d + 2 * i + 4, y1);
+    }
+
+    vst1q_f32(s, acc);
+    sum[0] += s[0] + s[2];
+    sum[1] += s[1] + s[3];
+
+    s8_f32_scalar(d + 2 * i, x + 2 * i, n - i, p, sum);
+}
+
+/* Round half away from zero, as round_satf() does, saturating to
+ * [min, max] */
+static inline int32x4_t round_sat_neon(float32x4_t y,
+                                       float32x4_t min,
+                                       float32x4_t max)
+{
+    y = vminq_f32(vmaxq_f32(y, min), max);
+    return vcvtq_s32_f32(vaddq_f32(
+        y, vbslq_f32(vcltq_f32(y, vdupq_n_f32(0.0f)), vdupq_n_f32(-0.5f),
+                     vdupq_n_f32(0.5f))));
+}
+
+/* Convert four complex floats to eight saturated 16-bit integers */
+static inline int16x8_t f32_to_s16x8_neon(const float *x,
+                                          float32x4_t a,
+                                          float32x4_t b,
+                                          float32x4_t min,
+                                          float32x4_t max,
+                                          float32x4_t *acc)
+{
+    float32x4_t y0 = vsubq_f32(vmulq_f32(vld1q_f32(x), a), b);
+    float32x4_t y1 = vsubq_f32(vmulq_f32(vld1q_f32(x + 4), a), b);
+
+    *acc = vaddq_f32(*acc, vaddq_f32(y0, y1));
+
+    return vcombine_s16(vqmovn_s32(round_sat_neon(y0, min, max)),
+                        vqmovn_s32(round_sat_neon(y1, min, max)));
+}
+
+static void f32_s16_neon(void *out, const void *in, size_t n,
+                         const struct convert_params *p, double sum[2])
+{
+    const float *x        = in;
+    int16_t *d            = out;
+    const float32x4_t a   = vdupq_n_f32((float)p->a);
+    const float bv[4]     = { (float)p->b[0], (float)p->b[1], (float)p->b[0],
+                          (float)p->b[1] };
+    const float32x4_t b   = vld1q_f32(bv);
+    const float32x4_t min = vdupq_n_f32((float)p->min);
+    const float32x4_t max = vdupq_n_f32((float)p->max);
+    float32x4_t acc       = vdupq_n_f32(0.0f);
+    float s[4];
+    size_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        vst1q_s16(d + 2 * i,
+                  f32_to_s16x8_neon(x + 2 * i, a, b, min, max, &acc));
+    }
+
+    vst1q_f32(s, acc);
+    sum[0] += s[0] + s[2];
+    sum[1] += s[1] + s[3];
+
+    f32_s16_scalar(d + 2 * i, x + 2 * i, n - i, p, sum);
+}
+
+static void f32_s8_neon(void *out, const void *in, size_t n,
+                        const struct convert_params *p, double sum[2])
+{
+    const float *x        = in;
+    int8_t *d             = out;
+    const float32x4_t a   = vdupq_n_f32((float)p->a);
+    const float bv[4]     = { (float)p->b[0], (float)p->b[1], (float)p->b[0],
+                          (float)p->b[1] };
+    const float32x4_t b   = vld1q_f32(bv);
+    const float32x4_t min = vdupq_n_f32((float)p->min);
+    const float32x4_t max = vdupq_n_f32((float)p->max);
+    float32x4_t acc       = vdupq_n_f32(0.0f);
+    float s[4];
+    size_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        int16x8_t r = f32_to_s16x8_neon(x + 2 * i, a, b, min, max, &acc);
+        vst1_s8(d + 2 * i, vqmovn_s16(r));
+    }
+
+    vst1q_f32(s, acc);
+    sum[0] += s[0] + s[2];
+    sum[1] += s[1] + s[3];
+
+    f32_s8_scalar(d + 2 * i, x + 2 * i, n - i, p, sum);
+}
+
+static const struct convert_kernels kernels_neon = {
+    "NEON", s16_f32_neon, f32_s16_neon, s8_f32_neon, f32_s8_neon,
+};
+#endif
+
+static const struct convert_kernels *kernels = &kernels_scalar;
+static pthread_once_t kernels_once = PTHREAD_ONCE_INIT;
+
+static void select_kernels(void)
+{
+#if defined(CONVERT_HAVE_AVX2)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        kernels = &kernels_avx2;
+    } else if (__builtin_cpu_supports("sse2")) {
+        kernels = &kernels_sse2;
+    }
+#elif defined(CONVERT_HAVE_SSE2)
+    kernels = &kernels_sse2;
+#elif defined(CONVERT_HAVE_NEON)
+    kernels = &kernels_neon;
+#endif
+
+    log_verbose("Using %s sample conversion kernels\n", kernels->name);
+}
+
+static const struct convert_kernels *get_kernels(void)
+{
+    pthread_once(&kernels_once, select_kernels);
+    return kernels;
+}
+
+const char *_sample_convert_kernel_name(void)
+{
+    return get_kernels()->name;
+}
+
+static convert_fn get_convert_fn(enum elem from, enum elem to)
+{
+    const struct convert_kernels *k = get_kernels();
+
+    if (from == ELEM_S16 && to == ELEM_F32) {
+        return k->s16_f32;
+    } else if (from == ELEM_F32 && to == ELEM_S16) {
+        return k->f32_s16;
+    } else if (from == ELEM_S8 && to == ELEM_F32) {
+        return k->s8_f32;
+    } else if (from == ELEM_F32 && to == ELEM_S8) {
+        return k->f32_s8;
+    }
+
+    return scalar_table[from][to];
+}
+
+static int device_type(bladerf_format format, struct sample_type *t)
+{
+    switch (format) {
+        case BLADERF_FORMAT_SC16_Q11:
+        case BLADERF_FORMAT_SC16_Q11_META:
+            t->elem       = ELEM_S16;
+            t->elem_size  = sizeof(int16_t);
+            t->full_scale = 2048.0;
+            t->min        = -2048.0;
+            t->max        = 2047.0;
+            return 0;
+
+        case BLADERF_FORMAT_SC8_Q7:
+        case BLADERF_FORMAT_SC8_Q7_META:
+            t->elem       = ELEM_S8;
+            t->elem_size  = sizeof(int8_t);
+            t->full_scale = 128.0;
+            t->min        = -128.0;
+            t->max        = 127.0;
+            return 0;
+
+        case BLADERF_FORMAT_PACKET_META:
+            return BLADERF_ERR_UNSUPPORTED;
+    }
+
+    return BLADERF_ERR_INVAL;
+}
+
+static int host_type(bladerf_host_format format, struct sample_type *t)
+{
+    switch (format) {
+        case BLADERF_HOST_FORMAT_CF32:
+            t->elem       = ELEM_F32;
+            t->elem_size  = sizeof(float);
+            t->full_scale = 1.0;
+            t->min        = 0.0;
+            t->max        = 0.0;
+            return 0;
+
+        case BLADERF_HOST_FORMAT_CF64:
+            t->elem       = ELEM_F64;
+            t->elem_size  = sizeof(double);
+            t->full_scale = 1.0;
+            t->min        = 0.0;
+            t->max        = 0.0;
+            return 0;
+
+        case BLADERF_HOST_FORMAT_CI16:
+            t->elem       = ELEM_S16;
+            t->elem_size  = sizeof(int16_t);
+            t->full_scale = 32768.0;
+            t->min        = -32768.0;
+            t->max        = 32767.0;
+            return 0;
+    }
+
+    return BLADERF_ERR_INVAL;
+}
+
+/* Run a kernel over n complex samples, a chunk at a time */
+static void run(convert_fn fn,
+                uint8_t *out,
+                size_t out_step,
+                const uint8_t *in,
+                size_t in_step,
+                size_t n,
+                const struct convert_params *p,
+                double sum[2])
+{
+    while (n > 0) {
+        size_t count = (n < CONVERT_CHUNK) ? n : CONVERT_CHUNK;
+        double partial[2] = { 0.0, 0.0 };
+
+        fn(out, in, count, p, partial);
+
+        sum[0] += partial[0];
+        sum[1] += partial[1];
+
+        out += count * out_step;
+        in += count * in_step;
+        n -= count;
+    }
+}
+
+/*
+ * Shared implementation of both directions. `dev` describes the
+ * device-format buffer `dev_buf` of `num_samples` samples, and `host` the
+ * packed host-format buffer `host_buf`.
+ */
+static int convert(bool to_device,
+                   bladerf_format format,
+                   const struct sample_type *dev,
+                   void *dev_buf,
+                   const struct sample_type *host,
+                   void *host_buf,
+                   unsigned int num_samples,
+                   struct bladerf_conversion *conv)
+{
+    const struct sample_type *from = to_device ? host : dev;
+    const struct sample_type *to   = to_device ? dev : host;
+    const size_t dev_step          = 2 * dev->elem_size;
+    const size_t host_step         = 2 * host->elem_size;
+    const size_t meta_size         = _interleave_calc_metadata_bytes(format);
+    struct convert_params p;
+    convert_fn fn;
+    double scale = 1.0, dc_i = 0.0, dc_q = 0.0, alpha = 1.0;
+    double sum[2] = { 0.0, 0.0 };
+    size_t msg_size, msg_samples, num_msgs, msg;
+    size_t total = 0;
+    uint8_t *dev_ptr  = dev_buf;
+    uint8_t *host_ptr = host_buf;
+
+    if (num_samples > INT_MAX) {
+        log_debug("%s: too many samples (%u)\n", __FUNCTION__, num_samples);
+        return BLADERF_ERR_INVAL;
+    }
+
+    if (conv != NULL) {
+        if (conv->scale != 0.0f) {
+            scale = conv->scale;
+        }
+
+        if (conv->dc_alpha < 0.0f || conv->dc_alpha > 1.0f) {
+            log_debug("%s: DC alpha out of range: %f\n", __FUNCTION__,
+                      conv->dc_alpha);
+            return BLADERF_ERR_INVAL;
+        } else if (conv->dc_alpha != 0.0f) {
+            alpha = conv->dc_alpha;
+        }
+
+        if (conv->remove_dc) {
+            dc_i = conv->dc_i;
+            dc_q = conv->dc_q;
+        }
+    }
+
+    fn = get_convert_fn(from->elem, to->elem);
+    if (NULL == fn) {
+        return BLADERF_ERR_UNSUPPORTED;
+    }
+
+    /* Map normalized input to output units, less the DC estimate (which is
+     * kept in normalized units so it is independent of either format) */
+    p.a    = scale * to->full_scale / from->full_scale;
+    p.b[0] = dc_i * scale * to->full_scale;
+    p.b[1] = dc_q * scale * to->full_scale;
+    p.min  = to->min;
+    p.max  = to->max;
+
+    /* Messages in a metadata-format buffer each begin with a header, which
+     * is skipped when reading and left untouched when writing */
+    msg_size = (conv != NULL && meta_size != 0) ? conv->msg_size : 0;
+
+    if (msg_size != 0) {
+        if (msg_size <= meta_size || (msg_size - meta_size) % dev_step != 0 ||
+            ((size_t)num_samples * dev_step) % msg_size != 0) {
+            log_debug("%s: invalid message size (%llu) for %u samples\n",
+                      __FUNCTION__, (unsigned long long)msg_size,
+                      num_samples);
+            return BLADERF_ERR_INVAL;
+        }
+
+        msg_samples = (msg_size - meta_size) / dev_step;
+        num_msgs    = (size_t)num_samples * dev_step / msg_size;
+    } else {
+        msg_samples = num_samples;
+        num_msgs    = 1;
+    }
+
+    for (msg = 0; msg < num_msgs; msg++) {
+        if (msg_size != 0) {
+            dev_ptr = (uint8_t *)dev_buf + msg * msg_size + meta_size;
+        }
+
+        if (to_device) {
+            run(fn, dev_ptr, dev_step, host_ptr, host_step, msg_samples, &p,
+                sum);
+        } else {
+            run(fn, host_ptr, host_step, dev_ptr, dev_step, msg_samples, &p,
+                sum);
+        }
+
+        host_ptr += msg_samples * host_step;
+        total += msg_samples;
+    }
+
+    /* Fold this block's mean into the running DC estimate. The sums are of
+     * the (pre-rounding) outputs, so undo the affine map to recover the mean
+     * of the normalized input. */
+    if (conv != NULL && conv->remove_dc && total != 0) {
+        double mean_i = (sum[0] / total + p.b[0]) / (scale * to->full_scale);
+        double mean_q = (sum[1] / total + p.b[1]) / (scale * to->full_scale);
+
+        conv->dc_i = (float)(dc_i + alpha * (mean_i - dc_i));
+        conv->dc_q = (float)(dc_q + alpha * (mean_q - dc_q));
+    }
+
+    return (int)total;
+}
+
+int _sample_convert_from_format(bladerf_format format,
+                                const void *samples,
+                                unsigned int num_samples,
+                                bladerf_host_format host_format,
+                                void *output,
+                                struct bladerf_conversion *conv)
+{
+    struct sample_type dev, host;
+    int status;
+
+    status = device_type(format, &dev);
+    if (status != 0) {
+        return status;
+    }
+
+    status = host_type(host_format, &host);
+    if (status != 0) {
+        return status;
+    }
+
+    return convert(false, format, &dev, (void *)samples, &host, output,
+                   num_samples, conv);
+}
+
+int _sample_convert_to_format(bladerf_host_format host_format,
+                              const void *input,
+                              bladerf_format format,
+                              void *samples,
+                              unsigned int num_samples,
+                              struct bladerf_conversion *conv)
+{
+    struct sample_type dev, host;
+    int status;
+
+    status = device_type(format, &dev);
+    if (status != 0) {
+        return status;
+    }
+
+    status = host_type(host_format, &host);
+    if (status != 0) {
+        return status;
+    }
+
+    return convert(true, format, &dev, samples, &host, (void *)input,
+                   num_samples, conv);
+}
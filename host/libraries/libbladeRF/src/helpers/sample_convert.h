@@ -0,0 +1,58 @@
+/*
+ * This file is part of the bladeRF project:
+ *   http://www.github.com/nuand/bladeRF
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef HELPERS_SAMPLE_CONVERT_H_
+#define HELPERS_SAMPLE_CONVERT_H_
+
+/**
+ * Convert a buffer of device-format samples to a host format.
+ *
+ * See bladerf_convert_from_format() for a description of the arguments.
+ *
+ * @return Number of host samples written on success, BLADERF_ERR_* on failure
+ */
+int _sample_convert_from_format(bladerf_format format,
+                                const void *samples,
+                                unsigned int num_samples,
+                                bladerf_host_format host_format,
+                                void *output,
+                                struct bladerf_conversion *conv);
+
+/**
+ * Convert a buffer of host-format samples to a device format.
+ *
+ * See bladerf_convert_to_format() for a description of the arguments.
+ *
+ * @return Number of host samples consumed on success, BLADERF_ERR_* on failure
+ */
+int _sample_convert_to_format(bladerf_host_format host_format,
+                              const void *input,
+                              bladerf_format format,
+                              void *samples,
+                              unsigned int num_samples,
+                              struct bladerf_conversion *conv);
+
+/**
+ * @return Name of the instruction set used by the conversion kernels
+ */
+const char *_sample_convert_kernel_name(void);
+
+#endif
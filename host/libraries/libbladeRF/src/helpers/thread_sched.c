@@ -0,0 +1,156 @@
+/*
+ * This file is part of the bladeRF project:
+ *   http://www.github.com/nuand/bladeRF
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/* Required for pthread_setaffinity_np() and the CPU_* macros */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#   define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <string.h>
+#include <sched.h>
+
+#include "host_config.h"
+#include "log.h"
+
+#include "thread_sched.h"
+
+static int errno_to_status(int err)
+{
+    switch (err) {
+        case EPERM:
+            return BLADERF_ERR_PERMISSION;
+
+        case EINVAL:
+            return BLADERF_ERR_INVAL;
+
+        case ENOTSUP:
+            return BLADERF_ERR_UNSUPPORTED;
+
+        case ESRCH:
+        default:
+            return BLADERF_ERR_UNEXPECTED;
+    }
+}
+
+static int sched_policy(bladerf_thread_sched policy)
+{
+    switch (policy) {
+        case BLADERF_THREAD_SCHED_FIFO:
+            return SCHED_FIFO;
+
+        case BLADERF_THREAD_SCHED_RR:
+            return SCHED_RR;
+
+        default:
+            return -1;
+    }
+}
+
+int thread_sched_validate(const struct bladerf_stream_thread_config *config)
+{
+    if (config->pin_cpu) {
+#if BLADERF_OS_LINUX
+        if (config->cpu >= CPU_SETSIZE) {
+            log_debug("CPU %u exceeds CPU_SETSIZE\n", config->cpu);
+            return BLADERF_ERR_INVAL;
+        }
+#else
+        log_debug("CPU pinning is not supported on this platform\n");
+        return BLADERF_ERR_UNSUPPORTED;
+#endif
+    }
+
+    if (config->policy != BLADERF_THREAD_SCHED_DEFAULT) {
+        const int policy = sched_policy(config->policy);
+        int min, max;
+
+        if (policy < 0) {
+            log_debug("Invalid scheduling policy: %d\n", config->policy);
+            return BLADERF_ERR_INVAL;
+        }
+
+        min = sched_get_priority_min(policy);
+        max = sched_get_priority_max(policy);
+
+        if (min < 0 || max < 0) {
+            return BLADERF_ERR_UNSUPPORTED;
+        }
+
+        if (config->priority != 0 &&
+            (config->priority < min || config->priority > max)) {
+            log_debug("Priority %d is outside of the range [%d, %d]\n",
+                      config->priority, min, max);
+            return BLADERF_ERR_INVAL;
+        }
+    }
+
+    return 0;
+}
+
+int thread_sched_apply(pthread_t thread,
+                       const struct bladerf_stream_thread_config *config)
+{
+    int status;
+
+    status = thread_sched_validate(config);
+    if (status != 0) {
+        return status;
+    }
+
+#if BLADERF_OS_LINUX
+    if (config->pin_cpu) {
+        cpu_set_t cpus;
+
+        CPU_ZERO(&cpus);
+        CPU_SET(config->cpu, &cpus);
+
+        status = pthread_setaffinity_np(thread, sizeof(cpus), &cpus);
+        if (status != 0) {
+            log_debug("Failed to pin thread to CPU %u: %s\n", config->cpu,
+                      strerror(status));
+            return errno_to_status(status);
+        }
+    }
+#endif
+
+    if (config->policy != BLADERF_THREAD_SCHED_DEFAULT) {
+        const int policy = sched_policy(config->policy);
+        struct sched_param param;
+
+        memset(&param, 0, sizeof(param));
+
+        if (config->priority == 0) {
+            param.sched_priority = sched_get_priority_min(policy);
+        } else {
+            param.sched_priority = config->priority;
+        }
+
+        status = pthread_setschedparam(thread, policy, &param);
+        if (status != 0) {
+            log_debug("Failed to set scheduling policy %d, priority %d: %s\n",
+                      policy, param.sched_priority, strerror(status));
+            return errno_to_status(status);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file thread_sched.h
+ *
+ * This file is not part of the API and may be changed at any time.
+ * If you're interfacing with libbladeRF, DO NOT use this file.
+ *
+ * This file is part of the bladeRF project:
+ *   http://www.github.com/nuand/bladeRF
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef HELPERS_THREAD_SCHED_H_
+#define HELPERS_THREAD_SCHED_H_
+
+#include <pthread.h>
+
+#include <libbladeRF.h>
+
+/**
+ * Check a thread configuration for values that can never be applied
+ *
+ * @param[in]   config      Configuration to check
+ *
+ * @return 0 if valid, BLADERF_ERR_INVAL or BLADERF_ERR_UNSUPPORTED otherwise
+ */
+int thread_sched_validate(const struct bladerf_stream_thread_config *config);
+
+/**
+ * Pin a thread to a CPU and/or change its scheduling policy, as requested by
+ * the provided configuration. Default (zero) fields leave the corresponding
+ * attribute of the thread unmodified.
+ *
+ * @param[in]   thread      Thread to modify
+ * @param[in]   config      Configuration to apply
+ *
+ * @return 0 on success, BLADERF_ERR_* on failure
+ */
+int thread_sched_apply(pthread_t thread,
+                       const struct bladerf_stream_thread_config *config);
+
+#endif
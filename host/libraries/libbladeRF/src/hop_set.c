@@ -0,0 +1,278 @@
+/*
+ * This file is part of the bladeRF project:
+ *   http://www.github.com/nuand/bladeRF
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/* Hop sets are stored as bladerf_image files of type
+ * BLADERF_IMAGE_TYPE_HOP_SET. The image's serial number field identifies the
+ * device the hop set was built with. The image data is laid out as follows,
+ * with all values in little-endian byte order.
+ *
+ * 0x0000 [uint32_t: Channel]
+ * 0x0004 [uint32_t: Flags. See HOP_SET_FLAG_* values]
+ * 0x0008 [uint32_t: Number of entries]
+ * 0x000c [Start of entries]
+ *
+ * Where an entry is:
+ *        [uint64_t: Frequency, in Hz]
+ *        [uint8_t:  bladeRF1 FREQSEL]
+ *        [uint8_t:  bladeRF1 VCOCAP]
+ *        [uint16_t: bladeRF1 NINT]
+ *        [uint32_t: bladeRF1 NFRAC]
+ *        [uint8_t:  bladeRF1 flags]
+ *        [uint8_t:  bladeRF1 XB GPIO]
+ *
+ * The bladeRF1 fields are 0 unless HOP_SET_FLAG_BLADERF1 is set. bladeRF2
+ * quick tune parameters refer to profiles held by the FPGA, which do not
+ * persist across power cycles, so only the frequencies are meaningful.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_config.h"
+#include "log.h"
+
+#include "board/board.h"
+#include "hop_set.h"
+#include "lms.h"
+
+#define HOP_SET_VERSION (struct bladerf_version) { \
+    .describe = "quick tune hop set", \
+    .major = 1, \
+    .minor = 0, \
+    .patch = 0, \
+}
+
+#define HOP_SET_FLAG_BLADERF1   (1 << 0)
+
+#define HOP_SET_META_SIZE       0x0c
+#define HOP_SET_ENTRY_SIZE      18
+#define HOP_SET_MAX_ENTRIES \
+    ((UINT32_MAX - HOP_SET_META_SIZE) / HOP_SET_ENTRY_SIZE)
+
+extern const struct board_fns bladerf1_board_fns;
+
+static inline void pack_u16(uint8_t *buf, size_t *off, uint16_t val)
+{
+    val = HOST_TO_LE16(val);
+    memcpy(&buf[*off], &val, sizeof(val));
+    *off += sizeof(val);
+}
+
+static inline void pack_u32(uint8_t *buf, size_t *off, uint32_t val)
+{
+    val = HOST_TO_LE32(val);
+    memcpy(&buf[*off], &val, sizeof(val));
+    *off += sizeof(val);
+}
+
+static inline void pack_u64(uint8_t *buf, size_t *off, uint64_t val)
+{
+    val = HOST_TO_LE64(val);
+    memcpy(&buf[*off], &val, sizeof(val));
+    *off += sizeof(val);
+}
+
+static inline uint16_t unpack_u16(const uint8_t *buf, size_t *off)
+{
+    uint16_t val;
+    memcpy(&val, &buf[*off], sizeof(val));
+    *off += sizeof(val);
+    return LE16_TO_HOST(val);
+}
+
+static inline uint32_t unpack_u32(const uint8_t *buf, size_t *off)
+{
+    uint32_t val;
+    memcpy(&val, &buf[*off], sizeof(val));
+    *off += sizeof(val);
+    return LE32_TO_HOST(val);
+}
+
+static inline uint64_t unpack_u64(const uint8_t *buf, size_t *off)
+{
+    uint64_t val;
+    memcpy(&val, &buf[*off], sizeof(val));
+    *off += sizeof(val);
+    return LE64_TO_HOST(val);
+}
+
+int hop_set_save(struct bladerf *dev,
+                 const char *filename,
+                 bladerf_channel ch,
+                 const bladerf_frequency *frequencies,
+                 const struct bladerf_quick_tune *quick_tunes,
+                 unsigned int n)
+{
+    struct bladerf_image *image;
+    const bool is_bladerf1 = (dev->board == &bladerf1_board_fns);
+    size_t off = 0;
+    unsigned int i;
+    int status;
+
+    if (n == 0 || n > HOP_SET_MAX_ENTRIES) {
+        log_debug("%s: Invalid number of hop set entries: %u\n",
+                  __FUNCTION__, n);
+        return BLADERF_ERR_INVAL;
+    }
+
+    image = bladerf_alloc_image(dev, BLADERF_IMAGE_TYPE_HOP_SET, 0xffffffff,
+                                HOP_SET_META_SIZE + n * HOP_SET_ENTRY_SIZE);
+    if (image == NULL) {
+        return BLADERF_ERR_MEM;
+    }
+
+    image->version = HOP_SET_VERSION;
+    memcpy(image->serial, dev->ident.serial, BLADERF_SERIAL_LENGTH);
+
+    pack_u32(image->data, &off, (uint32_t)ch);
+    pack_u32(image->data, &off, is_bladerf1 ? HOP_SET_FLAG_BLADERF1 : 0);
+    pack_u32(image->data, &off, n);
+
+    for (i = 0; i < n; i++) {
+        pack_u64(image->data, &off, frequencies[i]);
+
+        if (is_bladerf1) {
+            image->data[off++] = quick_tunes[i].freqsel;
+            image->data[off++] = quick_tunes[i].vcocap;
+            pack_u16(image->data, &off, quick_tunes[i].nint);
+            pack_u32(image->data, &off, quick_tunes[i].nfrac);
+            image->data[off++] = quick_tunes[i].flags;
+            image->data[off++] = quick_tunes[i].xb_gpio;
+        } else {
+            off += HOP_SET_ENTRY_SIZE - sizeof(uint64_t);
+        }
+    }
+
+    status = bladerf_image_write(dev, image, filename);
+    if (status != 0) {
+        log_debug("%s: Failed to write %s: %s\n", __FUNCTION__, filename,
+                  bladerf_strerror(status));
+    }
+
+    bladerf_free_image(image);
+    return status;
+}
+
+int hop_set_load(struct bladerf *dev,
+                 const char *filename,
+                 bladerf_channel ch,
+                 bladerf_frequency *frequencies,
+                 struct bladerf_quick_tune *quick_tunes,
+                 unsigned int max,
+                 unsigned int *n)
+{
+    struct bladerf_image *image;
+    uint32_t file_ch, flags, count;
+    bool reuse;
+    size_t off = 0;
+    unsigned int i;
+    int status;
+
+    image = bladerf_alloc_image(dev, BLADERF_IMAGE_TYPE_HOP_SET, 0xffffffff, 0);
+    if (image == NULL) {
+        return BLADERF_ERR_MEM;
+    }
+
+    status = bladerf_image_read(image, filename);
+    if (status != 0) {
+        log_debug("%s: Failed to read %s: %s\n", __FUNCTION__, filename,
+                  bladerf_strerror(status));
+        goto out;
+    }
+
+    if (image->type != BLADERF_IMAGE_TYPE_HOP_SET ||
+        image->version.major != HOP_SET_VERSION.major ||
+        image->length < HOP_SET_META_SIZE) {
+        log_debug("%s: %s is not a supported hop set file\n", __FUNCTION__,
+                  filename);
+        status = BLADERF_ERR_INVAL;
+        goto out;
+    }
+
+    file_ch = unpack_u32(image->data, &off);
+    flags   = unpack_u32(image->data, &off);
+    count   = unpack_u32(image->data, &off);
+
+    if (count > HOP_SET_MAX_ENTRIES ||
+        image->length != HOP_SET_META_SIZE + count * HOP_SET_ENTRY_SIZE) {
+        log_debug("%s: Hop set length does not match entry count (%u)\n",
+                  __FUNCTION__, count);
+        status = BLADERF_ERR_INVAL;
+        goto out;
+    }
+
+    if (file_ch != (uint32_t)ch) {
+        log_debug("%s: Hop set was built for channel %u, not %d\n",
+                  __FUNCTION__, file_ch, ch);
+        status = BLADERF_ERR_INVAL;
+        goto out;
+    }
+
+    *n = count;
+
+    if (frequencies == NULL && quick_tunes == NULL) {
+        goto out;
+    } else if (frequencies == NULL || quick_tunes == NULL || count > max) {
+        status = BLADERF_ERR_INVAL;
+        goto out;
+    }
+
+    /* bladeRF1 parameters are only reusable on the device that produced them,
+     * as the VCOCAP values are particular to its VCOs */
+    reuse = (dev->board == &bladerf1_board_fns) &&
+            (flags & HOP_SET_FLAG_BLADERF1) != 0 &&
+            strncmp(image->serial, dev->ident.serial,
+                    BLADERF_SERIAL_LENGTH) == 0;
+
+    for (i = 0; i < count; i++) {
+        frequencies[i] = unpack_u64(image->data, &off);
+
+        if (reuse) {
+            quick_tunes[i].freqsel = image->data[off++];
+            quick_tunes[i].vcocap  = image->data[off++];
+            quick_tunes[i].nint    = unpack_u16(image->data, &off);
+            quick_tunes[i].nfrac   = unpack_u32(image->data, &off);
+            quick_tunes[i].flags   = image->data[off++];
+            quick_tunes[i].xb_gpio = image->data[off++];
+
+            /* DC correction values are not stored. They are obtained from
+             * the DC calibration table loaded at the time of the retune. */
+            quick_tunes[i].flags  &= ~LMS_FREQ_FLAGS_DC_CORR;
+            quick_tunes[i].dc_i    = 0;
+            quick_tunes[i].dc_q    = 0;
+        } else {
+            off += HOP_SET_ENTRY_SIZE - sizeof(uint64_t);
+        }
+    }
+
+    if (!reuse) {
+        log_debug("%s: Rebuilding quick tune parameters for %s\n",
+                  __FUNCTION__, filename);
+
+        status = dev->board->build_hop_set(dev, ch, frequencies, count,
+                                           quick_tunes);
+    }
+
+out:
+    bladerf_free_image(image);
+    return status;
+}
@@ -0,0 +1,48 @@
+/*
+ * This file is part of the bladeRF project:
+ *   http://www.github.com/nuand/bladeRF
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef HOP_SET_H_
+#define HOP_SET_H_
+
+#include <libbladeRF.h>
+
+/**
+ * See bladerf_save_hop_set(). Expects dev->lock to be held.
+ */
+int hop_set_save(struct bladerf *dev,
+                 const char *filename,
+                 bladerf_channel ch,
+                 const bladerf_frequency *frequencies,
+                 const struct bladerf_quick_tune *quick_tunes,
+                 unsigned int n);
+
+/**
+ * See bladerf_load_hop_set(). Expects dev->lock to be held.
+ */
+int hop_set_load(struct bladerf *dev,
+                 const char *filename,
+                 bladerf_channel ch,
+                 bladerf_frequency *frequencies,
+                 struct bladerf_quick_tune *quick_tunes,
+                 unsigned int max,
+                 unsigned int *n);
+
+#endif
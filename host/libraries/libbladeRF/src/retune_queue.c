@@ -0,0 +1,399 @@
+/*
+ * This file is part of the bladeRF project:
+ *   http://www.github.com/nuand/bladeRF
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "log.h"
+#include "thread.h"
+
+#include "board/board.h"
+#include "helpers/timeout.h"
+#include "retune_queue.h"
+
+/* Number of submitted retune timestamps remembered per direction. This only
+ * needs to exceed the depth of the FPGA's retune queues. */
+#define RETUNE_INFLIGHT_MAX 256
+
+/* Bounds on how long the worker waits before retrying a full FPGA queue */
+#define RETUNE_RETRY_MIN_MS 1
+#define RETUNE_RETRY_MAX_MS 100
+
+/* A retune held on the host */
+struct retune_entry {
+    bladerf_channel ch;
+    bladerf_timestamp timestamp;
+    bladerf_frequency frequency;
+    bool has_quick_tune;
+    struct bladerf_quick_tune quick_tune;
+
+    struct retune_entry *next;
+};
+
+/* The FPGA keeps one retune queue per direction, shared by its channels */
+struct retune_dir {
+    struct retune_entry *head; /* Held retunes, FIFO order */
+    struct retune_entry *tail;
+
+    /* Timestamps of retunes most recently submitted to the FPGA. Once the
+     * sample clock passes one of these, the FPGA has room for another. */
+    bladerf_timestamp inflight[RETUNE_INFLIGHT_MAX];
+    unsigned int inflight_idx;
+    unsigned int inflight_count;
+
+    /* First error encountered while submitting a held retune */
+    int status;
+};
+
+struct retune_queue {
+    MUTEX lock;
+    pthread_cond_t pending; /* Signaled when retunes are held, and on
+                             * shutdown */
+
+    pthread_t thread;
+    bool thread_running;
+    bool shutdown;
+
+    struct retune_dir dir[2]; /* Indexed by bladerf_direction */
+};
+
+static inline struct retune_dir *get_dir(struct retune_queue *q,
+                                         bladerf_channel ch)
+{
+    return &q->dir[BLADERF_CHANNEL_IS_TX(ch) ? BLADERF_TX : BLADERF_RX];
+}
+
+static void discard_held(struct retune_dir *d)
+{
+    struct retune_entry *e;
+
+    while (d->head != NULL) {
+        e       = d->head;
+        d->head = e->next;
+        free(e);
+    }
+
+    d->tail = NULL;
+}
+
+static void inflight_add(struct retune_dir *d, bladerf_timestamp timestamp)
+{
+    d->inflight[d->inflight_idx] = timestamp;
+    d->inflight_idx = (d->inflight_idx + 1) % RETUNE_INFLIGHT_MAX;
+
+    if (d->inflight_count < RETUNE_INFLIGHT_MAX) {
+        d->inflight_count++;
+    }
+}
+
+static int submit(struct bladerf *dev,
+                  bladerf_channel ch,
+                  bladerf_timestamp timestamp,
+                  bladerf_frequency frequency,
+                  const struct bladerf_quick_tune *quick_tune)
+{
+    /* Boards take a non-const pointer, so hand them a copy */
+    struct bladerf_quick_tune qt;
+
+    if (quick_tune == NULL) {
+        return dev->board->schedule_retune(dev, ch, timestamp, frequency,
+                                           NULL);
+    }
+
+    qt = *quick_tune;
+    return dev->board->schedule_retune(dev, ch, timestamp, frequency, &qt);
+}
+
+/* Submit held retunes until the FPGA's queue fills up. Expects dev->lock and
+ * q->lock to be held.
+ *
+ * Returns the time to wait before trying again, in ms, or 0 if no retunes
+ * remain held. */
+static unsigned int top_up(struct bladerf *dev,
+                           struct retune_dir *d,
+                           bladerf_direction dir)
+{
+    struct retune_entry *e;
+    bladerf_timestamp now, next = UINT64_MAX;
+    bladerf_sample_rate rate;
+    unsigned int i;
+    uint64_t wait_ms;
+    int status;
+
+    while ((e = d->head) != NULL) {
+        status = submit(dev, e->ch, e->timestamp, e->frequency,
+                        e->has_quick_tune ? &e->quick_tune : NULL);
+
+        if (status == BLADERF_ERR_QUEUE_FULL) {
+            break;
+        }
+
+        d->head = e->next;
+        if (d->head == NULL) {
+            d->tail = NULL;
+        }
+
+        if (status == 0) {
+            inflight_add(d, e->timestamp);
+        } else {
+            log_debug("%s: Failed to submit retune at %" PRIu64 ": %s\n",
+                      __FUNCTION__, e->timestamp, bladerf_strerror(status));
+
+            if (d->status == 0) {
+                d->status = status;
+            }
+        }
+
+        free(e);
+    }
+
+    if (d->head == NULL) {
+        return 0;
+    }
+
+    /* The FPGA dequeues a retune once it has been performed, so the next
+     * opening is expected when the earliest pending timestamp passes */
+    if (dev->board->get_timestamp(dev, dir, &now) != 0 ||
+        dev->board->get_sample_rate(dev, d->head->ch, &rate) != 0 ||
+        rate == 0) {
+        return RETUNE_RETRY_MAX_MS;
+    }
+
+    for (i = 0; i < d->inflight_count; i++) {
+        if (d->inflight[i] > now && d->inflight[i] < next) {
+            next = d->inflight[i];
+        }
+    }
+
+    if (next == UINT64_MAX) {
+        /* Everything should have happened already; the FPGA just hasn't
+         * caught up */
+        return RETUNE_RETRY_MIN_MS;
+    } else if (next - now >= rate) {
+        return RETUNE_RETRY_MAX_MS;
+    }
+
+    wait_ms = (next - now) * 1000 / rate + 1;
+
+    if (wait_ms < RETUNE_RETRY_MIN_MS) {
+        wait_ms = RETUNE_RETRY_MIN_MS;
+    } else if (wait_ms > RETUNE_RETRY_MAX_MS) {
+        wait_ms = RETUNE_RETRY_MAX_MS;
+    }
+
+    return (unsigned int)wait_ms;
+}
+
+static void *retune_queue_task(void *arg)
+{
+    struct bladerf *dev    = arg;
+    struct retune_queue *q = dev->retune_queue;
+    struct timespec t_abs;
+    unsigned int wait_ms, dir_wait;
+    int dir;
+
+    MUTEX_LOCK(&q->lock);
+
+    while (!q->shutdown) {
+        if (q->dir[BLADERF_RX].head == NULL &&
+            q->dir[BLADERF_TX].head == NULL) {
+            pthread_cond_wait(&q->pending, &q->lock);
+            continue;
+        }
+
+        /* The device lock must always be acquired first */
+        MUTEX_UNLOCK(&q->lock);
+        MUTEX_LOCK(&dev->lock);
+        MUTEX_LOCK(&q->lock);
+
+        wait_ms = 0;
+
+        for (dir = BLADERF_RX; dir <= BLADERF_TX; dir++) {
+            dir_wait = top_up(dev, &q->dir[dir], (bladerf_direction)dir);
+
+            if (dir_wait != 0 && (wait_ms == 0 || dir_wait < wait_ms)) {
+                wait_ms = dir_wait;
+            }
+        }
+
+        MUTEX_UNLOCK(&dev->lock);
+
+        if (wait_ms != 0 && !q->shutdown &&
+            populate_abs_timeout(&t_abs, wait_ms) == 0) {
+            pthread_cond_timedwait(&q->pending, &q->lock, &t_abs);
+        }
+    }
+
+    MUTEX_UNLOCK(&q->lock);
+
+    return NULL;
+}
+
+int retune_queue_init(struct bladerf *dev)
+{
+    struct retune_queue *q;
+
+    q = calloc(1, sizeof(*q));
+    if (q == NULL) {
+        return BLADERF_ERR_MEM;
+    }
+
+    MUTEX_INIT(&q->lock);
+    pthread_cond_init(&q->pending, NULL);
+
+    dev->retune_queue = q;
+    return 0;
+}
+
+void retune_queue_deinit(struct bladerf *dev)
+{
+    struct retune_queue *q = dev->retune_queue;
+    int dir;
+
+    if (q == NULL) {
+        return;
+    }
+
+    MUTEX_LOCK(&q->lock);
+    q->shutdown = true;
+    pthread_cond_signal(&q->pending);
+    MUTEX_UNLOCK(&q->lock);
+
+    if (q->thread_running) {
+        pthread_join(q->thread, NULL);
+    }
+
+    for (dir = BLADERF_RX; dir <= BLADERF_TX; dir++) {
+        if (q->dir[dir].head != NULL) {
+            log_debug("%s: Discarding held %s retunes\n", __FUNCTION__,
+                      (dir == BLADERF_TX) ? "TX" : "RX");
+        }
+
+        discard_held(&q->dir[dir]);
+    }
+
+    pthread_cond_destroy(&q->pending);
+    MUTEX_DESTROY(&q->lock);
+
+    free(q);
+    dev->retune_queue = NULL;
+}
+
+int retune_queue_schedule(struct bladerf *dev,
+                          bladerf_channel ch,
+                          bladerf_timestamp timestamp,
+                          bladerf_frequency frequency,
+                          const struct bladerf_quick_tune *quick_tune)
+{
+    struct retune_queue *q = dev->retune_queue;
+    struct retune_dir *d   = get_dir(q, ch);
+    struct retune_entry *e;
+    int status;
+
+    /* Immediate retunes never wait in a queue */
+    if (timestamp == BLADERF_RETUNE_NOW) {
+        return submit(dev, ch, timestamp, frequency, quick_tune);
+    }
+
+    MUTEX_LOCK(&q->lock);
+
+    /* Report a failure to submit an earlier retune */
+    status    = d->status;
+    d->status = 0;
+    if (status != 0) {
+        goto out;
+    }
+
+    /* Retunes may not overtake those already held on the host */
+    if (d->head == NULL) {
+        status = submit(dev, ch, timestamp, frequency, quick_tune);
+
+        if (status == 0) {
+            inflight_add(d, timestamp);
+            goto out;
+        } else if (status != BLADERF_ERR_QUEUE_FULL) {
+            goto out;
+        }
+    }
+
+    if (!q->thread_running) {
+        status = pthread_create(&q->thread, NULL, retune_queue_task, dev);
+        if (status != 0) {
+            log_debug("%s: pthread_create failed: %s\n", __FUNCTION__,
+                      strerror(status));
+            status = BLADERF_ERR_UNEXPECTED;
+            goto out;
+        }
+
+        q->thread_running = true;
+    }
+
+    e = calloc(1, sizeof(*e));
+    if (e == NULL) {
+        status = BLADERF_ERR_MEM;
+        goto out;
+    }
+
+    e->ch        = ch;
+    e->timestamp = timestamp;
+    e->frequency = frequency;
+
+    if (quick_tune != NULL) {
+        e->has_quick_tune = true;
+        e->quick_tune     = *quick_tune;
+    }
+
+    if (d->tail == NULL) {
+        d->head = e;
+    } else {
+        d->tail->next = e;
+    }
+    d->tail = e;
+
+    pthread_cond_signal(&q->pending);
+    status = 0;
+
+out:
+    MUTEX_UNLOCK(&q->lock);
+
+    return status;
+}
+
+int retune_queue_cancel(struct bladerf *dev, bladerf_channel ch)
+{
+    struct retune_queue *q = dev->retune_queue;
+    struct retune_dir *d   = get_dir(q, ch);
+
+    /* The worker can't be submitting anything, as dev->lock is held */
+    MUTEX_LOCK(&q->lock);
+
+    discard_held(d);
+    d->inflight_count = 0;
+    d->inflight_idx   = 0;
+    d->status         = 0;
+
+    MUTEX_UNLOCK(&q->lock);
+
+    return dev->board->cancel_scheduled_retunes(dev, ch);
+}
@@ -0,0 +1,81 @@
+/*
+ * This file is part of the bladeRF project:
+ *   http://www.github.com/nuand/bladeRF
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef RETUNE_QUEUE_H_
+#define RETUNE_QUEUE_H_
+
+#include <libbladeRF.h>
+
+/* Per-device host queue of scheduled retunes, used to keep the FPGA's retune
+ * queues topped up. Opaque outside of retune_queue.c */
+struct retune_queue;
+
+/**
+ * Allocate a device's retune queue. The worker thread is not started until
+ * a retune must be held on the host.
+ *
+ * @param       dev         Device handle
+ *
+ * @return 0 on success, BLADERF_ERR_MEM on allocation failure
+ */
+int retune_queue_init(struct bladerf *dev);
+
+/**
+ * Stop the worker thread, discard any retunes held on the host, and free the
+ * queue.
+ *
+ * This must be called without holding dev->lock, as the worker thread
+ * acquires it to submit retunes.
+ *
+ * @param       dev         Device handle
+ */
+void retune_queue_deinit(struct bladerf *dev);
+
+/**
+ * Schedule a retune. Retunes are passed to the board directly, unless the
+ * FPGA's queue for the channel's direction is full or retunes are already
+ * held on the host for that direction. In these cases, the retune is
+ * appended to the host queue and submitted once the FPGA has room for it.
+ *
+ * Expects dev->lock to be held.
+ *
+ * See bladerf_schedule_retune()
+ *
+ * @return 0 on success, or the first error encountered while submitting a
+ *         previously held retune for the channel's direction
+ */
+int retune_queue_schedule(struct bladerf *dev,
+                          bladerf_channel ch,
+                          bladerf_timestamp timestamp,
+                          bladerf_frequency frequency,
+                          const struct bladerf_quick_tune *quick_tune);
+
+/**
+ * Discard the retunes held on the host for the channel's direction, and
+ * cancel those queued in the FPGA.
+ *
+ * Expects dev->lock to be held.
+ *
+ * See bladerf_cancel_scheduled_retunes()
+ */
+int retune_queue_cancel(struct bladerf *dev, bladerf_channel ch);
+
+#endif
@@ -21,6 +21,7 @@
 
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <errno.h>
 
 #include "log.h"
@@ -31,6 +32,7 @@
 #include "board/board.h"
 #include "helpers/timeout.h"
 #include "helpers/have_cap.h"
+#include "helpers/wallclock.h"
 
 int async_init_stream(struct bladerf_stream **stream,
                       struct bladerf *dev,
@@ -86,6 +88,9 @@ int async_init_stream(struct bladerf_stream **stream,
     lstream->cb = callback;
     lstream->user_data = user_data;
     lstream->buffers = NULL;
+    memset(&lstream->arena, 0, sizeof(lstream->arena));
+    memset(&lstream->stats, 0, sizeof(lstream->stats));
+    lstream->stats.num_buffers = (unsigned int)num_buffers;
 
     if (format == BLADERF_FORMAT_PACKET_META) {
         if (!have_cap_dev(dev, BLADERF_CAP_FW_SHORT_PACKET)) {
@@ -129,31 +134,32 @@ int async_init_stream(struct bladerf_stream **stream,
             break;
     }
 
+    /* All buffers are carved out of a single allocation, which allows a
+     * buffer's index to be determined from its address in constant time.
+     * See async_stream_buf_idx(). */
     if (!status) {
         lstream->buffers = calloc(num_buffers, sizeof(lstream->buffers[0]));
+
         if (lstream->buffers) {
-            for (i = 0; i < num_buffers && !status; i++) {
-                lstream->buffers[i] = calloc(1, buffer_size_bytes);
-                if (!lstream->buffers[i]) {
-                    status = BLADERF_ERR_MEM;
-                }
-            }
+            status = stream_mem_alloc(dev, &dev->stream_buf_config,
+                                      num_buffers * buffer_size_bytes,
+                                      &lstream->arena);
         } else {
             status = BLADERF_ERR_MEM;
         }
-    }
 
-    /* Clean up everything we've allocated if we hit any errors */
-    if (status) {
-
-        if (lstream->buffers) {
+        if (!status) {
             for (i = 0; i < num_buffers; i++) {
-                free(lstream->buffers[i]);
+                lstream->buffers[i] =
+                    (uint8_t *)lstream->arena.addr + (i * buffer_size_bytes);
             }
-
-            free(lstream->buffers);
         }
+    }
 
+    /* Clean up everything we've allocated if we hit any errors */
+    if (status) {
+        stream_mem_free(dev, &lstream->arena);
+        free(lstream->buffers);
         free(lstream);
     } else {
         /* Perform any backend-specific stream initialization */
@@ -195,6 +201,33 @@ int async_get_transfer_timeout(struct bladerf_stream *stream,
     return 0;
 }
 
+void async_record_transfer(struct bladerf_stream *stream,
+                           bool short_transfer,
+                           uint64_t cb_start_ns)
+{
+    const uint64_t now = wallclock_get_current_nsec();
+
+    stream->stats.buffers_transferred++;
+
+    if (short_transfer) {
+        stream->stats.short_transfers++;
+    }
+
+    /* The wallclock is not monotonic, so ignore any step backwards */
+    if (now > cb_start_ns &&
+        now - cb_start_ns > stream->stats.max_callback_latency_ns) {
+        stream->stats.max_callback_latency_ns = now - cb_start_ns;
+    }
+}
+
+void async_get_stats(struct bladerf_stream *stream,
+                     struct bladerf_stream_stats *stats)
+{
+    MUTEX_LOCK(&stream->lock);
+    *stats = stream->stats;
+    MUTEX_UNLOCK(&stream->lock);
+}
+
 int async_run_stream(struct bladerf_stream *stream, bladerf_channel_layout layout)
 {
     int status;
@@ -265,8 +298,6 @@ error:
 
 void async_deinit_stream(struct bladerf_stream *stream)
 {
-    size_t i;
-
     if (!stream) {
         log_debug("%s called with NULL stream\n", __FUNCTION__);
         return;
@@ -281,9 +312,7 @@ void async_deinit_stream(struct bladerf_stream *stream)
     stream->dev->backend->deinit_stream(stream);
 
     /* Free up the buffers */
-    for (i = 0; i < stream->num_buffers; i++) {
-        free(stream->buffers[i]);
-    }
+    stream_mem_free(stream->dev, &stream->arena);
 
     /* Free up the pointer to the buffers */
     free(stream->buffers);
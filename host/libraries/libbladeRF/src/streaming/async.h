@@ -29,6 +29,7 @@
 #include "thread.h"
 
 #include "format.h"
+#include "stream_mem.h"
 
 typedef enum {
     STREAM_IDLE,          /* Idle and initialized */
@@ -52,9 +53,16 @@ struct bladerf_stream {
     size_t samples_per_buffer;
     size_t num_buffers;
     void **buffers;
+    struct stream_mem arena; /* Contiguous allocation backing all of the
+                              * buffers. See stream_mem_alloc(). */
 
     MUTEX lock;
 
+    /* Only accessed while holding `lock`. The backend is responsible for
+     * the transfer-level counters (see async_record_transfer()), while the
+     * remainder are maintained by the sync interface. */
+    struct bladerf_stream_stats stats;
+
     /* The following items must be accessed atomically */
     int error_code;
     bladerf_stream_state state;
@@ -71,6 +79,28 @@ static inline size_t async_stream_buf_bytes(struct bladerf_stream *s)
     return samples_to_bytes(s->format, s->samples_per_buffer);
 }
 
+/* Get the index of a stream buffer from its address, in constant time.
+ * Returns s->num_buffers if the address is not that of one of the buffers. */
+static inline size_t async_stream_buf_idx(struct bladerf_stream *s,
+                                          const void *buf)
+{
+    const uint8_t *base   = (const uint8_t *)s->arena.addr;
+    const uint8_t *addr   = (const uint8_t *)buf;
+    const size_t buf_size = async_stream_buf_bytes(s);
+    size_t offset;
+
+    if (addr < base) {
+        return s->num_buffers;
+    }
+
+    offset = (size_t)(addr - base);
+    if (offset % buf_size != 0 || offset / buf_size >= s->num_buffers) {
+        return s->num_buffers;
+    }
+
+    return offset / buf_size;
+}
+
 int async_init_stream(struct bladerf_stream **stream,
                       struct bladerf *dev,
                       bladerf_stream_cb callback,
@@ -89,6 +119,17 @@ int async_set_transfer_timeout(struct bladerf_stream *stream,
 int async_get_transfer_timeout(struct bladerf_stream *stream,
                                unsigned int *transfer_timeout_ms);
 
+/* Record the completion of a transfer in stream->stats. `cb_start_ns` is the
+ * wallclock_get_current_nsec() value taken just prior to invoking the stream
+ * callback for this transfer. The caller must hold stream->lock. */
+void async_record_transfer(struct bladerf_stream *stream,
+                           bool short_transfer,
+                           uint64_t cb_start_ns);
+
+/* Get a snapshot of the stream's statistics. This acquires stream->lock. */
+void async_get_stats(struct bladerf_stream *stream,
+                     struct bladerf_stream_stats *stats);
+
 /* Backend code is responsible for acquiring stream->lock in their callbacks */
 int async_run_stream(struct bladerf_stream *stream,
                      bladerf_channel_layout layout);
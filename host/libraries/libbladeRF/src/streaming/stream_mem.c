@@ -0,0 +1,373 @@
+/*
+ * This file is part of the bladeRF project:
+ *   http://www.github.com/nuand/bladeRF
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/* Required for MAP_HUGETLB, MAP_ANONYMOUS and MADV_HUGEPAGE */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#   define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_config.h"
+#include "log.h"
+
+#include "backend/backend.h"
+#include "board/board.h"
+
+#include "stream_mem.h"
+
+#if !BLADERF_OS_WINDOWS
+#   define STREAM_MEM_HAVE_MMAP 1
+#   include <sys/mman.h>
+#   include <unistd.h>
+#else
+#   define STREAM_MEM_HAVE_MMAP 0
+#endif
+
+#if BLADERF_OS_LINUX
+#   include <linux/mempolicy.h>
+#   include <sys/syscall.h>
+#endif
+
+#define HUGEPAGE_SIZE (2 * 1024 * 1024)
+
+/* Largest NUMA node index accepted for BLADERF_STREAM_BUF_NUMA_NODE */
+#define NUMA_MAX_NODES 1024
+
+#define STREAM_BUF_ALL_FLAGS                                              \
+    (BLADERF_STREAM_BUF_NO_DEVICE_MEM | BLADERF_STREAM_BUF_HUGEPAGES |    \
+     BLADERF_STREAM_BUF_MLOCK | BLADERF_STREAM_BUF_PREFAULT |             \
+     BLADERF_STREAM_BUF_NUMA_NODE)
+
+/* Options that can only be satisfied by host memory we map ourselves */
+#define STREAM_BUF_HOST_FLAGS                                             \
+    (BLADERF_STREAM_BUF_HUGEPAGES | BLADERF_STREAM_BUF_NUMA_NODE)
+
+struct stream_mem_allocator {
+    const char *name;
+
+    /* Returns BLADERF_ERR_UNSUPPORTED to defer to the next allocator */
+    int (*alloc)(struct bladerf *dev,
+                 const struct bladerf_stream_buffer_config *config,
+                 size_t len,
+                 struct stream_mem *mem);
+
+    void (*free)(struct bladerf *dev, struct stream_mem *mem);
+};
+
+static size_t page_size(void)
+{
+#if STREAM_MEM_HAVE_MMAP
+    const long ret = sysconf(_SC_PAGESIZE);
+    if (ret > 0) {
+        return (size_t)ret;
+    }
+#endif
+    return 4096;
+}
+
+static void prefault(void *addr, size_t len)
+{
+    const size_t step = page_size();
+    volatile uint8_t *p = (volatile uint8_t *)addr;
+    size_t i;
+
+    for (i = 0; i < len; i += step) {
+        p[i] = 0;
+    }
+}
+
+/******************************************************************************
+ * Backend-provided memory (e.g., libusb_dev_mem_alloc())
+ *****************************************************************************/
+
+static int device_alloc(struct bladerf *dev,
+                        const struct bladerf_stream_buffer_config *config,
+                        size_t len,
+                        struct stream_mem *mem)
+{
+    void *addr;
+
+    if ((config->flags & BLADERF_STREAM_BUF_NO_DEVICE_MEM) ||
+        (config->flags & STREAM_BUF_HOST_FLAGS) ||
+        dev->backend->alloc_stream_mem == NULL) {
+        return BLADERF_ERR_UNSUPPORTED;
+    }
+
+    addr = dev->backend->alloc_stream_mem(dev, len);
+    if (addr == NULL) {
+        log_debug("Device memory unavailable for %llu byte stream arena. "
+                  "Falling back to host memory.\n", (unsigned long long)len);
+        return BLADERF_ERR_UNSUPPORTED;
+    }
+
+    /* This memory is already pinned by the kernel, so the MLOCK and
+     * PREFAULT options are inherently satisfied. */
+    memset(addr, 0, len);
+
+    mem->addr = addr;
+    mem->len  = len;
+    return 0;
+}
+
+static void device_free(struct bladerf *dev, struct stream_mem *mem)
+{
+    dev->backend->free_stream_mem(dev, mem->addr, mem->len);
+}
+
+/******************************************************************************
+ * Anonymous mappings
+ *****************************************************************************/
+
+#if STREAM_MEM_HAVE_MMAP
+#if BLADERF_OS_LINUX
+static int numa_bind(void *addr, size_t len, unsigned int node)
+{
+    const size_t bits = 8 * sizeof(unsigned long);
+    unsigned long nodemask[NUMA_MAX_NODES / (8 * sizeof(unsigned long))];
+    long ret;
+
+    memset(nodemask, 0, sizeof(nodemask));
+    nodemask[node / bits] = 1UL << (node % bits);
+
+    /* mbind(2) is invoked directly, to avoid depending upon libnuma. As is
+     * done there, maxnode is one greater than the number of bits in the
+     * mask. This must be called before the pages are first touched. */
+    ret = syscall(SYS_mbind, addr, len, MPOL_BIND, nodemask,
+                  (unsigned long)(NUMA_MAX_NODES + 1), 0);
+
+    if (ret != 0) {
+        log_debug("Failed to bind stream buffers to NUMA node %u: %s\n",
+                  node, strerror(errno));
+        return (errno == EPERM) ? BLADERF_ERR_PERMISSION : BLADERF_ERR_INVAL;
+    }
+
+    return 0;
+}
+#endif
+
+static int mapped_alloc(struct bladerf *dev,
+                        const struct bladerf_stream_buffer_config *config,
+                        size_t len,
+                        struct stream_mem *mem)
+{
+    const int prot  = PROT_READ | PROT_WRITE;
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    void *addr      = MAP_FAILED;
+    size_t map_len;
+    int status = 0;
+
+    if ((config->flags & ~BLADERF_STREAM_BUF_NO_DEVICE_MEM) == 0) {
+        /* Nothing requested that the heap cannot provide */
+        return BLADERF_ERR_UNSUPPORTED;
+    }
+
+    if (config->flags & BLADERF_STREAM_BUF_HUGEPAGES) {
+        map_len = (len + HUGEPAGE_SIZE - 1) & ~((size_t)HUGEPAGE_SIZE - 1);
+
+#if BLADERF_OS_LINUX
+        addr = mmap(NULL, map_len, prot, flags | MAP_HUGETLB, -1, 0);
+        if (addr == MAP_FAILED) {
+            log_debug("No reserved huge pages available (%s). Requesting "
+                      "transparent huge pages.\n", strerror(errno));
+
+            addr = mmap(NULL, map_len, prot, flags, -1, 0);
+            if (addr != MAP_FAILED &&
+                madvise(addr, map_len, MADV_HUGEPAGE) != 0) {
+                log_debug("madvise(MADV_HUGEPAGE) failed: %s\n",
+                          strerror(errno));
+            }
+        }
+#endif
+    } else {
+        const size_t pg = page_size();
+        map_len = (len + pg - 1) / pg * pg;
+        addr    = mmap(NULL, map_len, prot, flags, -1, 0);
+    }
+
+    if (addr == MAP_FAILED) {
+        log_debug("Failed to map %llu byte stream arena: %s\n",
+                  (unsigned long long)map_len, strerror(errno));
+        return BLADERF_ERR_MEM;
+    }
+
+#if BLADERF_OS_LINUX
+    if (config->flags & BLADERF_STREAM_BUF_NUMA_NODE) {
+        status = numa_bind(addr, map_len, config->numa_node);
+        if (status != 0) {
+            goto out;
+        }
+    }
+#endif
+
+    if (config->flags & BLADERF_STREAM_BUF_PREFAULT) {
+        prefault(addr, map_len);
+    }
+
+    if (config->flags & BLADERF_STREAM_BUF_MLOCK) {
+        if (mlock(addr, map_len) != 0) {
+            log_debug("Failed to lock %llu byte stream arena: %s\n",
+                      (unsigned long long)map_len, strerror(errno));
+            status = (errno == EPERM || errno == ENOMEM)
+                         ? BLADERF_ERR_PERMISSION
+                         : BLADERF_ERR_UNEXPECTED;
+            goto out;
+        }
+    }
+
+out:
+    if (status != 0) {
+        munmap(addr, map_len);
+    } else {
+        mem->addr = addr;
+        mem->len  = map_len;
+    }
+
+    return status;
+}
+
+static void mapped_free(struct bladerf *dev, struct stream_mem *mem)
+{
+    /* Unmapping also releases any mlock() */
+    munmap(mem->addr, mem->len);
+}
+#endif
+
+/******************************************************************************
+ * Heap
+ *****************************************************************************/
+
+static int heap_alloc(struct bladerf *dev,
+                      const struct bladerf_stream_buffer_config *config,
+                      size_t len,
+                      struct stream_mem *mem)
+{
+    if (config->flags & (STREAM_BUF_HOST_FLAGS | BLADERF_STREAM_BUF_MLOCK)) {
+        return BLADERF_ERR_UNSUPPORTED;
+    }
+
+    mem->addr = calloc(1, len);
+    if (mem->addr == NULL) {
+        return BLADERF_ERR_MEM;
+    }
+
+    if (config->flags & BLADERF_STREAM_BUF_PREFAULT) {
+        prefault(mem->addr, len);
+    }
+
+    mem->len = len;
+    return 0;
+}
+
+static void heap_free(struct bladerf *dev, struct stream_mem *mem)
+{
+    free(mem->addr);
+}
+
+/* Indexed by stream_mem_type, in order of preference */
+static const struct stream_mem_allocator allocators[] = {
+    { NULL, NULL, NULL },                   /* STREAM_MEM_NONE */
+    { "device", device_alloc, device_free }, /* STREAM_MEM_DEVICE */
+#if STREAM_MEM_HAVE_MMAP
+    { "mapped", mapped_alloc, mapped_free }, /* STREAM_MEM_MAPPED */
+#else
+    { NULL, NULL, NULL },                   /* STREAM_MEM_MAPPED */
+#endif
+    { "heap", heap_alloc, heap_free },       /* STREAM_MEM_HEAP */
+};
+
+int stream_mem_validate(const struct bladerf_stream_buffer_config *config)
+{
+    if (config->flags & ~STREAM_BUF_ALL_FLAGS) {
+        log_debug("Invalid stream buffer flags: 0x%08x\n", config->flags);
+        return BLADERF_ERR_INVAL;
+    }
+
+#if BLADERF_OS_LINUX
+    if ((config->flags & BLADERF_STREAM_BUF_NUMA_NODE) &&
+        config->numa_node >= NUMA_MAX_NODES) {
+        log_debug("Invalid NUMA node: %u\n", config->numa_node);
+        return BLADERF_ERR_INVAL;
+    }
+#else
+    if (config->flags & STREAM_BUF_HOST_FLAGS) {
+        log_debug("Huge pages and NUMA binding are not supported on this "
+                  "platform.\n");
+        return BLADERF_ERR_UNSUPPORTED;
+    }
+#endif
+
+#if !STREAM_MEM_HAVE_MMAP
+    if (config->flags & BLADERF_STREAM_BUF_MLOCK) {
+        log_debug("Locking stream buffers is not supported on this "
+                  "platform.\n");
+        return BLADERF_ERR_UNSUPPORTED;
+    }
+#endif
+
+    return 0;
+}
+
+int stream_mem_alloc(struct bladerf *dev,
+                     const struct bladerf_stream_buffer_config *config,
+                     size_t len,
+                     struct stream_mem *mem)
+{
+    int status;
+    size_t i;
+
+    memset(mem, 0, sizeof(*mem));
+
+    status = stream_mem_validate(config);
+    if (status != 0) {
+        return status;
+    }
+
+    for (i = 0; i < ARRAY_SIZE(allocators); i++) {
+        if (allocators[i].alloc == NULL) {
+            continue;
+        }
+
+        status = allocators[i].alloc(dev, config, len, mem);
+        if (status == 0) {
+            mem->type = (stream_mem_type)i;
+            log_verbose("Allocated %llu byte stream arena from %s memory.\n",
+                        (unsigned long long)mem->len, allocators[i].name);
+            return 0;
+        } else if (status != BLADERF_ERR_UNSUPPORTED) {
+            return status;
+        }
+    }
+
+    return BLADERF_ERR_UNSUPPORTED;
+}
+
+void stream_mem_free(struct bladerf *dev, struct stream_mem *mem)
+{
+    if (mem->type != STREAM_MEM_NONE && mem->addr != NULL) {
+        allocators[mem->type].free(dev, mem);
+    }
+
+    memset(mem, 0, sizeof(*mem));
+}
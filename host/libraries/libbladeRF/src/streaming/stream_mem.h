@@ -0,0 +1,80 @@
+/*
+ * This file is part of the bladeRF project:
+ *   http://www.github.com/nuand/bladeRF
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef STREAMING_STREAM_MEM_H_
+#define STREAMING_STREAM_MEM_H_
+
+#include <stddef.h>
+
+#include <libbladeRF.h>
+
+/* Source of a stream buffer arena */
+typedef enum {
+    STREAM_MEM_NONE = 0, /* Not allocated */
+    STREAM_MEM_DEVICE,   /* Provided by the backend for zero-copy DMA */
+    STREAM_MEM_MAPPED,   /* Anonymous mapping, with any requested
+                          * huge page, NUMA and locking options applied */
+    STREAM_MEM_HEAP,     /* Ordinary heap allocation */
+} stream_mem_type;
+
+struct stream_mem {
+    stream_mem_type type;
+    void *addr;
+    size_t len; /* Length of the allocation, which may exceed the length
+                 * requested, e.g., when rounded up to a huge page. */
+};
+
+/**
+ * Check that the requested buffer options are valid and supported on this
+ * platform.
+ *
+ * @return 0 on success, BLADERF_ERR_INVAL for unknown flags, or
+ *         BLADERF_ERR_UNSUPPORTED
+ */
+int stream_mem_validate(const struct bladerf_stream_buffer_config *config);
+
+/**
+ * Allocate zeroed memory for stream buffers.
+ *
+ * Each of the available allocators is tried in order of preference. An
+ * allocator that is unable to satisfy the requested options defers to the
+ * next, while an allocator that fails after accepting the request fails the
+ * allocation outright.
+ *
+ * @param       dev     Device handle
+ * @param[in]   config  Buffer options
+ * @param[in]   len     Required length, in bytes
+ * @param[out]  mem     Updated to describe the allocation
+ *
+ * @return 0 on success, BLADERF_ERR_* on failure
+ */
+int stream_mem_alloc(struct bladerf *dev,
+                     const struct bladerf_stream_buffer_config *config,
+                     size_t len,
+                     struct stream_mem *mem);
+
+/**
+ * Free memory allocated by stream_mem_alloc(). This is a no-op if `mem` does
+ * not describe an allocation.
+ */
+void stream_mem_free(struct bladerf *dev, struct stream_mem *mem);
+
+#endif
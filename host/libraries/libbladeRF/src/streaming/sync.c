@@ -39,6 +39,8 @@
 #include "board/board.h"
 #include "helpers/timeout.h"
 #include "helpers/have_cap.h"
+#include "helpers/atomic.h"
+#include "helpers/thread_sched.h"
 
 #ifdef ENABLE_LIBBLADERF_SYNC_LOG_VERBOSE
 static inline void dump_buf_states(struct bladerf_sync *s)
@@ -207,6 +209,8 @@ int sync_init(struct bladerf_sync *sync,
 
     sync->dev = dev;
     sync->state = SYNC_STATE_CHECK_WORKER;
+    sync->acquired = false;
+    sync->acquired_len = 0;
 
     sync->buf_mgmt.num_buffers = num_buffers;
     sync->buf_mgmt.resubmit_count = 0;
@@ -237,7 +241,11 @@ int sync_init(struct bladerf_sync *sync,
                 __FUNCTION__, sync->meta.samples_per_msg);
 
     MUTEX_INIT(&sync->buf_mgmt.lock);
-    pthread_cond_init(&sync->buf_mgmt.buf_ready, NULL);
+
+    status = sync_event_init(&sync->buf_mgmt.buf_ready);
+    if (status != 0) {
+        goto error;
+    }
 
     sync->buf_mgmt.status = (sync_buffer_status*) malloc(num_buffers * sizeof(sync_buffer_status));
     if (sync->buf_mgmt.status == NULL) {
@@ -258,6 +266,7 @@ int sync_init(struct bladerf_sync *sync,
             sync->buf_mgmt.prod_i = num_transfers;
             sync->buf_mgmt.cons_i = 0;
             sync->buf_mgmt.partial_off = 0;
+            sync->buf_mgmt.num_queued = 0;
 
             for (i = 0; i < num_buffers; i++) {
                 if (i < num_transfers) {
@@ -269,6 +278,7 @@ int sync_init(struct bladerf_sync *sync,
 
             sync->meta.msg_timestamp = 0;
             sync->meta.msg_flags = 0;
+            sync->meta.curr_timestamp_valid = false;
 
             break;
 
@@ -276,6 +286,7 @@ int sync_init(struct bladerf_sync *sync,
             sync->buf_mgmt.prod_i = 0;
             sync->buf_mgmt.cons_i = BUFFER_MGMT_INVALID_INDEX;
             sync->buf_mgmt.partial_off = 0;
+            sync->buf_mgmt.num_queued = 0;
 
             for (i = 0; i < num_buffers; i++) {
                 sync->buf_mgmt.status[i] = SYNC_BUFFER_EMPTY;
@@ -294,6 +305,13 @@ int sync_init(struct bladerf_sync *sync,
 
     sync->initialized = true;
 
+    status = thread_sched_apply(sync->worker->thread, &sync->thread_config);
+    if (status != 0) {
+        log_debug("%s: Failed to apply worker thread config: %s\n",
+                  __FUNCTION__, bladerf_strerror(status));
+        goto error;
+    }
+
     return 0;
 
 error:
@@ -309,14 +327,14 @@ void sync_deinit(struct bladerf_sync *sync)
                                        BLADERF_STREAM_SHUTDOWN, NULL, 0, false);
         }
 
-        sync_worker_deinit(sync->worker, &sync->buf_mgmt.lock,
-                           &sync->buf_mgmt.buf_ready);
+        sync_worker_deinit(sync->worker, &sync->buf_mgmt.buf_ready);
 
         if (sync->buf_mgmt.actual_lengths) {
             free(sync->buf_mgmt.actual_lengths);
         }
         /* De-allocate our buffer management resources */
         if (sync->buf_mgmt.status) {
+            sync_event_deinit(&sync->buf_mgmt.buf_ready);
             MUTEX_DESTROY(&sync->buf_mgmt.lock);
             free(sync->buf_mgmt.status);
         }
@@ -327,33 +345,35 @@ void sync_deinit(struct bladerf_sync *sync)
     }
 }
 
+/* sync_event_wait() predicates for the RX consumer and TX producer */
+static bool rx_buffer_full(void *arg)
+{
+    struct buffer_mgmt *b = (struct buffer_mgmt *)arg;
+    return ATOMIC_LOAD_ACQUIRE(&b->status[b->cons_i]) == SYNC_BUFFER_FULL;
+}
+
+static bool tx_buffer_empty(void *arg)
+{
+    struct buffer_mgmt *b = (struct buffer_mgmt *)arg;
+    return ATOMIC_LOAD_ACQUIRE(&b->status[b->prod_i]) == SYNC_BUFFER_EMPTY;
+}
+
 static int wait_for_buffer(struct buffer_mgmt *b,
+                           sync_event_ready_fn ready,
                            unsigned int timeout_ms,
                            const char *dbg_name,
                            unsigned int dbg_idx)
 {
     int status;
-    struct timespec timeout;
 
-    if (timeout_ms == 0) {
-        log_verbose("%s: Infinite wait for buffer[%d] (status: %d).\n",
-                    dbg_name, dbg_idx, b->status[dbg_idx]);
-        status = pthread_cond_wait(&b->buf_ready, &b->lock);
-    } else {
-        log_verbose("%s: Timed wait for buffer[%d] (status: %d).\n", dbg_name,
-                    dbg_idx, b->status[dbg_idx]);
-        status = populate_abs_timeout(&timeout, timeout_ms);
-        if (status == 0) {
-            status = pthread_cond_timedwait(&b->buf_ready, &b->lock, &timeout);
-        }
-    }
+    log_verbose("%s: %s wait for buffer[%d] (status: %d).\n", dbg_name,
+                timeout_ms == 0 ? "Infinite" : "Timed", dbg_idx,
+                b->status[dbg_idx]);
 
-    if (status == ETIMEDOUT) {
+    status = sync_event_wait(&b->buf_ready, ready, b, timeout_ms);
+    if (status == BLADERF_ERR_TIMEOUT) {
         log_error("%s: Timed out waiting for buf_ready after %d ms\n",
                   __FUNCTION__, timeout_ms);
-        status = BLADERF_ERR_TIMEOUT;
-    } else if (status != 0) {
-        status = BLADERF_ERR_UNEXPECTED;
     }
 
     return status;
@@ -385,8 +405,8 @@ static inline void advance_rx_buffer(struct buffer_mgmt *b)
 {
     log_verbose("%s: Marking buf[%u] empty.\n", __FUNCTION__, b->cons_i);
 
-    b->status[b->cons_i] = SYNC_BUFFER_EMPTY;
-    b->cons_i = (b->cons_i + 1) % b->num_buffers;
+    ATOMIC_STORE_RELEASE(&b->status[b->cons_i], SYNC_BUFFER_EMPTY);
+    ATOMIC_STORE_RELEASE(&b->cons_i, (b->cons_i + 1) % b->num_buffers);
 }
 
 static inline unsigned int timestamp_to_msg(struct bladerf_sync *s, uint64_t t)
@@ -396,6 +416,160 @@ static inline unsigned int timestamp_to_msg(struct bladerf_sync *s, uint64_t t)
     return (unsigned int) m;
 }
 
+/* Perform one step of the RX buffer management state machine, which starts the
+ * worker as needed and waits for a full buffer to become available. Once this
+ * is complete, the sync handle will be in one of the SYNC_STATE_USING_*
+ * states. */
+static int rx_buffer_mgmt_step(struct bladerf_sync *s, unsigned int timeout_ms)
+{
+    struct buffer_mgmt *b = &s->buf_mgmt;
+    int status = 0;
+
+    switch (s->state) {
+        case SYNC_STATE_CHECK_WORKER: {
+            int stream_error;
+            sync_worker_state worker_state =
+                sync_worker_get_state(s->worker, &stream_error);
+
+            /* Propagate stream error back to the caller.
+             * They can call this function again to restart the stream and
+             * try again.
+             */
+            if (stream_error != 0) {
+                status = stream_error;
+            } else {
+                if (worker_state == SYNC_WORKER_STATE_IDLE) {
+                    log_debug("%s: Worker is idle. Going to reset buf "
+                              "mgmt.\n", __FUNCTION__);
+                    s->state = SYNC_STATE_RESET_BUF_MGMT;
+                } else if (worker_state == SYNC_WORKER_STATE_RUNNING) {
+                    s->state = SYNC_STATE_WAIT_FOR_BUFFER;
+                } else {
+                    status = BLADERF_ERR_UNEXPECTED;
+                    log_debug("%s: Unexpected worker state=%d\n",
+                            __FUNCTION__, worker_state);
+                }
+            }
+
+            break;
+        }
+
+        case SYNC_STATE_RESET_BUF_MGMT:
+            MUTEX_LOCK(&b->lock);
+            /* When the RX stream starts up, it will submit the first T
+             * transfers, so the consumer index must be reset to 0 */
+            ATOMIC_STORE_RELEASE(&b->cons_i, 0);
+            MUTEX_UNLOCK(&b->lock);
+            s->meta.curr_timestamp_valid = false;
+            log_debug("%s: Reset buf_mgmt consumer index\n", __FUNCTION__);
+            s->state = SYNC_STATE_START_WORKER;
+            break;
+
+
+        case SYNC_STATE_START_WORKER:
+            sync_worker_submit_request(s->worker, SYNC_WORKER_START);
+
+            status = sync_worker_wait_for_state(
+                                            s->worker,
+                                            SYNC_WORKER_STATE_RUNNING,
+                                            SYNC_WORKER_START_TIMEOUT_MS);
+
+            if (status == 0) {
+                s->state = SYNC_STATE_WAIT_FOR_BUFFER;
+                log_debug("%s: Worker is now running.\n", __FUNCTION__);
+            } else {
+                log_debug("%s: Failed to start worker, (%d)\n",
+                          __FUNCTION__, status);
+            }
+            break;
+
+        case SYNC_STATE_WAIT_FOR_BUFFER:
+            /* Check the buffer state, as the worker may have produced one
+             * since we last queried the status */
+            if (rx_buffer_full(b)) {
+                s->state = SYNC_STATE_BUFFER_READY;
+                log_verbose("%s: buffer %u is ready to consume\n",
+                            __FUNCTION__, b->cons_i);
+            } else {
+                status = wait_for_buffer(b, rx_buffer_full, timeout_ms,
+                                         __FUNCTION__, b->cons_i);
+
+                if (status == 0) {
+                    if (!rx_buffer_full(b)) {
+                        s->state = SYNC_STATE_CHECK_WORKER;
+                    } else {
+                        s->state = SYNC_STATE_BUFFER_READY;
+                        log_verbose("%s: buffer %u is ready to consume\n",
+                                    __FUNCTION__, b->cons_i);
+                    }
+                }
+            }
+
+            break;
+
+        case SYNC_STATE_BUFFER_READY:
+            ATOMIC_STORE_RELEASE(&b->status[b->cons_i], SYNC_BUFFER_PARTIAL);
+            b->partial_off = 0;
+
+            switch (s->stream_config.format) {
+                case BLADERF_FORMAT_SC16_Q11:
+                case BLADERF_FORMAT_SC8_Q7:
+                    s->state = SYNC_STATE_USING_BUFFER;
+                    break;
+
+                case BLADERF_FORMAT_SC16_Q11_META:
+                case BLADERF_FORMAT_SC8_Q7_META:
+                    s->state = SYNC_STATE_USING_BUFFER_META;
+                    s->meta.curr_msg_off = 0;
+                    s->meta.msg_num = 0;
+                    break;
+
+                case BLADERF_FORMAT_PACKET_META:
+                    s->state = SYNC_STATE_USING_PACKET_META;
+                    break;
+
+                default:
+                    assert(!"Invalid stream format");
+                    status = BLADERF_ERR_UNEXPECTED;
+            }
+
+            break;
+
+        default:
+            assert(!"Invalid state");
+            status = BLADERF_ERR_UNEXPECTED;
+    }
+
+    return status;
+}
+
+/* Checks the timestamp of a newly read message header against the one that
+ * follows the samples already returned. A mismatch means samples were dropped,
+ * which is reported to the caller as an overrun and counted in the stream
+ * statistics. Returns true if a discontinuity was found. */
+static bool rx_timestamp_discontinuity(struct bladerf_sync *s,
+                                       struct bladerf_metadata *user_meta)
+{
+    if (s->meta.msg_timestamp == s->meta.curr_timestamp) {
+        return false;
+    }
+
+    user_meta->status |= BLADERF_META_STATUS_OVERRUN;
+
+    MUTEX_LOCK(&s->worker->stream->lock);
+    s->worker->stream->stats.timestamp_discontinuities++;
+    MUTEX_UNLOCK(&s->worker->stream->lock);
+
+    log_debug("Sample discontinuity detected @ "
+              "buffer %u, message %u: Expected t=%llu, "
+              "got t=%llu\n",
+              s->buf_mgmt.cons_i, s->meta.msg_num,
+              (unsigned long long)s->meta.curr_timestamp,
+              (unsigned long long)s->meta.msg_timestamp);
+
+    return true;
+}
+
 int sync_rx(struct bladerf_sync *s, void *samples, unsigned num_samples,
             struct bladerf_metadata *user_meta, unsigned int timeout_ms)
 {
@@ -427,6 +601,13 @@ int sync_rx(struct bladerf_sync *s, void *samples, unsigned num_samples,
 
     MUTEX_LOCK(&s->lock);
 
+    if (s->acquired) {
+        log_debug("%s: Acquired samples have not been released.\n",
+                  __FUNCTION__);
+        status = BLADERF_ERR_INVAL;
+        goto out;
+    }
+
     if (s->stream_config.format == BLADERF_FORMAT_SC16_Q11_META ||
           s->stream_config.format == BLADERF_FORMAT_SC8_Q7_META ||
           s->stream_config.format == BLADERF_FORMAT_PACKET_META) {
@@ -449,122 +630,15 @@ int sync_rx(struct bladerf_sync *s, void *samples, unsigned num_samples,
         dump_buf_states(s);
 
         switch (s->state) {
-            case SYNC_STATE_CHECK_WORKER: {
-                int stream_error;
-                sync_worker_state worker_state =
-                    sync_worker_get_state(s->worker, &stream_error);
-
-                /* Propagate stream error back to the caller.
-                 * They can call this function again to restart the stream and
-                 * try again.
-                 */
-                if (stream_error != 0) {
-                    status = stream_error;
-                } else {
-                    if (worker_state == SYNC_WORKER_STATE_IDLE) {
-                        log_debug("%s: Worker is idle. Going to reset buf "
-                                  "mgmt.\n", __FUNCTION__);
-                        s->state = SYNC_STATE_RESET_BUF_MGMT;
-                    } else if (worker_state == SYNC_WORKER_STATE_RUNNING) {
-                        s->state = SYNC_STATE_WAIT_FOR_BUFFER;
-                    } else {
-                        status = BLADERF_ERR_UNEXPECTED;
-                        log_debug("%s: Unexpected worker state=%d\n",
-                                __FUNCTION__, worker_state);
-                    }
-                }
-
-                break;
-            }
-
+            case SYNC_STATE_CHECK_WORKER:
             case SYNC_STATE_RESET_BUF_MGMT:
-                MUTEX_LOCK(&b->lock);
-                /* When the RX stream starts up, it will submit the first T
-                 * transfers, so the consumer index must be reset to 0 */
-                b->cons_i = 0;
-                MUTEX_UNLOCK(&b->lock);
-                log_debug("%s: Reset buf_mgmt consumer index\n", __FUNCTION__);
-                s->state = SYNC_STATE_START_WORKER;
-                break;
-
-
             case SYNC_STATE_START_WORKER:
-                sync_worker_submit_request(s->worker, SYNC_WORKER_START);
-
-                status = sync_worker_wait_for_state(
-                                                s->worker,
-                                                SYNC_WORKER_STATE_RUNNING,
-                                                SYNC_WORKER_START_TIMEOUT_MS);
-
-                if (status == 0) {
-                    s->state = SYNC_STATE_WAIT_FOR_BUFFER;
-                    log_debug("%s: Worker is now running.\n", __FUNCTION__);
-                } else {
-                    log_debug("%s: Failed to start worker, (%d)\n",
-                              __FUNCTION__, status);
-                }
-                break;
-
             case SYNC_STATE_WAIT_FOR_BUFFER:
-                MUTEX_LOCK(&b->lock);
-
-                /* Check the buffer state, as the worker may have produced one
-                 * since we last queried the status */
-                if (b->status[b->cons_i] == SYNC_BUFFER_FULL) {
-                    s->state = SYNC_STATE_BUFFER_READY;
-                    log_verbose("%s: buffer %u is ready to consume\n",
-                                __FUNCTION__, b->cons_i);
-                } else {
-                    status = wait_for_buffer(b, timeout_ms,
-                                             __FUNCTION__, b->cons_i);
-
-                    if (status == 0) {
-                        if (b->status[b->cons_i] != SYNC_BUFFER_FULL) {
-                            s->state = SYNC_STATE_CHECK_WORKER;
-                        } else {
-                            s->state = SYNC_STATE_BUFFER_READY;
-                            log_verbose("%s: buffer %u is ready to consume\n",
-                                        __FUNCTION__, b->cons_i);
-                        }
-                    }
-                }
-
-                MUTEX_UNLOCK(&b->lock);
-                break;
-
             case SYNC_STATE_BUFFER_READY:
-                MUTEX_LOCK(&b->lock);
-                b->status[b->cons_i] = SYNC_BUFFER_PARTIAL;
-                b->partial_off = 0;
-
-                switch (s->stream_config.format) {
-                    case BLADERF_FORMAT_SC16_Q11:
-                    case BLADERF_FORMAT_SC8_Q7:
-                        s->state = SYNC_STATE_USING_BUFFER;
-                        break;
-
-                    case BLADERF_FORMAT_SC16_Q11_META:
-                    case BLADERF_FORMAT_SC8_Q7_META:
-                        s->state = SYNC_STATE_USING_BUFFER_META;
-                        s->meta.curr_msg_off = 0;
-                        s->meta.msg_num = 0;
-                        break;
-
-                    case BLADERF_FORMAT_PACKET_META:
-                        s->state = SYNC_STATE_USING_PACKET_META;
-                        break;
-
-                    default:
-                        assert(!"Invalid stream format");
-                        status = BLADERF_ERR_UNEXPECTED;
-                }
-
-                MUTEX_UNLOCK(&b->lock);
+                status = rx_buffer_mgmt_step(s, timeout_ms);
                 break;
 
             case SYNC_STATE_USING_BUFFER: /* SC16Q11 buffers w/o metadata */
-                MUTEX_LOCK(&b->lock);
-
                 buf_src = (uint8_t*)b->buffers[b->cons_i];
 
                 samples_to_copy = uint_min(num_samples - samples_returned,
@@ -591,13 +665,10 @@ int sync_rx(struct bladerf_sync *s, void *samples, unsigned num_samples,
                     s->state = SYNC_STATE_WAIT_FOR_BUFFER;
                 }
 
-                MUTEX_UNLOCK(&b->lock);
                 break;
 
 
             case SYNC_STATE_USING_BUFFER_META: /* SC16Q11 buffers w/ metadata */
-                MUTEX_LOCK(&b->lock);
-
                 switch (s->meta.state) {
                     case SYNC_META_STATE_HEADER:
 
@@ -624,17 +695,8 @@ int sync_rx(struct bladerf_sync *s, void *samples, unsigned num_samples,
                         /* We've encountered a discontinuity and need to return
                          * what we have so far, setting the status flags */
                         if (copied_data &&
-                            s->meta.msg_timestamp != s->meta.curr_timestamp) {
-
-                            user_meta->status |= BLADERF_META_STATUS_OVERRUN;
+                            rx_timestamp_discontinuity(s, user_meta)) {
                             exit_early = true;
-                            log_debug("Sample discontinuity detected @ "
-                                      "buffer %u, message %u: Expected t=%llu, "
-                                      "got t=%llu\n",
-                                      b->cons_i, s->meta.msg_num,
-                                      (unsigned long long)s->meta.curr_timestamp,
-                                      (unsigned long long)s->meta.msg_timestamp);
-
                         } else {
                             log_verbose("Got header for message %u: "
                                         "t_new=%u, t_old=%u\n",
@@ -758,12 +820,9 @@ int sync_rx(struct bladerf_sync *s, void *samples, unsigned num_samples,
                         status = BLADERF_ERR_UNEXPECTED;
                 }
 
-                MUTEX_UNLOCK(&b->lock);
                 break;
 
             case SYNC_STATE_USING_PACKET_META: /* Packet buffers w/ metadata */
-                MUTEX_LOCK(&b->lock);
-
                 buf_src = (uint8_t*)b->buffers[b->cons_i];
 
                 pkt_len_dwords = metadata_get_packet_len(buf_src);
@@ -776,7 +835,6 @@ int sync_rx(struct bladerf_sync *s, void *samples, unsigned num_samples,
 
                 advance_rx_buffer(b);
                 s->state = SYNC_STATE_WAIT_FOR_BUFFER;
-                MUTEX_UNLOCK(&b->lock);
                 break;
 
 
@@ -787,23 +845,36 @@ int sync_rx(struct bladerf_sync *s, void *samples, unsigned num_samples,
         user_meta->actual_count = samples_returned;
     }
 
+    /* Once samples have been copied, the current timestamp tracks the next
+     * sample, rather than a seek target */
+    s->meta.curr_timestamp_valid = copied_data;
+
 out:
     MUTEX_UNLOCK(&s->lock);
 
     return status;
 }
 
-/* Assumes buffer lock is held */
+/* Hands the buffer at the producer index off for transmission and advances
+ * to the next one. The buffer lock is only held while deciding who submits the
+ * buffer, as this races with the TX callback taking over (or giving up) that
+ * duty. */
 static int advance_tx_buffer(struct bladerf_sync *s, struct buffer_mgmt *b)
 {
     int status = 0;
     const unsigned int idx = b->prod_i;
 
+    /* This must be accounted for before the callback can possibly see the
+     * buffer complete */
+    ATOMIC_FETCH_ADD(&b->num_queued, 1);
+
+    MUTEX_LOCK(&b->lock);
+
     if (b->submitter == SYNC_TX_SUBMITTER_FN) {
         /* Mark buffer in flight because we're going to send it out.
          * This ensures that if the callback fires before this function
          * completes, its state will be correct. */
-        b->status[idx] = SYNC_BUFFER_IN_FLIGHT;
+        ATOMIC_STORE_RELEASE(&b->status[idx], SYNC_BUFFER_IN_FLIGHT);
 
         /* This call may block and it results in a per-stream lock being held,
          * so the buffer lock must be dropped.
@@ -834,12 +905,12 @@ static int advance_tx_buffer(struct bladerf_sync *s, struct buffer_mgmt *b)
                         __FUNCTION__, idx);
 
             /* Mark this buffer as being full of data, but not in flight */
-            b->status[idx] = SYNC_BUFFER_FULL;
+            ATOMIC_STORE_RELEASE(&b->status[idx], SYNC_BUFFER_FULL);
 
             /* Assign callback the duty of submitting deferred buffers,
              * and use buffer_mgmt.cons_i to denote which it should submit
              * (i.e., consume). */
-            b->submitter = SYNC_TX_SUBMITTER_CALLBACK;
+            ATOMIC_STORE_RELEASE(&b->submitter, SYNC_TX_SUBMITTER_CALLBACK);
             b->cons_i = idx;
 
             /* This is expected and we are handling it. Don't propagate this
@@ -847,23 +918,29 @@ static int advance_tx_buffer(struct bladerf_sync *s, struct buffer_mgmt *b)
             status = 0;
         } else {
             /* Unmark this as being in flight */
-            b->status[idx] = SYNC_BUFFER_FULL;
+            ATOMIC_STORE_RELEASE(&b->status[idx], SYNC_BUFFER_FULL);
+
+            /* No callback will complete this buffer */
+            ATOMIC_FETCH_SUB(&b->num_queued, 1);
 
             log_debug("%s: Failed to submit buf[%u].\n", __FUNCTION__, idx);
+            MUTEX_UNLOCK(&b->lock);
             return status;
        }
     } else {
         /* We are not submitting this buffer; this is deffered to the worker
          * call back. Just update its state to being full of samples. */
-        b->status[idx] = SYNC_BUFFER_FULL;
+        ATOMIC_STORE_RELEASE(&b->status[idx], SYNC_BUFFER_FULL);
     }
 
+    MUTEX_UNLOCK(&b->lock);
+
     /* Advance "producer" insertion index. */
     b->prod_i = (idx + 1) % b->num_buffers;
 
     /* Determine our next state based upon the state of the next buffer we
      * want to use. */
-    if (b->status[b->prod_i] == SYNC_BUFFER_EMPTY) {
+    if (tx_buffer_empty(b)) {
         /* Buffer is empty and ready for use */
         s->state = SYNC_STATE_BUFFER_READY;
     } else {
@@ -875,6 +952,29 @@ static int advance_tx_buffer(struct bladerf_sync *s, struct buffer_mgmt *b)
     return status;
 }
 
+static void tx_write_msg_header(struct bladerf_sync *s, struct buffer_mgmt *b)
+{
+    uint8_t *buf_dest = (uint8_t *)b->buffers[b->prod_i];
+
+    s->meta.curr_msg = buf_dest + s->meta.msg_size * s->meta.msg_num;
+
+    log_verbose("%s: Set curr_msg to: %p (buf @ %p)\n",
+                __FUNCTION__, s->meta.curr_msg, buf_dest);
+
+    s->meta.curr_msg_off = 0;
+
+    if (s->meta.now) {
+        metadata_set(s->meta.curr_msg, 0, 0);
+    } else {
+        metadata_set(s->meta.curr_msg, s->meta.curr_timestamp, 0);
+    }
+
+    s->meta.state = SYNC_META_STATE_SAMPLES;
+
+    log_verbose("%s: Filled in header (t=%llu)\n", __FUNCTION__,
+                (unsigned long long)s->meta.curr_timestamp);
+}
+
 static inline bool timestamp_in_past(struct bladerf_metadata *user_meta,
                                      struct bladerf_sync *s)
 {
@@ -956,6 +1056,106 @@ static inline int handle_tx_parameters(struct bladerf_metadata *user_meta,
     return 0;
 }
 
+/* Perform one step of the TX buffer management state machine, which starts the
+ * worker as needed and waits for an empty buffer to become available. Once
+ * this is complete, the sync handle will be in one of the SYNC_STATE_USING_*
+ * states. */
+static int tx_buffer_mgmt_step(struct bladerf_sync *s, unsigned int timeout_ms)
+{
+    struct buffer_mgmt *b = &s->buf_mgmt;
+    int status = 0;
+
+    switch (s->state) {
+        case SYNC_STATE_CHECK_WORKER: {
+            int stream_error;
+            sync_worker_state worker_state =
+                sync_worker_get_state(s->worker, &stream_error);
+
+            if (stream_error != 0) {
+                status = stream_error;
+            } else {
+                if (worker_state == SYNC_WORKER_STATE_IDLE) {
+                    /* No need to reset any buffer management for TX since
+                     * the TX stream does not submit an initial set of
+                     * buffers.  Therefore the RESET_BUF_MGMT state is
+                     * skipped here. */
+                    s->state = SYNC_STATE_START_WORKER;
+                } else {
+                    /* Worker is running - continue onto checking for and
+                     * potentially waiting for an available buffer */
+                    s->state = SYNC_STATE_WAIT_FOR_BUFFER;
+                }
+            }
+            break;
+        }
+
+        case SYNC_STATE_RESET_BUF_MGMT:
+            assert(!"Bug");
+            break;
+
+        case SYNC_STATE_START_WORKER:
+            sync_worker_submit_request(s->worker, SYNC_WORKER_START);
+
+            status = sync_worker_wait_for_state(
+                s->worker, SYNC_WORKER_STATE_RUNNING,
+                SYNC_WORKER_START_TIMEOUT_MS);
+
+            if (status == 0) {
+                s->state = SYNC_STATE_WAIT_FOR_BUFFER;
+                log_debug("%s: Worker is now running.\n", __FUNCTION__);
+            }
+            break;
+
+        case SYNC_STATE_WAIT_FOR_BUFFER:
+            /* Check the buffer state, as the worker may have consumed one
+             * since we last queried the status */
+            if (tx_buffer_empty(b)) {
+                s->state = SYNC_STATE_BUFFER_READY;
+            } else {
+                status = wait_for_buffer(b, tx_buffer_empty, timeout_ms,
+                                         __FUNCTION__, b->prod_i);
+            }
+
+            break;
+
+        case SYNC_STATE_BUFFER_READY:
+            ATOMIC_STORE_RELEASE(&b->status[b->prod_i], SYNC_BUFFER_PARTIAL);
+            b->partial_off       = 0;
+
+            switch (s->stream_config.format) {
+                case BLADERF_FORMAT_SC16_Q11:
+                case BLADERF_FORMAT_SC8_Q7:
+                    s->state = SYNC_STATE_USING_BUFFER;
+                    break;
+
+                case BLADERF_FORMAT_SC16_Q11_META:
+                case BLADERF_FORMAT_SC8_Q7_META:
+                    s->state             = SYNC_STATE_USING_BUFFER_META;
+                    s->meta.curr_msg_off = 0;
+                    s->meta.msg_num      = 0;
+                    break;
+
+                case BLADERF_FORMAT_PACKET_META:
+                    s->state             = SYNC_STATE_USING_PACKET_META;
+                    s->meta.curr_msg_off = 0;
+                    s->meta.msg_num      = 0;
+                    break;
+
+                default:
+                    assert(!"Invalid stream format");
+                    status = BLADERF_ERR_UNEXPECTED;
+            }
+
+            break;
+
+        default:
+            assert(!"Invalid state");
+            status = BLADERF_ERR_UNEXPECTED;
+    }
+
+    return status;
+}
+
 int sync_tx(struct bladerf_sync *s,
             void const *samples,
             unsigned int num_samples,
@@ -982,6 +1182,13 @@ int sync_tx(struct bladerf_sync *s,
 
     MUTEX_LOCK(&s->lock);
 
+    if (s->acquired) {
+        log_debug("%s: Acquired buffer space has not been committed.\n",
+                  __FUNCTION__);
+        status = BLADERF_ERR_INVAL;
+        goto out;
+    }
+
     status = handle_tx_parameters(user_meta, s, &op);
     if (status != 0) {
         goto out;
@@ -992,97 +1199,15 @@ int sync_tx(struct bladerf_sync *s,
 
     while (status == 0 && ((samples_written < num_samples) || op.flush)) {
         switch (s->state) {
-            case SYNC_STATE_CHECK_WORKER: {
-                int stream_error;
-                sync_worker_state worker_state =
-                    sync_worker_get_state(s->worker, &stream_error);
-
-                if (stream_error != 0) {
-                    status = stream_error;
-                } else {
-                    if (worker_state == SYNC_WORKER_STATE_IDLE) {
-                        /* No need to reset any buffer management for TX since
-                         * the TX stream does not submit an initial set of
-                         * buffers.  Therefore the RESET_BUF_MGMT state is
-                         * skipped here. */
-                        s->state = SYNC_STATE_START_WORKER;
-                    } else {
-                        /* Worker is running - continue onto checking for and
-                         * potentially waiting for an available buffer */
-                        s->state = SYNC_STATE_WAIT_FOR_BUFFER;
-                    }
-                }
-                break;
-            }
-
+            case SYNC_STATE_CHECK_WORKER:
             case SYNC_STATE_RESET_BUF_MGMT:
-                assert(!"Bug");
-                break;
-
             case SYNC_STATE_START_WORKER:
-                sync_worker_submit_request(s->worker, SYNC_WORKER_START);
-
-                status = sync_worker_wait_for_state(
-                    s->worker, SYNC_WORKER_STATE_RUNNING,
-                    SYNC_WORKER_START_TIMEOUT_MS);
-
-                if (status == 0) {
-                    s->state = SYNC_STATE_WAIT_FOR_BUFFER;
-                    log_debug("%s: Worker is now running.\n", __FUNCTION__);
-                }
-                break;
-
             case SYNC_STATE_WAIT_FOR_BUFFER:
-                MUTEX_LOCK(&b->lock);
-
-                /* Check the buffer state, as the worker may have consumed one
-                 * since we last queried the status */
-                if (b->status[b->prod_i] == SYNC_BUFFER_EMPTY) {
-                    s->state = SYNC_STATE_BUFFER_READY;
-                } else {
-                    status =
-                        wait_for_buffer(b, timeout_ms, __FUNCTION__, b->prod_i);
-                }
-
-                MUTEX_UNLOCK(&b->lock);
-                break;
-
             case SYNC_STATE_BUFFER_READY:
-                MUTEX_LOCK(&b->lock);
-                b->status[b->prod_i] = SYNC_BUFFER_PARTIAL;
-                b->partial_off       = 0;
-
-                switch (s->stream_config.format) {
-                    case BLADERF_FORMAT_SC16_Q11:
-                    case BLADERF_FORMAT_SC8_Q7:
-                        s->state = SYNC_STATE_USING_BUFFER;
-                        break;
-
-                    case BLADERF_FORMAT_SC16_Q11_META:
-                    case BLADERF_FORMAT_SC8_Q7_META:
-                        s->state             = SYNC_STATE_USING_BUFFER_META;
-                        s->meta.curr_msg_off = 0;
-                        s->meta.msg_num      = 0;
-                        break;
-
-                    case BLADERF_FORMAT_PACKET_META:
-                        s->state             = SYNC_STATE_USING_PACKET_META;
-                        s->meta.curr_msg_off = 0;
-                        s->meta.msg_num      = 0;
-                        break;
-
-                    default:
-                        assert(!"Invalid stream format");
-                        status = BLADERF_ERR_UNEXPECTED;
-                }
-
-                MUTEX_UNLOCK(&b->lock);
+                status = tx_buffer_mgmt_step(s, timeout_ms);
                 break;
 
-
             case SYNC_STATE_USING_BUFFER:
-                MUTEX_LOCK(&b->lock);
-
                 buf_dest        = (uint8_t *)b->buffers[b->prod_i];
                 samples_to_copy = uint_min(num_samples - samples_written,
                                            samples_per_buffer - b->partial_off);
@@ -1105,36 +1230,12 @@ int sync_tx(struct bladerf_sync *s,
                     status = advance_tx_buffer(s, b);
                 }
 
-                MUTEX_UNLOCK(&b->lock);
                 break;
 
             case SYNC_STATE_USING_BUFFER_META: /* SC16Q11 buffers w/ metadata */
-                MUTEX_LOCK(&b->lock);
-
                 switch (s->meta.state) {
                     case SYNC_META_STATE_HEADER:
-                        buf_dest = (uint8_t *)b->buffers[b->prod_i];
-
-                        s->meta.curr_msg =
-                            buf_dest + s->meta.msg_size * s->meta.msg_num;
-
-                        log_verbose("%s: Set curr_msg to: %p (buf @ %p)\n",
-                                    __FUNCTION__, s->meta.curr_msg, buf_dest);
-
-                        s->meta.curr_msg_off = 0;
-
-                        if (s->meta.now) {
-                            metadata_set(s->meta.curr_msg, 0, 0);
-                        } else {
-                            metadata_set(s->meta.curr_msg,
-                                         s->meta.curr_timestamp, 0);
-                        }
-
-                        s->meta.state = SYNC_META_STATE_SAMPLES;
-
-                        log_verbose("%s: Filled in header (t=%llu)\n",
-                                    __FUNCTION__,
-                                    (unsigned long long)s->meta.curr_timestamp);
+                        tx_write_msg_header(s, b);
                         break;
 
                     case SYNC_META_STATE_SAMPLES:
@@ -1280,12 +1381,9 @@ int sync_tx(struct bladerf_sync *s,
                         status = BLADERF_ERR_UNEXPECTED;
                 }
 
-                MUTEX_UNLOCK(&b->lock);
                 break;
 
             case SYNC_STATE_USING_PACKET_META: /* Packet buffers w/ metadata */
-                MUTEX_LOCK(&b->lock);
-
                 buf_dest = (uint8_t *)b->buffers[b->prod_i];
 
                 memcpy(buf_dest + METADATA_HEADER_SIZE, samples_src, num_samples*4);
@@ -1301,7 +1399,6 @@ int sync_tx(struct bladerf_sync *s,
                 s->meta.msg_num = 0;
                 s->state        = SYNC_STATE_WAIT_FOR_BUFFER;
 
-                MUTEX_UNLOCK(&b->lock);
                 break;
 
         }
@@ -1320,14 +1417,503 @@ out:
     return status;
 }
 
-unsigned int sync_buf2idx(struct buffer_mgmt *b, void *addr)
+static inline bool is_meta_format(bladerf_format format)
+{
+    return format == BLADERF_FORMAT_SC16_Q11_META ||
+           format == BLADERF_FORMAT_SC8_Q7_META ||
+           format == BLADERF_FORMAT_PACKET_META;
+}
+
+int sync_rx_acquire(struct bladerf_sync *s,
+                    void **samples,
+                    unsigned int *num_samples,
+                    struct bladerf_metadata *user_meta,
+                    unsigned int timeout_ms)
 {
-    unsigned int i;
+    struct buffer_mgmt *b;
+
+    int status = 0;
+    bool acquired = false;
+    uint8_t *buf_src = NULL;
+    unsigned int pkt_len_dwords = 0;
+
+    if (s == NULL || samples == NULL || num_samples == NULL) {
+        log_debug("NULL pointer passed to %s\n", __FUNCTION__);
+        return BLADERF_ERR_INVAL;
+    } else if (!s->initialized) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    MUTEX_LOCK(&s->lock);
+
+    if (s->acquired) {
+        log_debug("%s: Previously acquired samples have not been released.\n",
+                  __FUNCTION__);
+        status = BLADERF_ERR_INVAL;
+        goto out;
+    }
 
-    for (i = 0; i < b->num_buffers; i++) {
-        if (b->buffers[i] == addr) {
-            return i;
+    if (is_meta_format(s->stream_config.format)) {
+        if (user_meta == NULL) {
+            log_debug("NULL metadata pointer passed to %s\n", __FUNCTION__);
+            status = BLADERF_ERR_INVAL;
+            goto out;
         }
+
+        user_meta->status = 0;
+    }
+
+    b = &s->buf_mgmt;
+
+    while (!acquired && status == 0) {
+        dump_buf_states(s);
+
+        switch (s->state) {
+            case SYNC_STATE_USING_BUFFER: /* SC16Q11 buffers w/o metadata */
+                buf_src = (uint8_t *)b->buffers[b->cons_i];
+
+                *samples = buf_src + samples2bytes(s, b->partial_off);
+                s->acquired_len =
+                    s->stream_config.samples_per_buffer - b->partial_off;
+                acquired = true;
+
+                break;
+
+            case SYNC_STATE_USING_BUFFER_META: /* SC16Q11 buffers w/ metadata */
+                if (s->meta.state == SYNC_META_STATE_HEADER) {
+                    assert(s->meta.msg_num < s->meta.msg_per_buf);
+
+                    buf_src = (uint8_t *)b->buffers[b->cons_i];
+
+                    s->meta.curr_msg =
+                        buf_src + s->meta.msg_size * s->meta.msg_num;
+
+                    s->meta.msg_timestamp =
+                        metadata_get_timestamp(s->meta.curr_msg);
+
+                    s->meta.msg_flags = metadata_get_flags(s->meta.curr_msg);
+
+                    if (s->meta.curr_timestamp_valid) {
+                        rx_timestamp_discontinuity(s, user_meta);
+                    }
+
+                    s->meta.curr_msg_off   = 0;
+                    s->meta.curr_timestamp = s->meta.msg_timestamp;
+                    s->meta.state          = SYNC_META_STATE_SAMPLES;
+                }
+
+                user_meta->timestamp = s->meta.curr_timestamp;
+                user_meta->status |= s->meta.msg_flags &
+                                     (BLADERF_META_FLAG_RX_HW_UNDERFLOW |
+                                      BLADERF_META_FLAG_RX_HW_MINIEXP1 |
+                                      BLADERF_META_FLAG_RX_HW_MINIEXP2);
+
+                *samples = s->meta.curr_msg + METADATA_HEADER_SIZE +
+                           samples2bytes(s, s->meta.curr_msg_off);
+                s->acquired_len = left_in_msg(s);
+                acquired        = true;
+
+                break;
+
+            case SYNC_STATE_USING_PACKET_META: /* Packet buffers w/ metadata */
+                buf_src        = (uint8_t *)b->buffers[b->cons_i];
+                pkt_len_dwords = metadata_get_packet_len(buf_src);
+
+                if (pkt_len_dwords > 0) {
+                    *samples        = buf_src + METADATA_HEADER_SIZE;
+                    s->acquired_len = pkt_len_dwords;
+                    acquired        = true;
+                } else {
+                    /* Nothing to hand out; move on to the next packet */
+                    advance_rx_buffer(b);
+                    s->state = SYNC_STATE_WAIT_FOR_BUFFER;
+                }
+
+                break;
+
+            default:
+                status = rx_buffer_mgmt_step(s, timeout_ms);
+                break;
+        }
+    }
+
+    if (status == 0) {
+        s->acquired  = true;
+        *num_samples = s->acquired_len;
+
+        if (user_meta != NULL) {
+            user_meta->actual_count = s->acquired_len;
+        }
+
+        log_verbose("%s: Provided %u samples to caller\n", __FUNCTION__,
+                    s->acquired_len);
+    }
+
+out:
+    MUTEX_UNLOCK(&s->lock);
+
+    return status;
+}
+
+int sync_rx_release(struct bladerf_sync *s, unsigned int num_samples)
+{
+    struct buffer_mgmt *b;
+    int status = 0;
+
+    if (s == NULL || !s->initialized) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    MUTEX_LOCK(&s->lock);
+
+    if (!s->acquired) {
+        log_debug("%s: No samples have been acquired.\n", __FUNCTION__);
+        status = BLADERF_ERR_INVAL;
+        goto out;
+    }
+
+    if (num_samples > s->acquired_len ||
+        num_samples % s->meta.samples_per_ts != 0) {
+        log_debug("%s: Invalid sample count: %u (acquired %u)\n",
+                  __FUNCTION__, num_samples, s->acquired_len);
+        status = BLADERF_ERR_INVAL;
+        goto out;
+    }
+
+    b = &s->buf_mgmt;
+
+    switch (s->state) {
+        case SYNC_STATE_USING_BUFFER:
+            b->partial_off += num_samples;
+
+            if (b->partial_off >= s->stream_config.samples_per_buffer) {
+                assert(b->partial_off == s->stream_config.samples_per_buffer);
+                advance_rx_buffer(b);
+                s->state = SYNC_STATE_WAIT_FOR_BUFFER;
+            }
+            break;
+
+        case SYNC_STATE_USING_BUFFER_META:
+            s->meta.curr_msg_off += num_samples;
+            s->meta.curr_timestamp += num_samples / s->meta.samples_per_ts;
+            s->meta.curr_timestamp_valid = true;
+
+            if (left_in_msg(s) == 0) {
+                s->meta.state = SYNC_META_STATE_HEADER;
+                s->meta.msg_num++;
+
+                if (s->meta.msg_num >= s->meta.msg_per_buf) {
+                    assert(s->meta.msg_num == s->meta.msg_per_buf);
+                    advance_rx_buffer(b);
+                    s->meta.msg_num = 0;
+                    s->state        = SYNC_STATE_WAIT_FOR_BUFFER;
+                }
+            }
+            break;
+
+        case SYNC_STATE_USING_PACKET_META:
+            /* Packets are always consumed in their entirety */
+            advance_rx_buffer(b);
+            s->state = SYNC_STATE_WAIT_FOR_BUFFER;
+            break;
+
+        default:
+            assert(!"Invalid state");
+            status = BLADERF_ERR_UNEXPECTED;
+    }
+
+    s->acquired     = false;
+    s->acquired_len = 0;
+
+out:
+    MUTEX_UNLOCK(&s->lock);
+
+    return status;
+}
+
+int sync_tx_acquire(struct bladerf_sync *s,
+                    void **samples,
+                    unsigned int *num_samples,
+                    struct bladerf_metadata *user_meta,
+                    unsigned int timeout_ms)
+{
+    struct buffer_mgmt *b;
+
+    int status        = 0;
+    bool acquired     = false;
+    uint8_t *buf_dest = NULL;
+    struct tx_options op = {
+        FIELD_INIT(.flush, false), FIELD_INIT(.zero_pad, false),
+    };
+
+    if (s == NULL || samples == NULL || num_samples == NULL) {
+        log_debug("NULL pointer passed to %s\n", __FUNCTION__);
+        return BLADERF_ERR_INVAL;
+    } else if (!s->initialized) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    MUTEX_LOCK(&s->lock);
+
+    if (s->acquired) {
+        log_debug("%s: Previously acquired buffer space has not been "
+                  "committed.\n", __FUNCTION__);
+        status = BLADERF_ERR_INVAL;
+        goto out;
+    }
+
+    if (s->stream_config.format == BLADERF_FORMAT_SC16_Q11_META &&
+        user_meta != NULL) {
+        if (user_meta->flags & BLADERF_META_FLAG_TX_UPDATE_TIMESTAMP) {
+            log_debug("%s: UPDATE_TIMESTAMP is not supported for zero-copy "
+                      "transmission.\n", __FUNCTION__);
+            status = BLADERF_ERR_UNSUPPORTED;
+            goto out;
+        }
+
+        if (user_meta->flags & BLADERF_META_FLAG_TX_BURST_END) {
+            log_debug("%s: BURST_END must be provided when committing "
+                      "samples.\n", __FUNCTION__);
+            status = BLADERF_ERR_INVAL;
+            goto out;
+        }
+    }
+
+    status = handle_tx_parameters(user_meta, s, &op);
+    if (status != 0) {
+        goto out;
+    }
+
+    b = &s->buf_mgmt;
+
+    while (!acquired && status == 0) {
+        switch (s->state) {
+            case SYNC_STATE_USING_BUFFER:
+                buf_dest = (uint8_t *)b->buffers[b->prod_i];
+
+                *samples = buf_dest + samples2bytes(s, b->partial_off);
+                s->acquired_len =
+                    s->stream_config.samples_per_buffer - b->partial_off;
+                acquired = true;
+
+                break;
+
+            case SYNC_STATE_USING_BUFFER_META: /* SC16Q11 buffers w/ metadata */
+                if (s->meta.state == SYNC_META_STATE_HEADER) {
+                    tx_write_msg_header(s, b);
+                }
+
+                *samples = s->meta.curr_msg + METADATA_HEADER_SIZE +
+                           samples2bytes(s, s->meta.curr_msg_off);
+                s->acquired_len = left_in_msg(s);
+                acquired        = true;
+
+                break;
+
+            case SYNC_STATE_USING_PACKET_META: /* Packet buffers w/ metadata */
+                buf_dest = (uint8_t *)b->buffers[b->prod_i];
+
+                *samples        = buf_dest + METADATA_HEADER_SIZE;
+                s->acquired_len = (unsigned int)
+                    ((async_stream_buf_bytes(s->worker->stream) -
+                      METADATA_HEADER_SIZE) /
+                     s->stream_config.bytes_per_sample);
+                acquired = true;
+
+                break;
+
+            default:
+                status = tx_buffer_mgmt_step(s, timeout_ms);
+                break;
+        }
+    }
+
+    if (status == 0) {
+        s->acquired  = true;
+        *num_samples = s->acquired_len;
+    }
+
+out:
+    MUTEX_UNLOCK(&s->lock);
+
+    return status;
+}
+
+/* Completes the current message if it has been filled, submitting the buffer
+ * once all of its messages are complete. When `flush` is set, the remainder of
+ * the buffer is zero-filled and submitted. */
+static int tx_complete_msg(struct bladerf_sync *s,
+                           struct buffer_mgmt *b,
+                           bool flush)
+{
+    int status = 0;
+
+    do {
+        if (s->meta.state == SYNC_META_STATE_HEADER) {
+            tx_write_msg_header(s, b);
+        }
+
+        if (flush && left_in_msg(s) != 0) {
+            const unsigned int to_zero = left_in_msg(s);
+
+            memset(s->meta.curr_msg + METADATA_HEADER_SIZE +
+                       samples2bytes(s, s->meta.curr_msg_off),
+                   0, samples2bytes(s, to_zero));
+
+            s->meta.curr_msg_off += to_zero;
+            s->meta.curr_timestamp += to_zero / s->meta.samples_per_ts;
+        }
+
+        if (left_in_msg(s) == 0) {
+            s->meta.msg_num++;
+            s->meta.state = SYNC_META_STATE_HEADER;
+        }
+
+        if (s->meta.msg_num >= s->meta.msg_per_buf) {
+            assert(s->meta.msg_num == s->meta.msg_per_buf);
+
+            status          = advance_tx_buffer(s, b);
+            s->meta.msg_num = 0;
+            s->state        = SYNC_STATE_WAIT_FOR_BUFFER;
+            break;
+        }
+    } while (flush);
+
+    return status;
+}
+
+int sync_tx_commit(struct bladerf_sync *s,
+                   unsigned int num_samples,
+                   struct bladerf_metadata *user_meta)
+{
+    struct buffer_mgmt *b;
+    uint8_t *buf_dest;
+    bool burst_end = false;
+    int status     = 0;
+
+    if (s == NULL || !s->initialized) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    MUTEX_LOCK(&s->lock);
+
+    if (!s->acquired) {
+        log_debug("%s: No buffer space has been acquired.\n", __FUNCTION__);
+        status = BLADERF_ERR_INVAL;
+        goto out;
+    }
+
+    if (num_samples > s->acquired_len ||
+        num_samples % s->meta.samples_per_ts != 0) {
+        log_debug("%s: Invalid sample count: %u (acquired %u)\n",
+                  __FUNCTION__, num_samples, s->acquired_len);
+        status = BLADERF_ERR_INVAL;
+        goto out;
+    }
+
+    if (s->stream_config.format == BLADERF_FORMAT_SC16_Q11_META &&
+        user_meta != NULL &&
+        (user_meta->flags & BLADERF_META_FLAG_TX_BURST_END)) {
+        if (!s->meta.in_burst) {
+            log_debug("%s: BURST_END provided while not in a burst.\n",
+                      __FUNCTION__);
+            status = BLADERF_ERR_INVAL;
+            goto out;
+        }
+
+        burst_end = true;
+    }
+
+    b = &s->buf_mgmt;
+
+    switch (s->state) {
+        case SYNC_STATE_USING_BUFFER:
+            b->partial_off += num_samples;
+
+            if (b->partial_off >= s->stream_config.samples_per_buffer) {
+                assert(b->partial_off == s->stream_config.samples_per_buffer);
+                status = advance_tx_buffer(s, b);
+            }
+            break;
+
+        case SYNC_STATE_USING_BUFFER_META:
+            s->meta.curr_msg_off += num_samples;
+            s->meta.curr_timestamp += num_samples / s->meta.samples_per_ts;
+
+            status = tx_complete_msg(s, b, burst_end);
+            break;
+
+        case SYNC_STATE_USING_PACKET_META:
+            buf_dest = (uint8_t *)b->buffers[b->prod_i];
+
+            b->actual_lengths[b->prod_i] =
+                samples2bytes(s, num_samples) + METADATA_HEADER_SIZE;
+
+            metadata_set_packet(buf_dest, 0, 0, num_samples, 0, 0);
+
+            status = advance_tx_buffer(s, b);
+
+            s->meta.msg_num = 0;
+            s->state        = SYNC_STATE_WAIT_FOR_BUFFER;
+            break;
+
+        default:
+            assert(!"Invalid state");
+            status = BLADERF_ERR_UNEXPECTED;
+    }
+
+    if (status == 0 && burst_end) {
+        s->meta.in_burst = false;
+        s->meta.now      = false;
+    }
+
+    s->acquired     = false;
+    s->acquired_len = 0;
+
+out:
+    MUTEX_UNLOCK(&s->lock);
+
+    return status;
+}
+
+int sync_get_stats(struct bladerf_sync *s, struct bladerf_stream_stats *stats)
+{
+    if (s == NULL || stats == NULL || !s->initialized) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    async_get_stats(s->worker->stream, stats);
+    return 0;
+}
+
+int sync_set_thread_config(struct bladerf_sync *s,
+                           const struct bladerf_stream_thread_config *config)
+{
+    int status;
+
+    if (s == NULL || config == NULL) {
+        return BLADERF_ERR_INVAL;
+    }
+
+    if (s->initialized) {
+        status = thread_sched_apply(s->worker->thread, config);
+    } else {
+        status = thread_sched_validate(config);
+    }
+
+    if (status == 0) {
+        s->thread_config = *config;
+    }
+
+    return status;
+}
+
+unsigned int sync_buf2idx(struct bladerf_stream *stream, void *addr)
+{
+    const size_t idx = async_stream_buf_idx(stream, addr);
+
+    if (idx < stream->num_buffers) {
+        return (unsigned int)idx;
     }
 
     assert(!"Bug: Buffer not found.");
@@ -29,6 +29,10 @@
 
 #include "thread.h"
 
+#include "sync_event.h"
+
+struct bladerf_stream;
+
 /* These parameters are only written during sync_init */
 struct stream_config {
     bladerf_format format;
@@ -66,6 +70,12 @@ typedef enum {
 
 #define BUFFER_MGMT_INVALID_INDEX (UINT_MAX)
 
+/* The buffers form a single-producer, single-consumer ring. Ownership of each
+ * buffer is handed between the stream callbacks and the sync_rx()/sync_tx()
+ * caller through its `status` entry, which must only be accessed with the
+ * acquire/release operations in helpers/atomic.h. Everything else associated
+ * with a buffer is owned by whichever side the status says owns it, so the
+ * data path does not need to take `lock`. */
 struct buffer_mgmt {
     sync_buffer_status *status;
     size_t *actual_lengths;
@@ -74,22 +84,29 @@ struct buffer_mgmt {
     unsigned int num_buffers;
 
     unsigned int prod_i;      /**< Producer index - next buffer to fill */
-    unsigned int cons_i;      /**< Consumer index - next buffer to empty */
+    unsigned int cons_i;      /**< Consumer index - next buffer to empty.
+                               *   For RX, this is peeked at atomically by
+                               *   the callback to track queue depth. */
     unsigned int partial_off; /**< Current index into partial buffer */
 
+    /* Applicable to TX only. Number of buffers that are full or in flight,
+     * which must only be modified atomically. */
+    unsigned int num_queued;
+
     /* In the event of a SW RX overrun, this count is used to determine
      * how many more transfers should be considered invalid and require
      * resubmission */
     unsigned int resubmit_count;
 
     /* Applicable to TX only. Denotes which context is responsible for
-     * submitting full buffers to the underlying async system */
+     * submitting full buffers to the underlying async system. This is only
+     * modified while holding `lock`, but may be peeked at atomically. */
     sync_tx_submitter submitter;
 
-
-    MUTEX lock;
-    pthread_cond_t buf_ready; /**< Buffer produced by RX callback, or
-                               *   buffer emptied by TX callback */
+    MUTEX lock;                  /**< Serializes TX submitter hand-offs and
+                                  *   (re)initialization of the ring */
+    struct sync_event buf_ready; /**< Buffer produced by RX callback, or
+                                  *   buffer emptied by TX callback */
 };
 
 /* State of API-side sync interface */
@@ -123,6 +140,8 @@ struct sync_meta {
             uint64_t
                 msg_timestamp;  /* Timestamp contained in the current message */
             uint32_t msg_flags; /* Flags for the current message */
+            bool curr_timestamp_valid; /* curr_timestamp follows the samples
+                                        * last returned to the caller */
         };
 
         /* Used only for TX */
@@ -145,6 +164,16 @@ struct bladerf_sync {
     struct stream_config stream_config;
     struct sync_worker *worker;
     struct sync_meta meta;
+
+    /* Zero-copy access. While `acquired` is set, the caller owns the
+     * `acquired_len` samples that were handed out by the last acquire call,
+     * and sync_rx()/sync_tx() may not be used. */
+    bool acquired;
+    unsigned int acquired_len;
+
+    /* Applied to the worker thread each time it is created. This persists
+     * across sync_init() and sync_deinit() calls. */
+    struct bladerf_stream_thread_config thread_config;
 };
 
 /**
@@ -174,6 +203,32 @@ int sync_init(struct bladerf_sync *sync,
  */
 void sync_deinit(struct bladerf_sync *sync);
 
+/**
+ * Get a snapshot of the statistics of the stream associated with the sync
+ * handle. This does not acquire sync->lock, and therefore does not block
+ * while a sync_rx()/sync_tx() call is in progress.
+ *
+ * @param[in]   sync    Sync handle
+ * @param[out]  stats   Updated with stream statistics
+ *
+ * @return 0 or BLADERF_ERR_INVAL if the handle is not initialized
+ */
+int sync_get_stats(struct bladerf_sync *sync,
+                   struct bladerf_stream_stats *stats);
+
+/**
+ * Set the placement and scheduling of the sync handle's worker thread. If the
+ * handle is initialized, this is applied to the worker immediately. The
+ * configuration is only retained if this succeeds.
+ *
+ * @param       sync    Sync handle
+ * @param[in]   config  Thread configuration
+ *
+ * @return 0 or BLADERF_ERR_* value on failure
+ */
+int sync_set_thread_config(struct bladerf_sync *sync,
+                           const struct bladerf_stream_thread_config *config);
+
 int sync_rx(struct bladerf_sync *sync,
             void *samples,
             unsigned int num_samples,
@@ -186,7 +241,79 @@ int sync_tx(struct bladerf_sync *sync,
             struct bladerf_metadata *metadata,
             unsigned int timeout_ms);
 
-unsigned int sync_buf2idx(struct buffer_mgmt *b, void *addr);
+/**
+ * Obtain direct access to the next contiguous region of received samples
+ * within the sync interface's buffers, avoiding the copy performed by
+ * sync_rx().
+ *
+ * For the non-metadata formats, this region spans the remainder of the current
+ * buffer. For the SC16Q11/SC8Q7 metadata formats, it spans the remainder of
+ * the current message, and `user_meta` is filled in with the timestamp and
+ * flags of its first sample. For the packet metadata format, it is the
+ * payload of the current packet.
+ *
+ * @param       sync            Sync handle
+ * @param[out]  samples         Updated to point to the first sample
+ * @param[out]  num_samples     Number of samples available at `samples`
+ * @param[out]  user_meta       Metadata. Required for metadata formats.
+ * @param[in]   timeout_ms      Timeout in ms. 0 implies "wait forever"
+ *
+ * @return 0 on success, BLADERF_ERR_* on failure
+ */
+int sync_rx_acquire(struct bladerf_sync *sync,
+                    void **samples,
+                    unsigned int *num_samples,
+                    struct bladerf_metadata *user_meta,
+                    unsigned int timeout_ms);
+
+/**
+ * Return the first `num_samples` samples of the region obtained by
+ * sync_rx_acquire() to the sync interface. Any remaining samples will be
+ * provided by the next sync_rx_acquire() or sync_rx() call.
+ *
+ * @return 0 on success, BLADERF_ERR_* on failure
+ */
+int sync_rx_release(struct bladerf_sync *sync, unsigned int num_samples);
+
+/**
+ * Obtain direct access to the next contiguous region of free space within the
+ * sync interface's TX buffers, avoiding the copy performed by sync_tx().
+ *
+ * For the SC16Q11 metadata format, the burst start flags in `user_meta` are
+ * handled here, as they would be by sync_tx().
+ *
+ * @param       sync            Sync handle
+ * @param[out]  samples         Updated to point to where samples may be written
+ * @param[out]  num_samples     Number of samples that may be written
+ * @param[in]   user_meta       Metadata. Required for metadata formats.
+ * @param[in]   timeout_ms      Timeout in ms. 0 implies "wait forever"
+ *
+ * @return 0 on success, BLADERF_ERR_* on failure
+ */
+int sync_tx_acquire(struct bladerf_sync *sync,
+                    void **samples,
+                    unsigned int *num_samples,
+                    struct bladerf_metadata *user_meta,
+                    unsigned int timeout_ms);
+
+/**
+ * Commit the first `num_samples` samples written into the region obtained by
+ * sync_tx_acquire(). Filled buffers are submitted for transmission.
+ *
+ * For the SC16Q11 metadata format, a burst end flag in `user_meta` flushes
+ * the remainder of the current buffer, as it would for sync_tx().
+ *
+ * @return 0 on success, BLADERF_ERR_* on failure
+ */
+int sync_tx_commit(struct bladerf_sync *sync,
+                   unsigned int num_samples,
+                   struct bladerf_metadata *user_meta);
+
+/**
+ * Get the index of the stream buffer at `addr`. This is a constant-time
+ * operation, as the stream's buffers are allocated contiguously.
+ */
+unsigned int sync_buf2idx(struct bladerf_stream *stream, void *addr);
 
 void *sync_idx2buf(struct buffer_mgmt *b, unsigned int idx);
 
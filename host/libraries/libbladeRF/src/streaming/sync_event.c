@@ -0,0 +1,214 @@
+/*
+ * This file is part of the bladeRF project:
+ *   http://www.github.com/nuand/bladeRF
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <errno.h>
+#include <limits.h>
+
+#include <libbladeRF.h>
+
+#include "sync_event.h"
+
+#include "helpers/atomic.h"
+#include "helpers/timeout.h"
+
+#if SYNC_EVENT_USE_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/* Upper bound on the number of iterations sync_event_wait() will spin before
+ * blocking. The budget shrinks when spinning fails to pay off and grows when
+ * it does, so a consumer that is consistently ahead of the stream will fall
+ * back to blocking without burning a core. */
+#ifdef ENABLE_LIBBLADERF_SYNC_SPIN
+#   ifndef SYNC_EVENT_SPIN_MAX
+#       define SYNC_EVENT_SPIN_MAX 16384
+#   endif
+#   define SYNC_EVENT_SPIN_MIN 64
+#else
+#   undef SYNC_EVENT_SPIN_MAX
+#   define SYNC_EVENT_SPIN_MAX 0
+#endif
+
+int sync_event_init(struct sync_event *e)
+{
+    e->seq     = 0;
+    e->waiters = 0;
+    e->spin    = SYNC_EVENT_SPIN_MAX;
+
+#if !SYNC_EVENT_USE_FUTEX
+    MUTEX_INIT(&e->lock);
+
+    if (pthread_cond_init(&e->cond, NULL) != 0) {
+        MUTEX_DESTROY(&e->lock);
+        return BLADERF_ERR_UNEXPECTED;
+    }
+#endif
+
+    return 0;
+}
+
+void sync_event_deinit(struct sync_event *e)
+{
+#if !SYNC_EVENT_USE_FUTEX
+    pthread_cond_destroy(&e->cond);
+    MUTEX_DESTROY(&e->lock);
+#endif
+}
+
+void sync_event_notify(struct sync_event *e)
+{
+    ATOMIC_FETCH_ADD(&e->seq, 1);
+
+    /* Skip the wake-up entirely if nobody is (or is about to be) blocked.
+     * A waiter registers itself before sampling `seq`, so it will either be
+     * seen here or observe the new sequence value. */
+    if (ATOMIC_LOAD_SEQ_CST(&e->waiters) == 0) {
+        return;
+    }
+
+#if SYNC_EVENT_USE_FUTEX
+    syscall(SYS_futex, &e->seq, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+#else
+    MUTEX_LOCK(&e->lock);
+    pthread_cond_broadcast(&e->cond);
+    MUTEX_UNLOCK(&e->lock);
+#endif
+}
+
+/* Block until e->seq no longer equals `seq`, or until `deadline` passes */
+static int block(struct sync_event *e,
+                 unsigned int seq,
+                 const struct timespec *deadline)
+{
+#if SYNC_EVENT_USE_FUTEX
+    long ret;
+
+    /* FUTEX_WAIT_BITSET takes an absolute timeout, which lets us reuse the
+     * CLOCK_REALTIME deadline from populate_abs_timeout() across retries. */
+    ret = syscall(SYS_futex, &e->seq,
+                  FUTEX_WAIT_BITSET_PRIVATE | FUTEX_CLOCK_REALTIME, seq,
+                  deadline, NULL, FUTEX_BITSET_MATCH_ANY);
+
+    if (ret == 0) {
+        return 0;
+    }
+
+    switch (errno) {
+        case EAGAIN: /* Already notified */
+        case EINTR:
+            return 0;
+
+        case ETIMEDOUT:
+            return BLADERF_ERR_TIMEOUT;
+
+        default:
+            return BLADERF_ERR_UNEXPECTED;
+    }
+#else
+    int status = 0;
+
+    MUTEX_LOCK(&e->lock);
+
+    if (ATOMIC_LOAD_SEQ_CST(&e->seq) == seq) {
+        if (deadline == NULL) {
+            status = pthread_cond_wait(&e->cond, &e->lock);
+        } else {
+            status = pthread_cond_timedwait(&e->cond, &e->lock, deadline);
+        }
+    }
+
+    MUTEX_UNLOCK(&e->lock);
+
+    if (status == ETIMEDOUT) {
+        return BLADERF_ERR_TIMEOUT;
+    } else if (status != 0) {
+        return BLADERF_ERR_UNEXPECTED;
+    }
+
+    return 0;
+#endif
+}
+
+/* Optionally spin first, in the hope of avoiding a trip through the
+ * scheduler when the other side is only moments away */
+static bool spin(struct sync_event *e, sync_event_ready_fn ready, void *arg)
+{
+#ifdef ENABLE_LIBBLADERF_SYNC_SPIN
+    unsigned int i;
+
+    for (i = 0; i < e->spin; i++) {
+        CPU_RELAX();
+
+        if (ready(arg)) {
+            e->spin = (e->spin < SYNC_EVENT_SPIN_MAX / 2) ? e->spin * 2
+                                                          : SYNC_EVENT_SPIN_MAX;
+            return true;
+        }
+    }
+
+    if (e->spin > SYNC_EVENT_SPIN_MIN) {
+        e->spin /= 2;
+    }
+#endif
+
+    return false;
+}
+
+int sync_event_wait(struct sync_event *e,
+                    sync_event_ready_fn ready,
+                    void *arg,
+                    unsigned int timeout_ms)
+{
+    struct timespec deadline;
+    unsigned int seq;
+    int status;
+
+    if (ready(arg)) {
+        return 0;
+    }
+
+    if (spin(e, ready, arg)) {
+        return 0;
+    }
+
+    if (timeout_ms != 0) {
+        status = populate_abs_timeout(&deadline, timeout_ms);
+        if (status != 0) {
+            return status;
+        }
+    }
+
+    ATOMIC_FETCH_ADD(&e->waiters, 1);
+
+    seq = ATOMIC_LOAD_SEQ_CST(&e->seq);
+
+    if (ready(arg)) {
+        status = 0;
+    } else {
+        status = block(e, seq, (timeout_ms != 0) ? &deadline : NULL);
+    }
+
+    ATOMIC_FETCH_SUB(&e->waiters, 1);
+
+    return status;
+}
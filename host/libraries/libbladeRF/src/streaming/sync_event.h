@@ -0,0 +1,105 @@
+/*
+ * This file is part of the bladeRF project:
+ *   http://www.github.com/nuand/bladeRF
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef STREAMING_SYNC_EVENT_H_
+#define STREAMING_SYNC_EVENT_H_
+
+#include <stdbool.h>
+
+#include "host_config.h"
+#include "thread.h"
+
+/* On Linux, waiters block on the event's sequence counter directly via
+ * futex(2). Elsewhere, a mutex and condition variable are used, but only when
+ * a waiter is actually blocked. */
+#if BLADERF_OS_LINUX
+#   define SYNC_EVENT_USE_FUTEX 1
+#else
+#   define SYNC_EVENT_USE_FUTEX 0
+#endif
+
+/**
+ * Wake-up event used to hand buffers between the stream callbacks and the
+ * sync_rx()/sync_tx() callers.
+ *
+ * The notifying side never takes a lock and only makes a system call when a
+ * waiter is blocked. The waiting side may optionally spin for a short,
+ * adaptively sized period before blocking (see ENABLE_LIBBLADERF_SYNC_SPIN).
+ *
+ * Only a single thread may wait on an event at a time.
+ */
+struct sync_event {
+    unsigned int seq;       /**< Incremented by every notification */
+    unsigned int waiters;   /**< Number of blocked (or blocking) waiters */
+    unsigned int spin;      /**< Current spin budget, in iterations */
+
+#if !SYNC_EVENT_USE_FUTEX
+    MUTEX lock;
+    pthread_cond_t cond;
+#endif
+};
+
+/**
+ * Predicate checked by sync_event_wait()
+ *
+ * @return true when the condition being waited upon has been met
+ */
+typedef bool (*sync_event_ready_fn)(void *arg);
+
+/**
+ * Initialize an event
+ *
+ * @return 0 on success, BLADERF_ERR_* on failure
+ */
+int sync_event_init(struct sync_event *e);
+
+/**
+ * Deinitialize an event
+ */
+void sync_event_deinit(struct sync_event *e);
+
+/**
+ * Wake any thread blocked in sync_event_wait(). Any state that the waiter's
+ * predicate depends upon must be updated prior to this call.
+ */
+void sync_event_notify(struct sync_event *e);
+
+/**
+ * Wait until `ready` returns true, or until the event is notified.
+ *
+ * As with a condition variable, a notification does not imply that the
+ * predicate has been satisfied; callers must re-examine their state upon a
+ * successful return.
+ *
+ * @param       e           Event to wait on
+ * @param[in]   ready       Predicate to check
+ * @param[in]   arg         Argument passed to `ready`
+ * @param[in]   timeout_ms  Timeout in ms. 0 implies "wait forever"
+ *
+ * @return 0 on success, BLADERF_ERR_TIMEOUT if the timeout elapsed, or
+ *         BLADERF_ERR_UNEXPECTED on failure
+ */
+int sync_event_wait(struct sync_event *e,
+                    sync_event_ready_fn ready,
+                    void *arg,
+                    unsigned int timeout_ms);
+
+#endif
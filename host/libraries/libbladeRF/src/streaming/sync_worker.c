@@ -32,6 +32,8 @@
 #include "conversions.h"
 #include "minmax.h"
 
+#include "helpers/atomic.h"
+
 #include "async.h"
 #include "sync.h"
 #include "sync_worker.h"
@@ -53,6 +55,7 @@ static void *rx_callback(struct bladerf *dev,
     unsigned int requests;      /* Pending requests */
     unsigned int next_idx;
     unsigned int samples_idx;
+    unsigned int queued;        /* Number of buffers in use */
     void *next_buf = NULL;      /* Next buffer to submit for reception */
 
     struct bladerf_sync *s = (struct bladerf_sync *)user_data;
@@ -72,48 +75,67 @@ static void *rx_callback(struct bladerf *dev,
         return NULL;
     }
 
-    MUTEX_LOCK(&b->lock);
+    /* This callback is the ring's sole producer. It owns prod_i and
+     * resubmit_count, and only needs to examine the status of the next buffer
+     * to determine whether the consumer has released it. */
 
     /* Get the index of the buffer that was just filled */
-    samples_idx = sync_buf2idx(b, samples);
+    samples_idx = sync_buf2idx(stream, samples);
 
     if (b->resubmit_count == 0) {
-        if (b->status[b->prod_i] == SYNC_BUFFER_EMPTY) {
+        if (ATOMIC_LOAD_ACQUIRE(&b->status[b->prod_i]) == SYNC_BUFFER_EMPTY) {
 
             /* This buffer is now ready for the consumer */
-            b->status[samples_idx] = SYNC_BUFFER_FULL;
             b->actual_lengths[samples_idx] = num_samples;
-            pthread_cond_signal(&b->buf_ready);
+            ATOMIC_STORE_RELEASE(&b->status[samples_idx], SYNC_BUFFER_FULL);
+            sync_event_notify(&b->buf_ready);
 
             /* Update the state of the buffer being submitted next */
             next_idx = b->prod_i;
-            b->status[next_idx] = SYNC_BUFFER_IN_FLIGHT;
+            ATOMIC_STORE_RELEASE(&b->status[next_idx], SYNC_BUFFER_IN_FLIGHT);
             next_buf = b->buffers[next_idx];
 
             /* Advance to the next buffer for the next callback */
             b->prod_i = (next_idx + 1) % b->num_buffers;
 
+            /* Buffers cons_i through next_idx are now in use. A stale cons_i
+             * can only overstate this, by the buffers that the consumer has
+             * just released. */
+            queued = (b->prod_i + b->num_buffers -
+                      ATOMIC_LOAD_ACQUIRE(&b->cons_i)) % b->num_buffers;
+            if (queued == 0) {
+                queued = b->num_buffers;
+            }
+
+            if (queued > stream->stats.queue_high_water) {
+                stream->stats.queue_high_water = queued;
+            }
+
             log_verbose("%s worker: buf[%u] = full, buf[%u] = in_flight\n",
                         worker2str(s), samples_idx, next_idx);
 
         } else {
-            /* TODO propagate back the RX Overrun to the sync_rx() caller */
+            /* The sync_rx() caller learns of this via the discontinuity
+             * in the metadata timestamps, when using a metadata format */
             log_debug("RX overrun @ buffer %u\r\n", samples_idx);
 
             next_buf = samples;
             b->resubmit_count = s->stream_config.num_xfers - 1;
+
+            stream->stats.overruns++;
+            stream->stats.resubmissions++;
+            stream->stats.queue_high_water = b->num_buffers;
         }
     } else {
         /* We're still recovering from an overrun at this point. Just
          * turn around and resubmit this buffer */
         next_buf = samples;
         b->resubmit_count--;
+        stream->stats.resubmissions++;
         log_verbose("Resubmitting buffer %u (%u resubmissions left)\r\n",
                     samples_idx, b->resubmit_count);
     }
 
-
-    MUTEX_UNLOCK(&b->lock);
     return next_buf;
 }
 
@@ -126,6 +148,7 @@ static void *tx_callback(struct bladerf *dev,
 {
     unsigned int requests;      /* Pending requests */
     unsigned int completed_idx; /* Index of completed buffer */
+    unsigned int queued;        /* Number of buffers in use */
 
     struct bladerf_sync *s = (struct bladerf_sync *)user_data;
     struct sync_worker  *w = s->worker;
@@ -149,38 +172,55 @@ static void *tx_callback(struct bladerf *dev,
     /* The initial set of callbacks will do not provide us with any
      * completed sample buffers */
     if (samples != NULL) {
-        MUTEX_LOCK(&b->lock);
-
         /* Mark the completed buffer as being empty */
-        completed_idx = sync_buf2idx(b, samples);
-        assert(b->status[completed_idx] == SYNC_BUFFER_IN_FLIGHT);
-        b->status[completed_idx] = SYNC_BUFFER_EMPTY;
-        pthread_cond_signal(&b->buf_ready);
+        completed_idx = sync_buf2idx(stream, samples);
+        assert(ATOMIC_LOAD_ACQUIRE(&b->status[completed_idx]) ==
+               SYNC_BUFFER_IN_FLIGHT);
+        ATOMIC_STORE_RELEASE(&b->status[completed_idx], SYNC_BUFFER_EMPTY);
+
+        /* Every buffer queued since the last completion is still
+         * outstanding, so the queue depth peaks just prior to this. */
+        queued = ATOMIC_FETCH_SUB(&b->num_queued, 1);
+        if (queued > stream->stats.queue_high_water) {
+            stream->stats.queue_high_water = queued;
+        }
+
+        if (queued == 1) {
+            stream->stats.underruns++;
+        }
+
+        sync_event_notify(&b->buf_ready);
 
         /* If the callback is assigned to be the submitter, there are
-         * buffers pending submission */
-        if (b->submitter == SYNC_TX_SUBMITTER_CALLBACK) {
-            assert(b->cons_i != BUFFER_MGMT_INVALID_INDEX);
-            if (b->status[b->cons_i] == SYNC_BUFFER_FULL) {
-                /* This buffer is ready to ship out ("consume") */
-                log_verbose("%s: Submitting deferred buf[%u]\n",
-                            __FUNCTION__, b->cons_i);
-
-                ret = b->buffers[b->cons_i];
-                /* This is actually # of 32bit DWORDs for PACKET_META */
-                meta->actual_count = b->actual_lengths[b->cons_i];
-                b->status[b->cons_i] = SYNC_BUFFER_IN_FLIGHT;
-                b->cons_i = (b->cons_i + 1) % b->num_buffers;
-            } else {
-                log_verbose("%s: No deferred buffer available. "
-                            "Assigning submitter=FN\n", __FUNCTION__);
-
-                b->submitter = SYNC_TX_SUBMITTER_FN;
-                b->cons_i = BUFFER_MGMT_INVALID_INDEX;
+         * buffers pending submission. This hand-off is rare, so the lock is
+         * only taken once we've seen that it has occurred. */
+        if (ATOMIC_LOAD_ACQUIRE(&b->submitter) == SYNC_TX_SUBMITTER_CALLBACK) {
+            MUTEX_LOCK(&b->lock);
+
+            if (b->submitter == SYNC_TX_SUBMITTER_CALLBACK) {
+                assert(b->cons_i != BUFFER_MGMT_INVALID_INDEX);
+                if (b->status[b->cons_i] == SYNC_BUFFER_FULL) {
+                    /* This buffer is ready to ship out ("consume") */
+                    log_verbose("%s: Submitting deferred buf[%u]\n",
+                                __FUNCTION__, b->cons_i);
+
+                    ret = b->buffers[b->cons_i];
+                    /* This is actually # of 32bit DWORDs for PACKET_META */
+                    meta->actual_count = b->actual_lengths[b->cons_i];
+                    ATOMIC_STORE_RELEASE(&b->status[b->cons_i],
+                                         SYNC_BUFFER_IN_FLIGHT);
+                    b->cons_i = (b->cons_i + 1) % b->num_buffers;
+                } else {
+                    log_verbose("%s: No deferred buffer available. "
+                                "Assigning submitter=FN\n", __FUNCTION__);
+
+                    ATOMIC_STORE_RELEASE(&b->submitter, SYNC_TX_SUBMITTER_FN);
+                    b->cons_i = BUFFER_MGMT_INVALID_INDEX;
+                }
             }
-        }
 
-        MUTEX_UNLOCK(&b->lock);
+            MUTEX_UNLOCK(&b->lock);
+        }
 
         log_verbose("%s worker: Buffer %u emptied.\r\n",
                     worker2str(s), completed_idx);
@@ -273,8 +313,7 @@ worker_init_out:
     return status;
 }
 
-void sync_worker_deinit(struct sync_worker *w,
-                        pthread_mutex_t *lock, pthread_cond_t *cond)
+void sync_worker_deinit(struct sync_worker *w, struct sync_event *event)
 {
     int status;
 
@@ -287,10 +326,8 @@ void sync_worker_deinit(struct sync_worker *w,
 
     sync_worker_submit_request(w, SYNC_WORKER_STOP);
 
-    if (lock != NULL && cond != NULL) {
-        MUTEX_LOCK(lock);
-        pthread_cond_signal(cond);
-        MUTEX_UNLOCK(lock);
+    if (event != NULL) {
+        sync_event_notify(event);
     }
 
     status = sync_worker_wait_for_state(w, SYNC_WORKER_STATE_STOPPED, 3000);
@@ -426,15 +463,22 @@ static sync_worker_state exec_idle_state(struct bladerf_sync *s)
         MUTEX_LOCK(&s->buf_mgmt.lock);
 
         if ((s->stream_config.layout & BLADERF_DIRECTION_MASK) == BLADERF_TX) {
+            unsigned int num_queued = 0;
+
             /* If we've previously timed out on a stream, we'll likely have some
-            * stale buffers marked "in-flight" that have since been cancelled. */
+            * stale buffers marked "in-flight" that have since been cancelled.
+            * Those won't complete, so only the full buffers remain queued. */
             for (i = 0; i < s->buf_mgmt.num_buffers; i++) {
                 if (s->buf_mgmt.status[i] == SYNC_BUFFER_IN_FLIGHT) {
                     s->buf_mgmt.status[i] = SYNC_BUFFER_EMPTY;
+                } else if (s->buf_mgmt.status[i] == SYNC_BUFFER_FULL) {
+                    num_queued++;
                 }
             }
 
-            pthread_cond_signal(&s->buf_mgmt.buf_ready);
+            ATOMIC_STORE_RELEASE(&s->buf_mgmt.num_queued, num_queued);
+
+            sync_event_notify(&s->buf_mgmt.buf_ready);
         } else {
             s->buf_mgmt.prod_i = s->stream_config.num_xfers;
 
@@ -476,9 +520,7 @@ static void exec_running_state(struct bladerf_sync *s)
     /* Wake the API-side if an error occurred, so that it can propagate
      * the stream error code back to the API caller */
     if (status != 0) {
-        MUTEX_LOCK(&s->buf_mgmt.lock);
-        pthread_cond_signal(&s->buf_mgmt.buf_ready);
-        MUTEX_UNLOCK(&s->buf_mgmt.lock);
+        sync_event_notify(&s->buf_mgmt.buf_ready);
     }
 }
 
@@ -84,14 +84,11 @@ int sync_worker_init(struct bladerf_sync *s);
  * Shutdown and deinitialize
  *
  * @param       w       Worker to deinitialize
- * @param[in]   lock    Acquired to signal `cond` if non-NULL
- * @param[in]   cond    If non-NULL, this is signaled after requesting the
+ * @param[in]   event   If non-NULL, this is notified after requesting the
  *                      worker to shut down, waking a potentially blocked
  *                      workers.
  */
-void sync_worker_deinit(struct sync_worker *w,
-                        pthread_mutex_t *lock,
-                        pthread_cond_t *cond);
+void sync_worker_deinit(struct sync_worker *w, struct sync_event *event);
 
 /**
  * Wait for state change with optional timeout
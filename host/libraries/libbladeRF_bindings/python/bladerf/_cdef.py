@@ -301,6 +301,19 @@ header = """
     bladerf_correction corr, bladerf_correction_value value);
   int bladerf_get_correction(struct bladerf *dev, bladerf_channel ch,
     bladerf_correction corr, bladerf_correction_value *value);
+  struct bladerf_correction_profile {
+    bladerf_correction_value dcoff_i;
+    bladerf_correction_value dcoff_q;
+    bladerf_correction_value phase;
+    bladerf_correction_value gain;
+  };
+  int bladerf_set_correction_profile(struct bladerf *dev, bladerf_channel ch,
+    const struct bladerf_correction_profile *profile);
+  int bladerf_get_correction_profile(struct bladerf *dev, bladerf_channel ch,
+    struct bladerf_correction_profile *profile);
+  int bladerf_set_quick_tune_correction_profile(struct bladerf *dev,
+    bladerf_channel ch, const struct bladerf_quick_tune *quick_tune,
+    const struct bladerf_correction_profile *profile);
   typedef enum
   {
     BLADERF_FORMAT_SC16_Q11,
@@ -0,0 +1,440 @@
+#include <libbladeRF.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "helpers/sample_convert.h"
+
+#ifndef ARRAY_SIZE
+#define ARRAY_SIZE(n) (sizeof(n) / sizeof(n[0]))
+#endif  // !ARRAY_SIZE
+
+#define PRINT_INFO(...) printf(__VA_ARGS__)
+#define PRINT_ERROR(...) printf(__VA_ARGS__)
+
+/* Odd lengths exercise the scalar tails of the vector kernels */
+static size_t const lengths[] = { 16384, 16386, 37, 1 };
+
+/* Every SC16Q11 value survives a trip through each host format */
+static int test_sc16_round_trip(bladerf_host_format host_fmt, size_t n)
+{
+    int16_t *in   = calloc(n, 2 * sizeof(int16_t));
+    int16_t *out  = calloc(n, 2 * sizeof(int16_t));
+    double *host  = calloc(n, 2 * sizeof(double));
+    int status    = -1;
+    size_t i;
+
+    if (in == NULL || out == NULL || host == NULL) {
+        PRINT_ERROR("%s: calloc failed\n", __FUNCTION__);
+        goto out;
+    }
+
+    for (i = 0; i < 2 * n; i++) {
+        in[i] = (int16_t)((i * 7) % 4096) - 2048;
+    }
+
+    status = _sample_convert_from_format(BLADERF_FORMAT_SC16_Q11, in,
+                                         (unsigned int)n, host_fmt, host, NULL);
+    if (status != (int)n) {
+        PRINT_ERROR("from_format returned %d\n", status);
+        status = -1;
+        goto out;
+    }
+
+    for (i = 0; i < 2 * n; i++) {
+        double expect = in[i] / 2048.0;
+        double actual;
+
+        switch (host_fmt) {
+            case BLADERF_HOST_FORMAT_CF32:
+                actual = ((float *)host)[i];
+                break;
+            case BLADERF_HOST_FORMAT_CF64:
+                actual = host[i];
+                break;
+            default:
+                actual = ((int16_t *)host)[i] / 32768.0;
+                break;
+        }
+
+        if (fabs(actual - expect) > 1e-6) {
+            PRINT_ERROR("sample %zu: expected %f, got %f\n", i, expect, actual);
+            status = -1;
+            goto out;
+        }
+    }
+
+    status = _sample_convert_to_format(host_fmt, host, BLADERF_FORMAT_SC16_Q11,
+                                       out, (unsigned int)n, NULL);
+    if (status != (int)n) {
+        PRINT_ERROR("to_format returned %d\n", status);
+        status = -1;
+        goto out;
+    }
+
+    if (memcmp(in, out, n * 2 * sizeof(int16_t)) != 0) {
+        PRINT_ERROR("round trip mismatch\n");
+        status = -1;
+        goto out;
+    }
+
+    status = 0;
+
+out:
+    free(host);
+    free(out);
+    free(in);
+    return status;
+}
+
+/* Float to SC8Q7 and SC16Q11 conversions round and saturate */
+static int test_saturation(size_t n)
+{
+    float *in   = calloc(n, 2 * sizeof(float));
+    int16_t *sc16 = calloc(n, 2 * sizeof(int16_t));
+    int8_t *sc8 = calloc(n, 2 * sizeof(int8_t));
+    int status  = -1;
+    size_t i;
+
+    if (in == NULL || sc16 == NULL || sc8 == NULL) {
+        PRINT_ERROR("%s: calloc failed\n", __FUNCTION__);
+        goto out;
+    }
+
+    for (i = 0; i < 2 * n; i++) {
+        in[i] = -2.0f + 4.0f * (float)i / (float)(2 * n);
+    }
+
+    status = _sample_convert_to_format(BLADERF_HOST_FORMAT_CF32, in,
+                                       BLADERF_FORMAT_SC16_Q11, sc16,
+                                       (unsigned int)n, NULL);
+    if (status != (int)n) {
+        PRINT_ERROR("SC16 to_format returned %d\n", status);
+        status = -1;
+        goto out;
+    }
+
+    status = _sample_convert_to_format(BLADERF_HOST_FORMAT_CF32, in,
+                                       BLADERF_FORMAT_SC8_Q7, sc8,
+                                       (unsigned int)n, NULL);
+    if (status != (int)n) {
+        PRINT_ERROR("SC8 to_format returned %d\n", status);
+        status = -1;
+        goto out;
+    }
+
+    for (i = 0; i < 2 * n; i++) {
+        double e16 = fmin(fmax(in[i] * 2048.0, -2048.0), 2047.0);
+        double e8  = fmin(fmax(in[i] * 128.0, -128.0), 127.0);
+
+        /* Allow for differences in how ties are rounded */
+        if (fabs(sc16[i] - e16) > 0.5 || fabs(sc8[i] - e8) > 0.5) {
+            PRINT_ERROR("sample %zu (%f): got %d/%d\n", i, in[i], sc16[i],
+                        sc8[i]);
+            status = -1;
+            goto out;
+        }
+    }
+
+    status = 0;
+
+out:
+    free(sc8);
+    free(sc16);
+    free(in);
+    return status;
+}
+
+/* Conversions to SC8Q7 and SC16Q11 round exact ties away from zero, whichever
+ * kernel handles a sample */
+static int test_ties(bladerf_host_format host_fmt, size_t n)
+{
+    struct {
+        bladerf_format fmt;
+        double full_scale;
+    } const outputs[] = {
+        { BLADERF_FORMAT_SC16_Q11, 2048.0 },
+        { BLADERF_FORMAT_SC8_Q7, 128.0 },
+    };
+    float *in32  = calloc(n, 2 * sizeof(float));
+    double *in64 = calloc(n, 2 * sizeof(double));
+    int16_t *out = calloc(n, 2 * sizeof(int16_t));
+    void *in     = (host_fmt == BLADERF_HOST_FORMAT_CF64) ? (void *)in64
+                                                          : (void *)in32;
+    int status   = -1;
+    size_t i, o;
+
+    if (in32 == NULL || in64 == NULL || out == NULL) {
+        PRINT_ERROR("%s: calloc failed\n", __FUNCTION__);
+        goto out;
+    }
+
+    for (o = 0; o < ARRAY_SIZE(outputs); o++) {
+        bool const sc8 = (outputs[o].fmt == BLADERF_FORMAT_SC8_Q7);
+
+        /* Halfway between two output values, from -63.5 to 63.5 */
+        for (i = 0; i < 2 * n; i++) {
+            in64[i] = ((double)(i % 128) - 63.5) / outputs[o].full_scale;
+            in32[i] = (float)in64[i];
+        }
+
+        status = _sample_convert_to_format(host_fmt, in, outputs[o].fmt, out,
+                                           (unsigned int)n, NULL);
+        if (status != (int)n) {
+            PRINT_ERROR("to_format returned %d\n", status);
+            status = -1;
+            goto out;
+        }
+
+        for (i = 0; i < 2 * n; i++) {
+            double const y = (double)(i % 128) - 63.5;
+            int const expect = (int)((y >= 0.0) ? y + 0.5 : y - 0.5);
+            int const actual = sc8 ? ((int8_t *)out)[i] : out[i];
+
+            if (actual != expect) {
+                PRINT_ERROR("sample %zu (%.1f): got %d, expected %d\n", i, y,
+                            actual, expect);
+                status = -1;
+                goto out;
+            }
+        }
+    }
+
+    status = 0;
+
+out:
+    free(out);
+    free(in64);
+    free(in32);
+    return status;
+}
+
+/* Headers in metadata messages are skipped on read and preserved on write */
+static int test_meta_messages(void)
+{
+    unsigned int const msg_size = 64;
+    unsigned int const num_msgs = 4;
+    unsigned int const per_msg  = (msg_size - 16) / 4;
+    unsigned int const n        = num_msgs * msg_size / 4;
+    struct bladerf_conversion conv;
+    uint8_t buf[4 * 64], out[4 * 64];
+    float host[2 * 4 * 12];
+    unsigned int m, i;
+    int status;
+
+    memset(&conv, 0, sizeof(conv));
+    conv.msg_size = msg_size;
+
+    for (i = 0; i < sizeof(buf); i++) {
+        buf[i] = (uint8_t)i;
+    }
+
+    status = _sample_convert_from_format(BLADERF_FORMAT_SC16_Q11_META, buf, n,
+                                         BLADERF_HOST_FORMAT_CF32, host, &conv);
+    if (status != (int)(num_msgs * per_msg)) {
+        PRINT_ERROR("from_format returned %d\n", status);
+        return -1;
+    }
+
+    for (m = 0; m < num_msgs; m++) {
+        int16_t const *payload = (int16_t *)(buf + m * msg_size + 16);
+
+        for (i = 0; i < 2 * per_msg; i++) {
+            if (host[2 * m * per_msg + i] != payload[i] / 2048.0f) {
+                PRINT_ERROR("message %u sample %u mismatch\n", m, i);
+                return -1;
+            }
+        }
+    }
+
+    memset(out, 0xa5, sizeof(out));
+
+    status = _sample_convert_to_format(BLADERF_HOST_FORMAT_CF32, host,
+                                       BLADERF_FORMAT_SC16_Q11_META, out, n,
+                                       &conv);
+    if (status != (int)(num_msgs * per_msg)) {
+        PRINT_ERROR("to_format returned %d\n", status);
+        return -1;
+    }
+
+    for (m = 0; m < num_msgs; m++) {
+        for (i = 0; i < 16; i++) {
+            if (out[m * msg_size + i] != 0xa5) {
+                PRINT_ERROR("message %u header was modified\n", m);
+                return -1;
+            }
+        }
+    }
+
+    /* Samples in buf are arbitrary, so only in-range values round trip */
+    for (m = 0; m < num_msgs; m++) {
+        int16_t const *expect = (int16_t *)(buf + m * msg_size + 16);
+        int16_t const *actual = (int16_t *)(out + m * msg_size + 16);
+
+        for (i = 0; i < 2 * per_msg; i++) {
+            int16_t e = expect[i];
+
+            e = (e < -2048) ? -2048 : ((e > 2047) ? 2047 : e);
+            if (actual[i] != e) {
+                PRINT_ERROR("message %u sample %u: %d != %d\n", m, i,
+                            actual[i], e);
+                return -1;
+            }
+        }
+    }
+
+    conv.msg_size = 60;
+    status = _sample_convert_from_format(BLADERF_FORMAT_SC16_Q11_META, buf, n,
+                                         BLADERF_HOST_FORMAT_CF32, host, &conv);
+    if (status != BLADERF_ERR_INVAL) {
+        PRINT_ERROR("bad message size returned %d\n", status);
+        return -1;
+    }
+
+    return 0;
+}
+
+/* A constant offset is tracked and removed across successive buffers */
+static int test_dc_removal(size_t n)
+{
+    int8_t *in  = calloc(n, 2 * sizeof(int8_t));
+    float *out  = calloc(n, 2 * sizeof(float));
+    struct bladerf_conversion conv;
+    double expect[2], mean[2];
+    int status = -1;
+    size_t i;
+    int iter;
+
+    if (in == NULL || out == NULL) {
+        PRINT_ERROR("%s: calloc failed\n", __FUNCTION__);
+        goto out;
+    }
+
+    /* Square wave of amplitude 32 around roughly (+40, -24) */
+    expect[0] = expect[1] = 0.0;
+    for (i = 0; i < n; i++) {
+        int8_t ac = (i & 1) ? 32 : -32;
+        in[2 * i]     = (int8_t)(40 + ac);
+        in[2 * i + 1] = (int8_t)(-24 - ac);
+        expect[0] += in[2 * i] / 128.0 / n;
+        expect[1] += in[2 * i + 1] / 128.0 / n;
+    }
+
+    memset(&conv, 0, sizeof(conv));
+    conv.scale     = 2.0f;
+    conv.remove_dc = true;
+    conv.dc_alpha  = 0.5f;
+
+    for (iter = 0; iter < 24; iter++) {
+        status = _sample_convert_from_format(BLADERF_FORMAT_SC8_Q7, in,
+                                             (unsigned int)n,
+                                             BLADERF_HOST_FORMAT_CF32, out,
+                                             &conv);
+        if (status != (int)n) {
+            PRINT_ERROR("from_format returned %d\n", status);
+            status = -1;
+            goto out;
+        }
+    }
+
+    mean[0] = mean[1] = 0.0;
+    for (i = 0; i < n; i++) {
+        mean[0] += out[2 * i];
+        mean[1] += out[2 * i + 1];
+    }
+    mean[0] /= n;
+    mean[1] /= n;
+
+    if (fabs(conv.dc_i - expect[0]) > 1e-4 ||
+        fabs(conv.dc_q - expect[1]) > 1e-4 || fabs(mean[0]) > 1e-3 ||
+        fabs(mean[1]) > 1e-3) {
+        PRINT_ERROR("DC estimate (%f, %f), residual (%f, %f)\n", conv.dc_i,
+                    conv.dc_q, mean[0], mean[1]);
+        status = -1;
+        goto out;
+    }
+
+    /* What remains is scaled */
+    if (fabs(out[0] - 2.0 * (in[0] / 128.0 - expect[0])) > 1e-3) {
+        PRINT_ERROR("scaled sample: %f\n", out[0]);
+        status = -1;
+        goto out;
+    }
+
+    status = 0;
+
+out:
+    free(out);
+    free(in);
+    return status;
+}
+
+/* it's main */
+int main(int argc, char *argv[])
+{
+    bladerf_host_format const host_fmts[] = {
+        BLADERF_HOST_FORMAT_CF32,
+        BLADERF_HOST_FORMAT_CF64,
+        BLADERF_HOST_FORMAT_CI16,
+    };
+    int status = 0;
+    size_t f, l;
+
+    PRINT_INFO("Using %s kernels\n", _sample_convert_kernel_name());
+
+    for (l = 0; l < ARRAY_SIZE(lengths); ++l) {
+        for (f = 0; f < ARRAY_SIZE(host_fmts); ++f) {
+            PRINT_INFO("SC16Q11 round trip, format %d, %zu samples... ",
+                       host_fmts[f], lengths[l]);
+            status = test_sc16_round_trip(host_fmts[f], lengths[l]);
+            if (status < 0) {
+                goto error;
+            }
+            PRINT_INFO("good!\n");
+        }
+
+        PRINT_INFO("Saturation, %zu samples... ", lengths[l]);
+        status = test_saturation(lengths[l]);
+        if (status < 0) {
+            goto error;
+        }
+        PRINT_INFO("good!\n");
+
+        for (f = 0; f < ARRAY_SIZE(host_fmts); ++f) {
+            /* Integer samples are never rounded */
+            if (host_fmts[f] == BLADERF_HOST_FORMAT_CI16) {
+                continue;
+            }
+
+            PRINT_INFO("Rounding ties, format %d, %zu samples... ",
+                       host_fmts[f], lengths[l]);
+            status = test_ties(host_fmts[f], lengths[l]);
+            if (status < 0) {
+                goto error;
+            }
+            PRINT_INFO("good!\n");
+        }
+
+        PRINT_INFO("DC removal, %zu samples... ", lengths[l]);
+        status = test_dc_removal(lengths[l]);
+        if (status < 0) {
+            goto error;
+        }
+        PRINT_INFO("good!\n");
+    }
+
+    PRINT_INFO("Metadata messages... ");
+    status = test_meta_messages();
+    if (status < 0) {
+        goto error;
+    }
+    PRINT_INFO("good!\n");
+
+error:
+    if (status < 0) {
+        PRINT_ERROR("test returned %d, failing\n", status);
+    }
+
+    return status;
+}
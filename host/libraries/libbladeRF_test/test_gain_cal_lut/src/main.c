@@ -0,0 +1,275 @@
+#include <libbladeRF.h>
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "helpers/gain_cal_lut.h"
+
+#ifndef ARRAY_SIZE
+#define ARRAY_SIZE(n) (sizeof(n) / sizeof(n[0]))
+#endif  // !ARRAY_SIZE
+
+#define PRINT_INFO(...) printf(__VA_ARGS__)
+#define PRINT_ERROR(...) printf(__VA_ARGS__)
+
+/* Number of lookups made per table, in addition to those at each entry */
+#define NUM_RANDOM_LOOKUPS 100001
+
+/* Largest number of points in a lookup */
+#define LUT_MAX_LEN 8192u
+
+/* Reference interpolation: a binary search of the table for the entries
+ * surrounding a frequency, as done by get_gain_cal_entry() */
+static double reference_corr(const struct bladerf_gain_cal_tbl *tbl,
+                             bladerf_frequency freq)
+{
+    const struct bladerf_gain_cal_entry *floor_entry, *ceil_entry;
+    int32_t low  = 0;
+    int32_t high = tbl->n_entries - 1;
+    int32_t mid;
+
+    while (low <= high && high >= 0) {
+        mid = (low + high) / 2;
+        if (tbl->entries[mid].freq == freq) {
+            return tbl->entries[mid].gain_corr;
+        } else if (tbl->entries[mid].freq < freq) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+
+    /* Below the start of the table, the first entry is used */
+    floor_entry = (high >= 0) ? &tbl->entries[high] : &tbl->entries[0];
+    ceil_entry  = &tbl->entries[low];
+
+    if (floor_entry->freq == ceil_entry->freq) {
+        return floor_entry->gain_corr;
+    }
+
+    return floor_entry->gain_corr +
+           (freq - floor_entry->freq) *
+               (ceil_entry->gain_corr - floor_entry->gain_corr) /
+               (ceil_entry->freq - floor_entry->freq);
+}
+
+/* A smooth gain correction curve, in dB */
+static double model_corr(bladerf_frequency freq)
+{
+    return 3.0 * sin((double)freq / 3.0e8) + 1.0e-9 * (double)freq;
+}
+
+/* Fills in a table of n entries, the first at start and each following one
+ * spacing Hz, plus up to jitter Hz, after the previous. Every fifth entry is
+ * a further skip Hz along. */
+static int make_tbl(struct bladerf_gain_cal_tbl *tbl,
+                    uint32_t n,
+                    bladerf_frequency start,
+                    bladerf_frequency spacing,
+                    bladerf_frequency jitter,
+                    bladerf_frequency skip)
+{
+    bladerf_frequency freq = start;
+    uint32_t i;
+
+    memset(tbl, 0, sizeof(*tbl));
+
+    tbl->entries = calloc(n, sizeof(tbl->entries[0]));
+    if (NULL == tbl->entries) {
+        PRINT_ERROR("failed to allocate table entries\n");
+        return -1;
+    }
+
+    for (i = 0; i < n; ++i) {
+        if (i > 0 && i % 5 == 0) {
+            freq += skip;
+        }
+
+        tbl->entries[i].freq      = freq;
+        tbl->entries[i].gain_corr = model_corr(freq);
+
+        freq += spacing;
+        if (jitter > 0) {
+            freq += (bladerf_frequency)rand() % (jitter + 1);
+        }
+    }
+
+    tbl->n_entries  = n;
+    tbl->start_freq = tbl->entries[0].freq;
+    tbl->stop_freq  = tbl->entries[n - 1].freq;
+    tbl->state      = BLADERF_GAIN_CAL_LOADED;
+
+    return 0;
+}
+
+/* Compiles a lookup for tbl, and compares lookups at every entry, at the
+ * ends of the table, and at random frequencies across it against the
+ * reference interpolation. Lookups are made in batches of varying length, so
+ * that both the vector and scalar paths are used. */
+static int check_tbl(const char *name,
+                     const struct bladerf_gain_cal_tbl *tbl,
+                     bool expect_resampled,
+                     double tolerance)
+{
+    struct gain_cal_lut lut;
+    bladerf_frequency *freqs = NULL;
+    double *corrs            = NULL;
+    const size_t count = tbl->n_entries + NUM_RANDOM_LOOKUPS + 3;
+    const bladerf_frequency span = tbl->stop_freq - tbl->start_freq;
+    double max_err = 0.0;
+    size_t i, n, batch;
+    int status;
+
+    PRINT_INFO("%s: %u entries... ", name, tbl->n_entries);
+
+    memset(&lut, 0, sizeof(lut));
+
+    status = gain_cal_lut_compile(tbl, &lut);
+    if (status != 0) {
+        PRINT_ERROR("gain_cal_lut_compile returned %d\n", status);
+        return -1;
+    }
+
+    status = -1;
+
+    /* A coarsened grid fills the lookup */
+    if (lut.len > LUT_MAX_LEN ||
+        (expect_resampled && lut.len != LUT_MAX_LEN)) {
+        PRINT_ERROR("lookup has %u points, which is unexpected\n", lut.len);
+        goto out;
+    }
+
+    freqs = calloc(count, sizeof(freqs[0]));
+    corrs = calloc(count, sizeof(corrs[0]));
+    if (NULL == freqs || NULL == corrs) {
+        PRINT_ERROR("failed to allocate lookups\n");
+        goto out;
+    }
+
+    n          = 0;
+    freqs[n++] = tbl->stop_freq;
+    freqs[n++] = tbl->start_freq;
+    freqs[n++] = (tbl->start_freq > 0) ? tbl->start_freq - 1 : 0;
+
+    for (i = 0; i < tbl->n_entries; ++i) {
+        freqs[n++] = tbl->entries[i].freq;
+    }
+
+    for (i = 0; i < NUM_RANDOM_LOOKUPS; ++i) {
+        uint64_t r = ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+        freqs[n++] = tbl->start_freq + ((span > 0) ? r % (span + 1) : 0);
+    }
+
+    for (i = 0, batch = 1; i < count; i += batch, batch = batch % 7 + 1) {
+        if (batch > count - i) {
+            batch = count - i;
+        }
+
+        gain_cal_lut_lookup(&lut, freqs + i, (unsigned int)batch, corrs + i);
+    }
+
+    for (i = 0; i < count; ++i) {
+        const double expect = reference_corr(tbl, freqs[i]);
+        const double err    = fabs(corrs[i] - expect);
+
+        if (err > max_err) {
+            max_err = err;
+        }
+
+        if (err > tolerance) {
+            PRINT_ERROR("%" PRIu64 " Hz: got %.9f, expected %.9f\n", freqs[i],
+                        corrs[i], expect);
+            goto out;
+        }
+    }
+
+    PRINT_INFO("%u points, max error %g dB, good!\n", lut.len, max_err);
+    status = 0;
+
+out:
+    free(freqs);
+    free(corrs);
+    gain_cal_lut_free(&lut);
+    return status;
+}
+
+/* Checks that a table with a descending entry is rejected */
+static int check_unsorted(void)
+{
+    struct gain_cal_lut lut;
+    struct bladerf_gain_cal_tbl tbl;
+    int status;
+
+    PRINT_INFO("unsorted table... ");
+
+    if (make_tbl(&tbl, 16, 100000000, 1000000, 0, 0) != 0) {
+        return -1;
+    }
+
+    tbl.entries[9].freq = tbl.entries[7].freq;
+
+    memset(&lut, 0, sizeof(lut));
+    status = gain_cal_lut_compile(&tbl, &lut);
+    gain_cal_lut_free(&lut);
+    free(tbl.entries);
+
+    if (status != BLADERF_ERR_INVAL) {
+        PRINT_ERROR("gain_cal_lut_compile returned %d\n", status);
+        return -1;
+    }
+
+    PRINT_INFO("rejected, good!\n");
+    return 0;
+}
+
+/* it's main */
+int main(int argc, char *argv[])
+{
+    struct bladerf_gain_cal_tbl tbl;
+    int status = 0;
+    size_t i;
+
+    const struct {
+        const char *name;
+        uint32_t n;
+        bladerf_frequency start, spacing, jitter, skip;
+        bool resampled;
+        double tolerance;
+    } cases[] = {
+        /* Uniform spacing: a grid point on every entry */
+        { "uniform", 594, 70000000, 10000000, 0, 0, false, 1e-9 },
+        /* Irregular, but on a 1 MHz grid: still exact */
+        { "irregular", 900, 300000000, 1000000, 0, 3000000, false, 1e-9 },
+        /* Arbitrary offsets require a coarser grid than the entries. The
+         * resampling error of the smooth curve is well below 0.001 dB. */
+        { "coarsened", 1190, 70000000, 5000000, 997, 0, true, 1e-3 },
+        /* A single entry applies everywhere */
+        { "single entry", 1, 2400000000u, 0, 0, 0, false, 0.0 },
+    };
+
+    srand(1);
+
+    for (i = 0; i < ARRAY_SIZE(cases) && status == 0; ++i) {
+        status = make_tbl(&tbl, cases[i].n, cases[i].start, cases[i].spacing,
+                          cases[i].jitter, cases[i].skip);
+        if (status != 0) {
+            break;
+        }
+
+        status = check_tbl(cases[i].name, &tbl, cases[i].resampled,
+                           cases[i].tolerance);
+        free(tbl.entries);
+    }
+
+    if (status == 0) {
+        status = check_unsorted();
+    }
+
+    if (status < 0) {
+        PRINT_ERROR("test returned %d, failing\n", status);
+    }
+
+    return status;
+}
@@ -1,5 +1,7 @@
 #include <libbladeRF.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "helpers/interleave.h"
 
@@ -11,6 +13,10 @@
 #define max(x, y) x > y ? x : y
 #endif  // !max
 
+#ifndef ARRAY_SIZE
+#define ARRAY_SIZE(n) (sizeof(n) / sizeof(n[0]))
+#endif  // !ARRAY_SIZE
+
 #define PRINT_VERBOSE(...)                 \
     {                                      \
         verbose ? printf(__VA_ARGS__) : 0; \
@@ -282,8 +288,141 @@ error:
     return status;
 }
 
-/* it's main */
-int main(int argc, char *argv[])
+/* Executes a test case that deinterleaves a buffer of num_samples into
+ * separate per-channel arrays and back again, comparing against a simple
+ * sample-by-sample reference */
+int test_channels(bladerf_channel_layout layout,
+                  bladerf_format format,
+                  size_t num_samples)
+{
+    void *buf = NULL, *out = NULL;
+    void *chbufs[INTERLEAVE_MAX_CHANNELS] = { NULL };
+    int status = -1;
+    size_t ch, samp;
+
+    size_t const samplesize = _interleave_calc_bytes_per_sample(format);
+    size_t const offset     = _interleave_calc_metadata_bytes(format);
+    size_t const num_chan   = _interleave_calc_num_channels(layout);
+    size_t const bytes      = samplesize * num_samples;
+    size_t const per_ch     = (bytes - offset) / num_chan / samplesize;
+
+    PRINT_INFO("beginning per-channel test: layout = %d, format = %d, "
+               "num_samples = %zu, kernels = %s... ",
+               layout, format, num_samples, _interleave_kernel_name());
+
+    buf = create_buf(bytes);
+    out = calloc(bytes, 1);
+    if (NULL == buf || NULL == out) {
+        PRINT_ERROR("failed to allocate buffers\n");
+        goto error;
+    }
+
+    for (ch = 0; ch < num_chan; ++ch) {
+        chbufs[ch] = calloc(per_ch, samplesize);
+        if (NULL == chbufs[ch]) {
+            PRINT_ERROR("failed to allocate channel buffer\n");
+            goto error;
+        }
+    }
+
+    status = _interleave_deinterleave_to_channels(
+        layout, format, (unsigned int)num_samples, buf, chbufs);
+    if (status != 0) {
+        PRINT_ERROR("deinterleaver returned %d\n", status);
+        goto error;
+    }
+
+    for (ch = 0; ch < num_chan; ++ch) {
+        for (samp = 0; samp < per_ch; ++samp) {
+            uint8_t const *expect = (uint8_t *)buf + offset +
+                                    (samp * num_chan + ch) * samplesize;
+            uint8_t const *actual = (uint8_t *)chbufs[ch] + samp * samplesize;
+
+            if (memcmp(expect, actual, samplesize) != 0) {
+                PRINT_ERROR("ch %zu sample %zu mismatch\n", ch, samp);
+                status = -1;
+                goto error;
+            }
+        }
+    }
+
+    memcpy(out, buf, offset);
+
+    status = _interleave_interleave_from_channels(
+        layout, format, (unsigned int)num_samples,
+        (const void *const *)chbufs, out);
+    if (status != 0) {
+        PRINT_ERROR("interleaver returned %d\n", status);
+        goto error;
+    }
+
+    if (memcmp(buf, out, offset + per_ch * num_chan * samplesize) != 0) {
+        PRINT_ERROR("round trip mismatch\n");
+        status = -1;
+        goto error;
+    }
+
+    PRINT_INFO("good!\n");
+
+error:
+    for (ch = 0; ch < num_chan; ++ch) {
+        free(chbufs[ch]);
+    }
+    free(out);
+    free(buf);
+    return status;
+}
+
+/* Round-trips a buffer through the _scratch variants, with a scratch buffer
+ * owned by the caller */
+int test_scratch(size_t num_samples)
+{
+    bladerf_format const format = BLADERF_FORMAT_SC16_Q11_META;
+    size_t const bytes =
+        _interleave_calc_bytes_per_sample(format) * num_samples;
+    void *scratch = NULL;
+    void *buf     = NULL;
+    int status    = -1;
+
+    PRINT_INFO("beginning scratch buffer test: num_samples = %zu... ",
+               num_samples);
+
+    scratch = malloc(bytes);
+    if (NULL == scratch) {
+        PRINT_ERROR("failed to allocate scratch buffer\n");
+        return -1;
+    }
+
+    buf = create_buf(bytes);
+    if (NULL == buf) {
+        PRINT_ERROR("failed to create_buf\n");
+        free(scratch);
+        return -1;
+    }
+
+    status = _interleave_interleave_buf_scratch(
+        BLADERF_TX_X2, format, (unsigned int)num_samples, buf, scratch);
+    if (status == 0) {
+        status = _interleave_deinterleave_buf_scratch(
+            BLADERF_RX_X2, format, (unsigned int)num_samples, buf, scratch);
+    }
+
+    if (status != 0) {
+        PRINT_ERROR("(de)interleaver returned %d\n", status);
+    } else if (!check_buf(buf, bytes, 4, 1, 0)) {
+        PRINT_ERROR("check_buf returned FALSE!\n");
+        status = -1;
+    } else {
+        PRINT_INFO("good!\n");
+    }
+
+    free(buf);
+    free(scratch);
+    return status;
+}
+
+/* Runs every test case with the currently selected kernels */
+int run_tests(void)
 {
     int status               = 0;
     size_t const NUM_SAMPLES = 16384;
@@ -293,13 +432,13 @@ int main(int argc, char *argv[])
     status = test(BLADERF_RX_X1, BLADERF_TX_X1, BLADERF_FORMAT_SC16_Q11,
                   NUM_SAMPLES);
     if (status < 0) {
-        goto error;
+        return status;
     }
 
     status = test(BLADERF_RX_X1, BLADERF_TX_X1, BLADERF_FORMAT_SC16_Q11_META,
                   NUM_SAMPLES);
     if (status < 0) {
-        goto error;
+        return status;
     }
 
     PRINT_INFO("*** BEGINNING 2-CHANNEL TESTS\n");
@@ -307,13 +446,75 @@ int main(int argc, char *argv[])
     status = test(BLADERF_RX_X2, BLADERF_TX_X2, BLADERF_FORMAT_SC16_Q11,
                   NUM_SAMPLES);
     if (status < 0) {
-        goto error;
+        return status;
     }
 
     status = test(BLADERF_RX_X2, BLADERF_TX_X2, BLADERF_FORMAT_SC16_Q11_META,
                   NUM_SAMPLES);
     if (status < 0) {
-        goto error;
+        return status;
+    }
+
+    PRINT_INFO("*** BEGINNING SCRATCH BUFFER TESTS\n");
+
+    status = test_scratch(NUM_SAMPLES);
+    if (status < 0) {
+        return status;
+    }
+
+    PRINT_INFO("*** BEGINNING PER-CHANNEL TESTS\n");
+
+    {
+        bladerf_channel_layout const layouts[] = { BLADERF_RX_X1,
+                                                   BLADERF_RX_X2 };
+        bladerf_format const formats[] = {
+            BLADERF_FORMAT_SC16_Q11, BLADERF_FORMAT_SC16_Q11_META,
+            BLADERF_FORMAT_SC8_Q7, BLADERF_FORMAT_SC8_Q7_META,
+        };
+        /* Odd lengths exercise the scalar tails of the vector kernels */
+        size_t const lengths[] = { NUM_SAMPLES, NUM_SAMPLES + 2, 70 };
+        size_t l, f, n;
+
+        for (l = 0; l < ARRAY_SIZE(layouts); ++l) {
+            for (f = 0; f < ARRAY_SIZE(formats); ++f) {
+                for (n = 0; n < ARRAY_SIZE(lengths); ++n) {
+                    status = test_channels(layouts[l], formats[f], lengths[n]);
+                    if (status < 0) {
+                        return status;
+                    }
+                }
+            }
+        }
+    }
+
+    return status;
+}
+
+/* it's main */
+int main(int argc, char *argv[])
+{
+    int status = 0;
+    unsigned int k;
+
+    /* Check each kernel set against the reference patterns, not just the
+     * one that would be selected for this CPU */
+    for (k = 0; k < _interleave_num_kernels(); ++k) {
+        status = _interleave_select_kernel(k);
+        if (BLADERF_ERR_UNSUPPORTED == status) {
+            PRINT_INFO("*** SKIPPING KERNEL SET %u: not supported by this "
+                       "CPU\n", k);
+            status = 0;
+            continue;
+        } else if (status != 0) {
+            goto error;
+        }
+
+        PRINT_INFO("*** TESTING %s KERNELS\n", _interleave_kernel_name());
+
+        status = run_tests();
+        if (status < 0) {
+            goto error;
+        }
     }
 
 error:
@@ -151,6 +151,63 @@ int run_test(struct bladerf *dev, uint32_t iterations)
         }
     }
 
+    /* Each frequency should have been assigned its own profile */
+    if (strcmp(board_name, "bladerf2") == 0) {
+        struct bladerf_quick_tune_stats stats;
+
+        status = bladerf_get_quick_tune_stats(dev, BLADERF_TX, &stats);
+        if (status != 0) {
+            fprintf(stderr, "Failed to get quick tune stats: %s\n",
+                    bladerf_strerror(status));
+            goto out;
+        }
+
+        printf("Quick tune profiles: %u, hits: %" PRIu64 ", misses: %" PRIu64
+               "\n", stats.profiles, stats.hits, stats.misses);
+
+        if (stats.profiles < NUM_FREQS) {
+            fprintf(stderr, "Unexpected quick tune profile reuse\n");
+            status = -1;
+            goto out;
+        }
+    }
+
+    /* A hop set built in a single call should agree with the above */
+    {
+        bladerf_frequency hop_freqs[NUM_FREQS];
+        struct bladerf_quick_tune hop_qts[NUM_FREQS];
+        bool match;
+
+        for( f = 0; f < NUM_FREQS; f++ ) {
+            hop_freqs[f] = freqs[f].f;
+        }
+
+        status = bladerf_build_hop_set(dev, BLADERF_CHANNEL_TX(0), hop_freqs,
+                                       NUM_FREQS, hop_qts);
+        if (status != 0) {
+            fprintf(stderr, "Failed to build hop set: %s\n",
+                    bladerf_strerror(status));
+            goto out;
+        }
+
+        for( f = 0; f < NUM_FREQS; f++ ) {
+            if (strcmp(board_name, "bladerf1") == 0) {
+                match = hop_qts[f].freqsel == freqs[f].qt.freqsel &&
+                        hop_qts[f].nint == freqs[f].qt.nint &&
+                        hop_qts[f].nfrac == freqs[f].qt.nfrac;
+            } else {
+                match = hop_qts[f].nios_profile == freqs[f].qt.nios_profile &&
+                        hop_qts[f].profile_gen == freqs[f].qt.profile_gen;
+            }
+
+            if (!match) {
+                fprintf(stderr, "Hop set entry %u does not match\n", f);
+                status = -1;
+                goto out;
+            }
+        }
+    }
+
     /* Enable and run! */
 
     status = bladerf_enable_module(dev, BLADERF_CHANNEL_TX(0), true);
@@ -28,6 +28,7 @@
 #include <string.h>
 #include <errno.h>
 #include <limits.h>
+#include <inttypes.h>
 
 #include <libbladeRF.h>
 #include <getopt.h>
@@ -42,7 +43,11 @@
 
 #define RESET_EXPECTED  UINT32_MAX
 
-#define OPTSTR "hs:i:t:b:v"
+/* In acquire mode, the test stalls after this many blocks, for long enough
+ * that every stream buffer fills and samples are dropped */
+#define STALL_INTERVAL  2500
+
+#define OPTSTR "hs:i:t:b:va"
 const struct option long_options[] = {
     { "help",           no_argument,        0,          'h' },
     { "device",         required_argument,  0,          'd' },
@@ -50,6 +55,8 @@ const struct option long_options[] = {
     { "iterations",     required_argument,  0,          'i' },
     { "bitmode",        required_argument,  0,          'b' },
     { "verbose",        no_argument,        0,          'v' },
+    { "acquire",        no_argument,        0,          'a' },
+    { 0,                0,                  0,          0   },
 };
 
 const struct numeric_suffix freq_suffixes[] = {
@@ -72,6 +79,7 @@ struct app_params {
     unsigned int iterations;
     char *device_str;
     bladerf_format fmt;
+    bool acquire;
 };
 
 static void print_usage(const char *argv0)
@@ -87,6 +95,10 @@ static void print_usage(const char *argv0)
     printf("    -t, --test <test name>      Run the specified test.\n");
     printf("    -i, --iterations <count>    Run the specified number of iterations\n");
     printf("    -d, --device <devstr>       Device argument string\n");
+    printf("    -a, --acquire               Read metadata-formatted samples with\n"
+           "                                bladerf_sync_rx_acquire(), stalling\n"
+           "                                periodically, and check that each\n"
+           "                                resulting gap is reported.\n");
     printf("    -h, --help                  Print this help text.\n");
     printf("\n");
     printf("Available tests:\n");
@@ -143,6 +155,10 @@ int handle_cmdline(int argc, char *argv[], struct app_params *p)
                 bladerf_log_set_verbosity(BLADERF_LOG_LEVEL_VERBOSE);
                 break;
 
+            case 'a':
+                p->acquire = true;
+                break;
+
             case 'b':
                 if (strcmp(optarg, "16bit") == 0 || strcmp(optarg, "16") == 0) {
                     p->fmt = BLADERF_FORMAT_SC16_Q11;
@@ -277,6 +293,155 @@ out:
     return status;
 }
 
+/* Reads counter samples through the zero-copy interface. Each gap in the
+ * timestamps must be flagged as an overrun and counted in the stream
+ * statistics, and the samples within each acquired block must be contiguous */
+int run_acquire_test(struct bladerf *dev, struct app_params *p)
+{
+    int status;
+    uint32_t gpio_val, gpio_backup;
+    unsigned int i, j, n;
+    void *samples;
+    struct bladerf_metadata meta;
+    struct bladerf_stream_stats stats;
+    bladerf_format fmt;
+    bool have_expected = false;
+    uint64_t expected_ts = 0;
+    unsigned int overruns = 0, stalls = 0;
+    unsigned int stall_us;
+
+    /* Counter values are only checked sample-by-sample in 16-bit mode */
+    fmt = (p->fmt == BLADERF_FORMAT_SC8_Q7) ? BLADERF_FORMAT_SC8_Q7_META
+                                            : BLADERF_FORMAT_SC16_Q11_META;
+
+    /* Long enough for the device to fill every buffer, twice over */
+    stall_us = (unsigned int)(2e6 * NUM_BUFFERS * BUFFER_SIZE / p->samplerate);
+
+    status = bladerf_sync_config(dev,
+                                 BLADERF_MODULE_RX,
+                                 fmt,
+                                 NUM_BUFFERS,
+                                 BUFFER_SIZE,
+                                 NUM_XFERS,
+                                 TIMEOUT_MS);
+
+    if (status != 0) {
+        fprintf(stderr, "Failed to configure RX sync i/f: %s\n",
+                bladerf_strerror(status));
+        return status;
+    }
+
+    status = bladerf_config_gpio_read(dev, &gpio_val);
+    if (status != 0) {
+        fprintf(stderr, "Failed to read device IO configuration: %s\n",
+                bladerf_strerror(status));
+        return status;
+    }
+
+    gpio_backup = gpio_val;
+    gpio_val |= BLADERF_GPIO_COUNTER_ENABLE;
+
+    status = bladerf_config_gpio_write(dev, gpio_val);
+    if (status != 0) {
+        fprintf(stderr, "Failed to write device IO configuration: %s\n",
+                bladerf_strerror(status));
+        return status;
+    }
+
+    status = bladerf_enable_module(dev, BLADERF_MODULE_RX, true);
+    if (status != 0) {
+        fprintf(stderr, "Failed to enable RX module: %s\n",
+                bladerf_strerror(status));
+        goto out;
+    }
+
+    printf("Running %u iterations, stalling every %u.\n\n", p->iterations,
+           STALL_INTERVAL);
+
+    for (i = 0; i < p->iterations && status == 0; i++) {
+        memset(&meta, 0, sizeof(meta));
+        meta.flags = BLADERF_META_FLAG_RX_NOW;
+
+        status = bladerf_sync_rx_acquire(dev, &samples, &n, &meta, TIMEOUT_MS);
+        if (status != 0) {
+            fprintf(stderr, "\nRX acquire failed: %s\n",
+                    bladerf_strerror(status));
+            break;
+        }
+
+        if (meta.status & BLADERF_META_STATUS_OVERRUN) {
+            overruns++;
+
+            if (!have_expected || meta.timestamp == expected_ts) {
+                fprintf(stderr, "[%u] Overrun reported at t=%" PRIu64
+                        " without a discontinuity\n", i, meta.timestamp);
+                status = -1;
+            }
+        } else if (have_expected && meta.timestamp != expected_ts) {
+            fprintf(stderr, "[%u] Unreported discontinuity: expected t=%"
+                    PRIu64 ", got t=%" PRIu64 "\n", i, expected_ts,
+                    meta.timestamp);
+            status = -1;
+        }
+
+        if (fmt == BLADERF_FORMAT_SC16_Q11_META) {
+            const uint32_t *data = samples;
+
+            for (j = 1; j < n && status == 0; j++) {
+                if (data[j] != data[0] + j) {
+                    fprintf(stderr, "[%u] Expected 0x%08x, Got 0x%08x\n", i,
+                            data[0] + j, data[j]);
+                    status = -1;
+                }
+            }
+        }
+
+        expected_ts   = meta.timestamp + n;
+        have_expected = true;
+
+        if (bladerf_sync_rx_release(dev, n) != 0 && status == 0) {
+            fprintf(stderr, "\nRX release failed\n");
+            status = -1;
+        }
+
+        if (status == 0 && i % STALL_INTERVAL == STALL_INTERVAL - 1) {
+            printf("\rCurrent iteration %10u / %-10u, stalling\n", i,
+                   p->iterations);
+            fflush(stdout);
+
+            usleep(stall_us);
+            stalls++;
+        }
+    }
+
+    if (status == 0) {
+        status = bladerf_get_stream_stats(dev, BLADERF_RX, &stats);
+        if (status != 0) {
+            fprintf(stderr, "Failed to get stream stats: %s\n",
+                    bladerf_strerror(status));
+        } else if (stats.timestamp_discontinuities != overruns) {
+            fprintf(stderr, "%u overruns were reported, but the stream "
+                    "counted %" PRIu64 " discontinuities\n", overruns,
+                    stats.timestamp_discontinuities);
+            status = -1;
+        } else if (overruns < stalls) {
+            fprintf(stderr, "Only %u overruns were reported for %u stalls\n",
+                    overruns, stalls);
+            status = -1;
+        }
+    }
+
+    printf("\n\nDone. %u overruns reported for %u stalls.\n", overruns,
+           stalls);
+
+out:
+    if (bladerf_config_gpio_write(dev, gpio_backup) != 0) {
+        fprintf(stderr, "Failed to restore device IO configuration\n");
+    }
+
+    return status;
+}
+
 int main(int argc, char *argv[])
 {
     int status;
@@ -311,7 +476,11 @@ int main(int argc, char *argv[])
         goto out;
     }
 
-    status = run_test(dev, &params);
+    if (params.acquire) {
+        status = run_acquire_test(dev, &params);
+    } else {
+        status = run_test(dev, &params);
+    }
 
 out:
     bladerf_close(dev);
@@ -394,135 +394,12 @@ static struct dc_calibration_params * prepare_dc_cal_params(unsigned int f_min,
     return p;
 }
 
-static int save_table_results(const char *filename,
-                              struct bladerf *dev, bladerf_module module,
-                              const struct dc_calibration_params *params,
-                              size_t num_params)
-{
-    int status = 0;
-    struct bladerf_lms_dc_cals lms_dc_cals;
-    struct bladerf_image *image = NULL;
-    size_t i;
-    size_t off = 0;
-    uint32_t n_frequencies_le = 0;
-
-    static const uint16_t magic = HOST_TO_LE16_CONST(0x1ab1);
-    static const uint32_t reserved = HOST_TO_LE32_CONST(0x00000000);
-    static const uint32_t tbl_version = HOST_TO_LE32_CONST(0x00000002);
-    static const size_t lms_data_size = 10; /* 10 uint8_t register values */
-
-
-    const size_t entry_size = sizeof(uint32_t) +   /* Frequency */
-                              8 * sizeof(int16_t); /* DC I and Q valus */
-
-    const size_t table_size = num_params * entry_size;
-
-    const size_t data_size = sizeof(magic) + sizeof(reserved) +
-                             sizeof(tbl_version) + sizeof(n_frequencies_le) +
-                             lms_data_size + table_size;
-
-    assert(num_params < UINT32_MAX);
-    assert(data_size <= UINT_MAX);
-
-    n_frequencies_le = HOST_TO_LE32((uint32_t) num_params);
-
-    status = bladerf_lms_get_dc_cals(dev, &lms_dc_cals);
-    if (status != 0) {
-        return status;
-    }
-
-    if (module == BLADERF_MODULE_RX) {
-        image = bladerf_alloc_image(dev, BLADERF_IMAGE_TYPE_RX_DC_CAL,
-                                    0xffffffff, (unsigned int) data_size);
-    } else {
-        image = bladerf_alloc_image(dev, BLADERF_IMAGE_TYPE_TX_DC_CAL,
-                                    0xffffffff, (unsigned int) data_size);
-    }
-
-    if (image == NULL) {
-        return BLADERF_ERR_MEM;
-    }
-
-    /* Fill in header */
-    memcpy(&image->data[off], &magic, sizeof(magic));
-    off += sizeof(magic);
-
-    memcpy(&image->data[off], &reserved, sizeof(reserved));
-    off += sizeof(reserved);
-
-    memcpy(&image->data[off], &tbl_version, sizeof(tbl_version));
-    off += sizeof(tbl_version);
-
-    memcpy(&image->data[off], &n_frequencies_le, sizeof(n_frequencies_le));
-    off += sizeof(n_frequencies_le);
-
-    image->data[off++] = (uint8_t)lms_dc_cals.lpf_tuning;
-    image->data[off++] = (uint8_t)lms_dc_cals.tx_lpf_i;
-    image->data[off++] = (uint8_t)lms_dc_cals.tx_lpf_q;
-    image->data[off++] = (uint8_t)lms_dc_cals.rx_lpf_i;
-    image->data[off++] = (uint8_t)lms_dc_cals.rx_lpf_q;
-    image->data[off++] = (uint8_t)lms_dc_cals.dc_ref;
-    image->data[off++] = (uint8_t)lms_dc_cals.rxvga2a_i;
-    image->data[off++] = (uint8_t)lms_dc_cals.rxvga2a_q;
-    image->data[off++] = (uint8_t)lms_dc_cals.rxvga2b_i;
-    image->data[off++] = (uint8_t)lms_dc_cals.rxvga2b_q;
-
-    for (i = 0; i < num_params; i++) {
-        uint32_t freq;
-        int16_t corr_i, corr_q;
-        int16_t max_dc_i, max_dc_q;
-        int16_t mid_dc_i, mid_dc_q;
-        int16_t min_dc_i, min_dc_q;
-
-        freq   = HOST_TO_LE32((uint32_t) params[i].frequency);
-        corr_i = HOST_TO_LE16(params[i].corr_i);
-        corr_q = HOST_TO_LE16(params[i].corr_q);
-        max_dc_i = HOST_TO_LE16(params[i].max_dc_i);
-        max_dc_q = HOST_TO_LE16(params[i].max_dc_q);
-        mid_dc_i = HOST_TO_LE16(params[i].mid_dc_i);
-        mid_dc_q = HOST_TO_LE16(params[i].mid_dc_q);
-        min_dc_i = HOST_TO_LE16(params[i].min_dc_i);
-        min_dc_q = HOST_TO_LE16(params[i].min_dc_q);
-
-        memcpy(&image->data[off], &freq, sizeof(freq));
-        off += sizeof(freq);
-
-        memcpy(&image->data[off], &corr_i, sizeof(corr_i));
-        off += sizeof(corr_q);
-
-        memcpy(&image->data[off], &corr_q, sizeof(corr_q));
-        off += sizeof(corr_q);
-
-        memcpy(&image->data[off], &max_dc_i, sizeof(max_dc_i));
-        off += sizeof(max_dc_i);
-
-        memcpy(&image->data[off], &max_dc_q, sizeof(max_dc_q));
-        off += sizeof(max_dc_q);
-
-        memcpy(&image->data[off], &mid_dc_i, sizeof(mid_dc_i));
-        off += sizeof(mid_dc_i);
-
-        memcpy(&image->data[off], &mid_dc_q, sizeof(mid_dc_q));
-        off += sizeof(mid_dc_q);
-
-        memcpy(&image->data[off], &min_dc_i, sizeof(min_dc_i));
-        off += sizeof(min_dc_i);
-
-        memcpy(&image->data[off], &min_dc_q, sizeof(min_dc_q));
-        off += sizeof(min_dc_q);
-    }
-
-    status = bladerf_image_write(dev, image, filename);
-
-    bladerf_free_image(image);
-    return status;
-}
-
 /* See libbladeRF's dc_cal_table.c for the packed table data format */
 static int cal_table(struct cli_state *s, int argc, char **argv)
 {
     int status;
     bool ok;
+    bool fast = false;
     bladerf_module module;
     char *filename = NULL;
     size_t filename_len = 1024;
@@ -530,6 +407,7 @@ static int cal_table(struct cli_state *s, int argc, char **argv)
 
     struct dc_calibration_params *params = NULL;
     size_t num_params = 0;
+    size_t i;
 
     /* The XB-200 does not affect the minimum, as we're tuning the LMS here. */
     unsigned int f_min = BLADERF_FREQUENCY_MIN;
@@ -542,6 +420,12 @@ static int cal_table(struct cli_state *s, int argc, char **argv)
        return 0;
     }
 
+    /* Optional trailing argument, selecting a faster RX search */
+    if (argc > 4 && !strcasecmp(argv[argc - 1], "fast")) {
+        fast = true;
+        argc--;
+    }
+
     if (argc == 4 || argc == 6 || argc == 7) {
         /* Only DC tables are currently supported.
          * IQ tables may be added in the future */
@@ -668,12 +552,19 @@ static int cal_table(struct cli_state *s, int argc, char **argv)
         goto out;
     }
 
+    if (fast) {
+        for (i = 0; i < num_params; i++) {
+            params[i].search = DC_CAL_SEARCH_SECANT;
+        }
+    }
+
     status = dc_calibration(s->dev, module, params, num_params, true);
     if (status != 0) {
         goto out;
     }
 
-    status = save_table_results(filename, s->dev, module, params, num_params);
+    status = dc_calibration_save_table(s->dev, module, params, num_params,
+                                       filename);
     if (status == 0) {
         printf("\n  Done.\n\n");
     }
@@ -0,0 +1,607 @@
+/*
+ * This file is part of the bladeRF project
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#include <errno.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "host_config.h"
+
+#include "capture_file.h"
+#include "common.h"
+#include "minmax.h"
+#include "rel_assert.h"
+
+struct capture_writer {
+    FILE *file;
+    struct capture_params params;
+    unsigned int channels;
+    size_t sample_size;
+    int64_t start_time;
+
+    uint64_t num_blocks;     /* Blocks committed so far */
+    uint64_t num_samples;    /* Samples per channel committed so far */
+    uint64_t next_timestamp; /* Expected timestamp of the next block */
+    bool overrun;            /* The last block was cut short by an overrun */
+
+    struct capture_index_entry *index; /* In host byte order */
+    size_t index_len;
+    size_t index_cap;
+
+    /* Block filled by capture_writer_fill(), pending capture_writer_commit() */
+    struct {
+        bool filled;
+        uint64_t timestamp;
+        uint32_t flags;
+        unsigned int num_samples;
+        bool overrun;
+    } pending;
+};
+
+struct capture_reader {
+    FILE *file;
+    struct capture_params params;
+    size_t sample_size;
+    uint64_t data_offset;
+    uint64_t num_blocks; /* 0 if the capture was not finished */
+    uint64_t next_block;
+    uint8_t *buf;
+};
+
+static unsigned int layout_channels(bladerf_channel_layout layout)
+{
+    return (layout == BLADERF_RX_X2 || layout == BLADERF_TX_X2) ? 2 : 1;
+}
+
+static size_t format_sample_size(enum capture_sample_fmt format)
+{
+    /* I and Q are each an int8_t or int16_t */
+    return 2 * (format == CAPTURE_FMT_SC8Q7 ? sizeof(int8_t) : sizeof(int16_t));
+}
+
+/* Seek to an absolute offset, which may exceed the range of a long */
+static int seek_to(FILE *file, uint64_t offset)
+{
+#if BLADERF_OS_WINDOWS
+    return _fseeki64(file, (__int64)offset, SEEK_SET);
+#else
+    return fseeko(file, (off_t)offset, SEEK_SET);
+#endif
+}
+
+unsigned int capture_block_samples(const struct capture_params *params)
+{
+    const unsigned int channels = layout_channels(params->layout);
+    unsigned int n;
+
+    if (params->block_size <= sizeof(struct capture_block_hdr)) {
+        return 0;
+    }
+
+    n = (unsigned int)((params->block_size - sizeof(struct capture_block_hdr)) /
+                       format_sample_size(params->format));
+
+    /* Blocks hold whole samples of every channel */
+    return n - (n % channels);
+}
+
+static void encode_file_hdr(struct capture_file_hdr *hdr,
+                            const struct capture_params *params,
+                            int64_t start_time,
+                            uint64_t num_blocks,
+                            uint64_t index_offset)
+{
+    memset(hdr, 0, sizeof(*hdr));
+    memcpy(hdr->magic, CAPTURE_FILE_MAGIC, sizeof(hdr->magic));
+
+    hdr->version        = HOST_TO_LE16(CAPTURE_FILE_VERSION);
+    hdr->block_hdr_size = HOST_TO_LE16(sizeof(struct capture_block_hdr));
+    hdr->format         = (uint8_t)params->format;
+    hdr->layout         = (uint8_t)params->layout;
+    hdr->block_size     = HOST_TO_LE32(params->block_size);
+    hdr->sample_rate    = HOST_TO_LE32(params->sample_rate);
+    hdr->frequency      = HOST_TO_LE64(params->frequency);
+    hdr->data_offset    = HOST_TO_LE64(CAPTURE_DATA_OFFSET);
+    hdr->num_blocks     = HOST_TO_LE64(num_blocks);
+    hdr->index_offset   = HOST_TO_LE64(index_offset);
+    hdr->start_time     = (int64_t)HOST_TO_LE64((uint64_t)start_time);
+}
+
+int capture_writer_create(FILE *file,
+                          const struct capture_params *params,
+                          struct capture_writer **writer)
+{
+    static const uint8_t zeros[CAPTURE_DATA_OFFSET] = { 0 };
+    struct capture_writer *w;
+    struct capture_file_hdr hdr;
+
+    *writer = NULL;
+
+    if (capture_block_samples(params) == 0) {
+        return CLI_RET_INVPARAM;
+    }
+
+    w = calloc(1, sizeof(*w));
+    if (w == NULL) {
+        return CLI_RET_MEM;
+    }
+
+    w->file        = file;
+    w->params      = *params;
+    w->channels    = layout_channels(params->layout);
+    w->sample_size = format_sample_size(params->format);
+    w->start_time  = (int64_t)time(NULL);
+
+    /* The header is rewritten with the block count and index location once
+     * the capture is finished */
+    encode_file_hdr(&hdr, params, w->start_time, 0, 0);
+
+    if (seek_to(file, 0) != 0 || fwrite(&hdr, sizeof(hdr), 1, file) != 1 ||
+        fwrite(zeros, CAPTURE_DATA_OFFSET - sizeof(hdr), 1, file) != 1 ||
+        fflush(file) != 0) {
+        free(w);
+        return CLI_RET_FILEOP;
+    }
+
+    *writer = w;
+    return 0;
+}
+
+/* Ensure the index has room for one more entry */
+static int index_reserve(struct capture_writer *w)
+{
+    if (w->index_len == w->index_cap) {
+        size_t cap = (w->index_cap == 0) ? 64 : 2 * w->index_cap;
+        void *tmp  = realloc(w->index, cap * sizeof(w->index[0]));
+
+        if (tmp == NULL) {
+            return CLI_RET_MEM;
+        }
+
+        w->index     = tmp;
+        w->index_cap = cap;
+    }
+
+    return 0;
+}
+
+/* Index the next block. Room must have been reserved with index_reserve(). */
+static void index_add(struct capture_writer *w,
+                      uint64_t timestamp,
+                      uint32_t flags)
+{
+    struct capture_index_entry *entry;
+
+    assert(w->index_len < w->index_cap);
+
+    entry            = &w->index[w->index_len++];
+    entry->block     = w->num_blocks;
+    entry->sample    = w->num_samples;
+    entry->timestamp = timestamp;
+    entry->flags     = flags;
+    entry->reserved  = 0;
+}
+
+/* Whether a block with the given flags starts a new index entry */
+static bool index_needed(const struct capture_writer *w, uint32_t flags)
+{
+    return w->num_blocks == 0 || flags != 0 ||
+           (w->num_blocks % CAPTURE_INDEX_INTERVAL) == 0;
+}
+
+int capture_writer_fill(struct capture_writer *w,
+                        void *block,
+                        const struct bladerf_metadata *meta)
+{
+    struct capture_block_hdr hdr;
+    const unsigned int max_samples = capture_block_samples(&w->params);
+    unsigned int num_samples;
+    uint32_t flags = 0;
+    size_t used;
+    int status;
+
+    num_samples = uint_min(meta->actual_count, max_samples);
+    num_samples -= num_samples % w->channels;
+
+    if (w->num_blocks != 0 && meta->timestamp != w->next_timestamp) {
+        flags |= CAPTURE_BLOCK_DISCONTINUITY;
+
+        if (w->overrun) {
+            flags |= CAPTURE_BLOCK_OVERRUN;
+        }
+    }
+
+    /* Reserve the index entry now, so that accounting for the block once it
+     * has been written cannot fail */
+    if (index_needed(w, flags)) {
+        status = index_reserve(w);
+        if (status != 0) {
+            return status;
+        }
+    }
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic       = HOST_TO_LE32(CAPTURE_BLOCK_MAGIC);
+    hdr.flags       = HOST_TO_LE32(flags);
+    hdr.timestamp   = HOST_TO_LE64(meta->timestamp);
+    hdr.num_samples = HOST_TO_LE32(num_samples);
+    hdr.layout      = HOST_TO_LE32((uint32_t)w->params.layout);
+    memcpy(block, &hdr, sizeof(hdr));
+
+    used = sizeof(hdr) + num_samples * w->sample_size;
+    memset((uint8_t *)block + used, 0, w->params.block_size - used);
+
+    w->pending.filled      = true;
+    w->pending.timestamp   = meta->timestamp;
+    w->pending.flags       = flags;
+    w->pending.num_samples = num_samples;
+
+    /* libbladeRF ends a block early when it encounters a discontinuity, and
+     * flags the block as an overrun */
+    w->pending.overrun = (meta->status & BLADERF_META_STATUS_OVERRUN) != 0;
+
+    return 0;
+}
+
+void capture_writer_commit(struct capture_writer *w)
+{
+    const unsigned int num_samples = w->pending.num_samples;
+
+    assert(w->pending.filled);
+
+    if (index_needed(w, w->pending.flags)) {
+        index_add(w, w->pending.timestamp, w->pending.flags);
+    }
+
+    w->num_blocks++;
+    w->num_samples += num_samples / w->channels;
+    w->next_timestamp = w->pending.timestamp + num_samples / w->channels;
+    w->overrun        = w->pending.overrun;
+
+    w->pending.filled = false;
+}
+
+int capture_writer_finish(struct capture_writer *w)
+{
+    const uint64_t index_offset =
+        CAPTURE_DATA_OFFSET + w->num_blocks * w->params.block_size;
+    struct capture_file_hdr file_hdr;
+    struct capture_index_hdr index_hdr;
+    size_t i;
+
+    if (seek_to(w->file, index_offset) != 0) {
+        return CLI_RET_FILEOP;
+    }
+
+    index_hdr.magic       = HOST_TO_LE32(CAPTURE_INDEX_MAGIC);
+    index_hdr.entry_size  = HOST_TO_LE32(sizeof(struct capture_index_entry));
+    index_hdr.num_entries = HOST_TO_LE64((uint64_t)w->index_len);
+
+    if (fwrite(&index_hdr, sizeof(index_hdr), 1, w->file) != 1) {
+        return CLI_RET_FILEOP;
+    }
+
+    for (i = 0; i < w->index_len; i++) {
+        struct capture_index_entry entry;
+
+        entry.block     = HOST_TO_LE64(w->index[i].block);
+        entry.sample    = HOST_TO_LE64(w->index[i].sample);
+        entry.timestamp = HOST_TO_LE64(w->index[i].timestamp);
+        entry.flags     = HOST_TO_LE32(w->index[i].flags);
+        entry.reserved  = 0;
+
+        if (fwrite(&entry, sizeof(entry), 1, w->file) != 1) {
+            return CLI_RET_FILEOP;
+        }
+    }
+
+    encode_file_hdr(&file_hdr, &w->params, w->start_time, w->num_blocks,
+                    index_offset);
+
+    if (seek_to(w->file, 0) != 0 ||
+        fwrite(&file_hdr, sizeof(file_hdr), 1, w->file) != 1 ||
+        fflush(w->file) != 0) {
+        return CLI_RET_FILEOP;
+    }
+
+    return 0;
+}
+
+/* Get the file name portion of a path */
+static const char *path_basename(const char *path)
+{
+    const char *sep = strrchr(path, '/');
+
+#if BLADERF_OS_WINDOWS
+    if (strrchr(path, '\\') > sep) {
+        sep = strrchr(path, '\\');
+    }
+#endif
+
+    return (sep != NULL) ? sep + 1 : path;
+}
+
+/* Replace the extension of the file name in path, if any */
+static char *replace_extension(const char *path, const char *ext)
+{
+    const char *name = path_basename(path);
+    const char *dot  = strrchr(name, '.');
+    size_t len;
+    char *ret;
+
+    len = (dot != NULL && dot != name) ? (size_t)(dot - path) : strlen(path);
+
+    ret = malloc(len + strlen(ext) + 1);
+    if (ret != NULL) {
+        memcpy(ret, path, len);
+        strcpy(ret + len, ext);
+    }
+
+    return ret;
+}
+
+/* Write a string as a JSON string literal */
+static void fput_json_string(const char *str, FILE *f)
+{
+    fputc('"', f);
+
+    for (; *str != '\0'; str++) {
+        if (*str == '"' || *str == '\\') {
+            fprintf(f, "\\%c", *str);
+        } else if ((unsigned char)*str < 0x20) {
+            fprintf(f, "\\u%04x", (unsigned char)*str);
+        } else {
+            fputc(*str, f);
+        }
+    }
+
+    fputc('"', f);
+}
+
+int capture_writer_write_sigmf(struct capture_writer *w, const char *path)
+{
+    const struct capture_params *p = &w->params;
+    const char *name;
+    char *meta_path;
+    char datetime[32] = "";
+    time_t start      = (time_t)w->start_time;
+    struct tm *tm;
+    FILE *f;
+    size_t i;
+    bool first;
+    int status;
+
+    meta_path = replace_extension(path, ".sigmf-meta");
+    if (meta_path == NULL) {
+        return CLI_RET_MEM;
+    }
+
+    status = expand_and_open(meta_path, "w", &f);
+    free(meta_path);
+
+    if (status != 0) {
+        return status;
+    }
+
+    /* The dataset is named relative to the metadata file */
+    name = path_basename(path);
+
+    tm = gmtime(&start);
+    if (tm != NULL) {
+        strftime(datetime, sizeof(datetime), "%Y-%m-%dT%H:%M:%SZ", tm);
+    }
+
+    fprintf(f, "{\n  \"global\": {\n");
+    fprintf(f, "    \"core:datatype\": \"%s\",\n",
+            p->format == CAPTURE_FMT_SC8Q7 ? "ci8" : "ci16_le");
+    fprintf(f, "    \"core:sample_rate\": %" PRIu32 ",\n", p->sample_rate);
+    fprintf(f, "    \"core:version\": \"1.0.0\",\n");
+    fprintf(f, "    \"core:num_channels\": %u,\n", w->channels);
+    fprintf(f, "    \"core:hw\": \"bladeRF\",\n");
+    fprintf(f, "    \"core:recorder\": \"bladeRF-cli\",\n");
+    fprintf(f, "    \"core:dataset\": ");
+    fput_json_string(name, f);
+    fprintf(f, ",\n");
+    fprintf(f, "    \"core:trailing_bytes\": %" PRIu64 ",\n",
+            (uint64_t)(sizeof(struct capture_index_hdr) +
+                       w->index_len * sizeof(struct capture_index_entry)));
+    fprintf(f, "    \"core:extensions\": [\n"
+               "      { \"name\": \"bladerf\", \"version\": \"1.0.0\", "
+               "\"optional\": false }\n"
+               "    ],\n");
+    fprintf(f, "    \"bladerf:data_offset\": %u,\n", CAPTURE_DATA_OFFSET);
+    fprintf(f, "    \"bladerf:block_size\": %" PRIu32 ",\n", p->block_size);
+    fprintf(f, "    \"bladerf:block_header_bytes\": %u\n",
+            (unsigned int)sizeof(struct capture_block_hdr));
+    fprintf(f, "  },\n");
+
+    /* Each discontinuity begins a new capture segment */
+    fprintf(f, "  \"captures\": [");
+    for (i = 0, first = true; i < w->index_len; i++) {
+        const struct capture_index_entry *e = &w->index[i];
+
+        if (e->block != 0 && !(e->flags & CAPTURE_BLOCK_DISCONTINUITY)) {
+            continue;
+        }
+
+        fprintf(f, "%s\n    { \"core:sample_start\": %" PRIu64
+                   ", \"core:global_index\": %" PRIu64
+                   ", \"core:frequency\": %" PRIu64,
+                first ? "" : ",", e->sample, e->timestamp, p->frequency);
+
+        if (e->block == 0 && datetime[0] != '\0') {
+            fprintf(f, ", \"core:datetime\": \"%s\"", datetime);
+        }
+
+        fprintf(f, " }");
+        first = false;
+    }
+    fprintf(f, "\n  ],\n");
+
+    fprintf(f, "  \"annotations\": [");
+    for (i = 0, first = true; i < w->index_len; i++) {
+        const struct capture_index_entry *e = &w->index[i];
+
+        if (!(e->flags & CAPTURE_BLOCK_OVERRUN)) {
+            continue;
+        }
+
+        fprintf(f, "%s\n    { \"core:sample_start\": %" PRIu64
+                   ", \"core:comment\": \"Overrun\" }",
+                first ? "" : ",", e->sample);
+        first = false;
+    }
+    fprintf(f, "\n  ]\n}\n");
+
+    status = ferror(f) ? CLI_RET_FILEOP : 0;
+
+    if (fclose(f) != 0) {
+        status = CLI_RET_FILEOP;
+    }
+
+    return status;
+}
+
+void capture_writer_free(struct capture_writer *w)
+{
+    if (w != NULL) {
+        free(w->index);
+        free(w);
+    }
+}
+
+int capture_reader_open(FILE *file, struct capture_reader **reader)
+{
+    struct capture_reader *r;
+    struct capture_file_hdr hdr;
+
+    *reader = NULL;
+
+    if (seek_to(file, 0) != 0) {
+        return CLI_RET_FILEOP;
+    }
+
+    if (fread(&hdr, sizeof(hdr), 1, file) != 1) {
+        return ferror(file) ? CLI_RET_FILEOP : CLI_RET_INVPARAM;
+    }
+
+    if (memcmp(hdr.magic, CAPTURE_FILE_MAGIC, sizeof(hdr.magic)) != 0 ||
+        LE16_TO_HOST(hdr.version) != CAPTURE_FILE_VERSION ||
+        LE16_TO_HOST(hdr.block_hdr_size) != sizeof(struct capture_block_hdr) ||
+        hdr.format > CAPTURE_FMT_SC8Q7 ||
+        LE64_TO_HOST(hdr.data_offset) < sizeof(hdr)) {
+        return CLI_RET_INVPARAM;
+    }
+
+    r = calloc(1, sizeof(*r));
+    if (r == NULL) {
+        return CLI_RET_MEM;
+    }
+
+    r->file               = file;
+    r->params.format      = (enum capture_sample_fmt)hdr.format;
+    r->params.layout      = (bladerf_channel_layout)hdr.layout;
+    r->params.block_size  = LE32_TO_HOST(hdr.block_size);
+    r->params.sample_rate = LE32_TO_HOST(hdr.sample_rate);
+    r->params.frequency   = LE64_TO_HOST(hdr.frequency);
+    r->sample_size        = format_sample_size(r->params.format);
+    r->data_offset        = LE64_TO_HOST(hdr.data_offset);
+    r->num_blocks         = LE64_TO_HOST(hdr.num_blocks);
+
+    if (capture_block_samples(&r->params) == 0) {
+        free(r);
+        return CLI_RET_INVPARAM;
+    }
+
+    r->buf = malloc(r->params.block_size);
+    if (r->buf == NULL) {
+        free(r);
+        return CLI_RET_MEM;
+    }
+
+    if (capture_reader_rewind(r) != 0) {
+        capture_reader_free(r);
+        return CLI_RET_FILEOP;
+    }
+
+    *reader = r;
+    return 0;
+}
+
+void capture_reader_get_params(const struct capture_reader *r,
+                               struct capture_params *params)
+{
+    *params = r->params;
+}
+
+int capture_reader_next(struct capture_reader *r, struct capture_block *block)
+{
+    struct capture_block_hdr hdr;
+    size_t n;
+
+    if (r->num_blocks != 0 && r->next_block >= r->num_blocks) {
+        return 1;
+    }
+
+    n = fread(r->buf, 1, r->params.block_size, r->file);
+
+    if (n != r->params.block_size) {
+        if (ferror(r->file)) {
+            return CLI_RET_FILEOP;
+        }
+
+        /* An unfinished capture ends at the last complete block */
+        return (r->num_blocks == 0) ? 1 : CLI_RET_INVPARAM;
+    }
+
+    memcpy(&hdr, r->buf, sizeof(hdr));
+
+    block->timestamp   = LE64_TO_HOST(hdr.timestamp);
+    block->flags       = LE32_TO_HOST(hdr.flags);
+    block->num_samples = LE32_TO_HOST(hdr.num_samples);
+    block->samples     = r->buf + sizeof(hdr);
+
+    if (LE32_TO_HOST(hdr.magic) != CAPTURE_BLOCK_MAGIC ||
+        block->num_samples > capture_block_samples(&r->params)) {
+        return CLI_RET_INVPARAM;
+    }
+
+    r->next_block++;
+    return 0;
+}
+
+int capture_reader_rewind(struct capture_reader *r)
+{
+    if (seek_to(r->file, r->data_offset) != 0) {
+        return CLI_RET_FILEOP;
+    }
+
+    r->next_block = 0;
+    return 0;
+}
+
+void capture_reader_free(struct capture_reader *r)
+{
+    if (r != NULL) {
+        free(r->buf);
+        free(r);
+    }
+}
@@ -0,0 +1,265 @@
+/**
+ * @file capture_file.h
+ *
+ * @brief Timestamped, block-based sample capture files
+ *
+ * A capture file records samples along with the hardware timestamp of each
+ * block of samples, so that gaps in a recording are preserved and the
+ * recording may be located in time, or replayed with the same timing.
+ *
+ * A capture file consists of:
+ *  - A struct capture_file_hdr, zero-padded to `data_offset` bytes
+ *  - `num_blocks` blocks, each `block_size` bytes long, holding a
+ *    struct capture_block_hdr followed by `num_samples` samples. Any space
+ *    remaining in a block is zero-filled.
+ *  - A seek index, located at `index_offset`, consisting of a
+ *    struct capture_index_hdr followed by `num_entries`
+ *    struct capture_index_entry items. The index holds the first block, each
+ *    block that does not follow on in time from its predecessor, and every
+ *    CAPTURE_INDEX_INTERVAL-th block. The timestamp of any other block follows
+ *    from the index entry preceding it.
+ *
+ * All fields and samples are little-endian. Samples are interleaved over
+ * channels, as per the block's channel layout.
+ *
+ * While a capture is being recorded, `num_blocks` and `index_offset` are
+ * zero. Readers should then scan blocks until reaching the end of the file.
+ *
+ * A SigMF metadata file is written alongside each capture. Its dataset is the
+ * capture file, and its capture segments begin at each discontinuity.
+ *
+ * This file is part of the bladeRF project
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef CAPTURE_FILE_H__
+#define CAPTURE_FILE_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <libbladeRF.h>
+
+#define CAPTURE_FILE_MAGIC "BRFCAPT1"
+#define CAPTURE_FILE_VERSION 1
+
+/* Offset of the first block. This keeps blocks aligned for direct I/O. */
+#define CAPTURE_DATA_OFFSET 4096
+
+#define CAPTURE_BLOCK_MAGIC 0x4b4c4243 /* "CBLK" */
+#define CAPTURE_INDEX_MAGIC 0x58444943 /* "CIDX" */
+
+/* Maximum number of blocks between index entries */
+#define CAPTURE_INDEX_INTERVAL 1024
+
+/* Block flags */
+#define CAPTURE_BLOCK_DISCONTINUITY (1 << 0) /* Does not follow on from the
+                                              * previous block in time */
+#define CAPTURE_BLOCK_OVERRUN (1 << 1)       /* The discontinuity was
+                                              * reported as an overrun */
+
+enum capture_sample_fmt {
+    CAPTURE_FMT_SC16Q11 = 0,
+    CAPTURE_FMT_SC8Q7   = 1,
+};
+
+struct capture_file_hdr {
+    char magic[8];           /* CAPTURE_FILE_MAGIC, not NUL-terminated */
+    uint16_t version;        /* CAPTURE_FILE_VERSION */
+    uint16_t block_hdr_size; /* sizeof(struct capture_block_hdr) */
+    uint8_t format;          /* enum capture_sample_fmt */
+    uint8_t layout;          /* bladerf_channel_layout */
+    uint16_t reserved;
+    uint32_t block_size;     /* Size of each block, including its header */
+    uint32_t sample_rate;    /* Sample rate, in Hz */
+    uint64_t frequency;      /* Frequency of the first channel, in Hz */
+    uint64_t data_offset;    /* File offset of the first block */
+    uint64_t num_blocks;     /* Number of blocks, or 0 while recording */
+    uint64_t index_offset;   /* File offset of the index, or 0 if absent */
+    int64_t start_time;      /* Host time at the start of the recording,
+                              * in seconds since the Unix epoch */
+};
+
+struct capture_block_hdr {
+    uint32_t magic;       /* CAPTURE_BLOCK_MAGIC */
+    uint32_t flags;       /* CAPTURE_BLOCK_* flags */
+    uint64_t timestamp;   /* Timestamp of the first sample */
+    uint32_t num_samples; /* Number of samples, over all channels */
+    uint32_t layout;      /* bladerf_channel_layout */
+    uint64_t reserved;
+};
+
+struct capture_index_hdr {
+    uint32_t magic;       /* CAPTURE_INDEX_MAGIC */
+    uint32_t entry_size;  /* sizeof(struct capture_index_entry) */
+    uint64_t num_entries; /* Number of entries that follow */
+};
+
+struct capture_index_entry {
+    uint64_t block;     /* Block number */
+    uint64_t sample;    /* Number of samples per channel preceding the block */
+    uint64_t timestamp; /* Timestamp of the block's first sample */
+    uint32_t flags;     /* The block's CAPTURE_BLOCK_* flags */
+    uint32_t reserved;
+};
+
+/* Parameters of a capture */
+struct capture_params {
+    enum capture_sample_fmt format;
+    bladerf_channel_layout layout;
+    uint32_t block_size;
+    uint32_t sample_rate;
+    uint64_t frequency;
+};
+
+/* A block read from a capture file */
+struct capture_block {
+    uint64_t timestamp;
+    uint32_t flags;
+    unsigned int num_samples;
+    const void *samples;
+};
+
+struct capture_writer;
+struct capture_reader;
+
+/**
+ * @param[in]   params      Capture parameters
+ *
+ * @return Number of samples, over all channels, that fit in one block
+ */
+unsigned int capture_block_samples(const struct capture_params *params);
+
+/**
+ * Start a capture file, writing its header and leaving the file positioned
+ * at the first block. Blocks may then be written by any means, at offsets
+ * CAPTURE_DATA_OFFSET + n * `block_size`.
+ *
+ * @param[in]   file        File to write to
+ * @param[in]   params      Capture parameters
+ * @param[out]  writer      Capture writer
+ *
+ * @return 0 on success, CLI_RET_INVPARAM if the block size is too small,
+ *         CLI_RET_MEM on allocation failure, or CLI_RET_FILEOP on a write
+ *         failure, with errno set.
+ */
+int capture_writer_create(FILE *file,
+                          const struct capture_params *params,
+                          struct capture_writer **writer);
+
+/**
+ * Fill in the header of the next block, and zero the unused remainder of the
+ * block. The block is not part of the capture until capture_writer_commit()
+ * is called, once it has been written to the file.
+ *
+ * @param[in]   writer      Capture writer
+ * @param       block       Block of `block_size` bytes, with samples
+ *                          beginning after the block header
+ * @param[in]   meta        Metadata returned by bladerf_sync_rx() for the
+ *                          block's samples
+ *
+ * @return 0 on success, or CLI_RET_MEM if the index could not be grown
+ */
+int capture_writer_fill(struct capture_writer *writer,
+                        void *block,
+                        const struct bladerf_metadata *meta);
+
+/**
+ * Add the block last filled by capture_writer_fill() to the capture, and
+ * index it if needed. Call this only once the block has been written, so that
+ * a failed write does not leave a hole in the indexed blocks.
+ *
+ * @param[in]   writer      Capture writer
+ */
+void capture_writer_commit(struct capture_writer *writer);
+
+/**
+ * Write the index after the last committed block, and update the file header.
+ * All blocks must have been written to the file beforehand.
+ *
+ * @param[in]   writer      Capture writer
+ *
+ * @return 0 on success, or CLI_RET_FILEOP on a write failure, with errno set
+ */
+int capture_writer_finish(struct capture_writer *writer);
+
+/**
+ * Write a SigMF metadata file describing the capture. Its path is that of the
+ * capture, with the extension replaced by ".sigmf-meta".
+ *
+ * @param[in]   writer      Capture writer, after capture_writer_finish()
+ * @param[in]   path        Path of the capture file
+ *
+ * @return 0 on success, CLI_RET_MEM on allocation failure, or a CLI_RET_*
+ *         value from expand_and_open() or CLI_RET_FILEOP on a write failure
+ */
+int capture_writer_write_sigmf(struct capture_writer *writer,
+                               const char *path);
+
+/**
+ * @param[in]   writer      Capture writer. NULL is ignored.
+ */
+void capture_writer_free(struct capture_writer *writer);
+
+/**
+ * Open a capture file for reading, from its first block
+ *
+ * @param[in]   file        File to read from
+ * @param[out]  reader      Capture reader
+ *
+ * @return 0 on success, CLI_RET_INVPARAM if the file is not a valid capture
+ *         file, CLI_RET_MEM on allocation failure, or CLI_RET_FILEOP on a
+ *         read failure, with errno set.
+ */
+int capture_reader_open(FILE *file, struct capture_reader **reader);
+
+/**
+ * @param[in]   reader      Capture reader
+ * @param[out]  params      Parameters of the capture
+ */
+void capture_reader_get_params(const struct capture_reader *reader,
+                               struct capture_params *params);
+
+/**
+ * Read the next block. The block's samples remain valid until the next call.
+ *
+ * @param[in]   reader      Capture reader
+ * @param[out]  block       Block read
+ *
+ * @return 0 on success, 1 at the end of the capture, CLI_RET_INVPARAM if a
+ *         block is malformed, or CLI_RET_FILEOP on a read failure, with
+ *         errno set.
+ */
+int capture_reader_next(struct capture_reader *reader,
+                        struct capture_block *block);
+
+/**
+ * Return to the first block
+ *
+ * @param[in]   reader      Capture reader
+ *
+ * @return 0 on success, or CLI_RET_FILEOP on failure, with errno set
+ */
+int capture_reader_rewind(struct capture_reader *reader);
+
+/**
+ * @param[in]   reader      Capture reader. NULL is ignored.
+ */
+void capture_reader_free(struct capture_reader *reader);
+
+#endif
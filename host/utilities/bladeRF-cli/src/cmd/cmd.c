@@ -36,6 +36,7 @@
 
 DECLARE_CMD(calibrate, "calibrate", "cal");
 DECLARE_CMD(clear, "clear", "cls");
+DECLARE_CMD(convert, "convert", "conv");
 DECLARE_CMD(echo, "echo");
 DECLARE_CMD(erase, "erase", "e");
 DECLARE_CMD(flash_backup, "flash_backup", "fb");
@@ -97,6 +98,15 @@ static struct cmd const cmd_table[] = {
         FIELD_INIT(.requires_fpga, false),
         FIELD_INIT(.allow_while_streaming, true),
     },
+    {
+        FIELD_INIT(.names, cmd_names_convert),
+        FIELD_INIT(.exec, cmd_convert),
+        FIELD_INIT(.desc, "Convert sample files between CSV and binary"),
+        FIELD_INIT(.help, CLI_CMD_HELPTEXT_convert),
+        FIELD_INIT(.requires_device, false),
+        FIELD_INIT(.requires_fpga, false),
+        FIELD_INIT(.allow_while_streaming, true),
+    },
     {
         FIELD_INIT(.names, cmd_names_echo),
         FIELD_INIT(.exec, cmd_echo),
@@ -0,0 +1,167 @@
+/*
+ * This file is part of the bladeRF project
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "common.h"
+#include "conversions.h"
+#include "rel_assert.h"
+#include "sample_csv.h"
+
+#define CONVERT_DEFAULT_THREADS 4
+
+int cmd_convert(struct cli_state *s, int argc, char **argv)
+{
+    enum sample_csv_fmt fmt;
+    unsigned int channels = 1;
+    unsigned int threads  = CONVERT_DEFAULT_THREADS;
+    FILE *in              = NULL;
+    FILE *out             = NULL;
+    bool to_csv;
+    bool ok;
+    int status = 0;
+    int i;
+
+    assert(argc > 0);
+
+    if (argc < 4) {
+        return CLI_RET_NARGS;
+    }
+
+    if (!strcasecmp(argv[1], "csv2bin")) {
+        to_csv = false;
+    } else if (!strcasecmp(argv[1], "bin2csv")) {
+        to_csv = true;
+    } else {
+        cli_err(s, argv[0], "Invalid conversion: %s\n", argv[1]);
+        return CLI_RET_INVPARAM;
+    }
+
+    fmt = s->bit_mode_8bit ? SAMPLE_CSV_SC8Q7 : SAMPLE_CSV_SC16Q11;
+
+    for (i = 4; i < argc; i++) {
+        char *val = strchr(argv[i], '=');
+
+        if (val == NULL) {
+            cli_err(s, argv[0], "Unexpected parameter: %s\n", argv[i]);
+            return CLI_RET_INVPARAM;
+        }
+
+        *val++ = '\0';
+
+        if (!strcasecmp("bitmode", argv[i])) {
+            unsigned int bits = str2uint(val, 8, 16, &ok);
+
+            if (!ok || (bits != 8 && bits != 16)) {
+                cli_err(s, argv[0], "Invalid bitmode: %s\n", val);
+                return CLI_RET_INVPARAM;
+            }
+
+            fmt = (bits == 8) ? SAMPLE_CSV_SC8Q7 : SAMPLE_CSV_SC16Q11;
+        } else if (!strcasecmp("channels", argv[i])) {
+            channels = str2uint(val, 1, 2, &ok);
+            if (!ok) {
+                cli_err(s, argv[0], "Invalid channel count: %s\n", val);
+                return CLI_RET_INVPARAM;
+            }
+        } else if (!strcasecmp("threads", argv[i])) {
+            threads = str2uint(val, 1, SAMPLE_CSV_MAX_THREADS, &ok);
+            if (!ok) {
+                cli_err(s, argv[0], "Thread count must be 1 to %d.\n",
+                        SAMPLE_CSV_MAX_THREADS);
+                return CLI_RET_INVPARAM;
+            }
+        } else {
+            cli_err(s, argv[0], "Unrecognized parameter: %s\n", argv[i]);
+            return CLI_RET_INVPARAM;
+        }
+    }
+
+    status = expand_and_open(argv[2], to_csv ? "rb" : "r", &in);
+    if (status != 0) {
+        goto out;
+    }
+
+    status = expand_and_open(argv[3], to_csv ? "w" : "wb", &out);
+    if (status != 0) {
+        goto out;
+    }
+
+    if (to_csv) {
+        uint64_t num_samples;
+
+        status = sample_csv_to_file(in, out, fmt, channels, threads,
+                                    &num_samples);
+
+        if (status == CLI_RET_INVPARAM) {
+            cli_err(s, argv[0],
+                    "%s does not hold a whole number of %u-channel "
+                    "samples.\n",
+                    argv[2], channels);
+        } else if (status == 0) {
+            printf("\n  Converted %" PRIu64 " samples to %s.\n\n",
+                   num_samples / channels, argv[3]);
+        }
+    } else {
+        struct sample_csv_stats stats;
+
+        status = sample_csv_from_file(in, out, fmt, threads, &stats);
+
+        if (status == CLI_RET_INVPARAM) {
+            cli_err(s, argv[0],
+                    "Line (%" PRIu64 "): Parsing failed. Values must be "
+                    "integers, in I,Q pairs.\n",
+                    stats.error_line);
+        } else if (status == 0) {
+            printf("\n  Converted %" PRIu64 " lines to %s.\n",
+                   stats.lines, argv[3]);
+
+            if (stats.clamped != 0) {
+                printf("  Warning: %" PRIu64 " value%s clamped within DAC "
+                       "%s range of [%d, %d].\n",
+                       stats.clamped, 1 == stats.clamped ? "" : "s",
+                       fmt == SAMPLE_CSV_SC8Q7 ? "SC8 Q7" : "SC16 Q11",
+                       fmt == SAMPLE_CSV_SC8Q7 ? -128 : -2048,
+                       fmt == SAMPLE_CSV_SC8Q7 ? 127 : 2047);
+            }
+
+            printf("\n");
+        }
+    }
+
+    if (status == 0 && fflush(out) != 0) {
+        status = CLI_RET_FILEOP;
+    }
+
+out:
+    if (in != NULL) {
+        fclose(in);
+    }
+
+    if (out != NULL) {
+        fclose(out);
+    }
+
+    return status;
+}
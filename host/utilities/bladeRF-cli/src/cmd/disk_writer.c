@@ -0,0 +1,582 @@
+/*
+ * This file is part of the bladeRF project
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/* O_DIRECT is a GNU extension */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_config.h"
+
+#if BLADERF_OS_WINDOWS || BLADERF_OS_OSX
+#include "clock_gettime.h"
+#else
+#include <time.h>
+#endif
+
+#if BLADERF_OS_LINUX || BLADERF_OS_FREEBSD
+#include <sys/uio.h>
+#define DISK_WRITER_HAVE_PWRITEV 1
+#else
+#define DISK_WRITER_HAVE_PWRITEV 0
+#endif
+
+#include "common.h"
+#include "disk_writer.h"
+#include "minmax.h"
+#include "rel_assert.h"
+#include "thread.h"
+
+/* Maximum number of consecutive buffers coalesced into one write */
+#define DISK_WRITER_MAX_IOV 16
+
+struct disk_writer_buf {
+    void *data;
+    size_t len;      /* Bytes to write, including any padding */
+    uint64_t offset; /* File offset */
+    bool queued;     /* Filled, and not yet written */
+};
+
+struct disk_writer {
+    int fd;
+    size_t buffer_size;
+    bool direct;
+
+    struct disk_writer_buf *bufs;
+    unsigned int num_bufs;
+
+    pthread_t threads[DISK_WRITER_MAX_WRITERS];
+    unsigned int num_threads;
+
+    MUTEX lock;               /* Must be held to access the following */
+    pthread_cond_t filled;    /* Signaled when a buffer is committed */
+    pthread_cond_t freed;     /* Signaled when buffers have been written */
+    uint64_t fill_seq;        /* Sequence number of the next buffer to fill */
+    uint64_t write_seq;       /* Sequence number of the next buffer to write */
+    uint64_t offset;          /* File offset of the next buffer to fill */
+    uint64_t end;             /* File size, excluding padding */
+    bool tail_committed;      /* A short buffer has been committed */
+    bool closing;             /* Writer threads should exit once idle */
+    bool closed;              /* disk_writer_close() has completed */
+    int error;                /* errno value of the first failed write */
+
+    struct timespec start;
+    struct disk_writer_stats stats;
+
+#if BLADERF_OS_WINDOWS
+    MUTEX io_lock; /* Serializes seek + write pairs */
+#endif
+};
+
+static double elapsed_since(const struct timespec *start)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    return (double)(now.tv_sec - start->tv_sec) +
+           (double)(now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void *alloc_aligned(size_t size)
+{
+#if BLADERF_OS_WINDOWS
+    return _aligned_malloc(size, DISK_WRITER_ALIGNMENT);
+#else
+    void *ptr;
+
+    if (posix_memalign(&ptr, DISK_WRITER_ALIGNMENT, size) != 0) {
+        return NULL;
+    }
+
+    return ptr;
+#endif
+}
+
+static void free_aligned(void *ptr)
+{
+#if BLADERF_OS_WINDOWS
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+/* Try to have writes to fd bypass the page cache */
+static bool enable_direct_io(int fd)
+{
+#if defined(O_DIRECT)
+    int flags = fcntl(fd, F_GETFL);
+
+    return (flags >= 0) && (fcntl(fd, F_SETFL, flags | O_DIRECT) == 0);
+#elif defined(F_NOCACHE)
+    return fcntl(fd, F_NOCACHE, 1) == 0;
+#else
+    return false;
+#endif
+}
+
+/* Undo enable_direct_io() */
+static void disable_direct_io(int fd)
+{
+#if defined(O_DIRECT)
+    int flags = fcntl(fd, F_GETFL);
+
+    if (flags >= 0) {
+        fcntl(fd, F_SETFL, flags & ~O_DIRECT);
+    }
+#elif defined(F_NOCACHE)
+    fcntl(fd, F_NOCACHE, 0);
+#endif
+}
+
+/* Write n buffers, which are consecutive in the file, starting at offset.
+ * Returns 0 on success or an errno value on failure. */
+static int write_bufs(struct disk_writer *w,
+                      struct disk_writer_buf **bufs,
+                      unsigned int n,
+                      uint64_t offset)
+{
+#if DISK_WRITER_HAVE_PWRITEV
+    struct iovec iov[DISK_WRITER_MAX_IOV];
+    unsigned int i = 0;
+    ssize_t ret;
+
+    for (i = 0; i < n; i++) {
+        iov[i].iov_base = bufs[i]->data;
+        iov[i].iov_len  = bufs[i]->len;
+    }
+
+    i = 0;
+    while (i < n) {
+        ret = pwritev(w->fd, &iov[i], (int)(n - i), (off_t)offset);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno;
+        }
+
+        offset += (uint64_t)ret;
+
+        /* Skip past whatever was written */
+        while (i < n && (size_t)ret >= iov[i].iov_len) {
+            ret -= (ssize_t)iov[i].iov_len;
+            i++;
+        }
+
+        if (i < n) {
+            iov[i].iov_base = (uint8_t *)iov[i].iov_base + ret;
+            iov[i].iov_len -= (size_t)ret;
+        }
+    }
+
+    return 0;
+#else
+    unsigned int i;
+    size_t done;
+
+    for (i = 0; i < n; i++) {
+        done = 0;
+
+        while (done < bufs[i]->len) {
+#if BLADERF_OS_WINDOWS
+            int ret;
+
+            MUTEX_LOCK(&w->io_lock);
+            if (_lseeki64(w->fd, (__int64)offset, SEEK_SET) < 0) {
+                ret = -1;
+            } else {
+                ret = _write(w->fd, (uint8_t *)bufs[i]->data + done,
+                             (unsigned int)(bufs[i]->len - done));
+            }
+            MUTEX_UNLOCK(&w->io_lock);
+#else
+            ssize_t ret = pwrite(w->fd, (uint8_t *)bufs[i]->data + done,
+                                 bufs[i]->len - done, (off_t)offset);
+#endif
+            if (ret < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return errno;
+            }
+
+            done += (size_t)ret;
+            offset += (uint64_t)ret;
+        }
+    }
+
+    return 0;
+#endif
+}
+
+static void *writer_task(void *arg)
+{
+    struct disk_writer *w = arg;
+    struct disk_writer_buf *bufs[DISK_WRITER_MAX_IOV];
+    struct timespec t0;
+    uint64_t offset, bytes, first;
+    unsigned int i, n;
+    int status;
+    double dt;
+
+    MUTEX_LOCK(&w->lock);
+
+    while (true) {
+        while (w->write_seq == w->fill_seq && !w->closing) {
+            pthread_cond_wait(&w->filled, &w->lock);
+        }
+
+        if (w->write_seq == w->fill_seq) {
+            /* Closing, and nothing left to write */
+            break;
+        }
+
+        /* Claim as many consecutive buffers as are ready */
+        n     = (unsigned int)u64_min(DISK_WRITER_MAX_IOV,
+                                      w->fill_seq - w->write_seq);
+        first = w->write_seq;
+        w->write_seq += n;
+
+        bytes = 0;
+        for (i = 0; i < n; i++) {
+            bufs[i] = &w->bufs[(first + i) % w->num_bufs];
+            bytes += bufs[i]->len;
+        }
+
+        offset = bufs[0]->offset;
+
+        /* Once a write has failed, just recycle buffers so that the
+         * producer can observe the error */
+        status = w->error;
+
+        MUTEX_UNLOCK(&w->lock);
+
+        dt = 0.0;
+        if (status == 0) {
+            clock_gettime(CLOCK_REALTIME, &t0);
+            status = write_bufs(w, bufs, n, offset);
+            dt = elapsed_since(&t0);
+        }
+
+        MUTEX_LOCK(&w->lock);
+
+        if (status != 0 && w->error == 0) {
+            w->error = status;
+        } else if (status == 0 && w->error == 0) {
+            w->stats.bytes_written += bytes;
+            w->stats.write_calls++;
+            w->stats.write_time += dt;
+        }
+
+        for (i = 0; i < n; i++) {
+            bufs[i]->queued = false;
+        }
+
+        w->stats.occupancy -= n;
+        pthread_cond_broadcast(&w->freed);
+    }
+
+    MUTEX_UNLOCK(&w->lock);
+
+    return NULL;
+}
+
+int disk_writer_create(FILE *file,
+                       const struct disk_writer_config *config,
+                       struct disk_writer **writer)
+{
+    struct disk_writer *w;
+    unsigned int i;
+    int status = 0;
+
+    *writer = NULL;
+
+    if (config->buffer_size == 0 || config->num_buffers < 2 ||
+        config->num_writers < 1 ||
+        config->num_writers > DISK_WRITER_MAX_WRITERS) {
+        return CLI_RET_INVPARAM;
+    }
+
+    w = calloc(1, sizeof(*w));
+    if (w == NULL) {
+        return CLI_RET_MEM;
+    }
+
+    w->fd          = fileno(file);
+    w->buffer_size = config->buffer_size;
+    w->num_bufs    = config->num_buffers;
+
+    w->bufs = calloc(w->num_bufs, sizeof(w->bufs[0]));
+    if (w->bufs == NULL) {
+        free(w);
+        return CLI_RET_MEM;
+    }
+
+    /* Round up to the alignment, to leave room for padding a short final
+     * buffer when using direct I/O */
+    for (i = 0; i < w->num_bufs; i++) {
+        w->bufs[i].data = alloc_aligned(
+            (w->buffer_size + DISK_WRITER_ALIGNMENT - 1) /
+            DISK_WRITER_ALIGNMENT * DISK_WRITER_ALIGNMENT);
+
+        if (w->bufs[i].data == NULL) {
+            status = CLI_RET_MEM;
+            goto error;
+        }
+    }
+
+    w->offset = config->offset;
+    w->end    = config->offset;
+
+    if (config->direct && (w->buffer_size % DISK_WRITER_ALIGNMENT) == 0 &&
+        (config->offset % DISK_WRITER_ALIGNMENT) == 0) {
+        w->direct = enable_direct_io(w->fd);
+    }
+
+    MUTEX_INIT(&w->lock);
+    pthread_cond_init(&w->filled, NULL);
+    pthread_cond_init(&w->freed, NULL);
+#if BLADERF_OS_WINDOWS
+    MUTEX_INIT(&w->io_lock);
+#endif
+
+    w->stats.num_buffers = w->num_bufs;
+    w->stats.direct      = w->direct;
+    clock_gettime(CLOCK_REALTIME, &w->start);
+
+    for (i = 0; i < config->num_writers; i++) {
+        if (pthread_create(&w->threads[i], NULL, writer_task, w) != 0) {
+            status = CLI_RET_UNKNOWN;
+            break;
+        }
+
+        w->num_threads++;
+    }
+
+    *writer = w;
+
+    if (status != 0) {
+        disk_writer_free(w);
+        *writer = NULL;
+    }
+
+    return status;
+
+error:
+    for (i = 0; i < w->num_bufs; i++) {
+        free_aligned(w->bufs[i].data);
+    }
+
+    free(w->bufs);
+    free(w);
+    return status;
+}
+
+void *disk_writer_acquire(struct disk_writer *w)
+{
+    struct disk_writer_buf *buf;
+
+    MUTEX_LOCK(&w->lock);
+
+    buf = &w->bufs[w->fill_seq % w->num_bufs];
+
+    if (buf->queued && w->error == 0) {
+        w->stats.stalls++;
+
+        while (buf->queued && w->error == 0) {
+            pthread_cond_wait(&w->freed, &w->lock);
+        }
+    }
+
+    if (w->error != 0) {
+        buf = NULL;
+    }
+
+    MUTEX_UNLOCK(&w->lock);
+
+    return (buf != NULL) ? buf->data : NULL;
+}
+
+int disk_writer_commit(struct disk_writer *w, size_t len)
+{
+    struct disk_writer_buf *buf;
+    size_t padded = len;
+    int status    = 0;
+
+    if (len == 0 || len > w->buffer_size) {
+        return CLI_RET_INVPARAM;
+    }
+
+    MUTEX_LOCK(&w->lock);
+
+    buf = &w->bufs[w->fill_seq % w->num_bufs];
+
+    if (w->error != 0) {
+        status = CLI_RET_FILEOP;
+    } else if (w->tail_committed || buf->queued) {
+        /* A buffer after a short one, or a commit without an acquire */
+        status = CLI_RET_INVPARAM;
+    }
+
+    MUTEX_UNLOCK(&w->lock);
+
+    if (status != 0) {
+        return status;
+    }
+
+    /* Direct I/O requires whole blocks. Pad with zeros, and trim the file
+     * when closing. */
+    if (w->direct && (len % DISK_WRITER_ALIGNMENT) != 0) {
+        padded = (len + DISK_WRITER_ALIGNMENT - 1) / DISK_WRITER_ALIGNMENT *
+                 DISK_WRITER_ALIGNMENT;
+        memset((uint8_t *)buf->data + len, 0, padded - len);
+    }
+
+    MUTEX_LOCK(&w->lock);
+
+    buf->len    = padded;
+    buf->offset = w->offset;
+    buf->queued = true;
+
+    w->offset += padded;
+    w->end = buf->offset + len;
+
+    if (len != w->buffer_size && w->direct) {
+        w->tail_committed = true;
+    }
+
+    w->fill_seq++;
+    w->stats.occupancy++;
+    w->stats.max_occupancy =
+        uint_max(w->stats.max_occupancy, w->stats.occupancy);
+
+    pthread_cond_signal(&w->filled);
+
+    MUTEX_UNLOCK(&w->lock);
+
+    return 0;
+}
+
+int disk_writer_close(struct disk_writer *w)
+{
+    unsigned int i;
+    int status = 0;
+
+    MUTEX_LOCK(&w->lock);
+    if (w->closed) {
+        status = (w->error == 0) ? 0 : CLI_RET_FILEOP;
+        MUTEX_UNLOCK(&w->lock);
+        return status;
+    }
+
+    w->closing = true;
+    pthread_cond_broadcast(&w->filled);
+    MUTEX_UNLOCK(&w->lock);
+
+    for (i = 0; i < w->num_threads; i++) {
+        pthread_join(w->threads[i], NULL);
+    }
+
+    w->num_threads = 0;
+
+    MUTEX_LOCK(&w->lock);
+
+#if !BLADERF_OS_WINDOWS
+    /* Remove the padding of a short final buffer */
+    if (w->error == 0 && w->offset != w->end) {
+        if (ftruncate(w->fd, (off_t)w->end) != 0) {
+            w->error = errno;
+        }
+    }
+#endif
+
+    if (w->direct) {
+        disable_direct_io(w->fd);
+    }
+
+    w->stats.elapsed = elapsed_since(&w->start);
+    w->closed        = true;
+
+    if (w->error != 0) {
+        status = CLI_RET_FILEOP;
+    }
+
+    MUTEX_UNLOCK(&w->lock);
+
+    return status;
+}
+
+int disk_writer_error(struct disk_writer *w)
+{
+    int error;
+
+    MUTEX_LOCK(&w->lock);
+    error = w->error;
+    MUTEX_UNLOCK(&w->lock);
+
+    return error;
+}
+
+void disk_writer_get_stats(struct disk_writer *w,
+                           struct disk_writer_stats *stats)
+{
+    MUTEX_LOCK(&w->lock);
+
+    *stats = w->stats;
+
+    if (!w->closed) {
+        stats->elapsed = elapsed_since(&w->start);
+    }
+
+    MUTEX_UNLOCK(&w->lock);
+}
+
+void disk_writer_free(struct disk_writer *w)
+{
+    unsigned int i;
+
+    if (w == NULL) {
+        return;
+    }
+
+    disk_writer_close(w);
+
+    for (i = 0; i < w->num_bufs; i++) {
+        free_aligned(w->bufs[i].data);
+    }
+
+    pthread_cond_destroy(&w->filled);
+    pthread_cond_destroy(&w->freed);
+    MUTEX_DESTROY(&w->lock);
+#if BLADERF_OS_WINDOWS
+    MUTEX_DESTROY(&w->io_lock);
+#endif
+
+    free(w->bufs);
+    free(w);
+}
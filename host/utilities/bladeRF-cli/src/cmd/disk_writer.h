@@ -0,0 +1,149 @@
+/**
+ * @file disk_writer.h
+ *
+ * @brief Buffered, multi-threaded sample file writer
+ *
+ * A disk writer decouples a sample producer (e.g., the RX task) from file
+ * system latency. The producer fills buffers from a pre-allocated ring, and
+ * one or more writer threads write them to the file at their respective
+ * offsets. Consecutive buffers are coalesced into a single vectored write
+ * where the platform supports it.
+ *
+ * This file is part of the bladeRF project
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef DISK_WRITER_H__
+#define DISK_WRITER_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Alignment of the ring's buffers, and the granularity of direct I/O */
+#define DISK_WRITER_ALIGNMENT 4096
+
+/* Maximum number of writer threads */
+#define DISK_WRITER_MAX_WRITERS 8
+
+struct disk_writer;
+
+struct disk_writer_config {
+    size_t buffer_size;       /* Size of each ring buffer, in bytes */
+    unsigned int num_buffers; /* Number of buffers in the ring */
+    unsigned int num_writers; /* Number of writer threads */
+    bool direct;              /* Attempt to bypass the OS page cache */
+    uint64_t offset;          /* File offset at which writing begins */
+};
+
+struct disk_writer_stats {
+    unsigned int num_buffers;   /* Number of buffers in the ring */
+    unsigned int occupancy;     /* Buffers currently awaiting a write */
+    unsigned int max_occupancy; /* High water mark of the above */
+    uint64_t bytes_written;     /* Total bytes written to the file */
+    uint64_t write_calls;       /* Number of (vectored) write calls */
+    uint64_t stalls;            /* Times the producer waited for a buffer */
+    double elapsed;             /* Seconds since the writer was created */
+    double write_time;          /* Seconds spent in writes, over all threads */
+    bool direct;                /* Direct I/O is in effect */
+};
+
+/**
+ * Create a disk writer, allocate its ring, and start its writer threads
+ *
+ * The writer takes over the file's underlying descriptor; the FILE stream
+ * must not be used to write to the file until disk_writer_close() returns.
+ * Writing begins at `offset`, leaving any preceding data in place.
+ *
+ * If direct I/O is requested but not supported by the platform or the
+ * file system, the writer silently falls back to buffered I/O. Direct I/O is
+ * also not used if `buffer_size` or `offset` is not a multiple of
+ * DISK_WRITER_ALIGNMENT.
+ *
+ * @param[in]   file        File to write to
+ * @param[in]   config      Writer configuration
+ * @param[out]  writer      Created writer
+ *
+ * @return 0 on success, CLI_RET_INVPARAM for invalid configurations,
+ *         CLI_RET_MEM on allocation failure, or CLI_RET_UNKNOWN if a writer
+ *         thread could not be started.
+ */
+int disk_writer_create(FILE *file,
+                       const struct disk_writer_config *config,
+                       struct disk_writer **writer);
+
+/**
+ * Obtain the next buffer to fill, waiting for a writer thread to free one if
+ * the ring is full.
+ *
+ * @param[in]   writer      Disk writer
+ *
+ * @return Buffer of `buffer_size` bytes, or NULL if a write has failed
+ */
+void *disk_writer_acquire(struct disk_writer *writer);
+
+/**
+ * Queue the buffer obtained from disk_writer_acquire() for writing
+ *
+ * When direct I/O is in effect, only the final buffer may be shorter than
+ * `buffer_size`.
+ *
+ * @param[in]   writer      Disk writer
+ * @param[in]   len         Number of bytes in the buffer to write
+ *
+ * @return 0 on success, CLI_RET_FILEOP if a write has failed, or
+ *         CLI_RET_INVPARAM if `len` is invalid
+ */
+int disk_writer_commit(struct disk_writer *writer, size_t len);
+
+/**
+ * Write all queued buffers, stop the writer threads, trim any padding from
+ * the end of the file, and return the file to buffered I/O. Statistics remain
+ * available until the writer is freed.
+ *
+ * @param[in]   writer      Disk writer
+ *
+ * @return 0 on success, CLI_RET_FILEOP if any write has failed. In the
+ *         latter case, disk_writer_error() provides the errno value.
+ */
+int disk_writer_close(struct disk_writer *writer);
+
+/**
+ * @param[in]   writer      Disk writer
+ *
+ * @return errno value of the first failed write, or 0 if none has failed
+ */
+int disk_writer_error(struct disk_writer *writer);
+
+/**
+ * Get a snapshot of the writer's statistics. This may be called from any
+ * thread.
+ *
+ * @param[in]   writer      Disk writer
+ * @param[out]  stats       Statistics
+ */
+void disk_writer_get_stats(struct disk_writer *writer,
+                           struct disk_writer_stats *stats);
+
+/**
+ * Free a disk writer, closing it first if needed
+ *
+ * @param[in]   writer      Disk writer. NULL is ignored.
+ */
+void disk_writer_free(struct disk_writer *writer);
+
+#endif
@@ -122,7 +122,7 @@ int cmd_generate(struct cli_state *s, int argc, char **argv)
             }
         } else if (!strcasecmp("format", argv[i])) {
             fmt = rxtx_str2fmt(val, s);
-            if (fmt == RXTX_FMT_INVALID) {
+            if (fmt == RXTX_FMT_INVALID || fmt == RXTX_FMT_CAPTURE) {
                 cli_err(s, argv[0], RXTX_ERRMSG_VALUE(argv[i], val));
                 status = CLI_RET_INVPARAM;
                 goto out;
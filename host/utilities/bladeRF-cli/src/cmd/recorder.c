@@ -0,0 +1,478 @@
+/*
+ * This file is part of the bladeRF project
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_config.h"
+
+#include "common.h"
+#include "minmax.h"
+#include "recorder.h"
+#include "rel_assert.h"
+#include "thread.h"
+
+struct recorder_buf {
+    void *data;
+    size_t len;
+    bool marked; /* To be recorded */
+};
+
+/*
+ * Buffers are identified by sequence number, and buffer n is held in slot
+ * n % num_bufs. A trigger marks the history preceding it, and buffers are
+ * marked as they are committed until mark_end.
+ *
+ * The writer thread visits each buffer in turn, once it can no longer become
+ * history for a later trigger: it writes marked buffers, and skips the rest,
+ * ending the current file at each gap in the recording.
+ */
+struct recorder {
+    char *path;
+    size_t buffer_size;
+    unsigned int history;
+    uint64_t post;
+    uint64_t rotate_bytes;
+
+    struct recorder_buf *bufs;
+    unsigned int num_bufs;
+
+    pthread_t thread;
+    bool have_thread;
+
+    /* Used only by the writer thread */
+    FILE *file;
+    uint64_t file_bytes;
+    unsigned int file_num;
+
+    MUTEX lock;            /* Must be held to access the following */
+    pthread_cond_t filled; /* Signaled on commits and triggers */
+    pthread_cond_t freed;  /* Signaled when a buffer has been visited */
+    uint64_t fill_seq;     /* Sequence number of the next buffer to fill */
+    uint64_t write_seq;    /* Sequence number of the next buffer to visit */
+    uint64_t mark_end;     /* End of the marked buffers, or UINT64_MAX */
+    bool closing;          /* The writer thread should exit once idle */
+    bool closed;           /* recorder_close() has completed */
+    int status;            /* CLI_RET_* value of the first failure */
+    int error;             /* errno value of the first failure */
+
+    struct recorder_stats stats;
+};
+
+/* Insert the file number before the extension of the base path */
+static int recorder_file_path(const struct recorder *r,
+                              unsigned int num,
+                              char *path,
+                              size_t len)
+{
+    const char *base = r->path;
+    const char *ext  = strrchr(base, '.');
+    const char *sep  = strrchr(base, '/');
+    int n;
+
+#if BLADERF_OS_WINDOWS
+    if (sep == NULL || strrchr(base, '\\') > sep) {
+        sep = strrchr(base, '\\');
+    }
+#endif
+
+    /* Dots in directory names, and leading dots, do not start extensions */
+    if (ext != NULL && (ext == base || (sep != NULL && ext <= sep + 1))) {
+        ext = NULL;
+    }
+
+    if (ext == NULL) {
+        n = snprintf(path, len, "%s-%04u", base, num);
+    } else {
+        n = snprintf(path, len, "%.*s-%04u%s", (int)(ext - base), base, num,
+                     ext);
+    }
+
+    return (n > 0 && (size_t)n < len) ? 0 : CLI_RET_INVPARAM;
+}
+
+/* Close the current file, if any. Called without the lock held. */
+static int recorder_close_file(struct recorder *r)
+{
+    int status = 0;
+
+    if (r->file != NULL) {
+        if (fclose(r->file) != 0) {
+            status = CLI_RET_FILEOP;
+        }
+
+        r->file = NULL;
+    }
+
+    return status;
+}
+
+/* Write one buffer, starting a new file if needed. Called without the lock
+ * held. */
+static int recorder_write(struct recorder *r,
+                          const struct recorder_buf *buf,
+                          char *opened)
+{
+    int status = 0;
+
+    if (r->file != NULL && r->rotate_bytes != 0 && r->file_bytes != 0 &&
+        r->file_bytes + buf->len > r->rotate_bytes) {
+        status = recorder_close_file(r);
+    }
+
+    if (status == 0 && r->file == NULL) {
+        status = recorder_file_path(r, r->file_num, opened,
+                                    RECORDER_MAX_PATH);
+        if (status != 0) {
+            errno = ENAMETOOLONG;
+        } else {
+            status = expand_and_open(opened, "wb", &r->file);
+        }
+
+        if (status != 0) {
+            opened[0] = '\0';
+            return status;
+        }
+
+        r->file_num++;
+        r->file_bytes = 0;
+    }
+
+    if (fwrite(buf->data, 1, buf->len, r->file) != buf->len) {
+        return CLI_RET_FILEOP;
+    }
+
+    r->file_bytes += buf->len;
+
+    return 0;
+}
+
+static void *recorder_task(void *arg)
+{
+    struct recorder *r = arg;
+    struct recorder_buf *buf;
+    char opened[RECORDER_MAX_PATH];
+    bool marked;
+    int status;
+    int error = 0;
+
+    MUTEX_LOCK(&r->lock);
+
+    while (true) {
+        buf = &r->bufs[r->write_seq % r->num_bufs];
+
+        if (r->write_seq == r->fill_seq ||
+            (!buf->marked && !r->closing &&
+             r->fill_seq - r->write_seq <= r->history)) {
+            /* Nothing to visit, or the next buffer may yet be marked */
+            if (r->closing) {
+                break;
+            }
+
+            pthread_cond_wait(&r->filled, &r->lock);
+            continue;
+        }
+
+        /* Once an operation has failed, just recycle buffers so that the
+         * producer can observe the error */
+        status    = r->status;
+        marked    = buf->marked;
+        opened[0] = '\0';
+
+        MUTEX_UNLOCK(&r->lock);
+
+        if (status != 0) {
+            /* Skip */
+        } else if (marked) {
+            status = recorder_write(r, buf, opened);
+            error  = errno;
+        } else {
+            /* A gap ends the recording */
+            status = recorder_close_file(r);
+            error  = errno;
+        }
+
+        MUTEX_LOCK(&r->lock);
+
+        if (opened[0] != '\0') {
+            memcpy(r->stats.path, opened, sizeof(opened));
+            r->stats.files++;
+        }
+
+        if (status == 0 && marked) {
+            r->stats.bytes_written += buf->len;
+        }
+
+        if (status != 0 && r->status == 0) {
+            r->status = status;
+            r->error  = error;
+        }
+
+        r->write_seq++;
+        pthread_cond_broadcast(&r->freed);
+    }
+
+    MUTEX_UNLOCK(&r->lock);
+
+    /* Closing in the middle of a recording */
+    status = recorder_close_file(r);
+    error  = errno;
+
+    MUTEX_LOCK(&r->lock);
+    if (status != 0 && r->status == 0) {
+        r->status = status;
+        r->error  = error;
+    }
+    MUTEX_UNLOCK(&r->lock);
+
+    return NULL;
+}
+
+int recorder_create(const struct recorder_config *config,
+                    struct recorder **recorder)
+{
+    struct recorder *r;
+    unsigned int i;
+
+    *recorder = NULL;
+
+    if (config->path == NULL || config->buffer_size == 0 ||
+        strlen(config->path) >= RECORDER_MAX_PATH ||
+        config->history_buffers > UINT_MAX / 2 ||
+        config->slack_buffers > UINT_MAX / 2) {
+        return CLI_RET_INVPARAM;
+    }
+
+    r = calloc(1, sizeof(*r));
+    if (r == NULL) {
+        return CLI_RET_MEM;
+    }
+
+    r->path = strdup(config->path);
+    if (r->path == NULL) {
+        free(r);
+        return CLI_RET_MEM;
+    }
+
+    r->buffer_size  = config->buffer_size;
+    r->history      = config->history_buffers;
+    r->post         = config->post_buffers;
+    r->rotate_bytes = config->rotate_bytes;
+
+    /* One more buffer than is held as history, for the one being filled */
+    r->num_bufs = config->history_buffers + config->slack_buffers + 1;
+    if (r->num_bufs < 2) {
+        r->num_bufs = 2;
+    }
+
+    r->bufs = calloc(r->num_bufs, sizeof(r->bufs[0]));
+    if (r->bufs == NULL) {
+        free(r->path);
+        free(r);
+        return CLI_RET_MEM;
+    }
+
+    for (i = 0; i < r->num_bufs; i++) {
+        r->bufs[i].data = malloc(r->buffer_size);
+        if (r->bufs[i].data == NULL) {
+            goto error;
+        }
+    }
+
+    MUTEX_INIT(&r->lock);
+    pthread_cond_init(&r->filled, NULL);
+    pthread_cond_init(&r->freed, NULL);
+
+    r->stats.num_buffers = r->num_bufs;
+
+    if (pthread_create(&r->thread, NULL, recorder_task, r) != 0) {
+        recorder_free(r);
+        return CLI_RET_UNKNOWN;
+    }
+
+    r->have_thread = true;
+    *recorder      = r;
+
+    return 0;
+
+error:
+    for (i = 0; i < r->num_bufs; i++) {
+        free(r->bufs[i].data);
+    }
+
+    free(r->bufs);
+    free(r->path);
+    free(r);
+    return CLI_RET_MEM;
+}
+
+void *recorder_acquire(struct recorder *r)
+{
+    struct recorder_buf *buf = NULL;
+
+    MUTEX_LOCK(&r->lock);
+
+    /* The slot still holds a buffer that is yet to be visited */
+    if (r->status == 0 && r->fill_seq - r->write_seq >= r->num_bufs) {
+        r->stats.stalls++;
+
+        while (r->status == 0 && r->fill_seq - r->write_seq >= r->num_bufs) {
+            pthread_cond_wait(&r->freed, &r->lock);
+        }
+    }
+
+    if (r->status == 0) {
+        buf = &r->bufs[r->fill_seq % r->num_bufs];
+    }
+
+    MUTEX_UNLOCK(&r->lock);
+
+    return (buf != NULL) ? buf->data : NULL;
+}
+
+int recorder_commit(struct recorder *r, size_t len)
+{
+    int status;
+
+    if (len == 0 || len > r->buffer_size) {
+        return CLI_RET_INVPARAM;
+    }
+
+    MUTEX_LOCK(&r->lock);
+
+    status = r->status;
+    if (status == 0) {
+        struct recorder_buf *buf = &r->bufs[r->fill_seq % r->num_bufs];
+
+        buf->len    = len;
+        buf->marked = (r->fill_seq < r->mark_end);
+        r->fill_seq++;
+        pthread_cond_signal(&r->filled);
+    }
+
+    MUTEX_UNLOCK(&r->lock);
+
+    return status;
+}
+
+void recorder_trigger(struct recorder *r)
+{
+    uint64_t trigger_seq, seq;
+
+    MUTEX_LOCK(&r->lock);
+
+    trigger_seq = r->fill_seq;
+    r->stats.triggers++;
+
+    /* Mark the available history, other than buffers already visited */
+    seq = trigger_seq - u64_min(trigger_seq, r->history);
+    seq = u64_max(seq, r->write_seq);
+
+    for (; seq < trigger_seq; seq++) {
+        r->bufs[seq % r->num_bufs].marked = true;
+    }
+
+    /* Extend any recording in progress */
+    if (r->post == 0) {
+        r->mark_end = UINT64_MAX;
+    } else if (r->mark_end != UINT64_MAX) {
+        r->mark_end = u64_max(r->mark_end, trigger_seq + r->post);
+    }
+
+    pthread_cond_signal(&r->filled);
+
+    MUTEX_UNLOCK(&r->lock);
+}
+
+int recorder_close(struct recorder *r)
+{
+    int status;
+
+    MUTEX_LOCK(&r->lock);
+    if (r->closed) {
+        status = r->status;
+        MUTEX_UNLOCK(&r->lock);
+        return status;
+    }
+
+    r->closing = true;
+    pthread_cond_signal(&r->filled);
+    MUTEX_UNLOCK(&r->lock);
+
+    if (r->have_thread) {
+        pthread_join(r->thread, NULL);
+        r->have_thread = false;
+    }
+
+    MUTEX_LOCK(&r->lock);
+    r->closed = true;
+    status    = r->status;
+    MUTEX_UNLOCK(&r->lock);
+
+    return status;
+}
+
+int recorder_error(struct recorder *r)
+{
+    int error;
+
+    MUTEX_LOCK(&r->lock);
+    error = r->error;
+    MUTEX_UNLOCK(&r->lock);
+
+    return error;
+}
+
+void recorder_get_stats(struct recorder *r, struct recorder_stats *stats)
+{
+    MUTEX_LOCK(&r->lock);
+
+    *stats           = r->stats;
+    stats->recording = (r->fill_seq < r->mark_end) && !r->closed;
+    stats->history   = (unsigned int)u64_min(r->fill_seq, r->history);
+
+    MUTEX_UNLOCK(&r->lock);
+}
+
+void recorder_free(struct recorder *r)
+{
+    unsigned int i;
+
+    if (r == NULL) {
+        return;
+    }
+
+    recorder_close(r);
+
+    for (i = 0; i < r->num_bufs; i++) {
+        free(r->bufs[i].data);
+    }
+
+    pthread_cond_destroy(&r->filled);
+    pthread_cond_destroy(&r->freed);
+    MUTEX_DESTROY(&r->lock);
+
+    free(r->bufs);
+    free(r->path);
+    free(r);
+}
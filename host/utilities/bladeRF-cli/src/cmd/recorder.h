@@ -0,0 +1,159 @@
+/**
+ * @file recorder.h
+ *
+ * @brief Triggered recording of a sample stream, with pre-trigger history
+ *
+ * A recorder keeps the most recent buffers of a stream in a ring. Until a
+ * trigger occurs, nothing is written and the oldest buffers are reused. When
+ * triggered, a writer thread writes the history preceding the trigger, and
+ * the buffers that follow it, to a new file. Files may be rotated after a
+ * given number of bytes; the next buffer is simply written to the next file,
+ * so no samples are lost across a rotation.
+ *
+ * Files are named after a base path, with a sequence number inserted before
+ * its extension: "capture.bin" is recorded as "capture-0000.bin",
+ * "capture-0001.bin", and so on.
+ *
+ * The writer thread visits each buffer once it is too old to become history
+ * for a later trigger. As with the disk writer, the producer waits for the
+ * writer thread if the ring fills up.
+ *
+ * This file is part of the bladeRF project
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef RECORDER_H__
+#define RECORDER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Maximum length of a recording's path */
+#define RECORDER_MAX_PATH 1024
+
+struct recorder;
+
+struct recorder_config {
+    const char *path;             /* Base path of the recorded files */
+    size_t buffer_size;           /* Size of each ring buffer, in bytes */
+    unsigned int history_buffers; /* Buffers kept from before a trigger */
+    unsigned int slack_buffers;   /* Additional buffers that absorb writer
+                                   * latency while recording */
+    uint64_t post_buffers;        /* Buffers recorded from a trigger onward,
+                                   * or 0 to record until closed */
+    uint64_t rotate_bytes;        /* Bytes after which to start a new file,
+                                   * or 0 for no limit */
+};
+
+struct recorder_stats {
+    unsigned int num_buffers;  /* Number of buffers in the ring */
+    unsigned int history;      /* Buffers of history currently held */
+    bool recording;            /* A recording is in progress */
+    uint64_t triggers;         /* Number of triggers */
+    uint64_t files;            /* Number of files written */
+    uint64_t bytes_written;    /* Total bytes written, over all files */
+    uint64_t stalls;           /* Times the producer waited for a buffer */
+    char path[RECORDER_MAX_PATH]; /* Current or last file, or empty */
+};
+
+/**
+ * Create a recorder, allocate its ring, and start its writer thread
+ *
+ * @param[in]   config      Recorder configuration
+ * @param[out]  recorder    Created recorder
+ *
+ * @return 0 on success, CLI_RET_INVPARAM for invalid configurations,
+ *         CLI_RET_MEM on allocation failure, or CLI_RET_UNKNOWN if the writer
+ *         thread could not be started.
+ */
+int recorder_create(const struct recorder_config *config,
+                    struct recorder **recorder);
+
+/**
+ * Obtain the next buffer to fill, waiting for the writer thread if the ring
+ * is full.
+ *
+ * @param[in]   recorder    Recorder
+ *
+ * @return Buffer of `buffer_size` bytes, or NULL if a file operation has
+ *         failed
+ */
+void *recorder_acquire(struct recorder *recorder);
+
+/**
+ * Add the buffer obtained from recorder_acquire() to the stream
+ *
+ * @param[in]   recorder    Recorder
+ * @param[in]   len         Number of bytes in the buffer
+ *
+ * @return 0 on success, CLI_RET_INVPARAM if `len` is invalid, or the
+ *         CLI_RET_* value of a failed file operation
+ */
+int recorder_commit(struct recorder *recorder, size_t len);
+
+/**
+ * Trigger a recording at the next buffer to be committed. This may be called
+ * from any thread.
+ *
+ * The available history is recorded, along with `post_buffers` buffers from
+ * the trigger onward. A trigger that falls within, or within the history
+ * after, a recording extends it; otherwise a new file is started.
+ *
+ * @param[in]   recorder    Recorder
+ */
+void recorder_trigger(struct recorder *recorder);
+
+/**
+ * Write the remainder of any recording in progress, up to the last committed
+ * buffer, and stop the writer thread. Statistics remain available until the
+ * recorder is freed.
+ *
+ * @param[in]   recorder    Recorder
+ *
+ * @return 0 on success, or a CLI_RET_* value if any file operation has
+ *         failed. In the latter case, recorder_error() provides the errno
+ *         value.
+ */
+int recorder_close(struct recorder *recorder);
+
+/**
+ * @param[in]   recorder    Recorder
+ *
+ * @return errno value of the first failed file operation, or 0 if none has
+ *         failed
+ */
+int recorder_error(struct recorder *recorder);
+
+/**
+ * Get a snapshot of the recorder's statistics. This may be called from any
+ * thread.
+ *
+ * @param[in]   recorder    Recorder
+ * @param[out]  stats       Statistics
+ */
+void recorder_get_stats(struct recorder *recorder,
+                        struct recorder_stats *stats);
+
+/**
+ * Free a recorder, closing it first if needed
+ *
+ * @param[in]   recorder    Recorder. NULL is ignored.
+ */
+void recorder_free(struct recorder *recorder);
+
+#endif
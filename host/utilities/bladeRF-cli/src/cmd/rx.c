@@ -31,12 +31,7 @@
 #include "minmax.h"
 #include "rel_assert.h"
 #include "rxtx_impl.h"
-
-#if BLADERF_OS_WINDOWS
-#define EOL "\r\n"
-#else
-#define EOL "\n"
-#endif
+#include "sample_csv.h"
 
 /**
  * Peform adjustments on received samples before writing them out:
@@ -71,70 +66,21 @@ static inline void sc16q11_sample_fixup(int16_t *buf, size_t n)
     }
 }
 
-/*
- * @pre data_mgmt lock is held
- *
- * returns 0 on success, CLI_RET_* on failure (and calls set_last_error()) */
-static int rx_write_bin_sc16q11(struct cli_state *s,
-                                void *samples,
-                                size_t n_samples)
-{
-    size_t status;
-    struct rxtx_data *rx = s->rx;
-
-    MUTEX_LOCK(&rx->file_mgmt.file_lock);
-    status = fwrite(samples, sizeof(int16_t),
-                    2 * n_samples, /* I and Q are each an int16_t */
-                    rx->file_mgmt.file);
-    MUTEX_UNLOCK(&rx->file_mgmt.file_lock);
-
-    if (status != (2 * n_samples)) {
-        set_last_error(&rx->last_error, ETYPE_CLI, CLI_RET_FILEOP);
-        return CLI_RET_FILEOP;
-    } else {
-        return 0;
-    }
-}
-
-/*
- * @pre data_mgmt lock is held
- *
- * returns 0 on success, CLI_RET_* on failure (and calls set_last_error()) */
-static int rx_write_bin_sc8q7(struct cli_state *s,
-                                void *samples,
-                                size_t n_samples)
-{
-    size_t status;
-    struct rxtx_data *rx = s->rx;
-
-    MUTEX_LOCK(&rx->file_mgmt.file_lock);
-    status = fwrite(samples, sizeof(int8_t),
-                    2 * n_samples, /* I and Q are each an int8_t */
-                    rx->file_mgmt.file);
-    MUTEX_UNLOCK(&rx->file_mgmt.file_lock);
-
-    if (status != (2 * n_samples)) {
-        set_last_error(&rx->last_error, ETYPE_CLI, CLI_RET_FILEOP);
-        return CLI_RET_FILEOP;
-    } else {
-        return 0;
-    }
-}
+/* Number of samples formatted at a time when writing CSV */
+#define RX_CSV_CHUNK_SAMPLES 1024
 
 /* returns 0 on success, CLI_RET_* on failure (and calls set_last_error()) */
 static int rx_write_csv(struct cli_state *s,
                         void *samples,
                         size_t n_samples)
 {
-    const size_t MAXLEN = 128; /* max line length (with newline and null) */
-
-    char *line = NULL;
-    char *tmp  = NULL;
-    int8_t *samples_sc8q7;
-    int16_t *samples_sc16q11;
+    char text[RX_CSV_CHUNK_SAMPLES * SAMPLE_CSV_SAMPLE_MAX];
     struct rxtx_data *rx = s->rx;
-    size_t i, j, nchans;
-    int status = 0;
+    enum sample_csv_fmt fmt;
+    size_t sample_size;
+    size_t i;
+    unsigned int nchans = 0;
+    int status          = 0;
 
     MUTEX_LOCK(&rx->data_mgmt.lock);
     switch (rx->data_mgmt.layout) {
@@ -153,77 +99,491 @@ static int rx_write_csv(struct cli_state *s,
     MUTEX_UNLOCK(&rx->data_mgmt.lock);
 
     if (status != 0) {
-        goto out;
+        return status;
     }
 
-    line = calloc(MAXLEN, 1);
-    if (NULL == line) {
-        status = errno;
-        set_last_error(&rx->last_error, ETYPE_ERRNO, status);
-        goto out;
+    if (s->bit_mode_8bit) {
+        fmt         = SAMPLE_CSV_SC8Q7;
+        sample_size = 2 * sizeof(int8_t);
+    } else {
+        fmt         = SAMPLE_CSV_SC16Q11;
+        sample_size = 2 * sizeof(int16_t);
     }
 
-    tmp = calloc(MAXLEN, 1);
-    if (NULL == tmp) {
-        status = errno;
-        set_last_error(&rx->last_error, ETYPE_ERRNO, status);
-        goto out;
+    MUTEX_LOCK(&rx->file_mgmt.file_lock);
+
+    // Output 2 columns for each enabled channel
+    // (2 cols for BLADERF_RX_X1, 4 cols for BLADERF_RX_X2, etc)
+    for (i = 0; i < n_samples; i += RX_CSV_CHUNK_SAMPLES) {
+        size_t n   = min_sz(RX_CSV_CHUNK_SAMPLES, n_samples - i);
+        size_t len = sample_csv_emit((uint8_t *)samples + i * sample_size, n,
+                                     nchans, fmt, text);
+
+        if (fwrite(text, 1, len, rx->file_mgmt.file) != len) {
+            set_last_error(&rx->last_error, ETYPE_ERRNO, errno);
+            status = CLI_RET_FILEOP;
+            break;
+        }
+    }
+
+    MUTEX_UNLOCK(&rx->file_mgmt.file_lock);
+
+    return status;
+}
+
+/* Minimum number of buffers in the disk writer's ring */
+#define RX_RING_BUFFERS_MIN 4
+
+/* Subcommand issuing a software trigger */
+#define RX_CMD_TRIGGER "trigger"
+
+/* Describe a capture of the enabled channels, using the current sample rate
+ * and the frequency of the first enabled channel.
+ *
+ * returns 0 on success, BLADERF_ERR_* on failure */
+static int rx_get_capture_params(struct cli_state *s,
+                                 size_t block_size,
+                                 struct capture_params *params)
+{
+    struct rxtx_data *rx       = s->rx;
+    bladerf_channel ch         = BLADERF_CHANNEL_RX(0);
+    bladerf_sample_rate rate   = 0;
+    bladerf_frequency freq     = 0;
+    int status;
+    int i;
+
+    MUTEX_LOCK(&rx->param_lock);
+    for (i = 0; i < RXTX_MAX_CHANNELS; ++i) {
+        if (rx->channel_enable[i]) {
+            ch = BLADERF_CHANNEL_RX(i);
+            break;
+        }
+    }
+    MUTEX_UNLOCK(&rx->param_lock);
+
+    status = bladerf_get_sample_rate(s->dev, ch, &rate);
+    if (status == 0) {
+        status = bladerf_get_frequency(s->dev, ch, &freq);
+    }
+
+    MUTEX_LOCK(&rx->data_mgmt.lock);
+    params->layout = rx->data_mgmt.layout;
+    MUTEX_UNLOCK(&rx->data_mgmt.lock);
+
+    params->format = s->bit_mode_8bit ? CAPTURE_FMT_SC8Q7 : CAPTURE_FMT_SC16Q11;
+    params->block_size  = (uint32_t)block_size;
+    params->sample_rate = rate;
+    params->frequency   = freq;
+
+    return status;
+}
+
+/*
+ * Receive samples directly into the buffers of a disk writer's ring, so that
+ * file system stalls are absorbed by the ring rather than the stream.
+ *
+ * For capture files, each buffer holds one block: the samples are received
+ * after the block header, along with the metadata used to fill it in.
+ *
+ * returns 0 on success, CLI_RET_* on failure (and calls set_last_error()) */
+static int rx_task_exec_running_ring(struct cli_state *s)
+{
+    int status = 0;
+    int close_status;
+    unsigned int samples_per_buffer;
+    void *samples;
+    size_t num_samples;
+    size_t samples_read = 0;
+    size_t sample_size;
+    size_t ring_size;
+    struct rxtx_data *rx        = s->rx;
+    struct rx_params *rx_params = rx->params;
+    struct disk_writer *writer  = NULL;
+    struct disk_writer_config config;
+    struct capture_writer *capture = NULL;
+    struct capture_params capture_params;
+    struct bladerf_metadata meta;
+    unsigned int block_samples;
+    unsigned int channels = 1;
+    unsigned int timeout_ms;
+    bool is_capture;
+
+    /* Read the parameters that will be used for the sync transfers */
+    MUTEX_LOCK(&rx->data_mgmt.lock);
+    timeout_ms         = rx->data_mgmt.timeout_ms;
+    samples_per_buffer = rx->data_mgmt.samples_per_buffer;
+    MUTEX_UNLOCK(&rx->data_mgmt.lock);
+
+    MUTEX_LOCK(&rx->param_lock);
+    num_samples        = rx_params->n_samples;
+    ring_size          = rx_params->ring_size;
+    config.num_writers = rx_params->num_writers;
+    config.direct      = rx_params->direct_io;
+    MUTEX_UNLOCK(&rx->param_lock);
+
+    /* I and Q are each an int8_t or int16_t */
+    sample_size = 2 * (s->bit_mode_8bit ? sizeof(int8_t) : sizeof(int16_t));
+
+    config.buffer_size = samples_per_buffer * sample_size;
+    config.num_buffers = (unsigned int)max_sz(RX_RING_BUFFERS_MIN,
+                                              ring_size / config.buffer_size);
+    config.offset      = 0;
+    block_samples      = samples_per_buffer;
+
+    MUTEX_LOCK(&rx->file_mgmt.file_meta_lock);
+    is_capture = (rx->file_mgmt.format == RXTX_FMT_CAPTURE);
+    MUTEX_UNLOCK(&rx->file_mgmt.file_meta_lock);
+
+    if (is_capture) {
+        status = rx_get_capture_params(s, config.buffer_size, &capture_params);
+        if (status != 0) {
+            set_last_error(&rx->last_error, ETYPE_BLADERF, status);
+            return status;
+        }
+
+        MUTEX_LOCK(&rx->file_mgmt.file_lock);
+        status = capture_writer_create(rx->file_mgmt.file, &capture_params,
+                                       &capture);
+        MUTEX_UNLOCK(&rx->file_mgmt.file_lock);
+
+        if (status == CLI_RET_FILEOP) {
+            set_last_error(&rx->last_error, ETYPE_ERRNO, errno);
+            return status;
+        } else if (status != 0) {
+            set_last_error(&rx->last_error, ETYPE_CLI, status);
+            return status;
+        }
+
+        config.offset = CAPTURE_DATA_OFFSET;
+        block_samples = capture_block_samples(&capture_params);
+        channels      = (capture_params.layout == BLADERF_RX_X2) ? 2 : 1;
     }
 
+    /* The writer owns the file's descriptor until it is closed. The file
+     * itself is closed when the task stops. */
     MUTEX_LOCK(&rx->file_mgmt.file_lock);
+    status = disk_writer_create(rx->file_mgmt.file, &config, &writer);
+    MUTEX_UNLOCK(&rx->file_mgmt.file_lock);
 
-    if (s->bit_mode_8bit) {
-        samples_sc8q7 = (int8_t*)samples;
-        // Output 2 columns for each enabled channel
-        // (2 cols for BLADERF_RX_X1, 4 cols for BLADERF_RX_X2, etc)
-        for (i = 0; i < 2 * n_samples; i += 2 * nchans) {
-            memset(line, 0, MAXLEN);
-            memset(tmp, 0, MAXLEN);
-
-            for (j = 0; j < 2 * nchans; j += 2) {
-                snprintf(tmp, MAXLEN, "%s%d, %d", (j > 0) ? ", " : "",
-                    samples_sc8q7[i + j], samples_sc8q7[i + j + 1]);
-                strncat(line, tmp, MAXLEN - 1);
+    if (status != 0) {
+        set_last_error(&rx->last_error, ETYPE_CLI, status);
+        capture_writer_free(capture);
+        return status;
+    }
+
+    MUTEX_LOCK(&rx->param_lock);
+    rx_params->writer = writer;
+    MUTEX_UNLOCK(&rx->param_lock);
+
+    while (status == 0 && (num_samples == 0 || samples_read < num_samples)) {
+        /* See rx_task_exec_running() */
+        unsigned char requests = rxtx_get_requests(rx, RXTX_TASK_REQ_STOP);
+        if (requests & (RXTX_TASK_REQ_STOP | RXTX_TASK_REQ_SHUTDOWN)) {
+            break;
+        }
+
+        /* Wait for a free buffer, if the writers have fallen behind */
+        samples = disk_writer_acquire(writer);
+        if (samples == NULL) {
+            status = CLI_RET_FILEOP;
+            set_last_error(&rx->last_error, ETYPE_ERRNO,
+                           disk_writer_error(writer));
+            break;
+        }
+
+        if (capture != NULL) {
+            unsigned int to_read = block_samples;
+
+            /* Stop at the requested count, in whole multi-channel samples */
+            if (num_samples != 0) {
+                to_read = (unsigned int)min_sz(block_samples,
+                                               num_samples - samples_read);
+                to_read += (channels - to_read % channels) % channels;
             }
 
-            strncat(line, EOL, MAXLEN - 1);
+            memset(&meta, 0, sizeof(meta));
+            meta.flags = BLADERF_META_FLAG_RX_NOW;
+
+            status = bladerf_sync_rx(
+                s->dev, (uint8_t *)samples + sizeof(struct capture_block_hdr),
+                to_read, &meta, timeout_ms);
 
-            if (fputs(line, rx->file_mgmt.file) < 0) {
-                set_last_error(&rx->last_error, ETYPE_ERRNO, errno);
-                status = CLI_RET_FILEOP;
+            if (status != 0) {
+                set_last_error(&rx->last_error, ETYPE_BLADERF, status);
                 break;
             }
+
+            /* Samples are kept little-endian, as received */
+            status = capture_writer_fill(capture, samples, &meta);
+            if (status == 0) {
+                status = disk_writer_commit(writer, config.buffer_size);
+            }
+
+            if (status == 0) {
+                capture_writer_commit(capture);
+            }
+
+            if (status != 0) {
+                set_last_error(&rx->last_error, ETYPE_CLI, status);
+            }
+
+            samples_read += meta.actual_count;
+            continue;
         }
+
+        status = bladerf_sync_rx(s->dev, samples, samples_per_buffer, NULL,
+                                 timeout_ms);
+
+        if (status != 0) {
+            set_last_error(&rx->last_error, ETYPE_BLADERF, status);
+        } else {
+            size_t to_write = samples_per_buffer;
+
+            /* Stop at the requested count, if there is one */
+            if (num_samples != 0) {
+                to_write = min_sz(to_write, num_samples - samples_read);
+            }
+
+            if (!s->bit_mode_8bit) {
+                sc16q11_sample_fixup(samples, to_write);
+            }
+
+            status = disk_writer_commit(writer, to_write * sample_size);
+
+            if (status != 0) {
+                set_last_error(&rx->last_error, ETYPE_CLI, status);
+            }
+        }
+
+        samples_read += samples_per_buffer;
     }
-    else {
-        samples_sc16q11 = (int16_t*)samples;
-        // Output 2 columns for each enabled channel
-        // (2 cols for BLADERF_RX_X1, 4 cols for BLADERF_RX_X2, etc)
-        for (i = 0; i < 2 * n_samples; i += 2 * nchans) {
-            memset(line, 0, MAXLEN);
-            memset(tmp, 0, MAXLEN);
-
-            for (j = 0; j < 2 * nchans; j += 2) {
-                snprintf(tmp, MAXLEN, "%s%d, %d", (j > 0) ? ", " : "",
-                    samples_sc16q11[i + j], samples_sc16q11[i + j + 1]);
-                strncat(line, tmp, MAXLEN - 1);
+
+    /* Drain the ring */
+    close_status = disk_writer_close(writer);
+    if (status == 0 && close_status != 0) {
+        status = close_status;
+        set_last_error(&rx->last_error, ETYPE_ERRNO, disk_writer_error(writer));
+    }
+
+    /* Index whatever was captured, even if the capture was cut short */
+    if (capture != NULL && (status == 0 || close_status == 0)) {
+        MUTEX_LOCK(&rx->file_mgmt.file_lock);
+        close_status = capture_writer_finish(capture);
+        MUTEX_UNLOCK(&rx->file_mgmt.file_lock);
+
+        if (close_status != 0) {
+            set_last_error(&rx->last_error, ETYPE_ERRNO, errno);
+        } else {
+            MUTEX_LOCK(&rx->file_mgmt.file_meta_lock);
+            close_status =
+                capture_writer_write_sigmf(capture, rx->file_mgmt.path);
+            MUTEX_UNLOCK(&rx->file_mgmt.file_meta_lock);
+
+            if (close_status != 0) {
+                set_last_error(&rx->last_error, ETYPE_CLI, close_status);
             }
+        }
+
+        if (status == 0) {
+            status = close_status;
+        }
+    }
+
+    capture_writer_free(capture);
+
+    MUTEX_LOCK(&rx->param_lock);
+    disk_writer_get_stats(writer, &rx_params->writer_stats);
+    rx_params->have_writer_stats = true;
+    rx_params->writer            = NULL;
+    MUTEX_UNLOCK(&rx->param_lock);
+
+    disk_writer_free(writer);
+
+    return status;
+}
+
+/*
+ * Receive samples into a recorder's ring of history, and record around each
+ * trigger. Software triggers are issued by "rx trigger". FPGA triggers are
+ * taken from the TX trigger, which is polled once per buffer; an armed RX
+ * trigger would withhold samples, and so the history, until it fired.
+ *
+ * returns 0 on success, CLI_RET_* on failure (and calls set_last_error()) */
+static int rx_task_exec_running_record(struct cli_state *s)
+{
+    int status = 0;
+    int close_status;
+    unsigned int samples_per_buffer;
+    void *samples;
+    size_t num_samples;
+    size_t samples_read = 0;
+    size_t to_write;
+    size_t sample_size;
+    size_t ring_size;
+    struct rxtx_data *rx        = s->rx;
+    struct rx_params *rx_params = rx->params;
+    struct recorder *recorder   = NULL;
+    struct recorder_config config;
+    struct capture_params stream;
+    struct bladerf_trigger trigger;
+    enum rx_trigger trigger_mode;
+    uint64_t pre_trigger, post_trigger;
+    uint64_t rotate_size, rotate_time_bytes;
+    unsigned int rotate_time;
+    unsigned int channels;
+    unsigned int timeout_ms;
+    bool fired;
+
+    /* Read the parameters that will be used for the sync transfers */
+    MUTEX_LOCK(&rx->data_mgmt.lock);
+    timeout_ms         = rx->data_mgmt.timeout_ms;
+    samples_per_buffer = rx->data_mgmt.samples_per_buffer;
+    MUTEX_UNLOCK(&rx->data_mgmt.lock);
+
+    MUTEX_LOCK(&rx->param_lock);
+    num_samples  = rx_params->n_samples;
+    ring_size    = rx_params->ring_size;
+    trigger_mode = rx_params->trigger;
+    pre_trigger  = rx_params->pre_trigger;
+    post_trigger = rx_params->post_trigger;
+    rotate_size  = rx_params->rotate_size;
+    rotate_time  = rx_params->rotate_time;
+    MUTEX_UNLOCK(&rx->param_lock);
+
+    /* I and Q are each an int8_t or int16_t */
+    sample_size = 2 * (s->bit_mode_8bit ? sizeof(int8_t) : sizeof(int16_t));
+
+    /* Triggers take effect on whole buffers */
+    config.buffer_size     = samples_per_buffer * sample_size;
+    config.history_buffers = (unsigned int)u64_min(
+        UINT_MAX / 2,
+        (pre_trigger + samples_per_buffer - 1) / samples_per_buffer);
+    config.slack_buffers = (unsigned int)max_sz(
+        RX_RING_BUFFERS_MIN, ring_size / config.buffer_size);
+    config.post_buffers =
+        (post_trigger + samples_per_buffer - 1) / samples_per_buffer;
+
+    /* Rotate at whichever limit is reached first */
+    config.rotate_bytes = rotate_size;
+
+    if (rotate_time != 0) {
+        status = rx_get_capture_params(s, config.buffer_size, &stream);
+        if (status != 0) {
+            set_last_error(&rx->last_error, ETYPE_BLADERF, status);
+            return status;
+        }
+
+        channels          = (stream.layout == BLADERF_RX_X2) ? 2 : 1;
+        rotate_time_bytes = (uint64_t)rotate_time * stream.sample_rate *
+                            channels * sample_size;
+
+        if (rotate_size == 0 || rotate_time_bytes < rotate_size) {
+            config.rotate_bytes = rotate_time_bytes;
+        }
+    }
+
+    if (trigger_mode == RX_TRIGGER_FPGA) {
+        status = bladerf_trigger_init(s->dev, BLADERF_CHANNEL_TX(0),
+                                      BLADERF_TRIGGER_MINI_EXP_1, &trigger);
+        if (status != 0) {
+            set_last_error(&rx->last_error, ETYPE_BLADERF, status);
+            return status;
+        }
+    }
+
+    MUTEX_LOCK(&rx->file_mgmt.file_meta_lock);
+    config.path = rx->file_mgmt.path;
+    status      = recorder_create(&config, &recorder);
+    MUTEX_UNLOCK(&rx->file_mgmt.file_meta_lock);
+
+    if (status != 0) {
+        set_last_error(&rx->last_error, ETYPE_CLI, status);
+        return status;
+    }
+
+    MUTEX_LOCK(&rx->param_lock);
+    rx_params->recorder = recorder;
+    MUTEX_UNLOCK(&rx->param_lock);
+
+    while (status == 0 && (num_samples == 0 || samples_read < num_samples)) {
+        /* See rx_task_exec_running() */
+        unsigned char requests = rxtx_get_requests(rx, RXTX_TASK_REQ_STOP);
+        if (requests & (RXTX_TASK_REQ_STOP | RXTX_TASK_REQ_SHUTDOWN)) {
+            break;
+        }
+
+        /* Wait for a free buffer, if the recording has fallen behind */
+        samples = recorder_acquire(recorder);
+        if (samples == NULL) {
+            status = CLI_RET_FILEOP;
+            set_last_error(&rx->last_error, ETYPE_ERRNO,
+                           recorder_error(recorder));
+            break;
+        }
+
+        status = bladerf_sync_rx(s->dev, samples, samples_per_buffer, NULL,
+                                 timeout_ms);
+
+        if (status != 0) {
+            set_last_error(&rx->last_error, ETYPE_BLADERF, status);
+            break;
+        }
 
-            strncat(line, EOL, MAXLEN - 1);
+        /* A firing seen now is attributed to this buffer. Re-arm for the
+         * next event. */
+        if (trigger_mode == RX_TRIGGER_FPGA) {
+            status = bladerf_trigger_state(s->dev, &trigger, NULL, &fired,
+                                           NULL, NULL, NULL);
 
-            if (fputs(line, rx->file_mgmt.file) < 0) {
-                set_last_error(&rx->last_error, ETYPE_ERRNO, errno);
-                status = CLI_RET_FILEOP;
+            if (status == 0 && fired) {
+                recorder_trigger(recorder);
+
+                status = bladerf_trigger_arm(s->dev, &trigger, false, 0, 0);
+                if (status == 0) {
+                    status = bladerf_trigger_arm(s->dev, &trigger, true, 0, 0);
+                }
+            }
+
+            if (status != 0) {
+                set_last_error(&rx->last_error, ETYPE_BLADERF, status);
                 break;
             }
         }
+
+        /* Stop at the requested count, if there is one */
+        to_write = samples_per_buffer;
+        if (num_samples != 0) {
+            to_write = min_sz(to_write, num_samples - samples_read);
+        }
+
+        if (!s->bit_mode_8bit) {
+            sc16q11_sample_fixup(samples, to_write);
+        }
+
+        status = recorder_commit(recorder, to_write * sample_size);
+
+        if (status != 0) {
+            set_last_error(&rx->last_error, ETYPE_ERRNO,
+                           recorder_error(recorder));
+        }
+
+        samples_read += samples_per_buffer;
     }
 
-    MUTEX_UNLOCK(&rx->file_mgmt.file_lock);
+    /* Finish any recording in progress */
+    close_status = recorder_close(recorder);
+    if (status == 0 && close_status != 0) {
+        status = close_status;
+        set_last_error(&rx->last_error, ETYPE_ERRNO, recorder_error(recorder));
+    }
 
-out:
-    free(line);
-    free(tmp);
+    MUTEX_LOCK(&rx->param_lock);
+    recorder_get_stats(recorder, &rx_params->recorder_stats);
+    rx_params->have_recorder_stats = true;
+    rx_params->recorder            = NULL;
+    MUTEX_UNLOCK(&rx->param_lock);
+
+    recorder_free(recorder);
 
     return status;
 }
@@ -237,6 +597,7 @@ static int rx_task_exec_running(struct cli_state *s)
     size_t samples_read = 0;
     struct rxtx_data *rx = s->rx;
     int (*write_samples)(struct cli_state *s, void *samples, size_t n);
+    enum rx_trigger trigger;
     unsigned int timeout_ms;
 
     /* Read the parameters that will be used for the sync transfers */
@@ -248,8 +609,17 @@ static int rx_task_exec_running(struct cli_state *s)
     MUTEX_LOCK(&rx->param_lock);
     num_samples   = ((struct rx_params *)rx->params)->n_samples;
     write_samples = ((struct rx_params *)rx->params)->write_samples;
+    trigger       = ((struct rx_params *)rx->params)->trigger;
     MUTEX_UNLOCK(&rx->param_lock);
 
+    /* Binary formats are written through the disk writer, or recorded
+     * around triggers */
+    if (write_samples == NULL && trigger != RX_TRIGGER_NONE) {
+        return rx_task_exec_running_record(s);
+    } else if (write_samples == NULL) {
+        return rx_task_exec_running_ring(s);
+    }
+
     /* Allocate a buffer for the block of samples */
     samples = malloc(samples_per_buffer * sizeof(uint16_t) * 2);
     if (samples == NULL) {
@@ -312,6 +682,9 @@ void *rx_task(void *cli_state_arg)
     struct rxtx_data *rx        = cli_state->rx;
     struct rx_params *rx_params = rx->params;
     bladerf_format sync_fmt;
+    bool with_meta = false;
+    enum error_type last_type;
+    int last_err;
 
     task_state = rxtx_get_state(rx);
     assert(task_state == RXTX_STATE_INIT);
@@ -347,11 +720,9 @@ void *rx_task(void *cli_state_arg)
                         break;
 
                     case RXTX_FMT_BIN_SC16Q11:
-                        rx_params->write_samples = rx_write_bin_sc16q11;
-                        break;
-
                     case RXTX_FMT_BIN_SC8Q7:
-                        rx_params->write_samples = rx_write_bin_sc8q7;
+                    case RXTX_FMT_CAPTURE:
+                        rx_params->write_samples = NULL;
                         break;
 
                     default:
@@ -364,14 +735,23 @@ void *rx_task(void *cli_state_arg)
                     assert(rx->file_mgmt.path);
                 }
 
+                /* Captures record the timestamp of each block */
+                with_meta = (rx->file_mgmt.format == RXTX_FMT_CAPTURE);
+
                 MUTEX_UNLOCK(&rx->file_mgmt.file_meta_lock);
 
                 /* Set up the reception stream and buffer information */
                 if (status == 0) {
                     MUTEX_LOCK(&rx->data_mgmt.lock);
 
-                    sync_fmt = cli_state->bit_mode_8bit ?
-                        BLADERF_FORMAT_SC8_Q7 : BLADERF_FORMAT_SC16_Q11;
+                    if (with_meta) {
+                        sync_fmt = cli_state->bit_mode_8bit ?
+                            BLADERF_FORMAT_SC8_Q7_META :
+                            BLADERF_FORMAT_SC16_Q11_META;
+                    } else {
+                        sync_fmt = cli_state->bit_mode_8bit ?
+                            BLADERF_FORMAT_SC8_Q7 : BLADERF_FORMAT_SC16_Q11;
+                    }
 
                     status = bladerf_sync_config(
                         cli_state->dev, rx->data_mgmt.layout,
@@ -395,6 +775,9 @@ void *rx_task(void *cli_state_arg)
             } break;
 
             case RXTX_STATE_RUNNING:
+                /* Any error recorded from here on belongs to this run */
+                set_last_error(&rx->last_error, ETYPE_BLADERF, 0);
+
                 status = rxtx_apply_channels(cli_state, rx, true);
 
                 if (status < 0) {
@@ -402,7 +785,9 @@ void *rx_task(void *cli_state_arg)
                 } else {
                     status = rx_task_exec_running(cli_state);
 
-                    if (status < 0) {
+                    /* Keep any more specific error the task recorded */
+                    get_last_error(&rx->last_error, &last_type, &last_err);
+                    if (status < 0 && last_err == 0) {
                         set_last_error(&rx->last_error, ETYPE_BLADERF, status);
                     }
 
@@ -436,9 +821,56 @@ void *rx_task(void *cli_state_arg)
     return NULL;
 }
 
+/* Check that a triggered recording can be started. The recorder creates its
+ * own files, and only records binary samples. */
+static int rx_check_trigger(struct cli_state *s, enum rx_trigger trigger)
+{
+    struct bladerf_trigger t;
+    enum rxtx_fmt format;
+    bool armed;
+    int status;
+
+    MUTEX_LOCK(&s->rx->file_mgmt.file_meta_lock);
+    format = s->rx->file_mgmt.format;
+    MUTEX_UNLOCK(&s->rx->file_mgmt.file_meta_lock);
+
+    if (format != RXTX_FMT_BIN_SC16Q11 && format != RXTX_FMT_BIN_SC8Q7) {
+        cli_err(s, "rx", "Triggered recording requires the bin format.\n");
+        return CLI_RET_UNSUPPORTED;
+    }
+
+    if (trigger != RX_TRIGGER_FPGA) {
+        return 0;
+    }
+
+    /* The TX trigger is used, as an armed RX trigger would gate the
+     * stream */
+    status = bladerf_trigger_init(s->dev, BLADERF_CHANNEL_TX(0),
+                                  BLADERF_TRIGGER_MINI_EXP_1, &t);
+    if (status == 0) {
+        status = bladerf_trigger_state(s->dev, &t, &armed, NULL, NULL, NULL,
+                                       NULL);
+    }
+
+    if (status != 0) {
+        s->last_lib_error = status;
+        return CLI_RET_LIBBLADERF;
+    }
+
+    if (!armed) {
+        cli_err(s, "rx", "The TX trigger must be armed for FPGA triggered "
+                         "recording. See \"help trigger\".\n");
+        return CLI_RET_STATE;
+    }
+
+    return 0;
+}
+
 static int rx_cmd_start(struct cli_state *s)
 {
     int status;
+    enum rx_trigger trigger;
+    struct rx_params *rx_params = s->rx->params;
 
     /* Check that we can start up in our current state */
     status = rxtx_cmd_start_check(s, s->rx, "rx");
@@ -446,14 +878,28 @@ static int rx_cmd_start(struct cli_state *s)
         return status;
     }
 
+    MUTEX_LOCK(&s->rx->param_lock);
+    trigger = rx_params->trigger;
+    MUTEX_UNLOCK(&s->rx->param_lock);
+
+    if (trigger != RX_TRIGGER_NONE) {
+        status = rx_check_trigger(s, trigger);
+        if (status != 0) {
+            return status;
+        }
+    }
+
     /* Set up output file */
     MUTEX_LOCK(&s->rx->file_mgmt.file_lock);
-    if (s->rx->file_mgmt.format == RXTX_FMT_CSV) {
+    if (trigger != RX_TRIGGER_NONE) {
+        /* Nothing to open; the recorder creates a file per recording */
+        status = 0;
+    } else if (s->rx->file_mgmt.format == RXTX_FMT_CSV) {
         status =
             expand_and_open(s->rx->file_mgmt.path, "w", &s->rx->file_mgmt.file);
 
     } else {
-        /* RXTX_FMT_BIN_SC16Q11, open file in binary mode */
+        /* Binary and capture formats, open file in binary mode */
         status = expand_and_open(s->rx->file_mgmt.path, "wb",
                                  &s->rx->file_mgmt.file);
     }
@@ -477,13 +923,115 @@ static int rx_cmd_start(struct cli_state *s)
     return status;
 }
 
+static void rx_print_writer_stats(const struct disk_writer_stats *stats)
+{
+    const double MiB = 1024.0 * 1024.0;
+    double rate = 0.0, busy = 0.0;
+
+    if (stats->elapsed > 0.0) {
+        rate = stats->bytes_written / MiB / stats->elapsed;
+        busy = 100.0 * stats->write_time / stats->elapsed;
+    }
+
+    printf("  Ring occupancy: %u/%u buffers (max %u), %" PRIu64 " stalls\n",
+           stats->occupancy, stats->num_buffers, stats->max_occupancy,
+           stats->stalls);
+    printf("  Writer throughput: %.1f MiB in %.1f s (%.1f MiB/s), "
+           "%" PRIu64 " writes, %.0f%% busy%s\n",
+           stats->bytes_written / MiB, stats->elapsed, rate,
+           stats->write_calls, busy, stats->direct ? ", direct I/O" : "");
+}
+
+static const char *rx_trigger2str(enum rx_trigger trigger)
+{
+    switch (trigger) {
+        case RX_TRIGGER_SOFTWARE:
+            return "software";
+        case RX_TRIGGER_FPGA:
+            return "fpga";
+        default:
+            return "none";
+    }
+}
+
+static void rx_print_recorder(const struct rx_params *rx_params,
+                              const struct recorder_stats *stats,
+                              bool have_stats)
+{
+    const double MiB = 1024.0 * 1024.0;
+
+    printf("  Trigger: %s, %" PRIu64 " samples before",
+           rx_trigger2str(rx_params->trigger), rx_params->pre_trigger);
+
+    if (rx_params->post_trigger != 0) {
+        printf(" and %" PRIu64 " after\n", rx_params->post_trigger);
+    } else {
+        printf(", then until stopped\n");
+    }
+
+    if (rx_params->rotate_size != 0 && rx_params->rotate_time != 0) {
+        printf("  File rotation: every %" PRIu64 " MiB or %u s\n",
+               rx_params->rotate_size / (1024 * 1024), rx_params->rotate_time);
+    } else if (rx_params->rotate_size != 0) {
+        printf("  File rotation: every %" PRIu64 " MiB\n",
+               rx_params->rotate_size / (1024 * 1024));
+    } else if (rx_params->rotate_time != 0) {
+        printf("  File rotation: every %u s\n", rx_params->rotate_time);
+    } else {
+        printf("  File rotation: off\n");
+    }
+
+    if (have_stats) {
+        printf("  Recorder: %s, %u/%u buffers of history, %" PRIu64
+               " trigger%s, %" PRIu64 " file%s, %.1f MiB, %" PRIu64
+               " stalls\n",
+               stats->recording ? "recording" : "idle", stats->history,
+               stats->num_buffers, stats->triggers,
+               stats->triggers == 1 ? "" : "s", stats->files,
+               stats->files == 1 ? "" : "s", stats->bytes_written / MiB,
+               stats->stalls);
+
+        if (stats->path[0] != '\0') {
+            printf("  Last file: %s\n", stats->path);
+        }
+    }
+}
+
 static void rx_print_config(struct rxtx_data *rx)
 {
     size_t n_samples;
+    size_t ring_size;
+    unsigned int num_writers;
+    bool direct_io;
+    bool have_stats;
+    struct disk_writer_stats stats;
+    struct rx_params params;
+    bool have_recorder_stats;
+    struct recorder_stats recorder_stats;
     struct rx_params *rx_params = rx->params;
 
     MUTEX_LOCK(&rx->param_lock);
-    n_samples = rx_params->n_samples;
+    n_samples   = rx_params->n_samples;
+    ring_size   = rx_params->ring_size;
+    num_writers = rx_params->num_writers;
+    direct_io   = rx_params->direct_io;
+
+    if (rx_params->writer != NULL) {
+        disk_writer_get_stats(rx_params->writer, &stats);
+        have_stats = true;
+    } else {
+        stats      = rx_params->writer_stats;
+        have_stats = rx_params->have_writer_stats;
+    }
+
+    params = *rx_params;
+    if (rx_params->recorder != NULL) {
+        recorder_get_stats(rx_params->recorder, &recorder_stats);
+        have_recorder_stats = true;
+    } else {
+        recorder_stats      = rx_params->recorder_stats;
+        have_recorder_stats = rx_params->have_recorder_stats;
+    }
     MUTEX_UNLOCK(&rx->param_lock);
 
     printf("\n");
@@ -500,6 +1048,19 @@ static void rx_print_config(struct rxtx_data *rx)
     }
     rxtx_print_stream_info(rx, "  ", "\n");
 
+    printf("  Disk writer: %" PRIu64 " MiB ring, %u writer%s, "
+           "direct I/O %s\n",
+           (uint64_t)ring_size / (1024 * 1024), num_writers,
+           num_writers == 1 ? "" : "s", direct_io ? "on" : "off");
+
+    if (have_stats) {
+        rx_print_writer_stats(&stats);
+    }
+
+    if (params.trigger != RX_TRIGGER_NONE) {
+        rx_print_recorder(&params, &recorder_stats, have_recorder_stats);
+    }
+
     printf("\n");
 }
 
@@ -539,6 +1100,108 @@ static int rx_cmd_config(struct cli_state *s, int argc, char **argv)
                     cli_err(s, argv[0], RXTX_ERRMSG_VALUE(argv[i], val));
                     return CLI_RET_INVPARAM;
                 }
+            } else if (!strcasecmp("ring", argv[i])) {
+                /* Configure the disk writer's ring size, in bytes */
+                uint64_t n;
+                bool ok;
+
+                n = str2uint64_suffix(val, 1024 * 1024, SIZE_MAX,
+                                      rxtx_kmg_suffixes,
+                                      (int)rxtx_kmg_suffixes_len, &ok);
+
+                if (ok) {
+                    MUTEX_LOCK(&s->rx->param_lock);
+                    rx_params->ring_size = (size_t)n;
+                    MUTEX_UNLOCK(&s->rx->param_lock);
+                } else {
+                    cli_err(s, argv[0], RXTX_ERRMSG_VALUE(argv[i], val));
+                    return CLI_RET_INVPARAM;
+                }
+            } else if (!strcasecmp("writers", argv[i])) {
+                /* Configure the number of disk writer threads */
+                unsigned int n;
+                bool ok;
+
+                n = str2uint(val, 1, DISK_WRITER_MAX_WRITERS, &ok);
+
+                if (ok) {
+                    MUTEX_LOCK(&s->rx->param_lock);
+                    rx_params->num_writers = n;
+                    MUTEX_UNLOCK(&s->rx->param_lock);
+                } else {
+                    cli_err(s, argv[0], RXTX_ERRMSG_VALUE(argv[i], val));
+                    return CLI_RET_INVPARAM;
+                }
+            } else if (!strcasecmp("direct", argv[i])) {
+                /* Configure whether to bypass the OS page cache */
+                bool direct_io;
+
+                if (str2bool(val, &direct_io) == 0) {
+                    MUTEX_LOCK(&s->rx->param_lock);
+                    rx_params->direct_io = direct_io;
+                    MUTEX_UNLOCK(&s->rx->param_lock);
+                } else {
+                    cli_err(s, argv[0], RXTX_ERRMSG_VALUE(argv[i], val));
+                    return CLI_RET_INVPARAM;
+                }
+            } else if (!strcasecmp("trigger", argv[i])) {
+                /* Configure what triggers a recording */
+                enum rx_trigger trigger;
+
+                if (!strcasecmp("none", val)) {
+                    trigger = RX_TRIGGER_NONE;
+                } else if (!strcasecmp("software", val)) {
+                    trigger = RX_TRIGGER_SOFTWARE;
+                } else if (!strcasecmp("fpga", val)) {
+                    trigger = RX_TRIGGER_FPGA;
+                } else {
+                    cli_err(s, argv[0], RXTX_ERRMSG_VALUE(argv[i], val));
+                    return CLI_RET_INVPARAM;
+                }
+
+                MUTEX_LOCK(&s->rx->param_lock);
+                rx_params->trigger = trigger;
+                MUTEX_UNLOCK(&s->rx->param_lock);
+            } else if (!strcasecmp("pretrigger", argv[i]) ||
+                       !strcasecmp("posttrigger", argv[i]) ||
+                       !strcasecmp("rotate_size", argv[i])) {
+                /* Configure the history kept before a trigger, the samples
+                 * recorded after it, or the file size limit, in bytes */
+                uint64_t n;
+                bool ok;
+
+                n = str2uint64_suffix(val, 0, UINT64_MAX, rxtx_kmg_suffixes,
+                                      (int)rxtx_kmg_suffixes_len, &ok);
+
+                if (ok) {
+                    MUTEX_LOCK(&s->rx->param_lock);
+                    if (!strcasecmp("pretrigger", argv[i])) {
+                        rx_params->pre_trigger = n;
+                    } else if (!strcasecmp("posttrigger", argv[i])) {
+                        rx_params->post_trigger = n;
+                    } else {
+                        rx_params->rotate_size = n;
+                    }
+                    MUTEX_UNLOCK(&s->rx->param_lock);
+                } else {
+                    cli_err(s, argv[0], RXTX_ERRMSG_VALUE(argv[i], val));
+                    return CLI_RET_INVPARAM;
+                }
+            } else if (!strcasecmp("rotate_time", argv[i])) {
+                /* Configure the file duration limit, in seconds */
+                unsigned int n;
+                bool ok;
+
+                n = str2uint(val, 0, UINT_MAX, &ok);
+
+                if (ok) {
+                    MUTEX_LOCK(&s->rx->param_lock);
+                    rx_params->rotate_time = n;
+                    MUTEX_UNLOCK(&s->rx->param_lock);
+                } else {
+                    cli_err(s, argv[0], RXTX_ERRMSG_VALUE(argv[i], val));
+                    return CLI_RET_INVPARAM;
+                }
             } else if (!strcasecmp("channel", argv[i])) {
                 /* Configure RX channels */
                 status = rxtx_handle_channel_list(s, s->rx, val);
@@ -559,6 +1222,31 @@ static int rx_cmd_config(struct cli_state *s, int argc, char **argv)
     return 0;
 }
 
+/* Trigger a recording from the current point in the stream */
+static int rx_cmd_trigger(struct cli_state *s, int argc, char **argv)
+{
+    struct rx_params *rx_params = s->rx->params;
+    int status                  = 0;
+
+    if (argc != 2) {
+        return CLI_RET_NARGS;
+    }
+
+    MUTEX_LOCK(&s->rx->param_lock);
+    if (rx_params->recorder == NULL) {
+        status = CLI_RET_STATE;
+    } else {
+        recorder_trigger(rx_params->recorder);
+    }
+    MUTEX_UNLOCK(&s->rx->param_lock);
+
+    if (status != 0) {
+        cli_err(s, argv[0], "No triggered recording is running.\n");
+    }
+
+    return status;
+}
+
 int cmd_rx(struct cli_state *s, int argc, char **argv)
 {
     int ret;
@@ -576,6 +1264,8 @@ int cmd_rx(struct cli_state *s, int argc, char **argv)
         ret = rx_cmd_config(s, argc, argv);
     } else if (!strcasecmp(argv[1], RXTX_CMD_WAIT)) {
         ret = rxtx_handle_wait(s, s->rx, argc, argv);
+    } else if (!strcasecmp(argv[1], RX_CMD_TRIGGER)) {
+        ret = rx_cmd_trigger(s, argc, argv);
     } else {
         cli_err(s, argv[0], "Invalid command: \"%s\"\n", argv[1]);
         ret = CLI_RET_INVPARAM;
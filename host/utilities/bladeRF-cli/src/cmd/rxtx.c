@@ -244,6 +244,9 @@ void rxtx_print_file_format(struct rxtx_data *rxtx,
         case RXTX_FMT_BIN_SC8Q7:
             printf("%sSC8 Q7, Binary%s", prefix, suffix);
             break;
+        case RXTX_FMT_CAPTURE:
+            printf("%sTimestamped capture%s", prefix, suffix);
+            break;
         default:
             printf("%sNot configured%s", prefix, suffix);
     }
@@ -341,6 +344,8 @@ enum rxtx_fmt rxtx_str2fmt(const char *str, struct cli_state *s)
         ret = RXTX_FMT_CSV;
     } else if (!strcasecmp("bin", str)) {
         ret = (s->bit_mode_8bit) ? RXTX_FMT_BIN_SC8Q7 : RXTX_FMT_BIN_SC16Q11;
+    } else if (!strcasecmp("capture", str)) {
+        ret = RXTX_FMT_CAPTURE;
     }
 
     return ret;
@@ -372,6 +377,8 @@ struct rxtx_data *rxtx_data_alloc(bladerf_direction dir)
         } else {
             tx_params->repeat       = 1;
             tx_params->repeat_delay = 0;
+            tx_params->playback     = TX_PLAYBACK_STREAM;
+            tx_params->timed        = false;
             ret->params             = tx_params;
         }
     } else {
@@ -382,8 +389,21 @@ struct rxtx_data *rxtx_data_alloc(bladerf_direction dir)
             free(ret);
             return NULL;
         } else {
-            rx_params->n_samples = 100000;
-            ret->params          = rx_params;
+            rx_params->n_samples           = 100000;
+            rx_params->write_samples       = NULL;
+            rx_params->ring_size           = 64 * 1024 * 1024;
+            rx_params->num_writers         = 2;
+            rx_params->direct_io           = true;
+            rx_params->writer              = NULL;
+            rx_params->have_writer_stats   = false;
+            rx_params->trigger             = RX_TRIGGER_NONE;
+            rx_params->pre_trigger         = 1024 * 1024;
+            rx_params->post_trigger        = 1024 * 1024;
+            rx_params->rotate_size         = 0;
+            rx_params->rotate_time         = 0;
+            rx_params->recorder            = NULL;
+            rx_params->have_recorder_stats = false;
+            ret->params                    = rx_params;
         }
     }
 
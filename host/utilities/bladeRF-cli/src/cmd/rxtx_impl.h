@@ -29,8 +29,11 @@
 
 #include <libbladeRF.h>
 
+#include "capture_file.h"
 #include "cmd.h"
 #include "conversions.h"
+#include "disk_writer.h"
+#include "recorder.h"
 #include "thread.h"
 
 #define RXTX_ERRMSG_VALUE(param, value) \
@@ -58,7 +61,8 @@ enum rxtx_fmt {
     RXTX_FMT_INVALID = -1,
     RXTX_FMT_CSV,         /* CSV (Comma-separated, one entry per line) */
     RXTX_FMT_BIN_SC16Q11, /* Binary (big-endian), c16 I,Q */
-    RXTX_FMT_BIN_SC8Q7    /* Binary (big-endian), c8 I,Q */
+    RXTX_FMT_BIN_SC8Q7,   /* Binary (big-endian), c8 I,Q */
+    RXTX_FMT_CAPTURE      /* Timestamped capture file. See capture_file.h */
 };
 
 enum rxtx_state {
@@ -132,14 +136,52 @@ struct rxtx_data {
     bool channel_enable[RXTX_MAX_CHANNELS];
 };
 
+enum tx_playback {
+    TX_PLAYBACK_STREAM,  /* Read the file while transmitting */
+    TX_PLAYBACK_MMAP,    /* Map the file into memory */
+    TX_PLAYBACK_PRELOAD, /* Read the file into locked memory up front */
+};
+
 struct tx_params {
     unsigned int repeat_delay; /* us delay between repetitions */
     unsigned int repeat;       /* # of repetitions */
+    enum tx_playback playback; /* How the file is read */
+    bool timed;                /* Schedule repetitions with timestamps */
+};
+
+enum rx_trigger {
+    RX_TRIGGER_NONE,     /* Write all samples received */
+    RX_TRIGGER_SOFTWARE, /* Record around "rx trigger" commands */
+    RX_TRIGGER_FPGA,     /* Record around firings of the TX trigger */
 };
 
 struct rx_params {
     size_t n_samples; /* Number of samples to receive */
     int (*write_samples)(struct cli_state *s, void *samples, size_t n);
+
+    /* Binary formats are written through a disk writer, with a ring of
+     * ring_size bytes and num_writers writer threads */
+    size_t ring_size;
+    unsigned int num_writers;
+    bool direct_io;
+
+    struct disk_writer *writer;           /* Active while receiving */
+    struct disk_writer_stats writer_stats; /* Stats of the last reception */
+    bool have_writer_stats;
+
+    /* With a trigger, binary samples are kept in a ring of pre_trigger
+     * samples of history instead, and each trigger records the history and
+     * post_trigger more samples (0 = until stopped). Files are rotated after
+     * rotate_size bytes or rotate_time seconds, if non-zero. */
+    enum rx_trigger trigger;
+    uint64_t pre_trigger;
+    uint64_t post_trigger;
+    uint64_t rotate_size;
+    unsigned int rotate_time;
+
+    struct recorder *recorder;            /* Active while receiving */
+    struct recorder_stats recorder_stats; /* Stats of the last reception */
+    bool have_recorder_stats;
 };
 
 /* Multipliers in units of 1024 */
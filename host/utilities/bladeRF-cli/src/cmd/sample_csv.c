@@ -0,0 +1,525 @@
+/*
+ * This file is part of the bladeRF project
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "conversions.h"
+#include "host_config.h"
+#include "minmax.h"
+#include "sample_csv.h"
+
+#if BLADERF_OS_WINDOWS
+#define EOL "\r\n"
+#else
+#define EOL "\n"
+#endif
+
+/* Amount of text converted by each thread at a time */
+#define SEGMENT_SIZE (4 * 1024 * 1024)
+
+/* Longest value handed to str2int(), for values not in plain decimal */
+#define TOKEN_MAX 32
+
+/* Magnitude beyond which decimal values are simply clamped */
+#define DECIMAL_MAX 1000000
+
+/* Work for one thread */
+struct sample_csv_job {
+    const void *in;
+    size_t len;
+    void *out;
+    size_t out_len;
+    enum sample_csv_fmt fmt;
+    unsigned int channels;
+    int status;
+    struct sample_csv_stats stats;
+    pthread_t thread;
+    bool started;
+};
+
+static inline bool is_delim(char c)
+{
+    /* As per csv2int(), with line endings handled separately */
+    return c == ',' || c == ' ' || c == '\t' || c == '\r' || c == '.' ||
+           c == ':';
+}
+
+static inline size_t value_size(enum sample_csv_fmt fmt)
+{
+    return (fmt == SAMPLE_CSV_SC8Q7) ? sizeof(int8_t) : sizeof(int16_t);
+}
+
+/* Parse a value that is not in plain decimal, as csv2int() would */
+static bool parse_token(const char *start, const char *end, long *value)
+{
+    char token[TOKEN_MAX];
+    size_t len = (size_t)(end - start);
+    bool ok;
+
+    if (len >= sizeof(token)) {
+        return false;
+    }
+
+    memcpy(token, start, len);
+    token[len] = '\0';
+
+    *value = str2int(token, INT32_MIN, INT32_MAX, &ok);
+    return ok;
+}
+
+int sample_csv_parse(const char *text,
+                     size_t len,
+                     enum sample_csv_fmt fmt,
+                     void *out,
+                     struct sample_csv_stats *stats)
+{
+    const char *p   = text;
+    const char *end = text + len;
+    int16_t *out16  = (int16_t *)out;
+    int8_t *out8    = (int8_t *)out;
+    const long min  = (fmt == SAMPLE_CSV_SC8Q7) ? INT8_MIN : -2048;
+    const long max  = (fmt == SAMPLE_CSV_SC8Q7) ? INT8_MAX : 2047;
+    size_t n        = 0;
+    size_t line_values = 0;
+
+    memset(stats, 0, sizeof(*stats));
+
+    while (p < end) {
+        const char *start;
+        unsigned long mag = 0;
+        bool negative     = false;
+        long value;
+
+        if (*p == '\n') {
+            if (line_values % 2 != 0) {
+                stats->error_line = stats->lines + 1;
+                return CLI_RET_INVPARAM;
+            }
+
+            line_values = 0;
+            stats->lines++;
+            p++;
+            continue;
+        } else if (is_delim(*p)) {
+            p++;
+            continue;
+        }
+
+        /* Plain decimal values are converted in place */
+        start = p;
+        if (*p == '-' || *p == '+') {
+            negative = (*p == '-');
+            p++;
+        }
+
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (mag < DECIMAL_MAX) {
+                mag = mag * 10 + (unsigned long)(*p - '0');
+            }
+            p++;
+        }
+
+        if (p > start + (negative || *start == '+') &&
+            (p == end || *p == '\n' || is_delim(*p))) {
+            value = negative ? -(long)mag : (long)mag;
+        } else {
+            /* Anything else, such as hex, goes through str2int() */
+            while (p < end && *p != '\n' && !is_delim(*p)) {
+                p++;
+            }
+
+            if (!parse_token(start, p, &value)) {
+                stats->error_line = stats->lines + 1;
+                return CLI_RET_INVPARAM;
+            }
+        }
+
+        if (value < min) {
+            value = min;
+            stats->clamped++;
+        } else if (value > max) {
+            value = max;
+            stats->clamped++;
+        }
+
+        if (fmt == SAMPLE_CSV_SC8Q7) {
+            out8[n++] = (int8_t)value;
+        } else {
+            out16[n++] = (int16_t)value;
+        }
+
+        line_values++;
+    }
+
+    /* The final line need not be terminated */
+    if (line_values % 2 != 0) {
+        stats->error_line = stats->lines + 1;
+        return CLI_RET_INVPARAM;
+    } else if (len > 0 && text[len - 1] != '\n') {
+        stats->lines++;
+    }
+
+    stats->num_values = n;
+    return 0;
+}
+
+static inline char *emit_int(char *p, int value)
+{
+    char digits[8];
+    unsigned int mag;
+    int n = 0;
+
+    if (value < 0) {
+        *p++ = '-';
+        mag  = 0u - (unsigned int)value;
+    } else {
+        mag = (unsigned int)value;
+    }
+
+    do {
+        digits[n++] = (char)('0' + mag % 10);
+        mag /= 10;
+    } while (mag != 0);
+
+    while (n > 0) {
+        *p++ = digits[--n];
+    }
+
+    return p;
+}
+
+size_t sample_csv_emit(const void *samples,
+                       size_t num_samples,
+                       unsigned int channels,
+                       enum sample_csv_fmt fmt,
+                       char *text)
+{
+    const int16_t *in16 = (const int16_t *)samples;
+    const int8_t *in8   = (const int8_t *)samples;
+    const size_t eol_len = strlen(EOL);
+    char *p = text;
+    size_t i;
+
+    for (i = 0; i < 2 * num_samples; i += 2) {
+        int i_val, q_val;
+
+        if (fmt == SAMPLE_CSV_SC8Q7) {
+            i_val = in8[i];
+            q_val = in8[i + 1];
+        } else {
+            i_val = in16[i];
+            q_val = in16[i + 1];
+        }
+
+        /* Output 2 columns for each channel, as "I, Q[, I, Q]" */
+        if ((i / 2) % channels != 0) {
+            *p++ = ',';
+            *p++ = ' ';
+        }
+
+        p    = emit_int(p, i_val);
+        *p++ = ',';
+        *p++ = ' ';
+        p    = emit_int(p, q_val);
+
+        if ((i / 2) % channels == channels - 1) {
+            memcpy(p, EOL, eol_len);
+            p += eol_len;
+        }
+    }
+
+    return (size_t)(p - text);
+}
+
+static void *parse_job(void *arg)
+{
+    struct sample_csv_job *job = (struct sample_csv_job *)arg;
+
+    job->status = sample_csv_parse((const char *)job->in, job->len, job->fmt,
+                                   job->out, &job->stats);
+    job->out_len = (size_t)job->stats.num_values * value_size(job->fmt);
+    return NULL;
+}
+
+static void *emit_job(void *arg)
+{
+    struct sample_csv_job *job = (struct sample_csv_job *)arg;
+
+    job->out_len = sample_csv_emit(job->in, job->len, job->channels, job->fmt,
+                                   (char *)job->out);
+    job->status  = 0;
+    return NULL;
+}
+
+/* Run jobs on their own threads, with the first on the calling thread. Jobs
+ * whose threads cannot be started are also run on the calling thread. */
+static void run_jobs(struct sample_csv_job *jobs,
+                     unsigned int num_jobs,
+                     void *(*fn)(void *))
+{
+    unsigned int i;
+
+    for (i = 1; i < num_jobs; i++) {
+        jobs[i].started =
+            (pthread_create(&jobs[i].thread, NULL, fn, &jobs[i]) == 0);
+    }
+
+    fn(&jobs[0]);
+
+    for (i = 1; i < num_jobs; i++) {
+        if (jobs[i].started) {
+            pthread_join(jobs[i].thread, NULL);
+        } else {
+            fn(&jobs[i]);
+        }
+    }
+}
+
+/* Write job outputs, in order. Returns 0 or CLI_RET_FILEOP. */
+static int write_jobs(const struct sample_csv_job *jobs,
+                      unsigned int num_jobs,
+                      FILE *file)
+{
+    unsigned int i;
+
+    for (i = 0; i < num_jobs; i++) {
+        if (jobs[i].out_len != 0 &&
+            fwrite(jobs[i].out, 1, jobs[i].out_len, file) != jobs[i].out_len) {
+            return CLI_RET_FILEOP;
+        }
+    }
+
+    return 0;
+}
+
+/* Find the end of the line containing text[pos], or len if there is none */
+static size_t line_end(const char *text, size_t pos, size_t len)
+{
+    const char *nl;
+
+    if (pos >= len) {
+        return len;
+    }
+
+    nl = memchr(text + pos, '\n', len - pos);
+    return (nl == NULL) ? len : (size_t)(nl - text) + 1;
+}
+
+int sample_csv_from_file(FILE *csv,
+                         FILE *bin,
+                         enum sample_csv_fmt fmt,
+                         unsigned int threads,
+                         struct sample_csv_stats *stats)
+{
+    struct sample_csv_job jobs[SAMPLE_CSV_MAX_THREADS];
+    const size_t capacity = (size_t)threads * SEGMENT_SIZE;
+    char *text    = NULL;
+    uint8_t *out  = NULL;
+    size_t have   = 0;
+    bool eof      = false;
+    int status    = 0;
+
+    memset(stats, 0, sizeof(*stats));
+
+    if (threads < 1 || threads > SAMPLE_CSV_MAX_THREADS) {
+        return CLI_RET_INVPARAM;
+    }
+
+    /* Each job's values fit in (len + 1) / 2 values */
+    text = malloc(capacity);
+    out  = malloc((capacity / 2 + threads) * value_size(fmt));
+    if (text == NULL || out == NULL) {
+        status = CLI_RET_MEM;
+        goto out;
+    }
+
+    while (status == 0 && !eof) {
+        size_t usable;
+        size_t start     = 0;
+        size_t out_off   = 0;
+        unsigned int num_jobs = 0;
+        unsigned int i;
+
+        have += fread(text + have, 1, capacity - have, csv);
+        if (ferror(csv)) {
+            status = CLI_RET_FILEOP;
+            break;
+        }
+
+        /* Parse whole lines, carrying any partial line over to the next
+         * segment */
+        eof = (feof(csv) != 0);
+        if (eof) {
+            usable = have;
+        } else {
+            const char *last = text + have;
+
+            while (last > text && last[-1] != '\n') {
+                last--;
+            }
+
+            if (last == text && have == capacity) {
+                /* A line longer than the entire buffer */
+                stats->error_line = stats->lines + 1;
+                status            = CLI_RET_INVPARAM;
+                break;
+            }
+
+            usable = (size_t)(last - text);
+        }
+
+        /* Split the lines evenly over the threads */
+        for (i = 0; i < threads && start < usable; i++) {
+            size_t end = usable;
+
+            if (i != threads - 1) {
+                end = line_end(text, max_sz(start, usable * (i + 1) / threads),
+                               usable);
+            }
+
+            jobs[num_jobs].in  = text + start;
+            jobs[num_jobs].len = end - start;
+            jobs[num_jobs].out = out + out_off * value_size(fmt);
+            jobs[num_jobs].fmt = fmt;
+            out_off += (end - start + 1) / 2;
+            start = end;
+            num_jobs++;
+        }
+
+        if (num_jobs != 0) {
+            run_jobs(jobs, num_jobs, parse_job);
+        }
+
+        for (i = 0; i < num_jobs; i++) {
+            if (jobs[i].status != 0) {
+                stats->error_line = stats->lines + jobs[i].stats.error_line;
+                status            = jobs[i].status;
+                break;
+            }
+
+            stats->num_values += jobs[i].stats.num_values;
+            stats->lines += jobs[i].stats.lines;
+            stats->clamped += jobs[i].stats.clamped;
+        }
+
+        if (status == 0) {
+            status = write_jobs(jobs, num_jobs, bin);
+        }
+
+        memmove(text, text + usable, have - usable);
+        have -= usable;
+    }
+
+out:
+    free(text);
+    free(out);
+    return status;
+}
+
+int sample_csv_to_file(FILE *bin,
+                       FILE *csv,
+                       enum sample_csv_fmt fmt,
+                       unsigned int channels,
+                       unsigned int threads,
+                       uint64_t *num_samples)
+{
+    struct sample_csv_job jobs[SAMPLE_CSV_MAX_THREADS];
+    const size_t sample_size = 2 * value_size(fmt);
+    const size_t set_size    = sample_size * channels;
+    const size_t job_sets    = SEGMENT_SIZE / SAMPLE_CSV_SAMPLE_MAX / channels;
+    uint8_t *samples = NULL;
+    char *text       = NULL;
+    size_t have      = 0;
+    bool eof         = false;
+    int status       = 0;
+
+    *num_samples = 0;
+
+    if (threads < 1 || threads > SAMPLE_CSV_MAX_THREADS || channels < 1) {
+        return CLI_RET_INVPARAM;
+    }
+
+    samples = malloc(threads * job_sets * set_size);
+    text    = malloc((size_t)threads * SEGMENT_SIZE);
+    if (samples == NULL || text == NULL) {
+        status = CLI_RET_MEM;
+        goto out;
+    }
+
+    while (status == 0 && !eof) {
+        const size_t capacity = threads * job_sets * set_size;
+        size_t sets;
+        size_t start = 0;
+        unsigned int num_jobs = 0;
+        unsigned int i;
+
+        have += fread(samples + have, 1, capacity - have, bin);
+        if (ferror(bin)) {
+            status = CLI_RET_FILEOP;
+            break;
+        }
+
+        /* Carry any partial sample over to the next segment */
+        eof = (feof(bin) != 0);
+        if (eof && have % set_size != 0) {
+            status = CLI_RET_INVPARAM;
+            break;
+        }
+
+        /* Split the samples evenly over the threads */
+        sets = have / set_size;
+        for (i = 0; i < threads && start < sets; i++) {
+            size_t end = (i == threads - 1) ? sets : sets * (i + 1) / threads;
+
+            if (end == start) {
+                continue;
+            }
+
+            jobs[num_jobs].in       = samples + start * set_size;
+            jobs[num_jobs].len      = (end - start) * channels;
+            jobs[num_jobs].out      = text + (size_t)i * SEGMENT_SIZE;
+            jobs[num_jobs].fmt      = fmt;
+            jobs[num_jobs].channels = channels;
+            start = end;
+            num_jobs++;
+        }
+
+        if (num_jobs != 0) {
+            run_jobs(jobs, num_jobs, emit_job);
+            status = write_jobs(jobs, num_jobs, csv);
+        }
+
+        *num_samples += sets * channels;
+
+        memmove(samples, samples + sets * set_size, have - sets * set_size);
+        have -= sets * set_size;
+    }
+
+out:
+    free(samples);
+    free(text);
+    return status;
+}
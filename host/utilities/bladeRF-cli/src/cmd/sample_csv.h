@@ -0,0 +1,147 @@
+/**
+ * @file sample_csv.h
+ *
+ * @brief Conversion of samples to and from CSV text
+ *
+ * The parser and emitter operate on caller-provided memory and do not
+ * allocate, so that they may be used on stream buffers and run on several
+ * chunks of a file at once. The file conversion routines split large files
+ * into such chunks and convert them on multiple threads.
+ *
+ * The CSV format holds one sample per line for each channel, as an I, Q pair
+ * of integers. Values may be separated by commas, whitespace, periods or
+ * colons, as accepted by csv2int().
+ *
+ * Binary samples are interleaved I, Q values in host byte order, as handled
+ * by the rx and tx commands.
+ *
+ * This file is part of the bladeRF project
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef SAMPLE_CSV_H__
+#define SAMPLE_CSV_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Maximum number of threads used to convert a file */
+#define SAMPLE_CSV_MAX_THREADS 16
+
+/* Number of bytes of emitted text that one sample (an I, Q pair) may need,
+ * including its separator and line ending */
+#define SAMPLE_CSV_SAMPLE_MAX 16
+
+enum sample_csv_fmt {
+    SAMPLE_CSV_SC16Q11, /* int16_t I, Q values, clamped to [-2048, 2047] */
+    SAMPLE_CSV_SC8Q7,   /* int8_t I, Q values, clamped to [-128, 127] */
+};
+
+/* Result of parsing CSV text */
+struct sample_csv_stats {
+    uint64_t num_values; /* Number of I and Q values parsed */
+    uint64_t lines;      /* Number of lines parsed */
+    uint64_t clamped;    /* Number of values clamped into range */
+    uint64_t error_line; /* Line number of an error, from 1, or 0 */
+};
+
+/**
+ * Parse CSV text into binary samples. Each line must hold an even number of
+ * values. Empty lines are skipped.
+ *
+ * @param[in]   text        CSV text. This should end at the end of a line.
+ * @param[in]   len         Length of `text`, in bytes
+ * @param[in]   fmt         Binary sample format
+ * @param[out]  out         Parsed I, Q values. This must be able to hold
+ *                          (`len` + 1) / 2 values; no more may be present.
+ * @param[out]  stats       Number of values and lines parsed, and the line
+ *                          number within `text` of an error
+ *
+ * @return 0 on success, or CLI_RET_INVPARAM on a malformed value or line
+ */
+int sample_csv_parse(const char *text,
+                     size_t len,
+                     enum sample_csv_fmt fmt,
+                     void *out,
+                     struct sample_csv_stats *stats);
+
+/**
+ * Format binary samples as CSV text
+ *
+ * @param[in]   samples     Interleaved I, Q values
+ * @param[in]   num_samples Number of samples, over all channels. This should
+ *                          be a multiple of `channels`.
+ * @param[in]   channels    Number of channels, written as a pair of columns
+ *                          each
+ * @param[in]   fmt         Binary sample format
+ * @param[out]  text        CSV text. This must be able to hold
+ *                          `num_samples` * SAMPLE_CSV_SAMPLE_MAX bytes.
+ *
+ * @return Length of the text, in bytes. The text is not NUL-terminated.
+ */
+size_t sample_csv_emit(const void *samples,
+                       size_t num_samples,
+                       unsigned int channels,
+                       enum sample_csv_fmt fmt,
+                       char *text);
+
+/**
+ * Convert a CSV file to a binary sample file
+ *
+ * @param[in]   csv         File to read from
+ * @param[in]   bin         File to write to
+ * @param[in]   fmt         Binary sample format
+ * @param[in]   threads     Number of threads to parse with, from 1 to
+ *                          SAMPLE_CSV_MAX_THREADS. A chunk whose thread
+ *                          cannot be started is parsed by the caller.
+ * @param[out]  stats       Totals over the file, and the line number of an
+ *                          error within the file
+ *
+ * @return 0 on success, CLI_RET_INVPARAM on a malformed value or line,
+ *         CLI_RET_MEM on allocation failure, or CLI_RET_FILEOP on a file
+ *         error, with errno set.
+ */
+int sample_csv_from_file(FILE *csv,
+                         FILE *bin,
+                         enum sample_csv_fmt fmt,
+                         unsigned int threads,
+                         struct sample_csv_stats *stats);
+
+/**
+ * Convert a binary sample file to a CSV file
+ *
+ * @param[in]   bin         File to read from
+ * @param[in]   csv         File to write to
+ * @param[in]   fmt         Binary sample format
+ * @param[in]   channels    Number of interleaved channels in `bin`
+ * @param[in]   threads     Number of threads to format with, from 1 to
+ *                          SAMPLE_CSV_MAX_THREADS
+ * @param[out]  num_samples Number of samples converted, over all channels
+ *
+ * @return 0 on success, CLI_RET_INVPARAM if the file does not hold a whole
+ *         number of samples on each channel, CLI_RET_MEM on allocation
+ *         failure, or CLI_RET_FILEOP on a file error, with errno set.
+ */
+int sample_csv_to_file(FILE *bin,
+                       FILE *csv,
+                       enum sample_csv_fmt fmt,
+                       unsigned int channels,
+                       unsigned int threads,
+                       uint64_t *num_samples);
+
+#endif
@@ -18,6 +18,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 #include <errno.h>
+#include <inttypes.h>
 #include <limits.h>
 #include <pthread.h>
 #include <stdbool.h>
@@ -32,6 +33,8 @@
 #include "parse.h"
 #include "rel_assert.h"
 #include "rxtx_impl.h"
+#include "sample_csv.h"
+#include "waveform.h"
 
 /* The DAC range is [-2048, 2047] */
 #define SC16Q11_IQ_MIN (-2048)
@@ -40,6 +43,385 @@
 #define SC8Q7_IQ_MIN (-128)
 #define SC8Q7_IQ_MAX (127)
 
+/* Number of threads used to parse CSV input */
+#define TX_CSV_THREADS 4
+
+/* Lead time given to the first burst of a timed playback */
+#define TX_TIMED_START_DELAY_MS 150
+
+/* Wait until the TX timestamp reaches the specified value, or a stop is
+ * requested.
+ *
+ * returns 0 on success, BLADERF_ERR_* on failure */
+static int tx_wait_for_timestamp(struct rxtx_data *tx,
+                                 struct cli_state *s,
+                                 uint64_t timestamp)
+{
+    int status   = 0;
+    uint64_t now = 0;
+
+    while (status == 0 && now < timestamp) {
+        if (rxtx_get_requests(tx, RXTX_TASK_REQ_STOP) &
+            (RXTX_TASK_REQ_STOP | RXTX_TASK_REQ_SHUTDOWN)) {
+            break;
+        }
+
+        status = bladerf_get_timestamp(s->dev, BLADERF_TX, &now);
+        if (status == 0 && now < timestamp) {
+            usleep(1000);
+        }
+    }
+
+    return status;
+}
+
+/* Transmit a file held in memory, via a mapping or a preloaded copy, so that
+ * each repetition is passed to bladerf_sync_tx() without re-reading the file.
+ *
+ * Repetition delays are fed from a single buffer of zeros or, for timed
+ * playback, realized by timestamping each repetition within one long burst.
+ * In the latter case the FPGA holds off transmission until each timestamp,
+ * and at most the remainder of a stream message is zero-padded.
+ *
+ * returns 0 on success, CLI_RET_* or BLADERF_ERR_* on failure */
+static int tx_task_exec_running_waveform(struct rxtx_data *tx,
+                                         struct cli_state *s,
+                                         bladerf_sample_rate sample_rate,
+                                         unsigned int repeats_remaining,
+                                         unsigned int delay_samples)
+{
+    int status = 0;
+    struct tx_params *tx_params = tx->params;
+    struct waveform *waveform   = NULL;
+    struct bladerf_metadata meta;
+    struct bladerf_metadata *meta_ptr = NULL;
+    enum waveform_mode mode;
+    const uint8_t *samples;
+    void *zeros = NULL;
+    size_t sample_size;
+    size_t num_samples;
+    size_t offset                        = 0;
+    unsigned int delay_samples_remaining = 0;
+    unsigned int samples_per_buffer;
+    unsigned int timeout_ms;
+    unsigned int channels;
+    uint64_t timestamp = 0;
+    uint64_t period;
+    bool repeat_infinite = (repeats_remaining == 0);
+    bool in_burst        = false;
+    bool timed;
+
+    enum state { TX_WAVEFORM, DELAY, DONE };
+    enum state state = TX_WAVEFORM;
+
+    MUTEX_LOCK(&tx->param_lock);
+    mode  = (tx_params->playback == TX_PLAYBACK_MMAP) ? WAVEFORM_MMAP
+                                                      : WAVEFORM_PRELOAD;
+    timed = tx_params->timed;
+    MUTEX_UNLOCK(&tx->param_lock);
+
+    MUTEX_LOCK(&tx->data_mgmt.lock);
+    samples_per_buffer = tx->data_mgmt.samples_per_buffer;
+    timeout_ms         = tx->data_mgmt.timeout_ms;
+    channels = (tx->data_mgmt.layout == BLADERF_TX_X2) ? 2 : 1;
+    MUTEX_UNLOCK(&tx->data_mgmt.lock);
+
+    MUTEX_LOCK(&tx->file_mgmt.file_lock);
+    status = waveform_load(tx->file_mgmt.file, mode, &waveform);
+    MUTEX_UNLOCK(&tx->file_mgmt.file_lock);
+
+    if (status == CLI_RET_FILEOP) {
+        set_last_error(&tx->last_error, ETYPE_ERRNO, errno);
+        return status;
+    } else if (status != 0) {
+        set_last_error(&tx->last_error, ETYPE_CLI, status);
+        return status;
+    }
+
+    /* I and Q are each an int8_t or int16_t. Each timestamp covers a sample
+     * on every channel, so only whole sets of samples are transmitted. */
+    sample_size = 2 * (s->bit_mode_8bit ? sizeof(int8_t) : sizeof(int16_t));
+    num_samples = waveform_size(waveform) / sample_size;
+    num_samples -= num_samples % channels;
+    samples     = waveform_data(waveform);
+
+    if (num_samples == 0) {
+        status = CLI_RET_INVPARAM;
+        set_last_error(&tx->last_error, ETYPE_CLI, status);
+        goto out;
+    }
+
+    /* Used for repetition delays and to flush the stream */
+    zeros = calloc(samples_per_buffer, sample_size);
+    if (zeros == NULL) {
+        status = CLI_RET_MEM;
+        set_last_error(&tx->last_error, ETYPE_CLI, status);
+        goto out;
+    }
+
+    period = num_samples / channels + delay_samples;
+
+    if (timed) {
+        status = bladerf_get_timestamp(s->dev, BLADERF_TX, &timestamp);
+        if (status != 0) {
+            goto out;
+        }
+
+        timestamp += (uint64_t)sample_rate * TX_TIMED_START_DELAY_MS / 1000;
+
+        memset(&meta, 0, sizeof(meta));
+        meta.flags     = BLADERF_META_FLAG_TX_BURST_START;
+        meta.timestamp = timestamp;
+        meta_ptr       = &meta;
+        in_burst       = true;
+    }
+
+    while (state != DONE && status == 0) {
+        unsigned char requests;
+        unsigned int to_send;
+
+        /* See tx_task_exec_running() */
+        requests = rxtx_get_requests(tx, RXTX_TASK_REQ_STOP);
+        if (requests & (RXTX_TASK_REQ_STOP | RXTX_TASK_REQ_SHUTDOWN)) {
+            break;
+        }
+
+        if (state == TX_WAVEFORM) {
+            bool last_repeat = false;
+
+            to_send = (unsigned int)min_sz(samples_per_buffer,
+                                           num_samples - offset);
+
+            if (offset + to_send == num_samples) {
+                if (!repeat_infinite) {
+                    repeats_remaining--;
+                }
+
+                last_repeat = !repeat_infinite && (repeats_remaining == 0);
+
+                if (timed && last_repeat) {
+                    meta.flags |= BLADERF_META_FLAG_TX_BURST_END;
+                    in_burst = false;
+                }
+            }
+
+            status = bladerf_sync_tx(s->dev, samples + offset * sample_size,
+                                     to_send, meta_ptr, timeout_ms);
+
+            offset += to_send;
+            if (timed) {
+                meta.flags = 0;
+            }
+
+            if (offset == num_samples) {
+                offset = 0;
+                timestamp += period;
+
+                if (last_repeat) {
+                    state = DONE;
+                } else if (delay_samples != 0 && timed) {
+                    /* Pick up again at the next repetition's timestamp */
+                    meta.flags     = BLADERF_META_FLAG_TX_UPDATE_TIMESTAMP;
+                    meta.timestamp = timestamp;
+                } else if (delay_samples != 0) {
+                    delay_samples_remaining = delay_samples;
+                    state                   = DELAY;
+                }
+            }
+        } else {
+            to_send = uint_min(samples_per_buffer, delay_samples_remaining);
+
+            status = bladerf_sync_tx(s->dev, zeros, to_send, NULL, timeout_ms);
+
+            delay_samples_remaining -= to_send;
+            if (delay_samples_remaining == 0) {
+                state = TX_WAVEFORM;
+            }
+        }
+    }
+
+    if (timed) {
+        /* Close out a burst cut short by a stop request */
+        if (status == 0 && in_burst) {
+            meta.flags = BLADERF_META_FLAG_TX_BURST_END;
+            status = bladerf_sync_tx(s->dev, zeros, samples_per_buffer, &meta,
+                                     timeout_ms);
+        }
+
+        /* Ending the burst flushed it to the device. Wait for the final
+         * repetition to go out before the channel is disabled. */
+        if (status == 0 && state == DONE) {
+            status = tx_wait_for_timestamp(tx, s, timestamp - delay_samples);
+        }
+    } else if (status == 0) {
+        /* See tx_task_exec_running() */
+        const unsigned int num_buffers = tx->data_mgmt.num_buffers;
+        unsigned int i;
+
+        for (i = 0; i < (num_buffers + 1) && status == 0; i++) {
+            status = bladerf_sync_tx(s->dev, zeros, samples_per_buffer, NULL,
+                                     timeout_ms);
+        }
+    }
+
+out:
+    free(zeros);
+    waveform_free(waveform);
+    return status;
+}
+
+/* Replay a capture file within one burst, reproducing the spacing of its
+ * blocks. Each gap in the recording, and each repetition delay, is realized
+ * by timestamping the block that follows it.
+ *
+ * returns 0 on success, CLI_RET_* or BLADERF_ERR_* on failure */
+static int tx_task_exec_running_capture(struct rxtx_data *tx,
+                                        struct cli_state *s,
+                                        bladerf_sample_rate sample_rate,
+                                        unsigned int repeats_remaining,
+                                        unsigned int delay_samples)
+{
+    int status = 0;
+    struct capture_reader *reader = NULL;
+    struct capture_params params;
+    struct capture_block block;
+    struct bladerf_metadata meta;
+    void *zeros = NULL;
+    unsigned int samples_per_buffer;
+    unsigned int timeout_ms;
+    unsigned int channels;
+    uint64_t timestamp = 0; /* Device time at which the next block is due */
+    uint64_t prev_end  = 0; /* Capture time following the previous block */
+    bool repeat_infinite = (repeats_remaining == 0);
+    bool first_block     = true;
+    bool in_burst        = false;
+    bool done            = false;
+
+    MUTEX_LOCK(&tx->data_mgmt.lock);
+    samples_per_buffer = tx->data_mgmt.samples_per_buffer;
+    timeout_ms         = tx->data_mgmt.timeout_ms;
+    MUTEX_UNLOCK(&tx->data_mgmt.lock);
+
+    MUTEX_LOCK(&tx->file_mgmt.file_lock);
+    status = capture_reader_open(tx->file_mgmt.file, &reader);
+    MUTEX_UNLOCK(&tx->file_mgmt.file_lock);
+
+    if (status == CLI_RET_FILEOP) {
+        set_last_error(&tx->last_error, ETYPE_ERRNO, errno);
+        return status;
+    } else if (status != 0) {
+        set_last_error(&tx->last_error, ETYPE_CLI, status);
+        return status;
+    }
+
+    capture_reader_get_params(reader, &params);
+    channels = (params.layout == BLADERF_RX_X2) ? 2 : 1;
+
+    /* Used to end the burst */
+    zeros = calloc(samples_per_buffer, 2 * sizeof(int16_t));
+    if (zeros == NULL) {
+        status = CLI_RET_MEM;
+        set_last_error(&tx->last_error, ETYPE_CLI, status);
+        goto out;
+    }
+
+    status = bladerf_get_timestamp(s->dev, BLADERF_TX, &timestamp);
+    if (status != 0) {
+        goto out;
+    }
+
+    timestamp += (uint64_t)sample_rate * TX_TIMED_START_DELAY_MS / 1000;
+
+    while (status == 0) {
+        unsigned char requests;
+
+        /* See tx_task_exec_running() */
+        requests = rxtx_get_requests(tx, RXTX_TASK_REQ_STOP);
+        if (requests & (RXTX_TASK_REQ_STOP | RXTX_TASK_REQ_SHUTDOWN)) {
+            break;
+        }
+
+        MUTEX_LOCK(&tx->file_mgmt.file_lock);
+        status = capture_reader_next(reader, &block);
+        MUTEX_UNLOCK(&tx->file_mgmt.file_lock);
+
+        if (status == 1) {
+            /* End of the capture */
+            status = 0;
+
+            if (!in_burst) {
+                status = CLI_RET_INVPARAM;
+                set_last_error(&tx->last_error, ETYPE_CLI, status);
+                break;
+            }
+
+            if (!repeat_infinite && --repeats_remaining == 0) {
+                done = true;
+                break;
+            }
+
+            MUTEX_LOCK(&tx->file_mgmt.file_lock);
+            status = capture_reader_rewind(reader);
+            MUTEX_UNLOCK(&tx->file_mgmt.file_lock);
+
+            if (status != 0) {
+                set_last_error(&tx->last_error, ETYPE_ERRNO, errno);
+            }
+
+            first_block = true;
+            continue;
+        } else if (status == CLI_RET_FILEOP) {
+            set_last_error(&tx->last_error, ETYPE_ERRNO, errno);
+            break;
+        } else if (status != 0) {
+            set_last_error(&tx->last_error, ETYPE_CLI, status);
+            break;
+        }
+
+        memset(&meta, 0, sizeof(meta));
+
+        if (!in_burst) {
+            meta.flags     = BLADERF_META_FLAG_TX_BURST_START;
+            meta.timestamp = timestamp;
+            in_burst       = true;
+        } else if (first_block && delay_samples != 0) {
+            timestamp += delay_samples;
+            meta.flags     = BLADERF_META_FLAG_TX_UPDATE_TIMESTAMP;
+            meta.timestamp = timestamp;
+        } else if (!first_block && block.timestamp > prev_end) {
+            /* Leave the same gap the recording did */
+            timestamp += block.timestamp - prev_end;
+            meta.flags     = BLADERF_META_FLAG_TX_UPDATE_TIMESTAMP;
+            meta.timestamp = timestamp;
+        }
+
+        status = bladerf_sync_tx(s->dev, block.samples, block.num_samples,
+                                 &meta, timeout_ms);
+
+        timestamp += block.num_samples / channels;
+        prev_end    = block.timestamp + block.num_samples / channels;
+        first_block = false;
+    }
+
+    /* End the burst, flushing it to the device */
+    if (status == 0 && in_burst) {
+        memset(&meta, 0, sizeof(meta));
+        meta.flags = BLADERF_META_FLAG_TX_BURST_END;
+        status = bladerf_sync_tx(s->dev, zeros, samples_per_buffer, &meta,
+                                 timeout_ms);
+    }
+
+    /* Wait for the final block to go out before the channel is disabled */
+    if (status == 0 && done) {
+        status = tx_wait_for_timestamp(tx, s, timestamp);
+    }
+
+out:
+    free(zeros);
+    capture_reader_free(reader);
+    return status;
+}
+
 static int tx_task_exec_running(struct rxtx_data *tx, struct cli_state *s)
 {
     int status = 0;
@@ -53,6 +435,8 @@ static int tx_task_exec_running(struct rxtx_data *tx, struct cli_state *s)
     bool repeat_infinite;
     unsigned int timeout_ms;
     bladerf_sample_rate sample_rate = 0;
+    enum tx_playback playback;
+    bool is_capture;
     int i;
 
     enum state { INIT, READ_FILE, DELAY, PAD_TRAILING, DONE };
@@ -62,6 +446,7 @@ static int tx_task_exec_running(struct rxtx_data *tx, struct cli_state *s)
     MUTEX_LOCK(&tx->param_lock);
     repeats_remaining = tx_params->repeat;
     delay_us          = tx_params->repeat_delay;
+    playback          = tx_params->playback;
     MUTEX_UNLOCK(&tx->param_lock);
 
     repeat_infinite = (repeats_remaining == 0);
@@ -92,6 +477,18 @@ static int tx_task_exec_running(struct rxtx_data *tx, struct cli_state *s)
     delay_samples = (unsigned int)((uint64_t)sample_rate * delay_us / 1000000);
     delay_samples_remaining = delay_samples;
 
+    MUTEX_LOCK(&tx->file_mgmt.file_meta_lock);
+    is_capture = (tx->file_mgmt.format == RXTX_FMT_CAPTURE);
+    MUTEX_UNLOCK(&tx->file_mgmt.file_meta_lock);
+
+    if (is_capture) {
+        return tx_task_exec_running_capture(tx, s, sample_rate,
+                                            repeats_remaining, delay_samples);
+    } else if (playback != TX_PLAYBACK_STREAM) {
+        return tx_task_exec_running_waveform(tx, s, sample_rate,
+                                             repeats_remaining, delay_samples);
+    }
+
     /* Allocate a buffer to hold each block of samples to transmit */
     tx_buffer = (int16_t *)malloc(samples_per_buffer * 2 * sizeof(int16_t));
     if (tx_buffer == NULL) {
@@ -234,19 +631,11 @@ static int tx_task_exec_running(struct rxtx_data *tx, struct cli_state *s)
 static int tx_csv_to_bladerf_format(struct cli_state *s)
 {
     struct rxtx_data *tx = s->tx;
-    char buf[81]         = { 0 };
     FILE *bin            = NULL;
     FILE *csv            = NULL;
     char *bin_name       = NULL;
-    int8_t *tmp_iq       = NULL;
-    int line             = 1;
-    size_t n_clamped     = 0;
-
-    int min_val          = SC16Q11_IQ_MIN;
-    int max_val          = SC16Q11_IQ_MAX;
-
-    // 16 bit samples are 2*int8_t samples wide
-    int sample_size      = s->bit_mode_8bit ? 1 : 2;
+    struct sample_csv_stats stats;
+    enum sample_csv_fmt fmt;
     int status;
 
     assert(tx->file_mgmt.path != NULL);
@@ -267,85 +656,33 @@ static int tx_csv_to_bladerf_format(struct cli_state *s)
         goto tx_csv_to_bladerf_format_out;
     }
 
+    fmt = s->bit_mode_8bit ? SAMPLE_CSV_SC8Q7 : SAMPLE_CSV_SC16Q11;
 
-    if (s->bit_mode_8bit) {
-        min_val = SC8Q7_IQ_MIN;
-        max_val = SC8Q7_IQ_MAX;
-    }
-
-    while (fgets(buf, sizeof(buf), csv)) {
-        int i, cols, tmp_int;
-        int **args = NULL;
-
-        cols = csv2int(buf, &args);
-
-        if (cols < 0) {
-            cli_err(s, "tx", "Line (%d): Parsing failed.\n", line);
-            status = CLI_RET_INVPARAM;
-            break;
-        }
-
-        if (cols == 0) {
-            // empty line...?
-            continue;
-        }
-
-        tmp_iq = realloc(tmp_iq, cols * sample_size);
-
-        for (i = 0; i < cols; ++i) {
-            tmp_int = *args[i];
-
-            if (tmp_int < min_val) {
-                tmp_int = min_val;
-                n_clamped++;
-            } else if (tmp_int > max_val) {
-                tmp_int = max_val;
-                n_clamped++;
-            }
-
-            memcpy(tmp_iq + i * sample_size, &tmp_int, sample_size);
-        }
-
-        free_csv2int(cols, args);
-
-        if (cols % 2 != 0) {
-            cli_err(
-                s, "tx",
-                "Line (%d): Encountered %d value%s (values must be in pairs)\n",
-                line, cols, 1 == cols ? "" : "s");
-            status = CLI_RET_INVPARAM;
-            break;
-        }
-
-        if ((int)fwrite(tmp_iq, sample_size, cols, bin) != cols) {
-            status = CLI_RET_FILEOP;
-            break;
-        }
+    status = sample_csv_from_file(csv, bin, fmt, TX_CSV_THREADS, &stats);
 
-        line++;
-    }
+    if (status == CLI_RET_INVPARAM) {
+        cli_err(s, "tx",
+                "Line (%" PRIu64 "): Parsing failed. Values must be "
+                "integers, in I,Q pairs.\n",
+                stats.error_line);
+    } else if (status == 0) {
+        free(tx->file_mgmt.path);
+        tx->file_mgmt.path   = bin_name;
+        tx->file_mgmt.format = s->bit_mode_8bit ? RXTX_FMT_BIN_SC8Q7
+                                                : RXTX_FMT_BIN_SC16Q11;
 
-    if (status == 0) {
-        if (feof(csv)) {
-            free(tx->file_mgmt.path);
-            tx->file_mgmt.path = bin_name;
-            tx->file_mgmt.format = RXTX_FMT_BIN_SC16Q11;
-
-            if (n_clamped != 0) {
-               if (s->bit_mode_8bit) {
-                   printf("  Warning: %zu value%s clamped within DAC SC8 Q7 "
-                          "range of [%d, %d].\n",
-                          n_clamped, 1 == n_clamped ? "" : "s", SC8Q7_IQ_MIN,
-                          SC8Q7_IQ_MAX);
-               } else {
-                  printf("  Warning: %zu value%s clamped within DAC SC16 Q11 "
-                         "range of [%d, %d].\n",
-                         n_clamped, 1 == n_clamped ? "" : "s", SC16Q11_IQ_MIN,
-                         SC16Q11_IQ_MAX);
-               }
+        if (stats.clamped != 0) {
+            if (s->bit_mode_8bit) {
+                printf("  Warning: %" PRIu64 " value%s clamped within DAC "
+                       "SC8 Q7 range of [%d, %d].\n",
+                       stats.clamped, 1 == stats.clamped ? "" : "s",
+                       SC8Q7_IQ_MIN, SC8Q7_IQ_MAX);
+            } else {
+                printf("  Warning: %" PRIu64 " value%s clamped within DAC "
+                       "SC16 Q11 range of [%d, %d].\n",
+                       stats.clamped, 1 == stats.clamped ? "" : "s",
+                       SC16Q11_IQ_MIN, SC16Q11_IQ_MAX);
             }
-        } else {
-            status = CLI_RET_FILEOP;
         }
     }
 
@@ -354,8 +691,6 @@ tx_csv_to_bladerf_format_out:
         free(bin_name);
     }
 
-    free(tmp_iq);
-
     if (csv) {
         fclose(csv);
     }
@@ -376,6 +711,8 @@ void *tx_task(void *cli_state_arg)
     struct cli_state *cli_state = (struct cli_state *)cli_state_arg;
     struct rxtx_data *tx        = cli_state->tx;
     bladerf_format sync_fmt;
+    enum error_type last_type;
+    int last_err;
 
     /* We expect to be in the IDLE state when this is kicked off. We could
      * also get into the shutdown state if the program exits before we
@@ -411,6 +748,20 @@ void *tx_task(void *cli_state_arg)
                 sync_fmt = cli_state->bit_mode_8bit ?
                     BLADERF_FORMAT_SC8_Q7 : BLADERF_FORMAT_SC16_Q11;
 
+                /* Timed playback schedules repetitions via metadata, as does
+                 * the replay of a capture */
+                MUTEX_LOCK(&tx->param_lock);
+                if (((struct tx_params *)tx->params)->timed) {
+                    sync_fmt = BLADERF_FORMAT_SC16_Q11_META;
+                }
+                MUTEX_UNLOCK(&tx->param_lock);
+
+                MUTEX_LOCK(&tx->file_mgmt.file_meta_lock);
+                if (tx->file_mgmt.format == RXTX_FMT_CAPTURE) {
+                    sync_fmt = BLADERF_FORMAT_SC16_Q11_META;
+                }
+                MUTEX_UNLOCK(&tx->file_mgmt.file_meta_lock);
+
                 /* Initialize the TX synchronous data configuration */
                 status = bladerf_sync_config(
                     cli_state->dev, tx->data_mgmt.layout,
@@ -431,6 +782,9 @@ void *tx_task(void *cli_state_arg)
             } break;
 
             case RXTX_STATE_RUNNING:
+                /* Any error recorded from here on belongs to this run */
+                set_last_error(&tx->last_error, ETYPE_BLADERF, 0);
+
                 status = rxtx_apply_channels(cli_state, tx, true);
 
                 if (status < 0) {
@@ -438,7 +792,9 @@ void *tx_task(void *cli_state_arg)
                 } else {
                     status = tx_task_exec_running(tx, cli_state);
 
-                    if (status < 0) {
+                    /* Keep any more specific error the task recorded */
+                    get_last_error(&tx->last_error, &last_type, &last_err);
+                    if (status < 0 && last_err == 0) {
                         set_last_error(&tx->last_error, ETYPE_BLADERF, status);
                     }
 
@@ -470,9 +826,59 @@ void *tx_task(void *cli_state_arg)
     return NULL;
 }
 
+/* Check that the open capture file can be replayed with the current TX
+ * configuration. The file is closed if it cannot.
+ *
+ * Must be called with the file lock held.
+ *
+ * returns 0 on success, CLI_RET_* on failure */
+static int tx_check_capture(struct cli_state *s)
+{
+    int status;
+    struct capture_reader *reader = NULL;
+    struct capture_params params;
+    bladerf_channel_layout layout;
+
+    status = capture_reader_open(s->tx->file_mgmt.file, &reader);
+    if (status == CLI_RET_INVPARAM) {
+        cli_err(s, "tx", "%s is not a valid capture file.\n",
+                s->tx->file_mgmt.path);
+    } else if (status == 0) {
+        capture_reader_get_params(reader, &params);
+
+        MUTEX_LOCK(&s->tx->data_mgmt.lock);
+        layout = s->tx->data_mgmt.layout;
+        MUTEX_UNLOCK(&s->tx->data_mgmt.lock);
+
+        /* libbladeRF only supports TX bursts in the SC16 Q11 metadata
+         * format */
+        if (params.format != CAPTURE_FMT_SC16Q11 || s->bit_mode_8bit) {
+            cli_err(s, "tx", "Capture replay requires an SC16 Q11 capture "
+                             "and 16-bit mode.\n");
+            status = CLI_RET_UNSUPPORTED;
+        } else if ((params.layout == BLADERF_RX_X2) !=
+                   (layout == BLADERF_TX_X2)) {
+            cli_err(s, "tx", "The capture's channel count does not match "
+                             "the enabled TX channels.\n");
+            status = CLI_RET_INVPARAM;
+        }
+    }
+
+    capture_reader_free(reader);
+
+    if (status != 0) {
+        fclose(s->tx->file_mgmt.file);
+        s->tx->file_mgmt.file = NULL;
+    }
+
+    return status;
+}
+
 static int tx_cmd_start(struct cli_state *s)
 {
     int status = 0;
+    enum tx_playback playback;
+    bool timed;
 
     /* Check that we're able to start up in our current state */
     status = rxtx_cmd_start_check(s, s->tx, "tx");
@@ -480,6 +886,22 @@ static int tx_cmd_start(struct cli_state *s)
         return status;
     }
 
+    MUTEX_LOCK(&s->tx->param_lock);
+    playback = ((struct tx_params *)s->tx->params)->playback;
+    timed    = ((struct tx_params *)s->tx->params)->timed;
+    MUTEX_UNLOCK(&s->tx->param_lock);
+
+    /* Timed repetitions are scheduled from a waveform held in memory, and
+     * libbladeRF only supports TX bursts in the SC16 Q11 metadata format */
+    if (timed && playback == TX_PLAYBACK_STREAM) {
+        cli_err(s, "tx", "Timed playback requires playback=mmap or "
+                         "playback=preload.\n");
+        return CLI_RET_INVPARAM;
+    } else if (timed && s->bit_mode_8bit) {
+        cli_err(s, "tx", "Timed playback is not supported in 8-bit mode.\n");
+        return CLI_RET_UNSUPPORTED;
+    }
+
     /* Perform file conversion (if needed) and open input file */
     MUTEX_LOCK(&s->tx->file_mgmt.file_meta_lock);
 
@@ -502,9 +924,15 @@ static int tx_cmd_start(struct cli_state *s)
         MUTEX_LOCK(&s->tx->file_mgmt.file_lock);
 
         assert(s->tx->file_mgmt.format == RXTX_FMT_BIN_SC16Q11 ||
-               s->tx->file_mgmt.format == RXTX_FMT_BIN_SC8Q7);
+               s->tx->file_mgmt.format == RXTX_FMT_BIN_SC8Q7 ||
+               s->tx->file_mgmt.format == RXTX_FMT_CAPTURE);
         status = expand_and_open(s->tx->file_mgmt.path, "rb",
                                  &s->tx->file_mgmt.file);
+
+        if (status == 0 && s->tx->file_mgmt.format == RXTX_FMT_CAPTURE) {
+            status = tx_check_capture(s);
+        }
+
         MUTEX_UNLOCK(&s->tx->file_mgmt.file_lock);
     }
 
@@ -528,14 +956,32 @@ static int tx_cmd_start(struct cli_state *s)
     return status;
 }
 
+static const char *tx_playback_str(enum tx_playback playback)
+{
+    switch (playback) {
+        case TX_PLAYBACK_STREAM:
+            return "stream";
+        case TX_PLAYBACK_MMAP:
+            return "mmap";
+        case TX_PLAYBACK_PRELOAD:
+            return "preload";
+        default:
+            return "unknown";
+    }
+}
+
 static void tx_print_config(struct rxtx_data *tx)
 {
     unsigned int repetitions, repeat_delay;
+    enum tx_playback playback;
+    bool timed;
     struct tx_params *tx_params = tx->params;
 
     MUTEX_LOCK(&tx->param_lock);
     repetitions  = tx_params->repeat;
     repeat_delay = tx_params->repeat_delay;
+    playback     = tx_params->playback;
+    timed        = tx_params->timed;
     MUTEX_UNLOCK(&tx->param_lock);
 
     printf("\n");
@@ -557,6 +1003,9 @@ static void tx_print_config(struct rxtx_data *tx)
         printf("  Repetition delay: none\n");
     }
 
+    printf("  Playback: %s%s\n", tx_playback_str(playback),
+           timed ? ", timed" : "");
+
     rxtx_print_stream_info(tx, "  ", "\n");
 
     printf("\n");
@@ -611,6 +1060,36 @@ static int tx_config(struct cli_state *s, int argc, char **argv)
                     cli_err(s, argv[0], RXTX_ERRMSG_VALUE(argv[i], val));
                     return CLI_RET_INVPARAM;
                 }
+            } else if (!strcasecmp("playback", argv[i])) {
+                /* Configure how the file is read during transmission */
+                enum tx_playback tmp;
+
+                if (!strcasecmp("stream", val)) {
+                    tmp = TX_PLAYBACK_STREAM;
+                } else if (!strcasecmp("mmap", val)) {
+                    tmp = TX_PLAYBACK_MMAP;
+                } else if (!strcasecmp("preload", val)) {
+                    tmp = TX_PLAYBACK_PRELOAD;
+                } else {
+                    cli_err(s, argv[0], RXTX_ERRMSG_VALUE(argv[i], val));
+                    return CLI_RET_INVPARAM;
+                }
+
+                MUTEX_LOCK(&s->tx->param_lock);
+                tx_params->playback = tmp;
+                MUTEX_UNLOCK(&s->tx->param_lock);
+            } else if (!strcasecmp("timed", argv[i])) {
+                /* Configure whether repetitions are timestamped bursts */
+                bool tmp;
+
+                if (str2bool(val, &tmp) == 0) {
+                    MUTEX_LOCK(&s->tx->param_lock);
+                    tx_params->timed = tmp;
+                    MUTEX_UNLOCK(&s->tx->param_lock);
+                } else {
+                    cli_err(s, argv[0], RXTX_ERRMSG_VALUE(argv[i], val));
+                    return CLI_RET_INVPARAM;
+                }
             } else if (!strcasecmp("channel", argv[i])) {
                 /* Configure TX channels */
                 status = rxtx_handle_channel_list(s, s->tx, val);
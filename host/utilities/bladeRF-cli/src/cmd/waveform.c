@@ -0,0 +1,239 @@
+/*
+ * This file is part of the bladeRF project
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "host_config.h"
+
+#if BLADERF_OS_WINDOWS
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "common.h"
+#include "minmax.h"
+#include "waveform.h"
+
+struct waveform {
+    void *data;
+    size_t size;
+    enum waveform_mode mode;
+    bool locked;
+
+#if BLADERF_OS_WINDOWS
+    HANDLE mapping; /* File mapping object backing a WAVEFORM_MMAP view */
+#endif
+};
+
+/* Get the size of an open file. Returns 0 on success or an errno value. */
+static int file_size(int fd, uint64_t *size)
+{
+#if BLADERF_OS_WINDOWS
+    struct _stat64 st;
+
+    if (_fstat64(fd, &st) != 0) {
+        return errno;
+    }
+#else
+    struct stat st;
+
+    if (fstat(fd, &st) != 0) {
+        return errno;
+    }
+#endif
+
+    *size = (uint64_t)st.st_size;
+    return 0;
+}
+
+static int map_file(struct waveform *w, int fd)
+{
+#if BLADERF_OS_WINDOWS
+    HANDLE file = (HANDLE)_get_osfhandle(fd);
+
+    w->mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (w->mapping == NULL) {
+        return EIO;
+    }
+
+    w->data = MapViewOfFile(w->mapping, FILE_MAP_READ, 0, 0, w->size);
+    if (w->data == NULL) {
+        CloseHandle(w->mapping);
+        return EIO;
+    }
+#else
+    w->data = mmap(NULL, w->size, PROT_READ, MAP_SHARED, fd, 0);
+    if (w->data == MAP_FAILED) {
+        w->data = NULL;
+        return errno;
+    }
+
+    /* The whole file will be read front to back, repeatedly */
+    posix_madvise(w->data, w->size, POSIX_MADV_WILLNEED);
+    posix_madvise(w->data, w->size, POSIX_MADV_SEQUENTIAL);
+#endif
+
+    return 0;
+}
+
+static int read_file(struct waveform *w, int fd)
+{
+    size_t done = 0;
+
+    w->data = malloc(w->size);
+    if (w->data == NULL) {
+        return ENOMEM;
+    }
+
+    while (done < w->size) {
+#if BLADERF_OS_WINDOWS
+        int ret;
+
+        if (_lseeki64(fd, (__int64)done, SEEK_SET) < 0) {
+            ret = -1;
+        } else {
+            ret = _read(fd, (uint8_t *)w->data + done,
+                        (unsigned int)min_sz(w->size - done, INT_MAX));
+        }
+#else
+        ssize_t ret = pread(fd, (uint8_t *)w->data + done, w->size - done,
+                            (off_t)done);
+#endif
+
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        } else if (ret < 0) {
+            return errno;
+        } else if (ret == 0) {
+            /* The file was truncated after we sized it */
+            return EIO;
+        }
+
+        done += (size_t)ret;
+    }
+
+#if BLADERF_OS_WINDOWS
+    w->locked = VirtualLock(w->data, w->size);
+#else
+    w->locked = (mlock(w->data, w->size) == 0);
+#endif
+
+    return 0;
+}
+
+int waveform_load(FILE *file,
+                  enum waveform_mode mode,
+                  struct waveform **waveform)
+{
+    struct waveform *w;
+    uint64_t size = 0;
+    int fd = fileno(file);
+    int err;
+
+    err = file_size(fd, &size);
+    if (err != 0) {
+        errno = err;
+        return CLI_RET_FILEOP;
+    }
+
+    if (size == 0) {
+        return CLI_RET_INVPARAM;
+    } else if (size > SIZE_MAX) {
+        return CLI_RET_MEM;
+    }
+
+    w = calloc(1, sizeof(*w));
+    if (w == NULL) {
+        return CLI_RET_MEM;
+    }
+
+    w->size = (size_t)size;
+    w->mode = mode;
+
+    if (mode == WAVEFORM_MMAP) {
+        err = map_file(w, fd);
+    } else {
+        err = read_file(w, fd);
+    }
+
+    if (err == ENOMEM) {
+        waveform_free(w);
+        return CLI_RET_MEM;
+    } else if (err != 0) {
+        waveform_free(w);
+        errno = err;
+        return CLI_RET_FILEOP;
+    }
+
+    *waveform = w;
+    return 0;
+}
+
+const void *waveform_data(const struct waveform *waveform)
+{
+    return waveform->data;
+}
+
+size_t waveform_size(const struct waveform *waveform)
+{
+    return waveform->size;
+}
+
+bool waveform_locked(const struct waveform *waveform)
+{
+    return waveform->locked;
+}
+
+void waveform_free(struct waveform *waveform)
+{
+    if (waveform == NULL) {
+        return;
+    }
+
+    if (waveform->data != NULL) {
+        if (waveform->mode == WAVEFORM_MMAP) {
+#if BLADERF_OS_WINDOWS
+            UnmapViewOfFile(waveform->data);
+            CloseHandle(waveform->mapping);
+#else
+            munmap(waveform->data, waveform->size);
+#endif
+        } else {
+            if (waveform->locked) {
+#if BLADERF_OS_WINDOWS
+                VirtualUnlock(waveform->data, waveform->size);
+#else
+                munlock(waveform->data, waveform->size);
+#endif
+            }
+
+            free(waveform->data);
+        }
+    }
+
+    free(waveform);
+}
@@ -0,0 +1,90 @@
+/**
+ * @file waveform.h
+ *
+ * @brief In-memory sample files for repeated transmission
+ *
+ * A waveform holds the entire contents of a sample file in memory, either by
+ * mapping the file or by reading it into (ideally page-locked) memory, so
+ * that it may be transmitted any number of times without re-reading the file.
+ *
+ * This file is part of the bladeRF project
+ *
+ * Copyright (C) 2026 Nuand LLC
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef WAVEFORM_H__
+#define WAVEFORM_H__
+
+#include <stdbool.h>
+#include <stdio.h>
+
+enum waveform_mode {
+    WAVEFORM_MMAP,    /* Map the file into memory */
+    WAVEFORM_PRELOAD, /* Read the file into locked memory */
+};
+
+struct waveform;
+
+/**
+ * Load the contents of a file
+ *
+ * The file is accessed through its underlying descriptor, from its start,
+ * and must not be modified while the waveform is in use.
+ *
+ * @param[in]   file        File to load
+ * @param[in]   mode        How to load the file
+ * @param[out]  waveform    Loaded waveform
+ *
+ * @return 0 on success, CLI_RET_INVPARAM if the file is empty, CLI_RET_MEM
+ *         if the file does not fit in memory, or CLI_RET_FILEOP if the file
+ *         could not be mapped or read. In the latter case, errno is set.
+ */
+int waveform_load(FILE *file,
+                  enum waveform_mode mode,
+                  struct waveform **waveform);
+
+/**
+ * @param[in]   waveform    Waveform
+ *
+ * @return File contents
+ */
+const void *waveform_data(const struct waveform *waveform);
+
+/**
+ * @param[in]   waveform    Waveform
+ *
+ * @return Size of the file contents, in bytes
+ */
+size_t waveform_size(const struct waveform *waveform);
+
+/**
+ * Page-locking is best-effort, as it is subject to the process' resource
+ * limits. Mapped files are not locked.
+ *
+ * @param[in]   waveform    Waveform
+ *
+ * @return true if the contents are locked into physical memory
+ */
+bool waveform_locked(const struct waveform *waveform);
+
+/**
+ * Unmap or free a waveform
+ *
+ * @param[in]   waveform    Waveform. NULL is ignored.
+ */
+void waveform_free(struct waveform *waveform);
+
+#endif